@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+Throughput/latency benchmark for the AzerothCore Character Web Service
+
+Drives the web service with a number of concurrent keep-alive connections and
+reports throughput, latency percentiles and how many requests were refused with
+"503 Service Unavailable" because CharacterWebService.MaxConcurrentRequests was
+reached.
+
+By default it hits GET /status, which measures the HTTP/session overhead only.
+Use --payload to POST a JSON file to /character/gear instead; be aware that this
+recreates the character of the payload for every request.
+
+Usage: python bench_character_web_service.py [host] [port] [--connections N] [--requests N] [--pipeline N] [--payload file.json]
+"""
+
+import argparse
+import socket
+import statistics
+import threading
+import time
+
+
+def build_request(host, payload):
+    if payload is None:
+        return f"GET /status HTTP/1.1\r\nHost: {host}\r\nConnection: keep-alive\r\n\r\n".encode()
+
+    return (f"POST /character/gear HTTP/1.1\r\nHost: {host}\r\nConnection: keep-alive\r\n"
+            f"Content-Type: application/json\r\nContent-Length: {len(payload)}\r\n\r\n").encode() + payload
+
+
+def read_response(sock, buffer):
+    """Reads one HTTP response from the socket, returns (status, remaining buffer)."""
+    while b"\r\n\r\n" not in buffer:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise ConnectionError("connection closed by server")
+        buffer += chunk
+
+    header, _, rest = buffer.partition(b"\r\n\r\n")
+    lines = header.split(b"\r\n")
+    status = int(lines[0].split()[1])
+    length = 0
+    for line in lines[1:]:
+        name, _, value = line.partition(b":")
+        if name.strip().lower() == b"content-length":
+            length = int(value.strip())
+
+    while len(rest) < length:
+        chunk = sock.recv(65536)
+        if not chunk:
+            raise ConnectionError("connection closed by server")
+        rest += chunk
+
+    return status, rest[length:]
+
+
+def run_connection(args, request, results):
+    latencies = []
+    statuses = {}
+    errors = 0
+
+    try:
+        sock = socket.create_connection((args.host, args.port))
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        buffer = b""
+        remaining = args.requests
+
+        while remaining > 0:
+            # Send a batch of pipelined requests, then read all responses in order
+            batch = min(args.pipeline, remaining)
+            start = time.perf_counter()
+            sock.sendall(request * batch)
+
+            for _ in range(batch):
+                status, buffer = read_response(sock, buffer)
+                latencies.append(time.perf_counter() - start)
+                statuses[status] = statuses.get(status, 0) + 1
+
+            remaining -= batch
+
+        sock.close()
+    except (OSError, ConnectionError, ValueError):
+        errors += 1
+
+    results.append((latencies, statuses, errors))
+
+
+def percentile(values, fraction):
+    if not values:
+        return 0.0
+
+    index = min(len(values) - 1, int(len(values) * fraction))
+    return values[index]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Character Web Service benchmark")
+    parser.add_argument("host", nargs="?", default="localhost")
+    parser.add_argument("port", nargs="?", type=int, default=8080)
+    parser.add_argument("--connections", type=int, default=16, help="concurrent keep-alive connections")
+    parser.add_argument("--requests", type=int, default=200, help="requests per connection")
+    parser.add_argument("--pipeline", type=int, default=1, help="requests sent back to back before reading responses")
+    parser.add_argument("--payload", help="JSON file to POST to /character/gear instead of GET /status")
+    args = parser.parse_args()
+
+    payload = None
+    if args.payload:
+        with open(args.payload, "rb") as f:
+            payload = f.read()
+
+    request = build_request(args.host, payload)
+    results = []
+    threads = [threading.Thread(target=run_connection, args=(args, request, results)) for _ in range(args.connections)]
+
+    start = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - start
+
+    latencies = sorted(latency for result in results for latency in result[0])
+    statuses = {}
+    for result in results:
+        for status, count in result[1].items():
+            statuses[status] = statuses.get(status, 0) + count
+    errors = sum(result[2] for result in results)
+
+    print(f"Connections: {args.connections}, requests/connection: {args.requests}, pipeline depth: {args.pipeline}")
+    print(f"Completed:   {len(latencies)} requests in {elapsed:.2f}s ({len(latencies) / elapsed:.1f} req/s)")
+    print(f"Statuses:    {dict(sorted(statuses.items()))}, connection errors: {errors}")
+    if latencies:
+        print(f"Latency:     mean {statistics.mean(latencies) * 1000:.2f} ms, "
+              f"p50 {percentile(latencies, 0.50) * 1000:.2f} ms, "
+              f"p90 {percentile(latencies, 0.90) * 1000:.2f} ms, "
+              f"p99 {percentile(latencies, 0.99) * 1000:.2f} ms, "
+              f"max {latencies[-1] * 1000:.2f} ms")
+
+
+if __name__ == "__main__":
+    main()
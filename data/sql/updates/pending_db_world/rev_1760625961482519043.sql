@@ -0,0 +1,5 @@
+--
+DELETE FROM `command` WHERE `name` IN ('server database', 'server database reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server database', 3, 'Syntax: .server database [#count]\r Show the queue size of every database and the #count statements (default 5) it spent the most time on, with their execution and queue wait times.'),
+('server database reset', 3, 'Syntax: .server database reset\r Reset the statistics shown by .server database.');
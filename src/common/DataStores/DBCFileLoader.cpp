@@ -17,70 +17,54 @@
 
 #include "DBCFileLoader.h"
 #include "Errors.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <string.h>
 
 DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
 
 bool DBCFileLoader::Load(char const* filename, char const* fmt)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = nullptr;
-    }
+    data = nullptr;
+    stringTable = nullptr;
+    delete[] fieldsOffset;
+    fieldsOffset = nullptr;
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
+    // Mapped copy-on-write: pages are shared with other processes mapping the same file
+    // until something writes to them, e.g. corrections applied to DBC entries at startup.
+    // The file handle is closed again right away, only the mapping is kept
+    std::shared_ptr<boost::interprocess::mapped_region> region;
+    try
     {
-        return false;
+        boost::interprocess::file_mapping file(filename, boost::interprocess::read_only);
+        region = std::make_shared<boost::interprocess::mapped_region>(file, boost::interprocess::copy_on_write);
     }
-
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
+    catch (std::exception const&)
     {
-        fclose(f);
         return false;
     }
 
-    EndianConvert(header);
-
-    if (header != 0x43424457)                                //'WDBC'
-    {
-        fclose(f);
-        return false;
-    }
+    unsigned char* fileData = static_cast<unsigned char*>(region->get_address());
+    std::size_t fileSize = region->get_size();
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
-    {
-        fclose(f);
+    uint32 header[5];                                       // 'WDBC', records, fields, record size, string size
+    if (fileSize < sizeof(header))
         return false;
-    }
 
-    EndianConvert(recordCount);
+    memcpy(header, fileData, sizeof(header));
+    for (uint32& value : header)
+        EndianConvert(value);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
+    if (header[0] != 0x43424457)                            //'WDBC'
         return false;
-    }
 
-    EndianConvert(fieldCount);
+    recordCount = header[1];
+    fieldCount = header[2];
+    recordSize = header[3];
+    stringSize = header[4];
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
+    if (fileSize - sizeof(header) < uint64(recordSize) * recordCount + stringSize)
         return false;
-    }
-
-    EndianConvert(recordSize);
-
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(stringSize);
 
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
@@ -98,24 +82,15 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
         }
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    mapping = std::move(region);
+    data = fileData + sizeof(header);
     stringTable = data + recordSize * recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
-
     delete[] fieldsOffset;
 }
 
@@ -195,6 +170,7 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
     //get struct size and index pos
     int32 i;
     uint32 recordsize = GetFormatRecordSize(format, &i);
+    bool inPlace = CanUseRecordsInPlace(format);
 
     if (i >= 0)
     {
@@ -220,6 +196,17 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    if (inPlace)
+    {
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            char* record = reinterpret_cast<char*>(data + y * recordSize);
+            indexTable[i >= 0 ? getRecord(y).getUInt(i) : y] = record;
+        }
+
+        return nullptr;
+    }
+
     char* dataTable = new char[recordCount * recordsize];
 
     uint32 offset = 0;
@@ -273,16 +260,13 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
+bool DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
 {
     if (strlen(format) != fieldCount)
     {
-        return nullptr;
+        return false;
     }
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
-
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; ++y)
@@ -307,8 +291,7 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !** slot)
                     {
-                        const char* st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (char const*)stringTable);
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     }
                     offset += sizeof(char*);
                     break;
@@ -327,5 +310,19 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    return true;
+}
+
+bool DBCFileLoader::CanUseRecordsInPlace(char const* format) const
+{
+    // Only 4 byte fields without pointers or skipped columns, on little endian hosts.
+    // The file is mapped page aligned and the records start after a 20 byte header, so they stay aligned
+    if (ACORE_ENDIAN != ACORE_LITTLEENDIAN || strlen(format) != fieldCount || recordSize != fieldCount * sizeof(uint32))
+        return false;
+
+    for (uint32 x = 0; x < fieldCount; ++x)
+        if (format[x] != FT_INT && format[x] != FT_FLOAT && format[x] != FT_IND)
+            return false;
+
+    return true;
 }
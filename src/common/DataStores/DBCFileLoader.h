@@ -21,6 +21,12 @@
 #include "Define.h"
 #include "Errors.h"
 #include "Utilities/ByteConverter.h"
+#include <memory>
+
+namespace boost::interprocess
+{
+    class mapped_region;
+}
 
 enum DbcFieldFormat
 {
@@ -92,10 +98,19 @@ public:
     [[nodiscard]] uint32 GetCols() const { return fieldCount; }
     [[nodiscard]] uint32 GetOffset(std::size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
     [[nodiscard]] bool IsLoaded() const { return data != nullptr; }
+
+    /// Returns nullptr without an error when the records are used in place from the mapped file
     char* AutoProduceData(char const* fmt, uint32& count, char**& indexTable);
-    char* AutoProduceStrings(char const* fmt, char* dataTable);
+    /// Points the string fields of dataTable into the mapped string block
+    bool AutoProduceStrings(char const* fmt, char* dataTable);
     static uint32 GetFormatRecordSize(const char* format, int32* index_pos = nullptr);
 
+    /// True when records of this format have the same layout in memory as in the file
+    [[nodiscard]] bool CanUseRecordsInPlace(char const* fmt) const;
+
+    /// The mapped file, must be kept alive as long as records or strings produced from it are used
+    [[nodiscard]] std::shared_ptr<void> GetMapping() const { return mapping; }
+
 private:
     uint32 recordSize;
     uint32 recordCount;
@@ -104,6 +119,7 @@ private:
     uint32* fieldsOffset;
     unsigned char* data;
     unsigned char* stringTable;
+    std::shared_ptr<boost::interprocess::mapped_region> mapping;
 
     DBCFileLoader(DBCFileLoader const& right) = delete;
     DBCFileLoader& operator=(DBCFileLoader const& right) = delete;
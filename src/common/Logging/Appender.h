@@ -42,6 +42,9 @@ public:
     static char const* getLogLevelString(LogLevel level);
     virtual void setRealmId(uint32 /*realmId*/) { }
 
+    /// Hands buffered output to the system, called after every synchronous message and after every batch of the logging thread
+    virtual void Flush() { }
+
 private:
     virtual void _write(LogMessage const* /*message*/) = 0;
 
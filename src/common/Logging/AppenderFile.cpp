@@ -97,9 +97,7 @@ void AppenderFile::_write(LogMessage const* message)
             return;
         }
 
-        fprintf(file, "%s%s\n", message->prefix.c_str(), message->text.c_str());
-        fflush(file);
-        _fileSize += uint64(message->Size());
+        WriteLine(file, message);
         fclose(file);
 
         return;
@@ -114,11 +112,26 @@ void AppenderFile::_write(LogMessage const* message)
         return;
     }
 
-    fprintf(logfile, "%s%s\n", message->prefix.c_str(), message->text.c_str());
-    fflush(logfile);
+    WriteLine(logfile, message);
+}
+
+void AppenderFile::WriteLine(FILE* file, LogMessage const* message)
+{
+    // Left in the stdio buffer until Flush(), so a batch of messages ends up in a few write calls
+    fwrite(message->prefix.data(), 1, message->prefix.size(), file);
+    fwrite(message->text.data(), 1, message->text.size(), file);
+    fputc('\n', file);
     _fileSize += uint64(message->Size());
 }
 
+void AppenderFile::Flush()
+{
+    if (logfile)
+    {
+        fflush(logfile);
+    }
+}
+
 FILE* AppenderFile::OpenFile(std::string const& filename, std::string const& mode, bool backup)
 {
     std::string fullName(_logDir + filename);
@@ -31,10 +31,12 @@ public:
     ~AppenderFile();
     FILE* OpenFile(std::string const& name, std::string const& mode, bool backup);
     AppenderType getType() const override { return type; }
+    void Flush() override;
 
 private:
     void CloseFile();
     void _write(LogMessage const* message) override;
+    void WriteLine(FILE* file, LogMessage const* message);
     FILE* logfile;
     std::string _fileName;
     std::string _logDir;
@@ -20,18 +20,221 @@
 #include "AppenderFile.h"
 #include "Config.h"
 #include "Errors.h"
-#include "IoContext.h"
 #include "LogMessage.h"
-#include "LogOperation.h"
+#include "LogRecordQueue.h"
 #include "Logger.h"
-#include "Strand.h"
 #include "StringConvert.h"
 #include "Timer.h"
 #include "Tokenize.h"
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <thread>
 
-Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL)
+namespace
+{
+    // Tells threads their queue belongs to a writer that was stopped, a new writer gets new queues
+    std::atomic<uint32> LogWriterIdCounter{0};
+}
+
+/**
+ * @brief Logging thread used with Log.Async.Enable.
+ *
+ * Every logging thread pushes its formatted messages into its own LogRecordQueue and the writer
+ * resolves the loggers and writes them in batches, flushing the appenders once per batch.
+ * A full queue drops the message and counts it, except for errors which wait for free space.
+ */
+class LogWriter
+{
+public:
+    LogWriter(Log& log, uint32 queueSize);
+    ~LogWriter();
+
+    void Enqueue(LogLevel level, std::string_view type, std::string_view text, std::string_view param1);
+
+    /// Writes everything queued so far and stops the thread
+    void Stop();
+
+    [[nodiscard]] uint64 GetDroppedMessageCount() const { return _droppedMessages.load(std::memory_order_relaxed); }
+
+private:
+    LogRecordQueue& GetThreadQueue();
+    void Run();
+    uint32 WriteQueuedMessages();
+    void Write(LogRecord& record);
+    void Wake();
+
+    Log& _log;
+    uint32 _id;
+    uint32 _queueSize;
+
+    std::mutex _queuesLock;
+    std::vector<std::shared_ptr<LogRecordQueue>> _queues;
+
+    std::thread _thread;
+    std::mutex _wakeLock;
+    std::condition_variable _wakeCondition;
+    std::atomic<bool> _waiting;
+    std::atomic<bool> _stop;
+
+    std::atomic<uint64> _droppedMessages;
+    uint64 _reportedDroppedMessages;
+
+    LogMessage _message;    // reused for every record, its strings are swapped with the record ones
+};
+
+LogWriter::LogWriter(Log& log, uint32 queueSize) : _log(log), _id(++LogWriterIdCounter), _queueSize(queueSize),
+    _waiting(false), _stop(false), _droppedMessages(0), _reportedDroppedMessages(0), _message(LOG_LEVEL_DISABLED, "", "")
+{
+    _thread = std::thread(&LogWriter::Run, this);
+}
+
+LogWriter::~LogWriter()
+{
+    Stop();
+}
+
+LogRecordQueue& LogWriter::GetThreadQueue()
+{
+    thread_local uint32 writerId = 0;
+    thread_local std::shared_ptr<LogRecordQueue> queue;
+
+    if (writerId != _id)
+    {
+        queue = std::make_shared<LogRecordQueue>(_queueSize);
+        writerId = _id;
+
+        std::lock_guard<std::mutex> guard(_queuesLock);
+        _queues.push_back(queue);
+    }
+
+    return *queue;
+}
+
+void LogWriter::Enqueue(LogLevel level, std::string_view type, std::string_view text, std::string_view param1)
+{
+    LogRecordQueue& queue = GetThreadQueue();
+    Seconds time = GetEpochTime();
+
+    while (!queue.Push(level, time, type, text, param1))
+    {
+        if (level > LOG_LEVEL_ERROR || _stop.load(std::memory_order_relaxed))
+        {
+            ++_droppedMessages;
+            Wake();
+            return;
+        }
+
+        _wakeCondition.notify_one();
+        std::this_thread::yield();
+    }
+
+    Wake();
+}
+
+void LogWriter::Wake()
+{
+    // Only pay for the notification when the writer is idle, a busy writer picks the message up with its next batch
+    if (_waiting.load(std::memory_order_acquire))
+        _wakeCondition.notify_one();
+}
+
+void LogWriter::Stop()
+{
+    if (!_thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(_wakeLock);
+        _stop = true;
+    }
+
+    _wakeCondition.notify_one();
+    _thread.join();
+}
+
+void LogWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(_wakeLock);
+    while (true)
+    {
+        bool stop = _stop.load();
+
+        lock.unlock();
+        uint32 written = WriteQueuedMessages();
+        lock.lock();
+
+        // Messages pushed before Stop() are written by the last pass above
+        if (stop)
+            break;
+
+        if (!written)
+        {
+            // The timeout covers a message pushed right before _waiting was set
+            _waiting = true;
+            _wakeCondition.wait_for(lock, 100ms);
+            _waiting = false;
+        }
+    }
+}
+
+uint32 LogWriter::WriteQueuedMessages()
+{
+    std::lock_guard<std::mutex> queuesGuard(_queuesLock);
+    std::lock_guard<std::recursive_mutex> loggersGuard(_log._loggersLock);
+
+    uint32 written = 0;
+    for (std::shared_ptr<LogRecordQueue> const& queue : _queues)
+        written += queue->Drain([this](LogRecord& record) { Write(record); });
+
+    uint64 dropped = _droppedMessages.load(std::memory_order_relaxed);
+    if (dropped != _reportedDroppedMessages)
+    {
+        LogRecord record;
+        record.Level = LOG_LEVEL_WARN;
+        record.Time = GetEpochTime();
+        record.Type = "server";
+        record.Text = Acore::StringFormat("Log: {} messages were dropped because the logging queue was full, consider raising Log.Async.QueueSize", dropped - _reportedDroppedMessages);
+        Write(record);
+
+        _reportedDroppedMessages = dropped;
+        ++written;
+    }
+
+    if (written)
+        _log.FlushAppenders();
+
+    // Queues of threads that exited
+    _queues.erase(std::remove_if(_queues.begin(), _queues.end(), [](std::shared_ptr<LogRecordQueue> const& queue)
+    {
+        return queue.use_count() == 1 && queue->IsEmpty();
+    }), _queues.end());
+
+    return written;
+}
+
+void LogWriter::Write(LogRecord& record)
+{
+    // Resolved here instead of by the caller so a config reload can never leave a dangling logger in the queues
+    Logger const* logger = _log.GetLoggerByType(record.Type);
+    if (!logger)
+        return;
+
+    _message.level = record.Level;
+    _message.mtime = record.Time;
+    _message.type.swap(record.Type);
+    _message.text.swap(record.Text);
+    _message.param1.swap(record.Param1);
+
+    logger->write(&_message);
+
+    _message.type.swap(record.Type);
+    _message.text.swap(record.Text);
+    _message.param1.swap(record.Param1);
+}
+
+Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL), _filterGeneration(1), _async(false)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -40,6 +243,7 @@ Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL)
 
 Log::~Log()
 {
+    SetSynchronous();
     Close();
 }
 
@@ -228,27 +432,38 @@ void Log::RegisterAppender(uint8 index, AppenderCreatorFn appenderCreateFn)
     appenderFactory[index] = appenderCreateFn;
 }
 
-void Log::_outMessage(std::string const& filter, LogLevel level, std::string_view message)
+void Log::_outMessage(std::string_view filter, LogLevel level, std::string_view message)
 {
-    write(std::make_unique<LogMessage>(level, filter, message));
+    if (_async.load(std::memory_order_relaxed))
+        _writer->Enqueue(level, filter, message, {});
+    else
+        write(std::make_unique<LogMessage>(level, std::string(filter), message));
 }
 
 void Log::_outCommand(std::string_view message, std::string_view param1)
 {
-    write(std::make_unique<LogMessage>(LOG_LEVEL_INFO, "commands.gm", message, param1));
+    if (_async.load(std::memory_order_relaxed))
+        _writer->Enqueue(LOG_LEVEL_INFO, "commands.gm", message, param1);
+    else
+        write(std::make_unique<LogMessage>(LOG_LEVEL_INFO, "commands.gm", message, param1));
 }
 
 void Log::write(std::unique_ptr<LogMessage>&& msg) const
 {
     Logger const* logger = GetLoggerByType(msg->type);
+    if (!logger)
+        return;
 
-    if (_ioContext)
+    logger->write(msg.get());
+    logger->flush();
+}
+
+void Log::FlushAppenders() const
+{
+    for (std::pair<uint8 const, std::unique_ptr<Appender>> const& appender : appenders)
     {
-        std::shared_ptr<LogOperation> logOperation = std::make_shared<LogOperation>(logger, std::move(msg));
-        Acore::Asio::post(*_ioContext, Acore::Asio::bind_executor(*_strand, [logOperation]() { logOperation->call(); }));
+        appender.second->Flush();
     }
-    else
-        logger->write(msg.get());
 }
 
 Logger const* Log::GetLoggerByType(std::string const& type) const
@@ -274,6 +489,12 @@ Logger const* Log::GetLoggerByType(std::string const& type) const
     return GetLoggerByType(parentLogger);
 }
 
+LogLevel Log::GetLogLevelForType(std::string const& type) const
+{
+    Logger const* logger = GetLoggerByType(type);
+    return logger ? logger->getLogLevel() : LOG_LEVEL_DISABLED;
+}
+
 std::string Log::GetTimestampStr()
 {
     return Acore::Time::TimeToTimestampStr(GetEpochTime(), "%Y-%m-%d_%H_%M_%S");
@@ -288,6 +509,8 @@ bool Log::SetLogLevel(std::string const& name, int32 newLeveli, bool isLogger /*
 
     LogLevel newLevel = LogLevel(newLeveli);
 
+    std::lock_guard<std::recursive_mutex> guard(_loggersLock);
+
     if (isLogger)
     {
         auto it = loggers.begin();
@@ -319,11 +542,13 @@ bool Log::SetLogLevel(std::string const& name, int32 newLeveli, bool isLogger /*
         appender->setLogLevel(newLevel);
     }
 
+    _filterGeneration.fetch_add(1, std::memory_order_release);
     return true;
 }
 
 void Log::SetRealmId(uint32 id)
 {
+    std::lock_guard<std::recursive_mutex> guard(_loggersLock);
     for (std::pair<uint8 const, std::unique_ptr<Appender>>& appender : appenders)
     {
         appender.second->setRealmId(id);
@@ -332,8 +557,10 @@ void Log::SetRealmId(uint32 id)
 
 void Log::Close()
 {
+    std::lock_guard<std::recursive_mutex> guard(_loggersLock);
     loggers.clear();
     appenders.clear();
+    _filterGeneration.fetch_add(1, std::memory_order_release);
 }
 
 bool Log::ShouldLog(std::string const& type, LogLevel level) const
@@ -348,41 +575,45 @@ bool Log::ShouldLog(std::string const& type, LogLevel level) const
         return false;
     }
 
-    Logger const* logger = GetLoggerByType(type);
-    if (!logger)
-    {
-        return false;
-    }
-
-    LogLevel logLevel = logger->getLogLevel();
+    LogLevel logLevel = GetLogLevelForType(type);
     return logLevel != LOG_LEVEL_DISABLED && logLevel >= level;
 }
 
+uint64 Log::GetDroppedMessageCount() const
+{
+    return _writer ? _writer->GetDroppedMessageCount() : 0;
+}
+
 Log* Log::instance()
 {
     static Log instance;
     return &instance;
 }
 
-void Log::Initialize(Acore::Asio::IoContext* ioContext)
+void Log::Initialize(bool async)
 {
-    if (ioContext)
+    SetSynchronous();
+    LoadFromConfig();
+
+    if (async)
     {
-        _ioContext = ioContext;
-        _strand = std::make_unique<Acore::Asio::Strand>(*ioContext);
+        _writer = std::make_unique<LogWriter>(*this, std::max<uint32>(sConfigMgr->GetOption<uint32>("Log.Async.QueueSize", 1024, false), 1));
+        _async = true;
     }
-
-    LoadFromConfig();
 }
 
 void Log::SetSynchronous()
 {
-    _strand.reset();
-    _ioContext = nullptr;
+    // The writer itself is kept, threads may still hold a reference to their queue
+    _async = false;
+    if (_writer)
+        _writer->Stop();
 }
 
 void Log::LoadFromConfig()
 {
+    std::lock_guard<std::recursive_mutex> guard(_loggersLock);
+
     Close();
 
     highestLogLevel = LOG_LEVEL_FATAL;
@@ -397,4 +628,6 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+
+    _filterGeneration.fetch_add(1, std::memory_order_release);
 }
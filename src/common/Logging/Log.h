@@ -22,19 +22,23 @@
 #include "Define.h"
 #include "LogCommon.h"
 #include "StringFormat.h"
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
+#include <type_traits>
 #include <vector>
 #include <memory>
 
 class Appender;
 class Logger;
+class LogWriter;
 struct LogMessage;
 
-namespace Acore::Asio
+/// Filter decision of a single LOG_* call site, see Log::ShouldLog
+struct LogFilterCache
 {
-    class IoContext;
-    class Strand;
-}
+    std::atomic<uint64> State{0};   // filter generation << 8 | level of the logger handling the type
+};
 
 #define LOGGER_ROOT "root"
 
@@ -61,15 +65,41 @@ private:
 public:
     static Log* instance();
 
-    void Initialize(Acore::Asio::IoContext* ioContext = nullptr);
+    void Initialize(bool async = false);
     void SetSynchronous();  // Not threadsafe - should only be called from main() after all threads are joined
     void LoadFromConfig();
     void Close();
     [[nodiscard]] bool ShouldLog(std::string const& type, LogLevel level) const;
     bool SetLogLevel(std::string const& name, int32 level, bool isLogger = true);
 
+    /// ShouldLog of a LOG_* call site, the logger lookup is only repeated after the loggers changed.
+    /// The macro only passes a cache for string literal types, see LOG_FILTER_TYPE_IS_LITERAL
+    template<std::size_t N>
+    [[nodiscard]] bool ShouldLog(char const (&type)[N], LogLevel level, LogFilterCache* cache) const
+    {
+        if (!cache)
+            return ShouldLog(type, level);
+
+        uint64 generation = _filterGeneration.load(std::memory_order_acquire);
+        uint64 state = cache->State.load(std::memory_order_relaxed);
+        if ((state >> 8) != generation)
+        {
+            state = (generation << 8) | GetLogLevelForType(type);
+            cache->State.store(state, std::memory_order_relaxed);
+        }
+
+        LogLevel logLevel = LogLevel(state & 0xFF);
+        return logLevel != LOG_LEVEL_DISABLED && logLevel >= level;
+    }
+
+    /// Types built at runtime can change between two calls of the same call site, they are not cached
+    [[nodiscard]] bool ShouldLog(std::string const& type, LogLevel level, LogFilterCache* /*cache*/) const { return ShouldLog(type, level); }
+
+    /// Messages not logged because the queue of the logging thread was full
+    [[nodiscard]] uint64 GetDroppedMessageCount() const;
+
     template<typename... Args>
-    inline void outMessage(std::string const& filter, LogLevel const level, Acore::FormatString<Args...> fmt, Args&&... args)
+    inline void outMessage(std::string_view filter, LogLevel const level, Acore::FormatString<Args...> fmt, Args&&... args)
     {
         _outMessage(filter, level, Acore::StringFormat(fmt, std::forward<Args>(args)...));
     }
@@ -97,10 +127,14 @@ public:
     [[nodiscard]] std::string const& GetLogsTimestamp() const { return m_logsTimestamp; }
 
 private:
+    friend class LogWriter;
+
     static std::string GetTimestampStr();
     void write(std::unique_ptr<LogMessage>&& msg) const;
+    void FlushAppenders() const;
 
     [[nodiscard]] Logger const* GetLoggerByType(std::string const& type) const;
+    [[nodiscard]] LogLevel GetLogLevelForType(std::string const& type) const;
     Appender* GetAppenderByName(std::string_view name);
     uint8 NextAppenderId();
     void CreateAppenderFromConfig(std::string const& name);
@@ -108,7 +142,7 @@ private:
     void ReadAppendersFromConfig();
     void ReadLoggersFromConfig();
     void RegisterAppender(uint8 index, AppenderCreatorFn appenderCreateFn);
-    void _outMessage(std::string const& filter, LogLevel level, std::string_view message);
+    void _outMessage(std::string_view filter, LogLevel level, std::string_view message);
     void _outCommand(std::string_view message, std::string_view param1);
 
     std::unordered_map<uint8, AppenderCreatorFn> appenderFactory;
@@ -120,8 +154,10 @@ private:
     std::string m_logsDir;
     std::string m_logsTimestamp;
 
-    Acore::Asio::IoContext* _ioContext;
-    std::unique_ptr<Acore::Asio::Strand> _strand;
+    std::atomic<uint64> _filterGeneration;
+    std::recursive_mutex _loggersLock;   // held by the logging thread while writing and by everything changing loggers or appenders
+    std::unique_ptr<LogWriter> _writer;
+    std::atomic<bool> _async;
 };
 
 #define sLog Log::instance()
@@ -139,13 +175,19 @@ private:
         } \
     }
 
+// Only a string literal is an expression of type char const(&)[N], arrays in variables may change between two calls
+#define LOG_FILTER_TYPE_IS_LITERAL(filterType__) \
+    std::is_same_v<decltype(filterType__), char const (&)[sizeof(filterType__)]>
+
 #ifdef PERFORMANCE_PROFILING
 #define LOG_MESSAGE_BODY(filterType__, level__, ...) ((void)0)
 #else
 #define LOG_MESSAGE_BODY(filterType__, level__, ...)                        \
         do                                                              \
         {                                                               \
-            if (sLog->ShouldLog(filterType__, level__))                 \
+            static LogFilterCache filterCache__;                        \
+            if (sLog->ShouldLog(filterType__, level__,                  \
+                LOG_FILTER_TYPE_IS_LITERAL(filterType__) ? &filterCache__ : nullptr)) \
                 LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
         } while (0)
 #endif
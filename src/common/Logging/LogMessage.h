@@ -34,9 +34,9 @@ struct LogMessage
     static std::string getTimeStr(Seconds time);
     std::string getTimeStr() const;
 
-    LogLevel const level;
-    std::string const type;
-    std::string const text;
+    LogLevel level;
+    std::string type;
+    std::string text;
     std::string prefix;
     std::string param1;
     Seconds mtime;
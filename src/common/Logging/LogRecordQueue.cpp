@@ -0,0 +1,43 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LogRecordQueue.h"
+#include "Errors.h"
+#include <bit>
+
+LogRecordQueue::LogRecordQueue(uint32 capacity) : _capacity(std::bit_ceil(capacity)), _head(0), _tail(0)
+{
+    ASSERT(capacity && capacity <= (1u << 31));
+    _records = std::make_unique<LogRecord[]>(_capacity);
+}
+
+bool LogRecordQueue::Push(LogLevel level, Seconds time, std::string_view type, std::string_view text, std::string_view param1)
+{
+    uint32 head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) >= _capacity)
+        return false;
+
+    LogRecord& record = _records[head & (_capacity - 1)];
+    record.Level = level;
+    record.Time = time;
+    record.Type.assign(type);
+    record.Text.assign(text);
+    record.Param1.assign(param1);
+
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LogRecordQueue_h__
+#define LogRecordQueue_h__
+
+#include "Define.h"
+#include "Duration.h"
+#include "LogCommon.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/// A formatted log line waiting for the log writer thread
+struct LogRecord
+{
+    LogLevel Level = LOG_LEVEL_DISABLED;
+    Seconds Time = 0s;
+    std::string Type;
+    std::string Text;
+    std::string Param1;
+};
+
+/**
+ * @brief Bounded single producer, single consumer ring of log records.
+ *
+ * Every thread logging asynchronously owns one queue and the log writer thread drains all of them.
+ * Slots are reused, so once their strings have grown to the usual line length pushing a record no
+ * longer allocates. The capacity is rounded up to a power of two, so the free running positions map to
+ * the same slots when they wrap around.
+ */
+class AC_COMMON_API LogRecordQueue
+{
+public:
+    explicit LogRecordQueue(uint32 capacity);
+
+    /// Producer side, false if the queue is full
+    bool Push(LogLevel level, Seconds time, std::string_view type, std::string_view text, std::string_view param1);
+
+    /// Consumer side, calls handler for every queued record in push order and returns their count
+    template<typename Handler>
+    uint32 Drain(Handler&& handler)
+    {
+        uint32 tail = _tail.load(std::memory_order_relaxed);
+        uint32 head = _head.load(std::memory_order_acquire);
+        for (uint32 i = tail; i != head; ++i)
+        {
+            handler(_records[i & (_capacity - 1)]);
+            _tail.store(i + 1, std::memory_order_release);
+        }
+
+        return head - tail;
+    }
+
+    [[nodiscard]] bool IsEmpty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+    [[nodiscard]] uint32 GetCapacity() const { return _capacity; }
+
+private:
+    std::unique_ptr<LogRecord[]> _records;
+    uint32 _capacity;           // power of two
+    std::atomic<uint32> _head;  // next slot written by the producer
+    std::atomic<uint32> _tail;  // next slot read by the consumer
+};
+
+#endif // LogRecordQueue_h__
@@ -17,12 +17,181 @@
 
 #include "Metric.h"
 #include "Config.h"
+#include "Errors.h"
 #include "Log.h"
 #include "SteadyTimer.h"
 #include "Strand.h"
 #include "Tokenize.h"
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+
+namespace
+{
+    // Histogram layout: values below 16 are counted exactly, above that every power of two is split
+    // in 8 buckets (at most 12.5% error) up to 2^24, larger values share the last bucket
+    constexpr uint32 METRIC_HISTOGRAM_EXACT = 16;
+    constexpr uint32 METRIC_HISTOGRAM_SUB_BITS = 3;
+    constexpr uint32 METRIC_HISTOGRAM_MAX_BIT = 24;
+    constexpr uint32 METRIC_HISTOGRAM_BUCKETS = METRIC_HISTOGRAM_EXACT + (METRIC_HISTOGRAM_MAX_BIT - 4) * (1 << METRIC_HISTOGRAM_SUB_BITS);
+
+    constexpr uint32 METRIC_SERIES_CHUNK_SIZE = 256;
+    constexpr uint32 METRIC_SERIES_MAX_CHUNKS = 256;
+
+    uint32 GetHistogramBucket(int64 value)
+    {
+        if (value < int64(METRIC_HISTOGRAM_EXACT))
+            return value < 0 ? 0 : uint32(value);
+
+        if (value >= (int64(1) << METRIC_HISTOGRAM_MAX_BIT))
+            return METRIC_HISTOGRAM_BUCKETS - 1;
+
+        uint32 bit = std::bit_width(uint64(value)) - 1; // 4 .. METRIC_HISTOGRAM_MAX_BIT - 1
+        uint32 sub = uint32(value >> (bit - METRIC_HISTOGRAM_SUB_BITS)) & ((1 << METRIC_HISTOGRAM_SUB_BITS) - 1);
+        return METRIC_HISTOGRAM_EXACT + (bit - 4) * (1 << METRIC_HISTOGRAM_SUB_BITS) + sub;
+    }
+
+    // Middle of the value range counted by a bucket
+    int64 GetHistogramBucketValue(uint32 bucket)
+    {
+        if (bucket < METRIC_HISTOGRAM_EXACT)
+            return bucket;
+
+        uint32 bit = (bucket - METRIC_HISTOGRAM_EXACT) / (1 << METRIC_HISTOGRAM_SUB_BITS) + 4;
+        uint32 sub = (bucket - METRIC_HISTOGRAM_EXACT) % (1 << METRIC_HISTOGRAM_SUB_BITS);
+        int64 width = int64(1) << (bit - METRIC_HISTOGRAM_SUB_BITS);
+        return (int64(1) << bit) + sub * width + width / 2;
+    }
+}
+
+/*
+ * Samples of one series recorded by one thread. Only the owning thread adds to it, the batch timer
+ * collects it with exchanges, so neither side ever waits. A sample recorded while the batch is
+ * collected may have its fields split over two batches.
+ */
+struct MetricAggregate
+{
+    explicit MetricAggregate(bool histogram)
+    {
+        if (histogram)
+        {
+            Buckets = std::make_unique<std::atomic<uint32>[]>(METRIC_HISTOGRAM_BUCKETS);
+            for (uint32 i = 0; i < METRIC_HISTOGRAM_BUCKETS; ++i)
+                Buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Add(int64 value)
+    {
+        Count.fetch_add(1, std::memory_order_relaxed);
+        Sum.fetch_add(value, std::memory_order_relaxed);
+
+        int64 min = Min.load(std::memory_order_relaxed);
+        while (value < min && !Min.compare_exchange_weak(min, value, std::memory_order_relaxed));
+
+        int64 max = Max.load(std::memory_order_relaxed);
+        while (value > max && !Max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+
+        if (Buckets)
+            Buckets[GetHistogramBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64> Count{ 0 };
+    std::atomic<int64> Sum{ 0 };
+    std::atomic<int64> Min{ std::numeric_limits<int64>::max() };
+    std::atomic<int64> Max{ std::numeric_limits<int64>::min() };
+    std::unique_ptr<std::atomic<uint32>[]> Buckets;
+};
+
+/*
+ * Aggregates of all series recorded by one thread, indexed by series id in chunks that are
+ * allocated by the owning thread on first use and never moved.
+ */
+class MetricThreadBuffer
+{
+public:
+    typedef std::array<std::atomic<MetricAggregate*>, METRIC_SERIES_CHUNK_SIZE> Chunk;
+
+    MetricThreadBuffer()
+    {
+        for (std::atomic<Chunk*>& chunk : _chunks)
+            chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~MetricThreadBuffer()
+    {
+        for (std::atomic<Chunk*>& chunk : _chunks)
+        {
+            if (Chunk* entries = chunk.load(std::memory_order_relaxed))
+            {
+                for (std::atomic<MetricAggregate*>& entry : *entries)
+                    delete entry.load(std::memory_order_relaxed);
+
+                delete entries;
+            }
+        }
+    }
+
+    MetricAggregate* Find(MetricSeriesId id) const
+    {
+        Chunk* chunk = _chunks[id / METRIC_SERIES_CHUNK_SIZE].load(std::memory_order_acquire);
+        return chunk ? (*chunk)[id % METRIC_SERIES_CHUNK_SIZE].load(std::memory_order_acquire) : nullptr;
+    }
+
+    // Owning thread only
+    MetricAggregate* Create(MetricSeriesId id, bool histogram)
+    {
+        std::atomic<Chunk*>& chunk = _chunks[id / METRIC_SERIES_CHUNK_SIZE];
+        Chunk* entries = chunk.load(std::memory_order_relaxed);
+        if (!entries)
+        {
+            entries = new Chunk();
+            for (std::atomic<MetricAggregate*>& entry : *entries)
+                entry.store(nullptr, std::memory_order_relaxed);
+
+            chunk.store(entries, std::memory_order_release);
+        }
+
+        MetricAggregate* aggregate = new MetricAggregate(histogram);
+        (*entries)[id % METRIC_SERIES_CHUNK_SIZE].store(aggregate, std::memory_order_release);
+        return aggregate;
+    }
+
+    template<typename Visitor>
+    void ForEach(Visitor&& visitor) const
+    {
+        for (uint32 c = 0; c < METRIC_SERIES_MAX_CHUNKS; ++c)
+            if (Chunk* entries = _chunks[c].load(std::memory_order_acquire))
+                for (uint32 i = 0; i < METRIC_SERIES_CHUNK_SIZE; ++i)
+                    if (MetricAggregate* aggregate = (*entries)[i].load(std::memory_order_acquire))
+                        visitor(c * METRIC_SERIES_CHUNK_SIZE + i, *aggregate);
+    }
+
+    std::atomic<bool> Retired{ false };
+
+private:
+    std::array<std::atomic<Chunk*>, METRIC_SERIES_MAX_CHUNKS> _chunks;
+};
+
+namespace
+{
+    // Hands the buffer back to Metric when the thread exits, the next flush collects and frees it
+    struct MetricThreadBufferOwner
+    {
+        ~MetricThreadBufferOwner()
+        {
+            if (Buffer)
+                Buffer->Retired.store(true, std::memory_order_release);
+        }
+
+        MetricThreadBuffer* Buffer = nullptr;
+    };
+
+    thread_local MetricThreadBufferOwner CurrentThreadBuffer;
+}
 
 Metric::Metric()
 {
@@ -182,6 +351,196 @@ void Metric::LogEvent(std::string const& category, std::string const& title, std
     _queuedData.Enqueue(data);
 }
 
+MetricSeriesId Metric::RegisterSeries(std::string const& category, std::vector<MetricTag> const& tags, MetricSeriesType type)
+{
+    std::string formattedTags;
+    for (MetricTag const& tag : tags)
+        formattedTags.append(",").append(tag.first).append("=").append(FormatInfluxDBTagValue(tag.second));
+
+    std::lock_guard<std::mutex> lock(_seriesLock);
+
+    auto itr = _seriesIds.find(category + formattedTags);
+    if (itr != _seriesIds.end() && _series[itr->second].Type == type)
+    {
+        ++_series[itr->second].References;
+        return itr->second;
+    }
+
+    MetricSeriesId id;
+    std::vector<MetricSeriesId>& freeSeries = _freeSeries[uint8(type)];
+    if (!freeSeries.empty())
+    {
+        id = freeSeries.back();
+        freeSeries.pop_back();
+    }
+    else
+    {
+        ASSERT(_series.size() < METRIC_SERIES_CHUNK_SIZE * METRIC_SERIES_MAX_CHUNKS, "Too many metric series registered");
+        id = MetricSeriesId(_series.size());
+        _series.emplace_back();
+    }
+
+    MetricSeries& series = _series[id];
+    series.Category = category;
+    series.Tags = std::move(formattedTags);
+    series.Type = type;
+    series.References = 1;
+
+    _seriesIds[series.Category + series.Tags] = id;
+    return id;
+}
+
+void Metric::ReleaseSeries(MetricSeriesId id)
+{
+    std::lock_guard<std::mutex> lock(_seriesLock);
+
+    MetricSeries& series = _series[id];
+    ASSERT(series.References > 0);
+    if (--series.References)
+        return;
+
+    auto itr = _seriesIds.find(series.Category + series.Tags);
+    if (itr != _seriesIds.end() && itr->second == id)
+        _seriesIds.erase(itr);
+
+    _releasedSeries.push_back(id);
+}
+
+MetricThreadBuffer& Metric::GetThreadBuffer()
+{
+    if (!CurrentThreadBuffer.Buffer)
+    {
+        std::lock_guard<std::mutex> lock(_seriesLock);
+        CurrentThreadBuffer.Buffer = _threadBuffers.emplace_back(std::make_unique<MetricThreadBuffer>()).get();
+    }
+
+    return *CurrentThreadBuffer.Buffer;
+}
+
+void Metric::Record(MetricSeriesId id, int64 value)
+{
+    MetricThreadBuffer& buffer = GetThreadBuffer();
+
+    MetricAggregate* aggregate = buffer.Find(id);
+    if (!aggregate)
+    {
+        bool histogram;
+        {
+            std::lock_guard<std::mutex> lock(_seriesLock);
+            histogram = _series[id].Type == MetricSeriesType::Histogram;
+        }
+
+        aggregate = buffer.Create(id, histogram);
+    }
+
+    aggregate->Add(value);
+}
+
+void Metric::FlushSeries(std::stringstream& batchedData)
+{
+    using namespace std::chrono;
+
+    struct Collected
+    {
+        uint64 Count = 0;
+        int64 Sum = 0;
+        int64 Min = std::numeric_limits<int64>::max();
+        int64 Max = std::numeric_limits<int64>::min();
+        std::vector<uint64> Buckets;
+    };
+
+    std::lock_guard<std::mutex> lock(_seriesLock);
+
+    std::vector<Collected> collected(_series.size());
+    for (auto itr = _threadBuffers.begin(); itr != _threadBuffers.end();)
+    {
+        // Checked before collecting so nothing recorded before the thread exited is lost
+        bool retired = (*itr)->Retired.load(std::memory_order_acquire);
+
+        (*itr)->ForEach([&](MetricSeriesId id, MetricAggregate& aggregate)
+        {
+            uint64 count = aggregate.Count.exchange(0, std::memory_order_relaxed);
+            if (!count)
+                return;
+
+            Collected& total = collected[id];
+            total.Count += count;
+            total.Sum += aggregate.Sum.exchange(0, std::memory_order_relaxed);
+            total.Min = std::min(total.Min, aggregate.Min.exchange(std::numeric_limits<int64>::max(), std::memory_order_relaxed));
+            total.Max = std::max(total.Max, aggregate.Max.exchange(std::numeric_limits<int64>::min(), std::memory_order_relaxed));
+
+            if (aggregate.Buckets)
+            {
+                total.Buckets.resize(METRIC_HISTOGRAM_BUCKETS);
+                for (uint32 i = 0; i < METRIC_HISTOGRAM_BUCKETS; ++i)
+                    total.Buckets[i] += aggregate.Buckets[i].exchange(0, std::memory_order_relaxed);
+            }
+        });
+
+        if (retired)
+            itr = _threadBuffers.erase(itr);
+        else
+            ++itr;
+    }
+
+    std::string timestamp = std::to_string(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+    for (MetricSeriesId id = 0; id < collected.size(); ++id)
+    {
+        Collected const& total = collected[id];
+        if (!total.Count || !_series[id].References)
+            continue;
+
+        MetricSeries const& series = _series[id];
+        if (batchedData.tellp() != std::streampos(0))
+            batchedData << "\n";
+
+        batchedData << series.Category;
+        if (!_realmName.empty())
+            batchedData << ",realm=" << _realmName;
+
+        batchedData << series.Tags << " value=" << total.Sum / int64(total.Count) << "i,count=" << total.Count << 'i';
+
+        // A sample recorded while its count was being collected may not have reached min and max yet
+        bool const hasRange = total.Min <= total.Max;
+        if (hasRange)
+            batchedData << ",min=" << total.Min << "i,max=" << total.Max << 'i';
+
+        if (!total.Buckets.empty())
+        {
+            // Percentiles as the middle of the bucket containing them, clamped to the exact min and max
+            auto percentile = [&](uint64 rank)
+            {
+                uint64 seen = 0;
+                uint32 last = 0;
+                for (uint32 i = 0; i < METRIC_HISTOGRAM_BUCKETS; ++i)
+                {
+                    if (!total.Buckets[i])
+                        continue;
+
+                    seen += total.Buckets[i];
+                    last = i;
+                    if (seen > rank)
+                        return hasRange ? std::clamp(GetHistogramBucketValue(i), total.Min, total.Max) : GetHistogramBucketValue(i);
+                }
+
+                return hasRange ? total.Max : GetHistogramBucketValue(last);
+            };
+
+            batchedData << ",p50=" << percentile(total.Count / 2) << "i,p90=" << percentile(total.Count * 9 / 10)
+                << "i,p99=" << percentile(total.Count * 99 / 100) << 'i';
+        }
+
+        batchedData << ' ' << timestamp;
+    }
+
+    // Released series had their last samples collected above, their ids can be handed out again
+    for (MetricSeriesId id : _releasedSeries)
+        if (!_series[id].References)
+            _freeSeries[uint8(_series[id].Type)].push_back(id);
+
+    _releasedSeries.clear();
+}
+
 void Metric::SendBatch()
 {
     using namespace std::chrono;
@@ -220,6 +579,8 @@ void Metric::SendBatch()
         delete data;
     }
 
+    FlushSeries(batchedData);
+
     // Check if there's any data to send
     if (batchedData.tellp() == std::streampos(0))
     {
@@ -294,6 +655,9 @@ void Metric::ScheduleSend()
         {
             delete data;
         }
+
+        std::stringstream discarded;
+        FlushSeries(discarded);
     }
 }
 
@@ -24,6 +24,8 @@
 #include <boost/asio/steady_timer.hpp>
 #include <functional>
 #include <memory> // NOTE: this import is NEEDED (even though some IDEs report it as unused)
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -56,6 +58,29 @@ struct MetricData
     std::string Text;
 };
 
+typedef uint32 MetricSeriesId;
+
+enum class MetricSeriesType : uint8
+{
+    Gauge,      // value (mean), count, min and max of the samples of a batch
+    Histogram   // additionally p50, p90 and p99
+};
+
+/*
+ * A category with a fixed set of tags, registered once and then recorded by id.
+ * Samples are aggregated per thread without locks or allocations and only turned into
+ * InfluxDB lines when the batch is sent.
+ */
+struct MetricSeries
+{
+    std::string Category;
+    std::string Tags;       // already formatted as ",key=value,..."
+    MetricSeriesType Type = MetricSeriesType::Gauge;
+    uint32 References = 0;
+};
+
+class MetricThreadBuffer;
+
 class AC_COMMON_API Metric
 {
 private:
@@ -79,8 +104,17 @@ private:
     std::string _realmName;
     std::unordered_map<std::string, int64> _thresholds;
 
+    std::mutex _seriesLock;
+    std::vector<MetricSeries> _series;
+    std::unordered_map<std::string, MetricSeriesId> _seriesIds;
+    std::vector<MetricSeriesId> _releasedSeries;        // reusable after the next flush collected their samples
+    std::vector<MetricSeriesId> _freeSeries[2];         // per MetricSeriesType
+    std::vector<std::unique_ptr<MetricThreadBuffer>> _threadBuffers;
+
     bool Connect();
     void SendBatch();
+    void FlushSeries(std::stringstream& batchedData);
+    MetricThreadBuffer& GetThreadBuffer();
     void ScheduleSend();
     void ScheduleOverallStatusLog();
 
@@ -127,6 +161,13 @@ public:
 
     void LogEvent(std::string const& category, std::string const& title, std::string const& description);
 
+    /// Interns a category and tag set, registering the same series twice returns the same id
+    MetricSeriesId RegisterSeries(std::string const& category, std::vector<MetricTag> const& tags = {}, MetricSeriesType type = MetricSeriesType::Gauge);
+    /// Drops a reference taken by RegisterSeries(), the id must not be recorded anymore by the caller
+    void ReleaseSeries(MetricSeriesId id);
+    /// Adds a sample to the calling thread's aggregate of the series, see METRIC_RECORD
+    void Record(MetricSeriesId id, int64 value);
+
     void Unload();
     bool IsEnabled() const { return _enabled; }
 };
@@ -169,7 +210,9 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
 #if defined PERFORMANCE_PROFILING || defined WITHOUT_METRICS
 #define METRIC_EVENT(category, title, description) ((void)0)
 #define METRIC_VALUE(category, value, ...) ((void)0)
+#define METRIC_RECORD(series, value) ((void)sizeof(series), (void)sizeof(value))
 #define METRIC_TIMER(category, ...) ((void)0)
+#define METRIC_RECORD_TIMER(series) ((void)sizeof(series))
 #define METRIC_DETAILED_EVENT(category, title, description) ((void)0)
 #define METRIC_DETAILED_TIMER(category, ...) ((void)0)
 #define METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) ((void)0)
@@ -185,6 +228,11 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
             if (sMetric->IsEnabled())                                  \
                 sMetric->LogValue(category, value, { __VA_ARGS__ });   \
         } while (0)
+#define METRIC_RECORD(series, value)                                \
+        do {                                                           \
+            if (sMetric->IsEnabled())                                  \
+                sMetric->Record(series, int64(value));                 \
+        } while (0)
 #else
 #define METRIC_EVENT(category, title, description)                  \
         __pragma(warning(push))                                        \
@@ -202,12 +250,25 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
                 sMetric->LogValue(category, value, { __VA_ARGS__ });   \
         } while (0)                                                    \
         __pragma(warning(pop))
+#define METRIC_RECORD(series, value)                                \
+        __pragma(warning(push))                                        \
+        __pragma(warning(disable:4127))                                \
+        do {                                                           \
+            if (sMetric->IsEnabled())                                  \
+                sMetric->Record(series, int64(value));                 \
+        } while (0)                                                    \
+        __pragma(warning(pop))
 #endif
 #define METRIC_TIMER(category, ...)                                                                           \
         MetricStopWatch METRIC_UNIQUE_NAME(__ac_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
         {                                                                                                        \
             sMetric->LogValue(category, std::chrono::steady_clock::now() - start, { __VA_ARGS__ });              \
         });
+#define METRIC_RECORD_TIMER(series)                                                                           \
+        MetricStopWatch METRIC_UNIQUE_NAME(__ac_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
+        {                                                                                                        \
+            sMetric->Record(series, std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - start).count()); \
+        });
 #if defined WITH_DETAILED_METRICS
 #define METRIC_DETAILED_TIMER(category, ...)                                                                  \
         MetricStopWatch METRIC_UNIQUE_NAME(__ac_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
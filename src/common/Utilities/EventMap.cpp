@@ -17,6 +17,7 @@
 
 #include "EventMap.h"
 #include "Random.h"
+#include <algorithm>
 
 void EventMap::Reset()
 {
@@ -65,7 +66,7 @@ void EventMap::ScheduleEvent(uint32 eventId, uint32 time, uint32 group /*= 0*/,
         eventId |= (1 << (phase + 23));
     }
 
-    _eventMap.emplace(_time + time, eventId);
+    Insert(_time + time, eventId);
 }
 
 void EventMap::ScheduleEvent(uint32 eventId, Milliseconds time, uint32 group /*= 0*/, uint8 phase /* = 0*/)
@@ -98,7 +99,7 @@ void EventMap::RescheduleEvent(uint32 eventId, Milliseconds minTime, Millisecond
 
 void EventMap::RepeatEvent(uint32 time)
 {
-    _eventMap.emplace(_time + time, _lastEvent);
+    Insert(_time + time, _lastEvent);
 }
 
 void EventMap::Repeat(Milliseconds time)
@@ -113,27 +114,22 @@ void EventMap::Repeat(Milliseconds minTime, Milliseconds maxTime)
 
 uint32 EventMap::ExecuteEvent()
 {
-    while (!Empty())
+    auto itr = _eventMap.begin();
+    for (; itr != _eventMap.end() && itr->first <= _time; ++itr)
     {
-        auto const& itr = _eventMap.begin();
-
-        if (itr->first > _time)
-        {
-            return 0;
-        }
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-        {
-            _eventMap.erase(itr);
-        }
-        else
+        // Events of other phases are dropped
+        if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
         {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second;
-            _eventMap.erase(itr);
-            return eventId;
+            continue;
         }
+
+        uint32 eventId = (itr->second & 0x0000FFFF);
+        _lastEvent = itr->second;
+        _eventMap.erase(_eventMap.begin(), itr + 1);
+        return eventId;
     }
 
+    _eventMap.erase(_eventMap.begin(), itr);
     return 0;
 }
 
@@ -154,37 +150,44 @@ void EventMap::DelayEvents(uint32 delay, uint32 group)
         return;
     }
 
-    EventStore delayed;
+    uint32 groupMask = group ? (1 << (group + 15)) : 0;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    // Delayed events go after the others of their new time, in their previous order
+    auto delayed = std::stable_partition(_eventMap.begin(), _eventMap.end(), [groupMask](std::pair<uint32, uint32> const& event)
     {
-        if (!group || (itr->second & (1 << (group + 15))))
-        {
-            delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-            itr = _eventMap.erase(itr);
-            continue;
-        }
-
-        ++itr;
+        return groupMask && !(event.second & groupMask);
+    });
+    for (auto itr = delayed; itr != _eventMap.end(); ++itr)
+    {
+        itr->first += delay;
     }
 
-    _eventMap.insert(delayed.begin(), delayed.end());
+    std::inplace_merge(_eventMap.begin(), delayed, _eventMap.end(), [](std::pair<uint32, uint32> const& left, std::pair<uint32, uint32> const& right)
+    {
+        return left.first < right.first;
+    });
 }
 
 void EventMap::DelayEventsToMax(uint32 delay, uint32 group)
 {
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    uint32 time = _time + delay;
+    uint32 groupMask = group ? (1 << (group + 15)) : 0;
+
+    // Events before the new time move to it, after the events already planned for it
+    auto limit = std::find_if(_eventMap.begin(), _eventMap.end(), [time](std::pair<uint32, uint32> const& event) { return event.first >= time; });
+    auto delayed = std::stable_partition(_eventMap.begin(), limit, [groupMask](std::pair<uint32, uint32> const& event)
     {
-        if (itr->first < _time + delay && (group == 0 || ((1 << (group + 15)) & itr->second)))
-        {
-            ScheduleEvent(itr->second, delay);
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
-        }
+        return groupMask && !(event.second & groupMask);
+    });
 
-        ++itr;
+    for (auto itr = delayed; itr != limit; ++itr)
+    {
+        // Same as rescheduling it without group and phase, the event data keeps them
+        itr->first = time;
     }
+
+    auto next = std::find_if(limit, _eventMap.end(), [time](std::pair<uint32, uint32> const& event) { return event.first > time; });
+    std::rotate(delayed, limit, next);
 }
 
 void EventMap::CancelEvent(uint32 eventId)
@@ -194,16 +197,7 @@ void EventMap::CancelEvent(uint32 eventId)
         return;
     }
 
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
-        if (eventId == (itr->second & 0x0000FFFF))
-        {
-            itr = _eventMap.erase(itr);
-            continue;
-        }
-
-        ++itr;
-    }
+    std::erase_if(_eventMap, [eventId](std::pair<uint32, uint32> const& event) { return eventId == (event.second & 0x0000FFFF); });
 }
 
 void EventMap::CancelEventGroup(uint32 group)
@@ -214,17 +208,7 @@ void EventMap::CancelEventGroup(uint32 group)
     }
 
     uint32 groupMask = (1 << (group + 15));
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
-        if (itr->second & groupMask)
-        {
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
-        }
-
-        ++itr;
-    }
+    std::erase_if(_eventMap, [groupMask](std::pair<uint32, uint32> const& event) { return event.second & groupMask; });
 }
 
 uint32 EventMap::GetNextEventTime(uint32 eventId) const
@@ -257,9 +241,19 @@ bool EventMap::IsInPhase(uint8 phase)
 
 Milliseconds EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (std::pair<uint32 const, uint32> const& itr : _eventMap)
+    for (std::pair<uint32, uint32> const& itr : _eventMap)
         if (eventId == (itr.second & 0x0000FFFF))
             return std::chrono::duration_cast<Milliseconds>(Milliseconds(itr.first) - Milliseconds(_time));
 
     return Milliseconds::max();
 }
+
+void EventMap::Insert(uint32 time, uint32 eventData)
+{
+    auto itr = std::upper_bound(_eventMap.begin(), _eventMap.end(), time, [](uint32 time, std::pair<uint32, uint32> const& event)
+    {
+        return time < event.first;
+    });
+
+    _eventMap.emplace(itr, time, eventData);
+}
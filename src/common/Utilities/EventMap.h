@@ -20,14 +20,15 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include <utility>
+#include <vector>
 
 class EventMap
 {
     /**
-    * Internal storage type.
-    * Key: Time as TimePoint when the event should occur.
-    * Value: The event data as uint32.
+    * Internal storage type, sorted by time. Events of the same time keep the order they were scheduled in.
+    * First: Time as TimePoint when the event should occur.
+    * Second: The event data as uint32.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
@@ -35,7 +36,7 @@ class EventMap
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
     */
-    typedef std::multimap<uint32, uint32> EventStore;
+    typedef std::vector<std::pair<uint32, uint32>> EventStore;
 
 public:
     EventMap() { }
@@ -286,6 +287,14 @@ public:
     Milliseconds GetTimeUntilEvent(uint32 eventId) const;
 
 private:
+    /**
+    * @name Insert
+    * @brief Adds an event after all events of the same or an earlier time.
+    * @param time Time when the event should occur.
+    * @param eventData Event id, group and phase.
+    */
+    void Insert(uint32 time, uint32 eventData);
+
     /**
     * @name _time
     * @brief Internal timer.
@@ -319,7 +328,8 @@ private:
     * @brief Internal event storage map. Contains the scheduled events.
     *
     * See typedef at the beginning of the class for more
-    * details.
+    * details. Its capacity is kept by Reset, so a script
+    * scheduling the same events again does not allocate.
     */
     EventStore _eventMap;
 };
@@ -17,6 +17,76 @@
 
 #include "EventProcessor.h"
 #include "Errors.h"
+#include <array>
+#include <bit>
+#include <memory>
+#include <vector>
+
+struct EventTimingWheel
+{
+    std::array<std::array<BasicEvent*, 64>, 4> Slots{};
+    std::array<uint64, 4> Occupied{};
+};
+
+namespace
+{
+    /// Wheels of processors that ran out of events, reused by the next processor of the same thread
+    class EventTimingWheelPool
+    {
+    public:
+        ~EventTimingWheelPool()
+        {
+            Destroyed = true;
+            for (EventTimingWheel* wheel : _wheels)
+                delete wheel;
+        }
+
+        EventTimingWheel* Acquire()
+        {
+            if (_wheels.empty())
+                return new EventTimingWheel();
+
+            EventTimingWheel* wheel = _wheels.back();
+            _wheels.pop_back();
+            return wheel;
+        }
+
+        void Release(EventTimingWheel* wheel)
+        {
+            if (_wheels.size() >= MaxPooledWheels)
+            {
+                delete wheel;
+                return;
+            }
+
+            _wheels.push_back(wheel);
+        }
+
+        // processors of static objects can outlive the pool of the main thread
+        static thread_local bool Destroyed;
+
+    private:
+        static constexpr std::size_t MaxPooledWheels = 256;
+
+        std::vector<EventTimingWheel*> _wheels;
+    };
+
+    thread_local bool EventTimingWheelPool::Destroyed = false;
+    thread_local EventTimingWheelPool WheelPool;
+
+    EventTimingWheel* AcquireEventTimingWheel()
+    {
+        return EventTimingWheelPool::Destroyed ? new EventTimingWheel() : WheelPool.Acquire();
+    }
+
+    void ReleaseEventTimingWheel(EventTimingWheel* wheel)
+    {
+        if (EventTimingWheelPool::Destroyed)
+            delete wheel;
+        else
+            WheelPool.Release(wheel);
+    }
+}
 
 void BasicEvent::ScheduleAbort()
 {
@@ -32,6 +102,29 @@ void BasicEvent::SetAborted()
     m_abortState = AbortState::STATE_ABORTED;
 }
 
+template<typename Callback>
+void EventProcessor::ForEachEvent(Callback&& callback)
+{
+    auto forEachInList = [&callback](BasicEvent* event)
+    {
+        while (event)
+        {
+            BasicEvent* next = event->m_next;
+            callback(event);
+            event = next;
+        }
+    };
+
+    // Far away events first, an event added by a callback can move them to the wheel
+    forEachInList(m_overflowHead);
+    forEachInList(m_readyHead);
+
+    // A callback may release the wheel by unlinking its last event
+    for (uint8 level = 0; level < WHEEL_LEVELS && m_wheel; ++level)
+        for (uint8 slot = 0; slot < WHEEL_SLOTS && m_wheel; ++slot)
+            forEachInList(m_wheel->Slots[level][slot]);
+}
+
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
@@ -43,13 +136,8 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (BasicEvent* event = PopDueEvent())
     {
-        // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
-
         if (event->IsRunning())
         {
             if (event->Execute(m_time, p_time))
@@ -82,78 +170,72 @@ void EventProcessor::Update(uint32 p_time)
 void EventProcessor::KillAllEvents(bool force)
 {
     // first, abort all existing events
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    ForEachEvent([this, force](BasicEvent* event)
     {
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
         // Skip non-deletable events when we are
         // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
-        {
-            ++itr;
-            continue;
-        }
-
-        delete itr->second;
+        if (!force && !event->IsDeletable())
+            return;
 
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
-    }
-
-    if (force)
-        m_events.clear();
+        Unlink(event);
+        delete event;
+    });
 }
 
 void EventProcessor::CancelEventGroup(uint8 group)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    ForEachEvent([this, group](BasicEvent* event)
     {
-        if (itr->second->m_eventGroup != group)
-        {
-            ++itr;
-            continue;
-        }
+        if (event->m_eventGroup != group)
+            return;
 
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
-        delete itr->second;
-        itr = m_events.erase(itr);
-    }
+        Unlink(event);
+        delete event;
+    });
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime, uint8 eventGroup)
 {
+    ASSERT(!Event->m_owner
+           && "Tried to add an event which is already queued!");
+
     if (set_addtime)
         Event->m_addTime = m_time;
     Event->m_execTime = e_time;
     Event->m_eventGroup = eventGroup;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Event->m_owner = this;
+    Event->m_sequence = ++m_sequence;
+    ++m_eventCount;
+
+    // The wheel time may only move while no event is on the wheel, keep it at the current
+    // time so new events land on the low levels
+    if (!m_wheel && m_wheelTime != m_time)
+        Rebase();
+
+    Schedule(Event);
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* event, Milliseconds newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != event)
-            continue;
+    if (event->m_owner != this)
+        return;
 
-        event->m_execTime = newTime.count();
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(newTime.count(), event));
-        break;
-    }
+    Unlink(event);
+    AddEvent(event, newTime.count(), false, event->m_eventGroup);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -165,3 +247,183 @@ uint64 EventProcessor::CalculateQueueTime(uint64 delay) const
 {
     return CalculateTime(delay - (m_time % delay));
 }
+
+void EventProcessor::Schedule(BasicEvent* event)
+{
+    uint64 execTime = event->m_execTime;
+    if (execTime <= m_wheelTime)
+    {
+        InsertReady(event);
+        return;
+    }
+
+    // The level is the highest 6 bit digit in which the planned time differs from the wheel time
+    uint8 level = uint8((std::bit_width(execTime ^ m_wheelTime) - 1) / WHEEL_LEVEL_BITS);
+    if (level >= WHEEL_LEVELS)
+    {
+        event->m_wheelLevel = WHEEL_LEVEL_OVERFLOW;
+        event->m_prev = nullptr;
+        event->m_next = m_overflowHead;
+        if (m_overflowHead)
+            m_overflowHead->m_prev = event;
+        m_overflowHead = event;
+        return;
+    }
+
+    if (!m_wheel)
+        m_wheel = AcquireEventTimingWheel();
+
+    uint8 slot = uint8((execTime >> (level * WHEEL_LEVEL_BITS)) & (WHEEL_SLOTS - 1));
+    BasicEvent*& head = m_wheel->Slots[level][slot];
+
+    event->m_wheelLevel = level;
+    event->m_wheelSlot = slot;
+    event->m_prev = nullptr;
+    event->m_next = head;
+    if (head)
+        head->m_prev = event;
+    head = event;
+    m_wheel->Occupied[level] |= uint64(1) << slot;
+}
+
+void EventProcessor::InsertReady(BasicEvent* event)
+{
+    event->m_wheelLevel = WHEEL_LEVEL_READY;
+
+    // Events are mostly added in order, so the position is searched from the back
+    BasicEvent* prev = m_readyTail;
+    while (prev && (prev->m_execTime > event->m_execTime || (prev->m_execTime == event->m_execTime && prev->m_sequence > event->m_sequence)))
+        prev = prev->m_prev;
+
+    event->m_prev = prev;
+    event->m_next = prev ? prev->m_next : m_readyHead;
+
+    if (event->m_next)
+        event->m_next->m_prev = event;
+    else
+        m_readyTail = event;
+
+    if (prev)
+        prev->m_next = event;
+    else
+        m_readyHead = event;
+}
+
+void EventProcessor::Unlink(BasicEvent* event)
+{
+    if (event->m_next)
+        event->m_next->m_prev = event->m_prev;
+
+    if (event->m_prev)
+        event->m_prev->m_next = event->m_next;
+    else
+    {
+        switch (event->m_wheelLevel)
+        {
+            case WHEEL_LEVEL_READY:
+                m_readyHead = event->m_next;
+                break;
+            case WHEEL_LEVEL_OVERFLOW:
+                m_overflowHead = event->m_next;
+                break;
+            default:
+                m_wheel->Slots[event->m_wheelLevel][event->m_wheelSlot] = event->m_next;
+                if (!event->m_next)
+                    m_wheel->Occupied[event->m_wheelLevel] &= ~(uint64(1) << event->m_wheelSlot);
+                break;
+        }
+    }
+
+    if (event->m_wheelLevel == WHEEL_LEVEL_READY && m_readyTail == event)
+        m_readyTail = event->m_prev;
+
+    event->m_owner = nullptr;
+    event->m_prev = nullptr;
+    event->m_next = nullptr;
+    --m_eventCount;
+
+    ReleaseWheelIfEmpty();
+}
+
+BasicEvent* EventProcessor::PopDueEvent()
+{
+    while (!m_readyHead)
+        if (!AdvanceWheel())
+            return nullptr;
+
+    BasicEvent* event = m_readyHead;
+    Unlink(event);
+    return event;
+}
+
+bool EventProcessor::AdvanceWheel()
+{
+    if (!m_wheel)
+    {
+        if (!m_overflowHead || m_wheelTime == m_time)
+            return false;
+
+        // Nothing is on the wheel, it can move to the current time and pick up the far away events
+        Rebase();
+        return m_readyHead != nullptr;
+    }
+
+    // Slots at or before the wheel time digit of their level are always empty, so the lowest
+    // occupied slot of the lowest occupied level holds the next events
+    uint8 level = 0;
+    while (!m_wheel->Occupied[level])
+        ++level;
+
+    uint8 slot = uint8(std::countr_zero(m_wheel->Occupied[level]));
+    uint8 shift = level * WHEEL_LEVEL_BITS;
+    uint64 slotTime = ((m_wheelTime >> shift) & ~uint64(WHEEL_SLOTS - 1)) | slot;
+    slotTime <<= shift;
+    if (slotTime > m_time)
+        return false;
+
+    m_wheelTime = slotTime;
+
+    // Events of the slot move to the ready list or to a lower level
+    EventTimingWheel* wheel = m_wheel;
+    BasicEvent* event = wheel->Slots[level][slot];
+    wheel->Slots[level][slot] = nullptr;
+    wheel->Occupied[level] &= ~(uint64(1) << slot);
+
+    while (event)
+    {
+        BasicEvent* next = event->m_next;
+        Schedule(event);
+        event = next;
+    }
+
+    ReleaseWheelIfEmpty();
+    return true;
+}
+
+void EventProcessor::Rebase()
+{
+    m_wheelTime = m_time;
+
+    BasicEvent* event = m_overflowHead;
+    m_overflowHead = nullptr;
+
+    while (event)
+    {
+        BasicEvent* next = event->m_next;
+        Schedule(event);
+        event = next;
+    }
+}
+
+void EventProcessor::ReleaseWheelIfEmpty()
+{
+    if (!m_wheel)
+        return;
+
+    for (uint64 occupied : m_wheel->Occupied)
+        if (occupied)
+            return;
+
+    ReleaseEventTimingWheel(m_wheel);
+    m_wheel = nullptr;
+}
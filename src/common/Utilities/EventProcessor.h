@@ -21,9 +21,9 @@
 #include "Define.h"
 #include "Duration.h"
 #include "Random.h"
-#include <map>
 
 class EventProcessor;
+struct EventTimingWheel;
 
 // Note. All times are in milliseconds here.
 class BasicEvent
@@ -68,6 +68,14 @@ class BasicEvent
         uint64 m_addTime{0};                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime{0};                                  // planned time of next execution, filled by event handler
         uint8 m_eventGroup{0};
+
+        // intrusive links of the event processor queues, an event is queued in at most one processor
+        EventProcessor* m_owner{nullptr};
+        BasicEvent* m_prev{nullptr};
+        BasicEvent* m_next{nullptr};
+        uint64 m_sequence{0};                                  // insertion order, orders events planned for the same time
+        uint8 m_wheelLevel{0};
+        uint8 m_wheelSlot{0};
 };
 
 template<typename T>
@@ -90,14 +98,23 @@ class LambdaBasicEvent : public BasicEvent
 template<typename T>
 using is_lambda_event = std::enable_if_t<!std::is_base_of_v<BasicEvent, std::remove_pointer_t<std::remove_cvref_t<T>>>>;
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
-
+/**
+ * @brief Event queue of a single object.
+ *
+ * Events are kept in a hierarchical timing wheel of 64 slot levels, linked through the events
+ * themselves, so adding, moving and removing an event never allocates. Events are executed in
+ * the order of their planned time and, for the same time, in the order they were added.
+ * The slot arrays are only held while the wheel has events and are recycled per thread.
+ */
 class EventProcessor
 {
     public:
         EventProcessor()  = default;
         ~EventProcessor();
 
+        EventProcessor(EventProcessor const&) = delete;
+        EventProcessor& operator=(EventProcessor const&) = delete;
+
         void Update(uint32 p_time);
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true) { AddEvent(Event, e_time, set_addtime, 0); };
@@ -122,10 +139,37 @@ class EventProcessor
 
         void CancelEventGroup(uint8 group);
 
+        [[nodiscard]] bool HasEvents() const { return m_eventCount != 0; }
+
     protected:
         uint64 m_time{0};
-        EventList m_events;
-        bool m_aborting;
+
+    private:
+        static constexpr uint8 WHEEL_LEVEL_BITS = 6;
+        static constexpr uint8 WHEEL_SLOTS = 1 << WHEEL_LEVEL_BITS;
+        static constexpr uint8 WHEEL_LEVELS = 4;                        // 2^24 ms (~4.6 hours) ahead of the wheel time
+        static constexpr uint8 WHEEL_LEVEL_READY = WHEEL_LEVELS;        // due events, sorted by time and sequence
+        static constexpr uint8 WHEEL_LEVEL_OVERFLOW = WHEEL_LEVELS + 1; // events beyond the last level
+
+        void Schedule(BasicEvent* event);
+        void Unlink(BasicEvent* event);
+        void InsertReady(BasicEvent* event);
+        BasicEvent* PopDueEvent();
+        bool AdvanceWheel();
+        void Rebase();
+        void ReleaseWheelIfEmpty();
+
+        // calls callback for every queued event, the callback may unlink the event it is given
+        template<typename Callback>
+        void ForEachEvent(Callback&& callback);
+
+        uint64 m_wheelTime{0};              // events planned up to this time are in the ready list
+        uint64 m_sequence{0};
+        uint32 m_eventCount{0};
+        BasicEvent* m_readyHead{nullptr};
+        BasicEvent* m_readyTail{nullptr};
+        BasicEvent* m_overflowHead{nullptr};
+        EventTimingWheel* m_wheel{nullptr};
 };
 
 #endif
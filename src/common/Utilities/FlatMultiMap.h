@@ -0,0 +1,311 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _FLAT_MULTIMAP_H_
+#define _FLAT_MULTIMAP_H_
+
+#include "Define.h"
+#include "Errors.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/*
+ * Multimap from integer or enum keys to small values, kept in one array of slots in insertion order with an open
+ * addressed index from every key to the chain of its slots. Iterating walks the array and looking up a key hashes it
+ * once, so neither chases tree nodes scattered over the heap.
+ *
+ * Erasing only marks the slot as removed. Iterators are slot indices: they survive inserts and erases, and one left
+ * on an erased element can still be advanced past it. Slot indices are only reused after clear() or compact(), which
+ * drop the removed slots and may only be called while nobody holds an iterator.
+ *
+ * find(), lower_bound() and equal_range() return iterators visiting only the elements of their key, in insertion
+ * order, while upper_bound() is end(). Loops from lower_bound(key) to upper_bound(key) visit the same elements as
+ * with a std::multimap, but iterating the whole map follows insertion order rather than key order.
+ */
+template <typename Key, typename Value>
+class FlatMultiMap
+{
+    static constexpr uint32 INVALID_SLOT = std::numeric_limits<uint32>::max();
+    static constexpr uint32 MIN_BUCKETS = 8;
+
+    struct Slot
+    {
+        std::pair<Key, Value> Element;
+        uint32 NextWithKey;     // kept when removed, for iterators left on the slot
+        bool Removed;
+    };
+
+    struct Bucket
+    {
+        Key BucketKey;
+        uint32 First;           // slots with the key that are not removed
+        uint32 Last;
+        bool Used;
+    };
+
+public:
+    typedef Key key_type;
+    typedef Value mapped_type;
+    typedef std::pair<Key, Value> value_type;
+    typedef std::size_t size_type;
+
+    class iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::pair<Key, Value> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type const* pointer;
+        typedef value_type const& reference;
+
+        iterator() : _map(nullptr), _slot(INVALID_SLOT), _sameKey(false) { }
+
+        reference operator*() const { return _map->_slots[_slot].Element; }
+        pointer operator->() const { return &_map->_slots[_slot].Element; }
+
+        iterator& operator++()
+        {
+            // stepping past the end is a bug of the caller, stay on the end instead of starting over
+            ASSERT(_slot != INVALID_SLOT);
+            if (_slot == INVALID_SLOT)
+                return *this;
+
+            _slot = _sameKey ? _map->NextWithKey(_slot) : _map->NextInOrder(_slot + 1);
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(iterator const& right) const { return _slot == right._slot; }
+        bool operator!=(iterator const& right) const { return _slot != right._slot; }
+
+    private:
+        friend class FlatMultiMap;
+
+        iterator(FlatMultiMap const* map, uint32 slot, bool sameKey) : _map(map), _slot(slot), _sameKey(sameKey) { }
+
+        FlatMultiMap const* _map;
+        uint32 _slot;
+        bool _sameKey;
+    };
+
+    // elements are never modified in place, both are read only
+    typedef iterator const_iterator;
+
+    FlatMultiMap() : _size(0), _bucketsUsed(0), _bucketShift(32) { }
+
+    iterator begin() const { return iterator(this, NextInOrder(0), false); }
+    iterator end() const { return iterator(this, INVALID_SLOT, false); }
+
+    [[nodiscard]] bool empty() const { return !_size; }
+    [[nodiscard]] size_type size() const { return _size; }
+
+    iterator find(Key key) const
+    {
+        Bucket const* bucket = FindBucket(key);
+        return iterator(this, bucket ? bucket->First : INVALID_SLOT, true);
+    }
+
+    iterator lower_bound(Key key) const { return find(key); }
+    iterator upper_bound(Key /*key*/) const { return end(); }
+    std::pair<iterator, iterator> equal_range(Key key) const { return { find(key), end() }; }
+
+    [[nodiscard]] size_type count(Key key) const
+    {
+        size_type count = 0;
+        for (iterator itr = find(key); itr != end(); ++itr)
+            ++count;
+
+        return count;
+    }
+
+    iterator insert(value_type const& element)
+    {
+        // may rehash, which links the existing slots again
+        Bucket& bucket = GetOrAddBucket(element.first);
+
+        uint32 slot = uint32(_slots.size());
+        _slots.push_back({ element, INVALID_SLOT, false });
+        ++_size;
+
+        if (bucket.Last != INVALID_SLOT)
+            _slots[bucket.Last].NextWithKey = slot;
+        else
+            bucket.First = slot;
+
+        bucket.Last = slot;
+        return iterator(this, slot, false);
+    }
+
+    iterator erase(iterator position)
+    {
+        iterator next = position;
+        ++next;
+
+        uint32 slot = position._slot;
+        Bucket* bucket = const_cast<Bucket*>(FindBucket(_slots[slot].Element.first));
+
+        uint32 previous = INVALID_SLOT;
+        for (uint32 current = bucket->First; current != slot; current = _slots[current].NextWithKey)
+            previous = current;
+
+        if (previous == INVALID_SLOT)
+            bucket->First = _slots[slot].NextWithKey;
+        else
+            _slots[previous].NextWithKey = _slots[slot].NextWithKey;
+
+        if (bucket->Last == slot)
+            bucket->Last = previous;
+
+        _slots[slot].Removed = true;
+        --_size;
+        return next;
+    }
+
+    /// Drops all elements, invalidating all iterators
+    void clear()
+    {
+        _slots.clear();
+        std::fill(_buckets.begin(), _buckets.end(), Bucket());
+        _size = 0;
+        _bucketsUsed = 0;
+    }
+
+    /// Drops removed slots, invalidating all iterators
+    void compact()
+    {
+        if (_slots.size() == _size)
+            return;
+
+        _slots.erase(std::remove_if(_slots.begin(), _slots.end(), [](Slot const& slot) { return slot.Removed; }), _slots.end());
+        Rehash(uint32(_buckets.size()));
+    }
+
+private:
+    uint32 NextInOrder(uint32 slot) const
+    {
+        while (slot < _slots.size() && _slots[slot].Removed)
+            ++slot;
+
+        return slot < _slots.size() ? slot : INVALID_SLOT;
+    }
+
+    uint32 NextWithKey(uint32 slot) const
+    {
+        do
+        {
+            if (slot >= _slots.size())
+                return INVALID_SLOT;
+
+            slot = _slots[slot].NextWithKey;
+        } while (slot != INVALID_SLOT && _slots[slot].Removed);
+
+        return slot;
+    }
+
+    uint32 GetBucketIndex(Key key) const
+    {
+        // fibonacci hashing, spell ids are often consecutive
+        return (uint32(key) * 2654435769u) >> _bucketShift;
+    }
+
+    Bucket const* FindBucket(Key key) const
+    {
+        if (_buckets.empty())
+            return nullptr;
+
+        uint32 const mask = uint32(_buckets.size()) - 1;
+        for (uint32 index = GetBucketIndex(key); _buckets[index].Used; index = (index + 1) & mask)
+            if (_buckets[index].BucketKey == key)
+                return &_buckets[index];
+
+        return nullptr;
+    }
+
+    Bucket& GetOrAddBucket(Key key)
+    {
+        if (Bucket const* bucket = FindBucket(key))
+            return const_cast<Bucket&>(*bucket);
+
+        if ((_bucketsUsed + 1) * 2 > _buckets.size())
+            Rehash(std::max<uint32>(MIN_BUCKETS, uint32(_buckets.size()) * 2));
+
+        return AddBucket(key);
+    }
+
+    Bucket& AddBucket(Key key)
+    {
+        uint32 const mask = uint32(_buckets.size()) - 1;
+        uint32 index = GetBucketIndex(key);
+        while (_buckets[index].Used)
+            index = (index + 1) & mask;
+
+        Bucket& bucket = _buckets[index];
+        bucket.BucketKey = key;
+        bucket.First = INVALID_SLOT;
+        bucket.Last = INVALID_SLOT;
+        bucket.Used = true;
+        ++_bucketsUsed;
+        return bucket;
+    }
+
+    /// Builds the index of the slots again, keys without any element left are dropped
+    void Rehash(uint32 bucketCount)
+    {
+        _buckets.assign(bucketCount, Bucket());
+        _bucketsUsed = 0;
+        _bucketShift = 32;
+        for (uint32 count = bucketCount; count > 1; count >>= 1)
+            --_bucketShift;
+
+        for (uint32 slot = 0; slot < _slots.size(); ++slot)
+        {
+            if (_slots[slot].Removed)
+                continue;
+
+            Key key = _slots[slot].Element.first;
+            Bucket* bucket = const_cast<Bucket*>(FindBucket(key));
+            if (!bucket)
+                bucket = &AddBucket(key);
+
+            _slots[slot].NextWithKey = INVALID_SLOT;
+            if (bucket->Last != INVALID_SLOT)
+                _slots[bucket->Last].NextWithKey = slot;
+            else
+                bucket->First = slot;
+
+            bucket->Last = slot;
+        }
+    }
+
+    std::vector<Slot> _slots;
+    std::vector<Bucket> _buckets;       // power of two, at most half used
+    uint32 _size;
+    uint32 _bucketsUsed;
+    uint8 _bucketShift;
+};
+
+#endif
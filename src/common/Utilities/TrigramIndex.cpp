@@ -0,0 +1,106 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TrigramIndex.h"
+#include <algorithm>
+#include <iterator>
+
+std::vector<uint64> TrigramIndex::GetTrigrams(std::wstring_view text)
+{
+    std::vector<uint64> trigrams;
+    if (text.size() < MIN_PATTERN_LENGTH)
+        return trigrams;
+
+    trigrams.reserve(text.size() - 2);
+
+    // code points take at most 21 bits
+    for (std::size_t i = 0; i + 2 < text.size(); ++i)
+        trigrams.push_back((uint64(uint32(text[i]) & 0x1FFFFF) << 42) | (uint64(uint32(text[i + 1]) & 0x1FFFFF) << 21) | uint64(uint32(text[i + 2]) & 0x1FFFFF));
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+void TrigramIndex::Add(uint32 id, std::wstring_view text)
+{
+    for (uint64 trigram : GetTrigrams(text))
+    {
+        PostingList& postings = _postings[trigram];
+
+        // ids are mostly added in ascending order
+        if (postings.empty() || postings.back() < id)
+            postings.push_back(id);
+        else
+        {
+            PostingList::iterator itr = std::lower_bound(postings.begin(), postings.end(), id);
+            if (*itr != id)
+                postings.insert(itr, id);
+        }
+    }
+}
+
+void TrigramIndex::Remove(uint32 id, std::wstring_view text)
+{
+    for (uint64 trigram : GetTrigrams(text))
+    {
+        auto itr = _postings.find(trigram);
+        if (itr == _postings.end())
+            continue;
+
+        PostingList& postings = itr->second;
+        PostingList::iterator posting = std::lower_bound(postings.begin(), postings.end(), id);
+        if (posting != postings.end() && *posting == id)
+            postings.erase(posting);
+
+        if (postings.empty())
+            _postings.erase(itr);
+    }
+}
+
+bool TrigramIndex::FindCandidates(std::wstring_view pattern, std::vector<uint32>& candidates) const
+{
+    candidates.clear();
+    if (pattern.size() < MIN_PATTERN_LENGTH)
+        return false;
+
+    std::vector<PostingList const*> lists;
+    for (uint64 trigram : GetTrigrams(pattern))
+    {
+        auto itr = _postings.find(trigram);
+        if (itr == _postings.end())
+            return true;
+
+        lists.push_back(&itr->second);
+    }
+
+    // start with the rarest trigram, every further intersection can only shrink the candidates
+    std::sort(lists.begin(), lists.end(), [](PostingList const* left, PostingList const* right) { return left->size() < right->size(); });
+
+    // set_intersection may not write into one of its inputs
+    candidates = *lists.front();
+    std::vector<uint32> intersection;
+    for (std::size_t i = 1; i < lists.size() && !candidates.empty(); ++i)
+    {
+        PostingList const& postings = *lists[i];
+        intersection.clear();
+        std::set_intersection(candidates.begin(), candidates.end(), postings.begin(), postings.end(), std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    return true;
+}
@@ -0,0 +1,58 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TRIGRAM_INDEX_H_
+#define _TRIGRAM_INDEX_H_
+
+#include "Define.h"
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Inverted index from the three character substrings of texts to the ids of the texts containing them.
+ * A text can only contain a search string if it contains all of its trigrams, so intersecting their posting
+ * lists gives the few texts worth comparing instead of all of them. Texts are lowercased wide strings, as
+ * produced by wstrToLower, and ids are chosen by the caller.
+ */
+class AC_COMMON_API TrigramIndex
+{
+public:
+    static constexpr std::size_t MIN_PATTERN_LENGTH = 3;
+
+    void Add(uint32 id, std::wstring_view text);
+    void Remove(uint32 id, std::wstring_view text);
+    void Clear() { _postings.clear(); }
+
+    /**
+     * @brief Finds the ids of the texts containing all trigrams of pattern, ascending.
+     * The candidates still have to be compared against the pattern, they are a superset of the matches.
+     * @return false if pattern is shorter than MIN_PATTERN_LENGTH, any text may contain it then.
+     */
+    bool FindCandidates(std::wstring_view pattern, std::vector<uint32>& candidates) const;
+
+    [[nodiscard]] std::size_t GetTrigramCount() const { return _postings.size(); }
+
+private:
+    typedef std::vector<uint32> PostingList;    // ascending
+
+    static std::vector<uint64> GetTrigrams(std::wstring_view text);
+
+    std::unordered_map<uint64, PostingList> _postings;
+};
+
+#endif
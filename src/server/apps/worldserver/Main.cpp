@@ -50,6 +50,7 @@
 #include "SharedDefines.h"
 #include "SteadyTimer.h"
 #include "World.h"
+#include "WorldDatabaseCache.h"
 #include "WorldSessionMgr.h"
 #include "WorldSocket.h"
 #include "WorldSocketMgr.h"
@@ -188,8 +189,7 @@ int main(int argc, char** argv)
 
     // Init all logs
     sLog->RegisterAppender<AppenderDB>();
-    // If logs are supposed to be handled async then we need to pass the IoContext into the Log singleton
-    sLog->Initialize(sConfigMgr->GetOption<bool>("Log.Async.Enable", false) ? ioContext.get() : nullptr);
+    sLog->Initialize(sConfigMgr->GetOption<bool>("Log.Async.Enable", false));
 
     Acore::Banner::Show("worldserver-daemon",
         [](std::string_view text)
@@ -291,6 +291,7 @@ int main(int argc, char** argv)
         METRIC_VALUE("db_queue_login", uint64(LoginDatabase.QueueSize()));
         METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.QueueSize()));
         METRIC_VALUE("db_queue_world", uint64(WorldDatabase.QueueSize()));
+        EncryptableAndCompressiblePacket::LogCompressionMetrics();
     });
 
     METRIC_EVENT("events", "Worldserver started", "");
@@ -361,13 +362,16 @@ int main(int argc, char** argv)
     std::unique_ptr<CharacterWebService> charWebService;
     if (sConfigMgr->GetOption<bool>("CharacterWebService.Enable", false))
     {
-        uint16 webPort = sConfigMgr->GetOption<uint16>("CharacterWebService.Port", 8080);
-        charWebService = std::make_unique<CharacterWebService>(*ioContext, webPort);
-        if (charWebService->Start())
-        {
-            LOG_INFO("server.worldserver", "Character Web Service started on port {}", webPort);
-        }
-        else
+        CharacterWebServiceSettings webSettings;
+        webSettings.Port = sConfigMgr->GetOption<uint16>("CharacterWebService.Port", 8080);
+        webSettings.NetworkThreads = sConfigMgr->GetOption<uint32>("CharacterWebService.NetworkThreads", 1);
+        webSettings.WorkerThreads = sConfigMgr->GetOption<uint32>("CharacterWebService.WorkerThreads", 2);
+        webSettings.MaxConcurrentRequests = sConfigMgr->GetOption<uint32>("CharacterWebService.MaxConcurrentRequests", 16);
+        webSettings.ReadTimeout = sConfigMgr->GetOption<uint32>("CharacterWebService.ReadTimeout", 30);
+        webSettings.MaxBatchSize = sConfigMgr->GetOption<uint32>("CharacterWebService.MaxBatchSize", 500);
+
+        charWebService = std::make_unique<CharacterWebService>(webSettings);
+        if (!charWebService->Start())
         {
             LOG_ERROR("server.worldserver", "Failed to start Character Web Service");
             charWebService.reset();
@@ -735,6 +739,7 @@ variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile, [
         ("help,h", "print usage message")
         ("version,v", "print version build info")
         ("dry-run,d", "Dry run")
+        ("rebuild-world-cache", "write a new world database cache file, see WorldDatabaseCache.Enable")
         ("config,c", value<fs::path>(&configFile)->default_value(fs::path(sConfigMgr->GetConfigPath() + std::string(_ACORE_CORE_CONFIG))), "use <arg> as configuration file");
 
 #if AC_PLATFORM == AC_PLATFORM_WINDOWS
@@ -764,5 +769,8 @@ variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile, [
     else if (vm.count("dry-run"))
         sConfigMgr->setDryRun(true);
 
+    if (vm.count("rebuild-world-cache"))
+        sWorldDatabaseCache->SetRebuild(true);
+
     return vm;
 }
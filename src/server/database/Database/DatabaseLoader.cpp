@@ -56,6 +56,8 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
         uint8 const synchThreads = sConfigMgr->GetOption<uint8>(name + "Database.SynchThreads", 1);
 
         pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+        pool.SetSlowQueryLogging(Milliseconds(sConfigMgr->GetOption<uint32>("Database.SlowQuery.Threshold", 500)),
+            sConfigMgr->GetOption<uint32>("Database.SlowQuery.SampleRate", 10));
 
         if (uint32 error = pool.Open())
         {
@@ -0,0 +1,199 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseStatistics.h"
+#include "Metric.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    constexpr MetricSeriesId UNREGISTERED_SERIES = std::numeric_limits<MetricSeriesId>::max();
+
+    void StoreMax(std::atomic<int64>& max, int64 value)
+    {
+        int64 current = max.load(std::memory_order_relaxed);
+        while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+    }
+}
+
+struct DatabaseStatistics::Slot
+{
+    std::atomic<uint64> Waits{ 0 };
+    std::atomic<int64> WaitTotal{ 0 };
+    std::atomic<int64> WaitMax{ 0 };
+
+    std::atomic<uint64> Executions{ 0 };
+    std::atomic<int64> ExecutionTotal{ 0 };
+    std::atomic<int64> ExecutionMax{ 0 };
+    std::atomic<uint64> SlowExecutions{ 0 };
+
+    // registered on the first sample recorded while metrics are enabled
+    std::atomic<uint32> WaitSeries{ UNREGISTERED_SERIES };
+    std::atomic<uint32> ExecutionSeries{ UNREGISTERED_SERIES };
+
+    std::string Query;
+};
+
+DatabaseStatistics::DatabaseStatistics(std::string_view database, uint32 statementCount) :
+    _database(database),
+    _slotCount(DATABASE_STATISTICS_STATEMENT + statementCount),
+    _slots(std::make_unique<Slot[]>(_slotCount)),
+    _queueSize(0),
+    _peakQueueSize(0),
+    _queueSizeSeries(UNREGISTERED_SERIES),
+    _slowThreshold(0),
+    _slowSampleRate(1)
+{
+}
+
+DatabaseStatistics::~DatabaseStatistics() = default;
+
+void DatabaseStatistics::SetSlowQueryLogging(Milliseconds threshold, uint32 sampleRate)
+{
+    _slowThreshold.store(std::chrono::duration_cast<Microseconds>(threshold).count(), std::memory_order_relaxed);
+    _slowSampleRate.store(std::max<uint32>(sampleRate, 1), std::memory_order_relaxed);
+}
+
+void DatabaseStatistics::SetStatementQuery(uint32 index, std::string_view sql)
+{
+    uint32 slot = DATABASE_STATISTICS_STATEMENT + index;
+    if (slot < _slotCount && _slots[slot].Query.empty())
+        _slots[slot].Query = sql;
+}
+
+uint32 DatabaseStatistics::GetSeries(std::atomic<uint32>& series, char const* category, uint32 slot) const
+{
+    MetricSeriesId id = series.load(std::memory_order_acquire);
+    if (id == UNREGISTERED_SERIES)
+    {
+        std::vector<MetricTag> tags = { METRIC_TAG("db", _database) };
+        if (slot < _slotCount)
+            tags.push_back(METRIC_TAG("statement", GetSlotName(slot)));
+
+        // two threads may both register, the series is interned so they get the same id
+        id = sMetric->RegisterSeries(category, tags, MetricSeriesType::Histogram);
+        series.store(id, std::memory_order_release);
+    }
+
+    return id;
+}
+
+void DatabaseStatistics::OnEnqueue()
+{
+    int64 size = _queueSize.fetch_add(1, std::memory_order_relaxed) + 1;
+    StoreMax(_peakQueueSize, size);
+
+    METRIC_RECORD(GetSeries(_queueSizeSeries, "db_queue_size", _slotCount), size);
+}
+
+void DatabaseStatistics::OnDequeue(uint32 slot, Microseconds wait)
+{
+    _queueSize.fetch_sub(1, std::memory_order_relaxed);
+
+    if (slot >= _slotCount)
+        return;
+
+    Slot& counters = _slots[slot];
+    counters.Waits.fetch_add(1, std::memory_order_relaxed);
+    counters.WaitTotal.fetch_add(wait.count(), std::memory_order_relaxed);
+    StoreMax(counters.WaitMax, wait.count());
+
+    METRIC_RECORD(GetSeries(counters.WaitSeries, "db_wait", slot), wait.count());
+}
+
+bool DatabaseStatistics::OnExecute(uint32 slot, Microseconds duration)
+{
+    if (slot >= _slotCount)
+        return false;
+
+    Slot& counters = _slots[slot];
+    counters.Executions.fetch_add(1, std::memory_order_relaxed);
+    counters.ExecutionTotal.fetch_add(duration.count(), std::memory_order_relaxed);
+    StoreMax(counters.ExecutionMax, duration.count());
+
+    METRIC_RECORD(GetSeries(counters.ExecutionSeries, "db_execution", slot), duration.count());
+
+    int64 threshold = _slowThreshold.load(std::memory_order_relaxed);
+    if (!threshold || duration.count() < threshold)
+        return false;
+
+    // the first slow execution of a slot is always logged, then one in every sample rate
+    uint64 slow = counters.SlowExecutions.fetch_add(1, std::memory_order_relaxed);
+    return slow % _slowSampleRate.load(std::memory_order_relaxed) == 0;
+}
+
+std::string DatabaseStatistics::GetSlotName(uint32 slot)
+{
+    switch (slot)
+    {
+        case DATABASE_STATISTICS_ADHOC:
+            return "adhoc";
+        case DATABASE_STATISTICS_TRANSACTION:
+            return "transaction";
+        case DATABASE_STATISTICS_QUERY_HOLDER:
+            return "query_holder";
+        case DATABASE_STATISTICS_PING:
+            return "ping";
+        default:
+            return std::to_string(slot - DATABASE_STATISTICS_STATEMENT);
+    }
+}
+
+std::vector<DatabaseSlotStatistics> DatabaseStatistics::GetSlots() const
+{
+    std::vector<DatabaseSlotStatistics> slots;
+
+    for (uint32 slot = 0; slot < _slotCount; ++slot)
+    {
+        Slot const& counters = _slots[slot];
+
+        DatabaseSlotStatistics statistics;
+        statistics.Waits = counters.Waits.load(std::memory_order_relaxed);
+        statistics.Executions = counters.Executions.load(std::memory_order_relaxed);
+        if (!statistics.Waits && !statistics.Executions)
+            continue;
+
+        statistics.Slot = slot;
+        statistics.Query = counters.Query;
+        statistics.WaitTotal = Microseconds(counters.WaitTotal.load(std::memory_order_relaxed));
+        statistics.WaitMax = Microseconds(counters.WaitMax.load(std::memory_order_relaxed));
+        statistics.ExecutionTotal = Microseconds(counters.ExecutionTotal.load(std::memory_order_relaxed));
+        statistics.ExecutionMax = Microseconds(counters.ExecutionMax.load(std::memory_order_relaxed));
+        statistics.SlowExecutions = counters.SlowExecutions.load(std::memory_order_relaxed);
+        slots.push_back(std::move(statistics));
+    }
+
+    return slots;
+}
+
+void DatabaseStatistics::Reset()
+{
+    for (uint32 slot = 0; slot < _slotCount; ++slot)
+    {
+        Slot& counters = _slots[slot];
+        counters.Waits.store(0, std::memory_order_relaxed);
+        counters.WaitTotal.store(0, std::memory_order_relaxed);
+        counters.WaitMax.store(0, std::memory_order_relaxed);
+        counters.Executions.store(0, std::memory_order_relaxed);
+        counters.ExecutionTotal.store(0, std::memory_order_relaxed);
+        counters.ExecutionMax.store(0, std::memory_order_relaxed);
+        counters.SlowExecutions.store(0, std::memory_order_relaxed);
+    }
+
+    _peakQueueSize.store(_queueSize.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
@@ -0,0 +1,110 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DATABASESTATISTICS_H
+#define _DATABASESTATISTICS_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//- What the time of an operation is accounted to
+enum DatabaseStatisticsSlot : uint32
+{
+    DATABASE_STATISTICS_ADHOC,          // raw SQL strings
+    DATABASE_STATISTICS_TRANSACTION,    // whole transactions, their statements are counted on their own as well
+    DATABASE_STATISTICS_QUERY_HOLDER,   // whole query holders, likewise
+    DATABASE_STATISTICS_PING,
+    DATABASE_STATISTICS_STATEMENT       // prepared statement index 0, the other indices follow
+};
+
+//- Counters of one slot, as returned by DatabaseStatistics::GetSlots()
+struct DatabaseSlotStatistics
+{
+    uint32 Slot = 0;
+    std::string Query;                  // SQL of prepared statements
+
+    uint64 Waits = 0;                   // operations taken from the asynchronous queue
+    Microseconds WaitTotal = 0us;       // from being queued until a worker started them
+    Microseconds WaitMax = 0us;
+
+    uint64 Executions = 0;
+    Microseconds ExecutionTotal = 0us;
+    Microseconds ExecutionMax = 0us;
+    uint64 SlowExecutions = 0;
+};
+
+/*
+ * Counters of one DatabaseWorkerPool, kept per prepared statement index and per kind of other operation.
+ * Worker threads add the time operations spent in the queue, connections add the time the server took
+ * for each statement, both with relaxed atomics so the counters cost no locks on the hot path.
+ * When metrics are enabled the samples also go to the db_wait and db_execution histograms.
+ */
+class AC_DATABASE_API DatabaseStatistics
+{
+public:
+    DatabaseStatistics(std::string_view database, uint32 statementCount);
+    ~DatabaseStatistics();
+
+    /// Executions at least as long as threshold are counted as slow, every sampleRate-th one of a slot is logged
+    void SetSlowQueryLogging(Milliseconds threshold, uint32 sampleRate);
+
+    void SetStatementQuery(uint32 index, std::string_view sql);
+
+    void OnEnqueue();
+    void OnDequeue(uint32 slot, Microseconds wait);
+    /// Returns true if the execution was slow and should be logged
+    bool OnExecute(uint32 slot, Microseconds duration);
+
+    /// Operations timed by the worker running them, statements are timed by the connection executing them
+    static bool IsComposite(uint32 slot) { return slot == DATABASE_STATISTICS_TRANSACTION || slot == DATABASE_STATISTICS_QUERY_HOLDER || slot == DATABASE_STATISTICS_PING; }
+    static std::string GetSlotName(uint32 slot);
+
+    [[nodiscard]] std::string_view GetDatabase() const { return _database; }
+    [[nodiscard]] int64 GetQueueSize() const { return _queueSize.load(std::memory_order_relaxed); }
+    [[nodiscard]] int64 GetPeakQueueSize() const { return _peakQueueSize.load(std::memory_order_relaxed); }
+
+    /// Slots with any operation since the last reset
+    [[nodiscard]] std::vector<DatabaseSlotStatistics> GetSlots() const;
+    void Reset();
+
+private:
+    struct Slot;
+
+    /// Metric series of a slot, or of the whole pool for slots past the last one
+    uint32 GetSeries(std::atomic<uint32>& series, char const* category, uint32 slot) const;
+
+    std::string _database;
+    uint32 _slotCount;
+    std::unique_ptr<Slot[]> _slots;
+
+    std::atomic<int64> _queueSize;
+    std::atomic<int64> _peakQueueSize;
+    std::atomic<uint32> _queueSizeSeries;
+
+    std::atomic<int64> _slowThreshold;  // microseconds, 0 if disabled
+    std::atomic<uint32> _slowSampleRate;
+
+    DatabaseStatistics(DatabaseStatistics const& right) = delete;
+    DatabaseStatistics& operator=(DatabaseStatistics const& right) = delete;
+};
+
+#endif
@@ -16,6 +16,7 @@
  */
 
 #include "DatabaseWorker.h"
+#include "MySQLConnection.h"
 #include "PCQueue.h"
 #include "SQLOperation.h"
 
@@ -45,9 +46,20 @@ void DatabaseWorker::WorkerThread()
         if (!operation)
             return;
 
+        DatabaseStatistics* statistics = _connection->GetStatistics();
+        uint32 slot = operation->GetStatisticsSlot();
+        TimePoint start = std::chrono::steady_clock::now();
+
+        if (statistics)
+            statistics->OnDequeue(slot, std::chrono::duration_cast<Microseconds>(start - operation->m_enqueueTime));
+
         operation->SetConnection(_connection);
         operation->call();
 
+        // the statements of transactions and query holders are counted by the connection as well
+        if (statistics && DatabaseStatistics::IsComposite(slot))
+            statistics->OnExecute(slot, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
+
         delete operation;
     }
 }
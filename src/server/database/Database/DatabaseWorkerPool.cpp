@@ -18,6 +18,7 @@
 #include "DatabaseWorkerPool.h"
 #include "AdhocStatement.h"
 #include "CharacterDatabase.h"
+#include "DatabaseStatistics.h"
 #include "Errors.h"
 #include "Log.h"
 #include "LoginDatabase.h"
@@ -41,6 +42,18 @@
 #include <sstream>
 #endif
 
+template <class T>
+struct DatabaseStatementCount;
+
+template <>
+struct DatabaseStatementCount<LoginDatabaseConnection> : std::integral_constant<uint32, MAX_LOGINDATABASE_STATEMENTS> { };
+
+template <>
+struct DatabaseStatementCount<WorldDatabaseConnection> : std::integral_constant<uint32, MAX_WORLDDATABASE_STATEMENTS> { };
+
+template <>
+struct DatabaseStatementCount<CharacterDatabaseConnection> : std::integral_constant<uint32, MAX_CHARACTERDATABASE_STATEMENTS> { };
+
 class PingOperation : public SQLOperation
 {
     //! Operation for idle delaythreads
@@ -49,6 +62,8 @@ class PingOperation : public SQLOperation
         m_conn->Ping();
         return true;
     }
+
+    uint32 GetStatisticsSlot() const override { return DATABASE_STATISTICS_PING; }
 };
 
 template <class T>
@@ -78,6 +93,7 @@ template <class T>
 void DatabaseWorkerPool<T>::SetConnectionInfo(std::string_view infoString, uint8 const asyncThreads, uint8 const synchThreads)
 {
     _connectionInfo = std::make_unique<MySQLConnectionInfo>(infoString);
+    _statistics = std::make_unique<DatabaseStatistics>(_connectionInfo->database, DatabaseStatementCount<T>::value);
 
     _async_threads = asyncThreads;
     _synch_threads = synchThreads;
@@ -433,6 +449,9 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
             }
         }();
 
+        // before Open(), the worker thread must not run any operation without it
+        connection->SetStatistics(_statistics.get());
+
         if (uint32 error = connection->Open())
         {
             // Failed to open a connection or invalid version, abort and cleanup
@@ -468,9 +487,17 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 template <class T>
 void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
 {
+    op->m_enqueueTime = std::chrono::steady_clock::now();
+    _statistics->OnEnqueue();
     _queue->Push(op);
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::SetSlowQueryLogging(Milliseconds threshold, uint32 sampleRate)
+{
+    _statistics->SetSlowQueryLogging(threshold, sampleRate);
+}
+
 template <class T>
 std::size_t DatabaseWorkerPool<T>::QueueSize() const
 {
@@ -20,6 +20,7 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
+#include "Duration.h"
 #include "StringFormat.h"
 #include <array>
 #include <vector>
@@ -41,6 +42,7 @@
 template <typename T>
 class ProducerConsumerQueue;
 
+class DatabaseStatistics;
 class SQLOperation;
 struct MySQLConnectionInfo;
 
@@ -215,6 +217,12 @@ public:
 
     [[nodiscard]] std::size_t QueueSize() const;
 
+    //! Queue wait and execution time of the asynchronous operations and prepared statements, valid after SetConnectionInfo
+    [[nodiscard]] DatabaseStatistics& GetStatistics() const { return *_statistics; }
+
+    //! Logs every sampleRate-th execution of a statement taking at least threshold, a threshold of 0 disables it
+    void SetSlowQueryLogging(Milliseconds threshold, uint32 sampleRate);
+
 private:
     uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
@@ -230,6 +238,8 @@ private:
 
     //! Queue shared by async worker threads.
     std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+    //! Declared before the connections, their workers use it until they are destroyed.
+    std::unique_ptr<DatabaseStatistics> _statistics;
     std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
     std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
     std::vector<uint8> _preparedStatementSize;
@@ -16,6 +16,7 @@
  */
 
 #include "CharacterDatabase.h"
+#include "MultiRowStatement.h"
 #include "MySQLPreparedStatement.h"
 
 void CharacterDatabaseConnection::DoPrepareStatements()
@@ -506,7 +507,6 @@ void CharacterDatabaseConnection::DoPrepareStatements()
     PrepareStatement(CHAR_UDP_CHAR_MONEY_ACCUMULATIVE, "UPDATE characters SET money = money + ? WHERE guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_UPD_CHAR_REMOVE_GHOST, "UPDATE characters SET playerFlags = (playerFlags & (~16)) WHERE guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_INS_CHAR_ACTION, "INSERT INTO character_action (guid, spec, button, action, type) VALUES (?, ?, ?, ?, ?)", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_UPD_CHAR_ACTION, "UPDATE character_action SET action = ?, type = ? WHERE guid = ? AND button = ? AND spec = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_DEL_CHAR_ACTION_BY_BUTTON_SPEC, "DELETE FROM character_action WHERE guid = ? AND button = ? AND spec = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_DEL_CHAR_INVENTORY_BY_ITEM, "DELETE FROM character_inventory WHERE item = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_DEL_CHAR_INVENTORY_BY_BAG_SLOT, "DELETE FROM character_inventory WHERE bag = ? AND slot = ? AND guid = ?", CONNECTION_ASYNC);
@@ -519,9 +519,29 @@ void CharacterDatabaseConnection::DoPrepareStatements()
     PrepareStatement(CHAR_UPD_CHAR_QUESTSTATUS_REWARDED_ACTIVE, "UPDATE character_queststatus_rewarded SET active = 1 WHERE guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_UPD_CHAR_QUESTSTATUS_REWARDED_ACTIVE_BY_QUEST, "UPDATE character_queststatus_rewarded SET active = 0 WHERE quest = ? AND guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_DEL_CHAR_SKILL_BY_SKILL, "DELETE FROM character_skills WHERE guid = ? AND skill = ?", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_INS_CHAR_SKILLS, "INSERT INTO character_skills (guid, skill, value, max) VALUES (?, ?, ?, ?)", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_UDP_CHAR_SKILLS, "UPDATE character_skills SET value = ?, max = ? WHERE guid = ? AND skill = ?", CONNECTION_ASYNC);
-    PrepareStatement(CHAR_INS_CHAR_SPELL, "INSERT INTO character_spell (guid, spell, specMask) VALUES (?, ?, ?)", CONNECTION_ASYNC);
+
+    // Rows written by Player::SaveToDB through MultiRowStatement, one at a time and in batches that repeat the row parameters
+    PrepareStatement(CHAR_REP_CHAR_ACTION, "REPLACE INTO character_action (guid, spec, button, action, type) VALUES (?, ?, ?, ?, ?)", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_CHAR_ACTION_BATCH, "REPLACE INTO character_action (guid, spec, button, action, type) VALUES " + MultiRowStatement::JoinRows("(?, ?, ?, ?, ?)", MultiRowStatement::DefaultBatchRows), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_ACTION_BY_BUTTON_SPEC_BATCH, "DELETE FROM character_action WHERE (guid, button, spec) IN (" + MultiRowStatement::JoinRows("(?, ?, ?)", MultiRowStatement::DefaultBatchRows) + ")", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_CHAR_AURA, "REPLACE INTO character_aura (guid, casterGuid, itemGuid, spell, effectMask, recalculateMask, stackCount, amount0, amount1, amount2, base_amount0, base_amount1, base_amount2, maxDuration, remainTime, remainCharges) "
+                     "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_CHAR_AURA_BATCH, "REPLACE INTO character_aura (guid, casterGuid, itemGuid, spell, effectMask, recalculateMask, stackCount, amount0, amount1, amount2, base_amount0, base_amount1, base_amount2, maxDuration, remainTime, remainCharges) "
+                     "VALUES " + MultiRowStatement::JoinRows("(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", MultiRowStatement::DefaultBatchRows), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_AURA_BY_KEY, "DELETE FROM character_aura WHERE guid = ? AND casterGuid = ? AND itemGuid = ? AND spell = ? AND effectMask = ?", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_AURA_BY_KEY_BATCH, "DELETE FROM character_aura WHERE (guid, casterGuid, itemGuid, spell, effectMask) IN (" + MultiRowStatement::JoinRows("(?, ?, ?, ?, ?)", MultiRowStatement::DefaultBatchRows) + ")", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_CHAR_QUESTSTATUS_BATCH, "REPLACE INTO character_queststatus (guid, quest, status, explored, timer, mobcount1, mobcount2, mobcount3, mobcount4, itemcount1, itemcount2, itemcount3, itemcount4, itemcount5, itemcount6, playercount) "
+                     "VALUES " + MultiRowStatement::JoinRows("(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", MultiRowStatement::DefaultBatchRows), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_QUESTSTATUS_BY_QUEST_BATCH, "DELETE FROM character_queststatus WHERE (guid, quest) IN (" + MultiRowStatement::JoinRows("(?, ?)", MultiRowStatement::DefaultBatchRows) + ")", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_INS_CHAR_QUESTSTATUS_REWARDED_BATCH, "INSERT IGNORE INTO character_queststatus_rewarded (guid, quest, active) VALUES " + MultiRowStatement::JoinRows("(?, ?, 1)", MultiRowStatement::DefaultBatchRows), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_QUESTSTATUS_REWARDED_BY_QUEST_BATCH, "DELETE FROM character_queststatus_rewarded WHERE (guid, quest) IN (" + MultiRowStatement::JoinRows("(?, ?)", MultiRowStatement::DefaultBatchRows) + ")", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_SKILL_BY_SKILL_BATCH, "DELETE FROM character_skills WHERE (guid, skill) IN (" + MultiRowStatement::JoinRows("(?, ?)", MultiRowStatement::DefaultBatchRows) + ")", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_CHAR_SKILLS, "REPLACE INTO character_skills (guid, skill, value, max) VALUES (?, ?, ?, ?)", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_CHAR_SKILLS_BATCH, "REPLACE INTO character_skills (guid, skill, value, max) VALUES " + MultiRowStatement::JoinRows("(?, ?, ?, ?)", MultiRowStatement::DefaultBatchRows), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_CHAR_SPELL, "REPLACE INTO character_spell (guid, spell, specMask) VALUES (?, ?, ?)", CONNECTION_ASYNC);
+    PrepareStatement(CHAR_REP_CHAR_SPELL_BATCH, "REPLACE INTO character_spell (guid, spell, specMask) VALUES " + MultiRowStatement::JoinRows("(?, ?, ?)", MultiRowStatement::DefaultBatchRows), CONNECTION_ASYNC);
+    PrepareStatement(CHAR_DEL_CHAR_SPELL_BY_SPELL_BATCH, "DELETE FROM character_spell WHERE (guid, spell) IN (" + MultiRowStatement::JoinRows("(?, ?)", MultiRowStatement::DefaultBatchRows) + ")", CONNECTION_ASYNC);
+
     PrepareStatement(CHAR_DEL_CHAR_STATS, "DELETE FROM character_stats WHERE guid = ?", CONNECTION_ASYNC);
     PrepareStatement(CHAR_INS_CHAR_STATS, "INSERT INTO character_stats (guid, maxhealth, maxpower1, maxpower2, maxpower3, maxpower4, maxpower5, maxpower6, maxpower7, strength, agility, stamina, intellect, spirit, "
                      "armor, resHoly, resFire, resNature, resFrost, resShadow, resArcane, blockPct, dodgePct, parryPct, critPct, rangedCritPct, spellCritPct, attackPower, rangedAttackPower, "
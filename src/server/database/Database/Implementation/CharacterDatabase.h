@@ -430,22 +430,35 @@ enum CharacterDatabaseStatements : uint32
     CHAR_UDP_CHAR_MONEY_ACCUMULATIVE,
     CHAR_UPD_CHAR_REMOVE_GHOST, // pussywizard
     CHAR_INS_CHAR_ACTION,
-    CHAR_UPD_CHAR_ACTION,
+    CHAR_REP_CHAR_ACTION,
+    CHAR_REP_CHAR_ACTION_BATCH,
     CHAR_DEL_CHAR_ACTION_BY_BUTTON_SPEC,
+    CHAR_DEL_CHAR_ACTION_BY_BUTTON_SPEC_BATCH,
+    CHAR_REP_CHAR_AURA,
+    CHAR_REP_CHAR_AURA_BATCH,
+    CHAR_DEL_CHAR_AURA_BY_KEY,
+    CHAR_DEL_CHAR_AURA_BY_KEY_BATCH,
     CHAR_DEL_CHAR_INVENTORY_BY_ITEM,
     CHAR_DEL_CHAR_INVENTORY_BY_BAG_SLOT,
     CHAR_UPD_MAIL,
     CHAR_REP_CHAR_QUESTSTATUS,
+    CHAR_REP_CHAR_QUESTSTATUS_BATCH,
     CHAR_DEL_CHAR_QUESTSTATUS_BY_QUEST,
+    CHAR_DEL_CHAR_QUESTSTATUS_BY_QUEST_BATCH,
     CHAR_INS_CHAR_QUESTSTATUS_REWARDED,
+    CHAR_INS_CHAR_QUESTSTATUS_REWARDED_BATCH,
     CHAR_DEL_CHAR_QUESTSTATUS_REWARDED_BY_QUEST,
+    CHAR_DEL_CHAR_QUESTSTATUS_REWARDED_BY_QUEST_BATCH,
     CHAR_UPD_CHAR_QUESTSTATUS_REWARDED_FACTION_CHANGE,
     CHAR_UPD_CHAR_QUESTSTATUS_REWARDED_ACTIVE,
     CHAR_UPD_CHAR_QUESTSTATUS_REWARDED_ACTIVE_BY_QUEST,
     CHAR_DEL_CHAR_SKILL_BY_SKILL,
-    CHAR_INS_CHAR_SKILLS,
-    CHAR_UDP_CHAR_SKILLS,
-    CHAR_INS_CHAR_SPELL,
+    CHAR_DEL_CHAR_SKILL_BY_SKILL_BATCH,
+    CHAR_REP_CHAR_SKILLS,
+    CHAR_REP_CHAR_SKILLS_BATCH,
+    CHAR_REP_CHAR_SPELL,
+    CHAR_REP_CHAR_SPELL_BATCH,
+    CHAR_DEL_CHAR_SPELL_BY_SPELL_BATCH,
     CHAR_DEL_CHAR_STATS,
     CHAR_INS_CHAR_STATS,
     CHAR_SEL_CHAR_STATS,
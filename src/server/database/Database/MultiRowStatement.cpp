@@ -0,0 +1,49 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MultiRowStatement.h"
+
+MultiRowStatement::MultiRowStatement(uint32 rowIndex, uint32 batchIndex, uint8 batchRows /*= DefaultBatchRows*/)
+    : _rowIndex(rowIndex), _batchIndex(batchIndex), _batchRows(batchRows), _columns(0)
+{
+    ASSERT(batchRows > 1);
+}
+
+std::string MultiRowStatement::JoinRows(std::string_view row, uint8 rows)
+{
+    std::string sql;
+    sql.reserve((row.size() + 2) * rows);
+
+    for (uint8 i = 0; i < rows; ++i)
+    {
+        if (i)
+            sql += ", ";
+
+        sql += row;
+    }
+
+    return sql;
+}
+
+void MultiRowStatement::Bind(PreparedStatementBase* stmt, std::size_t first, std::size_t count) const
+{
+    // The statement was prepared for a different number of rows or values
+    ASSERT(stmt->statement_data.size() == count, "Statement {} takes {} parameters instead of {}", stmt->GetIndex(), stmt->statement_data.size(), count);
+
+    for (std::size_t i = 0; i < count; ++i)
+        stmt->statement_data[i] = _values[first + i];
+}
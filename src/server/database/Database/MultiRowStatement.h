@@ -0,0 +1,110 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MULTIROWSTATEMENT_H
+#define _MULTIROWSTATEMENT_H
+
+#include "Define.h"
+#include "Errors.h"
+#include "PreparedStatement.h"
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Writes many rows through two prepared statements, one taking a single row and one taking a fixed batch of rows.
+ *
+ * The batch statement repeats the parameters of the single row one, e.g. "REPLACE INTO table (a, b) VALUES (?, ?), (?, ?), ..."
+ * or "DELETE FROM table WHERE (a, b) IN ((?, ?), (?, ?), ...)". The rows fill as many batch statements as they can and the rest
+ * are written one by one, so a save writing a hundred rows sends sixteen statements instead of a hundred, and each of them
+ * is still counted under its own index in the database statistics.
+ */
+class AC_DATABASE_API MultiRowStatement
+{
+public:
+    /// Statements take less than 255 parameters, 8 rows leave room for 31 values per row
+    static constexpr uint8 DefaultBatchRows = 8;
+
+    MultiRowStatement(uint32 rowIndex, uint32 batchIndex, uint8 batchRows = DefaultBatchRows);
+
+    /// All rows of a statement take the same number of values
+    template<typename... Args>
+    void AddRow(Args const&... values)
+    {
+        static_assert(sizeof...(Args) > 0, "MultiRowStatement rows need values");
+
+        if (!_columns)
+            _columns = sizeof...(Args);
+
+        ASSERT(_columns == sizeof...(Args), "MultiRowStatement row has {} values instead of {}", sizeof...(Args), _columns);
+        (AddValue(values), ...);
+    }
+
+    [[nodiscard]] bool IsEmpty() const { return _values.empty(); }
+    [[nodiscard]] uint32 GetRowCount() const { return _columns ? _values.size() / _columns : 0; }
+
+    /// Binds the rows to statements of database, appends them to trans and starts over with no rows
+    template<class Database, class Transaction>
+    void AppendTo(Database& database, Transaction const& trans)
+    {
+        std::size_t rows = GetRowCount();
+        std::size_t first = 0;
+
+        while (rows)
+        {
+            uint8 count = rows >= _batchRows ? _batchRows : 1;
+            uint32 index = count > 1 ? _batchIndex : _rowIndex;
+
+            auto stmt = database.GetPreparedStatement(static_cast<typename Database::PreparedStatementIndex>(index));
+            Bind(stmt, first, count * _columns);
+            trans->Append(stmt);
+
+            first += count * _columns;
+            rows -= count;
+        }
+
+        _values.clear();
+    }
+
+    /// Parameter list of a batch statement, row repeated rows times and separated by commas
+    static std::string JoinRows(std::string_view row, uint8 rows);
+
+private:
+    template<typename T>
+    void AddValue(T const& value)
+    {
+        PreparedStatementData& data = _values.emplace_back();
+
+        if constexpr (std::is_enum_v<T>)
+            data.data.template emplace<std::underlying_type_t<T>>(value);
+        else if constexpr (std::is_convertible_v<T const&, std::string_view>)
+            data.data.template emplace<std::string>(std::string_view(value));
+        else
+            data.data.template emplace<T>(value);
+    }
+
+    void Bind(PreparedStatementBase* stmt, std::size_t first, std::size_t count) const;
+
+    uint32 _rowIndex;
+    uint32 _batchIndex;
+    uint8 _batchRows;
+    uint8 _columns;
+    std::vector<PreparedStatementData> _values;
+};
+
+#endif
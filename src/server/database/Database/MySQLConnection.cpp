@@ -16,6 +16,7 @@
  */
 
 #include "MySQLConnection.h"
+#include "DatabaseStatistics.h"
 #include "DatabaseWorker.h"
 #include "Log.h"
 #include "MySQLHacks.h"
@@ -48,6 +49,7 @@ MySQLConnectionInfo::MySQLConnectionInfo(std::string_view infoString)
 }
 
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
+    m_statistics(nullptr),
     m_reconnecting(false),
     m_prepareError(false),
     m_Mysql(nullptr),
@@ -56,6 +58,7 @@ MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
     m_connectionFlags(CONNECTION_SYNCH) { }
 
 MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
+    m_statistics(nullptr),
     m_reconnecting(false),
     m_prepareError(false),
     m_Mysql(nullptr),
@@ -172,6 +175,17 @@ bool MySQLConnection::PrepareStatements()
     return !m_prepareError;
 }
 
+template<typename QueryText>
+void MySQLConnection::TrackExecution(uint32 slot, TimePoint start, QueryText&& queryText)
+{
+    if (!m_statistics)
+        return;
+
+    Microseconds duration = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start);
+    if (m_statistics->OnExecute(slot, duration))
+        LOG_WARN("sql.performances", "Slow query on database `{}` ({} ms): {}", m_connectionInfo.database, duration.count() / 1000, queryText());
+}
+
 bool MySQLConnection::Execute(std::string_view sql)
 {
     if (!m_Mysql)
@@ -179,6 +193,7 @@ bool MySQLConnection::Execute(std::string_view sql)
 
     {
         uint32 _s = getMSTime();
+        TimePoint start = std::chrono::steady_clock::now();
 
         if (mysql_query(m_Mysql, std::string(sql).c_str()))
         {
@@ -194,6 +209,8 @@ bool MySQLConnection::Execute(std::string_view sql)
         }
         else
             LOG_DEBUG("sql.sql", "[{} ms] SQL: {}", getMSTimeDiff(_s, getMSTime()), sql);
+
+        TrackExecution(DATABASE_STATISTICS_ADHOC, start, [sql] { return sql; });
     }
 
     return true;
@@ -215,6 +232,7 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    TimePoint start = std::chrono::steady_clock::now();
 
 #if MYSQL_VERSION_ID >= 80300
     if (mysql_stmt_bind_named_param(msql_STMT, msql_BIND, m_mStmt->GetParameterCount(), nullptr))
@@ -246,6 +264,8 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
 
     LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
 
+    TrackExecution(DATABASE_STATISTICS_STATEMENT + index, start, [m_mStmt] { return m_mStmt->getQueryString(); });
+
     m_mStmt->ClearParameters();
     return true;
 }
@@ -267,6 +287,7 @@ bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    TimePoint start = std::chrono::steady_clock::now();
 
 #if MYSQL_VERSION_ID >= 80300
     if (mysql_stmt_bind_named_param(msql_STMT, msql_BIND, m_mStmt->GetParameterCount(), nullptr))
@@ -298,6 +319,8 @@ bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement
 
     LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
 
+    TrackExecution(DATABASE_STATISTICS_STATEMENT + index, start, [m_mStmt] { return m_mStmt->getQueryString(); });
+
     m_mStmt->ClearParameters();
 
     *pResult = reinterpret_cast<MySQLResult*>(mysql_stmt_result_metadata(msql_STMT));
@@ -330,6 +353,7 @@ bool MySQLConnection::_Query(std::string_view sql, MySQLResult** pResult, MySQLF
 
     {
         uint32 _s = getMSTime();
+        TimePoint start = std::chrono::steady_clock::now();
 
         if (mysql_query(m_Mysql, std::string(sql).c_str()))
         {
@@ -345,6 +369,8 @@ bool MySQLConnection::_Query(std::string_view sql, MySQLResult** pResult, MySQLF
         else
             LOG_DEBUG("sql.sql", "[{} ms] SQL: {}", getMSTimeDiff(_s, getMSTime()), sql);
 
+        TrackExecution(DATABASE_STATISTICS_ADHOC, start, [sql] { return sql; });
+
         *pResult = reinterpret_cast<MySQLResult*>(mysql_store_result(m_Mysql));
         *pRowCount = mysql_affected_rows(m_Mysql);
         *pFieldCount = mysql_field_count(m_Mysql);
@@ -504,6 +530,9 @@ MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
 
 void MySQLConnection::PrepareStatement(uint32 index, std::string_view sql, ConnectionFlags flags)
 {
+    if (m_statistics && !m_reconnecting)
+        m_statistics->SetStatementQuery(index, sql);
+
     // Check if specified query should be prepared on this connection
     // i.e. don't prepare async statements on synchronous connections
     // to save memory that will not be used.
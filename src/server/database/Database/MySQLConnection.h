@@ -20,6 +20,7 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
+#include "Duration.h"
 #include <map>
 #include <mutex>
 #include <string>
@@ -28,6 +29,7 @@
 template <typename T>
 class ProducerConsumerQueue;
 
+class DatabaseStatistics;
 class DatabaseWorker;
 class MySQLPreparedStatement;
 class SQLOperation;
@@ -84,6 +86,10 @@ public:
 
     uint32 GetLastError();
 
+    //! Counters of the pool the connection belongs to, null for connections outside of a pool
+    [[nodiscard]] DatabaseStatistics* GetStatistics() const { return m_statistics; }
+    void SetStatistics(DatabaseStatistics* statistics) { m_statistics = statistics; }
+
 protected:
     /// Tries to acquire lock. If lock is acquired by another thread
     /// the calling parent will just try another connection
@@ -103,11 +109,16 @@ protected:
     typedef std::vector<std::unique_ptr<MySQLPreparedStatement>> PreparedStatementContainer;
 
     PreparedStatementContainer m_stmts; //! PreparedStatements storage
+    DatabaseStatistics* m_statistics;   //! Set by the pool before any operation is queued
     bool m_reconnecting;  //! Are we reconnecting?
     bool m_prepareError;  //! Was there any error while preparing statements?
     MySQLHandle* m_Mysql; //! MySQL Handle.
 
 private:
+    //! Counts the execution of a statement and logs it if it was slow, queryText is only called then
+    template<typename QueryText>
+    void TrackExecution(uint32 slot, TimePoint start, QueryText&& queryText);
+
     ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue shared with other asynchronous connections.
     std::unique_ptr<DatabaseWorker> m_worker;           //! Core worker task.
     MySQLConnectionInfo& m_connectionInfo;              //! Connection info (used for logging)
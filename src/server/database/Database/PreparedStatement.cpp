@@ -28,6 +28,26 @@ PreparedStatementBase::PreparedStatementBase(uint32 index, uint8 capacity) :
 
 PreparedStatementBase::~PreparedStatementBase() { }
 
+std::size_t PreparedStatementBase::GetDataSize() const
+{
+    std::size_t size = 0;
+    for (PreparedStatementData const& parameter : statement_data)
+    {
+        size += std::visit([](auto const& value) -> std::size_t
+        {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<uint8>>)
+                return value.size();
+            else if constexpr (std::is_same_v<T, std::nullptr_t>)
+                return 0;
+            else
+                return sizeof(T);
+        }, parameter.data);
+    }
+
+    return size;
+}
+
 //- Bind to buffer
 template<typename T>
 Acore::Types::is_non_string_view_v<T> PreparedStatementBase::SetValidData(const uint8 index, T const& value)
@@ -67,6 +67,7 @@ struct PreparedStatementData
 class AC_DATABASE_API PreparedStatementBase
 {
 friend class PreparedStatementTask;
+friend class MultiRowStatement;
 
 public:
     explicit PreparedStatementBase(uint32 index, uint8 capacity);
@@ -123,6 +124,9 @@ public:
     [[nodiscard]] uint32 GetIndex() const { return m_index; }
     [[nodiscard]] std::vector<PreparedStatementData> const& GetParameters() const { return statement_data; }
 
+    /// Size of the bound parameters in bytes, strings and binaries count their length
+    [[nodiscard]] std::size_t GetDataSize() const;
+
 protected:
     template<typename T>
     Acore::Types::is_non_string_view_v<T> SetValidData(const uint8 index, T const& value);
@@ -173,6 +177,7 @@ public:
     ~PreparedStatementTask() override;
 
     bool Execute() override;
+    uint32 GetStatisticsSlot() const override { return DATABASE_STATISTICS_STATEMENT + m_stmt->GetIndex(); }
     PreparedQueryResultFuture GetFuture() { return m_result->get_future(); }
 
 protected:
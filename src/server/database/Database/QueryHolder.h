@@ -58,6 +58,7 @@ public:
     ~SQLQueryHolderTask();
 
     bool Execute() override;
+    uint32 GetStatisticsSlot() const override { return DATABASE_STATISTICS_QUERY_HOLDER; }
     QueryResultHolderFuture GetFuture() { return m_result.get_future(); }
 
 private:
@@ -21,6 +21,7 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
+#include <cstring>
 
 namespace
 {
@@ -168,7 +169,8 @@ ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, u
     _rowCount(rowCount),
     _fieldCount(fieldCount),
     _result(result),
-    _fields(fields)
+    _fields(fields),
+    _rowsOffset(0)
 {
     _fieldMetadata.resize(_fieldCount);
     _currentRow = new Field[_fieldCount];
@@ -180,6 +182,21 @@ ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, u
     }
 }
 
+ResultSet::ResultSet(std::shared_ptr<ResultSetRows const> rows) :
+    _fieldMetadata(rows->Fields),
+    _rowCount(rows->RowCount),
+    _fieldCount(uint32(rows->Fields.size())),
+    _result(nullptr),
+    _fields(nullptr),
+    _rows(std::move(rows)),
+    _rowsOffset(0)
+{
+    _currentRow = new Field[_fieldCount];
+
+    for (uint32 i = 0; i < _fieldCount; i++)
+        _currentRow[i].SetMetadata(&_fieldMetadata[i]);
+}
+
 ResultSet::~ResultSet()
 {
     CleanUp();
@@ -189,6 +206,9 @@ bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (_rows)
+        return NextStoredRow();
+
     if (!_result)
         return false;
 
@@ -213,10 +233,38 @@ bool ResultSet::NextRow()
     return true;
 }
 
+bool ResultSet::NextStoredRow()
+{
+    std::string_view data = _rows->Data;
+    if (_rowsOffset >= data.size())
+    {
+        CleanUp();
+        return false;
+    }
+
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        uint32 length;
+        memcpy(&length, data.data() + _rowsOffset, sizeof(length));
+        _rowsOffset += sizeof(length);
+
+        if (length == ResultSetRows::NULL_LENGTH)
+        {
+            _currentRow[i].SetStructuredValue(nullptr, 0);
+            continue;
+        }
+
+        _currentRow[i].SetStructuredValue(data.data() + _rowsOffset, length);
+        _rowsOffset += length + 1;
+    }
+
+    return true;
+}
+
 std::string ResultSet::GetFieldName(uint32 index) const
 {
     ASSERT(index < _fieldCount);
-    return _fields[index].name;
+    return _fieldMetadata[index].Alias;
 }
 
 void ResultSet::CleanUp()
@@ -227,6 +275,8 @@ void ResultSet::CleanUp()
         _currentRow = nullptr;
     }
 
+    _rows.reset();
+
     if (_result)
     {
         mysql_free_result(_result);
@@ -245,6 +295,66 @@ void ResultSet::AssertRows(std::size_t sizeRows)
     ASSERT(sizeRows == _fieldCount);
 }
 
+std::shared_ptr<ResultSetRows> ResultSetRows::Read(ResultSet& result)
+{
+    std::shared_ptr<ResultSetRows> rows = std::make_shared<ResultSetRows>();
+    uint32 fieldCount = result.GetFieldCount();
+    for (uint32 i = 0; i < fieldCount; ++i)
+        rows->Fields.push_back(result.GetFieldMetadata(i));
+
+    std::shared_ptr<std::string> data = std::make_shared<std::string>();
+    do
+    {
+        Field* fields = result.Fetch();
+        for (uint32 i = 0; i < fieldCount; ++i)
+        {
+            uint32 length = ResultSetRows::NULL_LENGTH;
+            std::string_view value;
+            if (!fields[i].IsNull())
+            {
+                value = fields[i].Get<std::string_view>();
+                length = uint32(value.size());
+            }
+
+            data->append(reinterpret_cast<char const*>(&length), sizeof(length));
+            if (length != ResultSetRows::NULL_LENGTH)
+                data->append(value).push_back('\0');
+        }
+
+        ++rows->RowCount;
+    } while (result.NextRow());
+
+    rows->Data = *data;
+    rows->Storage = std::move(data);
+    return rows;
+}
+
+bool ResultSetRows::IsValid() const
+{
+    std::size_t offset = 0;
+    for (uint64 row = 0; row < RowCount; ++row)
+    {
+        for (std::size_t i = 0; i < Fields.size(); ++i)
+        {
+            uint32 length;
+            if (Data.size() - offset < sizeof(length))
+                return false;
+
+            memcpy(&length, Data.data() + offset, sizeof(length));
+            offset += sizeof(length);
+            if (length == NULL_LENGTH)
+                continue;
+
+            if (Data.size() - offset <= length || Data[offset + length] != '\0')
+                return false;
+
+            offset += length + 1;
+        }
+    }
+
+    return offset == Data.size();
+}
+
 PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount) :
     m_rowCount(rowCount),
     m_rowPosition(0),
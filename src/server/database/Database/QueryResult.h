@@ -21,6 +21,8 @@
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
 #include "Field.h"
+#include <memory>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -45,10 +47,33 @@ private:
     pointer _ptr;
 };
 
+/**
+ * @brief Rows of a text protocol result kept outside of the MySQL client library, e.g. in a cache file.
+ *
+ * Data holds every field of every row as a uint32 length (NULL_LENGTH for NULL), the value bytes and a
+ * terminating '\0', in row order.
+ */
+struct AC_DATABASE_API ResultSetRows
+{
+    static constexpr uint32 NULL_LENGTH = 0xFFFFFFFF;
+
+    std::vector<QueryResultFieldMetadata> Fields;
+    uint64 RowCount = 0;
+    std::string_view Data;
+    std::shared_ptr<void const> Storage;    // keeps the memory of Data alive
+
+    /// Reads the remaining rows of result, starting with the current one
+    static std::shared_ptr<ResultSetRows> Read(ResultSet& result);
+
+    /// Checks that Data holds exactly RowCount rows of Fields.size() fields
+    [[nodiscard]] bool IsValid() const;
+};
+
 class AC_DATABASE_API ResultSet
 {
 public:
     ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount);
+    explicit ResultSet(std::shared_ptr<ResultSetRows const> rows);
     ~ResultSet();
 
     bool NextRow();
@@ -56,6 +81,8 @@ public:
     [[nodiscard]] uint32 GetFieldCount() const { return _fieldCount; }
     [[nodiscard]] std::string GetFieldName(uint32 index) const;
 
+    [[nodiscard]] QueryResultFieldMetadata const& GetFieldMetadata(uint32 index) const { return _fieldMetadata[index]; }
+
     [[nodiscard]] Field* Fetch() const { return _currentRow; }
     Field const& operator[](std::size_t index) const;
 
@@ -87,9 +114,12 @@ protected:
 private:
     void CleanUp();
     void AssertRows(std::size_t sizeRows);
+    bool NextStoredRow();
 
     MySQLResult* _result;
     MySQLField* _fields;
+    std::shared_ptr<ResultSetRows const> _rows;
+    std::size_t _rowsOffset;
 
     ResultSet(ResultSet const& right) = delete;
     ResultSet& operator=(ResultSet const& right) = delete;
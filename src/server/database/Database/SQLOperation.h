@@ -19,7 +19,9 @@
 #define _SQLOPERATION_H
 
 #include "DatabaseEnvFwd.h"
+#include "DatabaseStatistics.h"
 #include "Define.h"
+#include "Duration.h"
 #include <variant>
 
 //- Type specifier of our element data
@@ -52,8 +54,11 @@ public:
 
     virtual bool Execute() = 0;
     virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
+    /// DatabaseStatistics slot the queue wait of the operation is accounted to
+    virtual uint32 GetStatisticsSlot() const { return DATABASE_STATISTICS_ADHOC; }
 
     MySQLConnection* m_conn{nullptr};
+    TimePoint m_enqueueTime;
 
 private:
     SQLOperation(SQLOperation const& right) = delete;
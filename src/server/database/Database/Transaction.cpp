@@ -47,6 +47,21 @@ void TransactionBase::AppendPreparedStatement(PreparedStatementBase* stmt)
     m_queries.emplace_back(data);
 }
 
+std::size_t TransactionBase::GetDataSize(std::size_t index /*= 0*/) const
+{
+    std::size_t size = 0;
+    for (; index < m_queries.size(); ++index)
+    {
+        SQLElementData const& data = m_queries[index];
+        if (data.type == SQL_ELEMENT_PREPARED)
+            size += std::get<PreparedStatementBase*>(data.element)->GetDataSize();
+        else
+            size += std::get<std::string>(data.element).size();
+    }
+
+    return size;
+}
+
 void TransactionBase::Cleanup()
 {
     // This might be called by explicit calls to Cleanup or by the auto-destructor
@@ -49,6 +49,9 @@ public:
 
     [[nodiscard]] std::size_t GetSize() const { return m_queries.size(); }
 
+    /// Bytes sent for the queries from index on, the text of ad-hoc queries and the parameters of prepared ones
+    [[nodiscard]] std::size_t GetDataSize(std::size_t index = 0) const;
+
 protected:
     void AppendPreparedStatement(PreparedStatementBase* statement);
     void Cleanup();
@@ -83,6 +86,8 @@ public:
     TransactionTask(std::shared_ptr<TransactionBase> trans) : m_trans(std::move(trans)) { }
     ~TransactionTask() override = default;
 
+    uint32 GetStatisticsSlot() const override { return DATABASE_STATISTICS_TRANSACTION; }
+
 protected:
     bool Execute() override;
     int TryExecute();
@@ -20,14 +20,21 @@
 #include "CharacterCache.h"
 #include "DBCStores.h"
 #include "GameTime.h"
+#include "Metric.h"
 #include "Player.h"
 
-AuctionHouseWorkerThread::AuctionHouseWorkerThread(ProducerConsumerQueue<AuctionSearcherRequest*>* requestQueue, MPSCQueue<AuctionSearcherResponse>* responseQueue)
+namespace
+{
+    AuctionSearchSnapshot::PostingList const EmptyPostingList;
+}
+
+AuctionHouseWorkerThread::AuctionHouseWorkerThread(ProducerConsumerQueue<AuctionSearcherRequest*>* requestQueue, MPSCQueue<AuctionSearcherResponse>* responseQueue, AuctionSearchResultCache* resultCache)
 {
-    _workerThread = std::thread(&AuctionHouseWorkerThread::Run, this);
     _requestQueue = requestQueue;
     _responseQueue = responseQueue;
+    _resultCache = resultCache;
     _stopped = false;
+    _workerThread = std::thread(&AuctionHouseWorkerThread::Run, this);
 }
 
 void AuctionHouseWorkerThread::Stop()
@@ -36,113 +43,56 @@ void AuctionHouseWorkerThread::Stop()
     _workerThread.join();
 }
 
-void AuctionHouseWorkerThread::AddAuctionSearchUpdateToQueue(std::shared_ptr<AuctionSearcherUpdate> const auctionSearchUpdate)
-{
-    _auctionUpdatesQueue.add(auctionSearchUpdate);
-}
-
 void AuctionHouseWorkerThread::Run()
 {
     while (!_stopped)
     {
-        std::this_thread::sleep_for(Milliseconds(25));
+        // the requests come from the snapshot builder, nothing to do until it hands one over
+        AuctionSearcherRequest* searchRequest = nullptr;
+        _requestQueue->WaitAndPop(searchRequest);
+
+        // only returns without a request once the queue was cancelled
+        if (!searchRequest)
+            break;
 
-        ProcessSearchUpdates();
-        ProcessSearchRequests();
+        ProcessSearchRequest(searchRequest);
     }
 }
 
-void AuctionHouseWorkerThread::ProcessSearchUpdates()
+void AuctionHouseWorkerThread::ProcessSearchRequest(AuctionSearcherRequest* searchRequest)
 {
-    std::shared_ptr<AuctionSearcherUpdate> auctionSearchUpdate;
-    while (_auctionUpdatesQueue.next(auctionSearchUpdate))
+    switch (searchRequest->requestType)
     {
-        switch (auctionSearchUpdate->updateType)
-        {
-        case AuctionSearcherUpdate::Type::ADD:
-        {
-            std::shared_ptr<AuctionSearchAdd> const auctionAdd = std::static_pointer_cast<AuctionSearchAdd>(auctionSearchUpdate);
-            SearchUpdateAdd(*auctionAdd.get());
-            break;
-        }
-        case AuctionSearcherUpdate::Type::REMOVE:
-        {
-            std::shared_ptr<AuctionSearchRemove> const auctionRemove = std::static_pointer_cast<AuctionSearchRemove>(auctionSearchUpdate);
-            SearchUpdateRemove(*auctionRemove.get());
-            break;
-        }
-        case AuctionSearcherUpdate::Type::UPDATE_BID:
-        {
-            std::shared_ptr<AuctionSearchUpdateBid> const auctionUpdateBid = std::static_pointer_cast<AuctionSearchUpdateBid>(auctionSearchUpdate);
-            SearchUpdateBid(*auctionUpdateBid.get());
-            break;
-        }
-        default:
-            break;
-        }
+    case AuctionSearcherRequest::Type::LIST:
+    {
+        AuctionSearchListRequest const* searchListRequest = static_cast<AuctionSearchListRequest*>(searchRequest);
+        SearchListRequest(*searchListRequest);
+        break;
     }
-}
-
-void AuctionHouseWorkerThread::SearchUpdateAdd(AuctionSearchAdd const& auctionAdd)
-{
-    SearchableAuctionEntriesMap& searchableAuctionMap = GetSearchableAuctionMap(auctionAdd.listFaction);
-    searchableAuctionMap.insert(std::make_pair(auctionAdd.searchableAuctionEntry->Id, auctionAdd.searchableAuctionEntry));
-}
-
-void AuctionHouseWorkerThread::SearchUpdateRemove(AuctionSearchRemove const& auctionRemove)
-{
-    SearchableAuctionEntriesMap& searchableAuctionMap = GetSearchableAuctionMap(auctionRemove.listFaction);
-    searchableAuctionMap.erase(auctionRemove.auctionId);
-}
-
-void AuctionHouseWorkerThread::SearchUpdateBid(AuctionSearchUpdateBid const& auctionUpdateBid)
-{
-    SearchableAuctionEntriesMap const& searchableAuctionMap = GetSearchableAuctionMap(auctionUpdateBid.listFaction);
-    SearchableAuctionEntriesMap::const_iterator itr = searchableAuctionMap.find(auctionUpdateBid.auctionId);
-    if (itr != searchableAuctionMap.end())
+    case AuctionSearcherRequest::Type::OWNER_LIST:
     {
-        itr->second->bid = auctionUpdateBid.bid;
-        itr->second->bidderGuid = auctionUpdateBid.bidderGuid;
+        AuctionSearchOwnerListRequest const* searchOwnerListRequest = static_cast<AuctionSearchOwnerListRequest*>(searchRequest);
+        SearchOwnerListRequest(*searchOwnerListRequest);
+        break;
     }
-}
-
-void AuctionHouseWorkerThread::ProcessSearchRequests()
-{
-    AuctionSearcherRequest* searchRequest;
-    while (_requestQueue->Pop(searchRequest))
+    case AuctionSearcherRequest::Type::BIDDER_LIST:
     {
-        switch (searchRequest->requestType)
-        {
-        case AuctionSearcherRequest::Type::LIST:
-        {
-            AuctionSearchListRequest const* searchListRequest = static_cast<AuctionSearchListRequest*>(searchRequest);
-            SearchListRequest(*searchListRequest);
-            break;
-        }
-        case AuctionSearcherRequest::Type::OWNER_LIST:
-        {
-            AuctionSearchOwnerListRequest const* searchOwnerListRequest = static_cast<AuctionSearchOwnerListRequest*>(searchRequest);
-            SearchOwnerListRequest(*searchOwnerListRequest);
-            break;
-        }
-        case AuctionSearcherRequest::Type::BIDDER_LIST:
-        {
-            AuctionSearchBidderListRequest const* searchBidderListRequest = static_cast<AuctionSearchBidderListRequest*>(searchRequest);
-            SearchBidderListRequest(*searchBidderListRequest);
-            break;
-        }
-        default:
-            break;
-        }
-
-        delete searchRequest;
+        AuctionSearchBidderListRequest const* searchBidderListRequest = static_cast<AuctionSearchBidderListRequest*>(searchRequest);
+        SearchBidderListRequest(*searchBidderListRequest);
+        break;
     }
+    default:
+        break;
+    }
+
+    delete searchRequest;
 }
 
 void AuctionHouseWorkerThread::SearchListRequest(AuctionSearchListRequest const& searchListRequest)
 {
-    SearchableAuctionEntriesMap const& searchableAuctionMap = GetSearchableAuctionMap(searchListRequest.listFaction);
+    AuctionSearchSnapshot const& snapshot = *searchListRequest.snapshot;
     uint32 count = 0, totalCount = 0;
+    TimePoint const start = std::chrono::steady_clock::now();
 
     AuctionSearcherResponse* searchResponse = new AuctionSearcherResponse();
     searchResponse->playerGuid = searchListRequest.playerInfo.playerGuid;
@@ -151,48 +101,45 @@ void AuctionHouseWorkerThread::SearchListRequest(AuctionSearchListRequest const&
 
     if (!searchListRequest.searchInfo.getAll)
     {
-        SortableAuctionEntriesList auctionEntries;
-        BuildListAuctionItems(searchListRequest, auctionEntries, searchableAuctionMap);
+        bool cached = false;
+        std::shared_ptr<AuctionSearchResult> result = GetSearchResult(searchListRequest, start, cached);
+        std::lock_guard<std::mutex> guard(result->lock);
 
-        if (!searchListRequest.searchInfo.sorting.empty() && auctionEntries.size() > MAX_AUCTIONS_PER_PAGE)
-        {
-            AuctionSorter sorter(&searchListRequest.searchInfo.sorting, searchListRequest.playerInfo.loc_idx);
-            std::sort(auctionEntries.begin(), auctionEntries.end(), sorter);
-        }
+        SortableAuctionEntriesList& auctionEntries = result->entries;
+        std::size_t const listfrom = std::min<std::size_t>(searchListRequest.searchInfo.listfrom, auctionEntries.size());
+        std::size_t const listto = std::min<std::size_t>(listfrom + MAX_AUCTIONS_PER_PAGE, auctionEntries.size());
 
-        SortableAuctionEntriesList::const_iterator itr = auctionEntries.begin();
-        if (searchListRequest.searchInfo.listfrom)
-        {
-            if (searchListRequest.searchInfo.listfrom > auctionEntries.size())
-                itr = auctionEntries.end();
-            else
-                itr += searchListRequest.searchInfo.listfrom;
-        }
+        // Only sort as far as the requested page, the entries of later pages are selected when they are requested
+        result->SortEntries(listto, AuctionSorter(&searchListRequest.searchInfo.sorting, searchListRequest.playerInfo.loc_idx));
 
-        for (; itr != auctionEntries.end(); ++itr)
+        for (std::size_t i = listfrom; i < listto; ++i)
         {
-            (*itr)->BuildAuctionInfo(searchResponse->packet);
-
-            if (++count >= MAX_AUCTIONS_PER_PAGE)
-                break;
+            auctionEntries[i]->BuildAuctionInfo(searchResponse->packet);
+            ++count;
         }
 
         totalCount = auctionEntries.size();
+
+        static MetricSeriesId const hitMetric = sMetric->RegisterSeries("auction_search_cache_hit");
+        static MetricSeriesId const hitTimeMetric = sMetric->RegisterSeries("auction_search_time", { METRIC_TAG("cache", "hit") }, MetricSeriesType::Histogram);
+        static MetricSeriesId const missTimeMetric = sMetric->RegisterSeries("auction_search_time", { METRIC_TAG("cache", "miss") }, MetricSeriesType::Histogram);
+
+        METRIC_RECORD(hitMetric, cached ? 1 : 0);
+        METRIC_RECORD(cached ? hitTimeMetric : missTimeMetric, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start).count());
     }
     else
     {
         // getAll handling
-        for (auto const& pair : searchableAuctionMap)
+        for (uint32 position = 0; position < snapshot.GetSize(); ++position)
         {
-            std::shared_ptr<SearchableAuctionEntry> const& Aentry = pair.second;
             ++count;
-            Aentry->BuildAuctionInfo(searchResponse->packet);
+            snapshot.GetEntry(position).BuildAuctionInfo(searchResponse->packet);
 
             if (count >= MAX_GETALL_RETURN)
                 break;
         }
 
-        totalCount = searchableAuctionMap.size();
+        totalCount = snapshot.GetSize();
     }
 
     searchResponse->packet.put<uint32>(0, count);
@@ -204,7 +151,7 @@ void AuctionHouseWorkerThread::SearchListRequest(AuctionSearchListRequest const&
 
 void AuctionHouseWorkerThread::SearchOwnerListRequest(AuctionSearchOwnerListRequest const& searchOwnerListRequest)
 {
-    SearchableAuctionEntriesMap const& searchableAuctionMap = GetSearchableAuctionMap(searchOwnerListRequest.listFaction);
+    AuctionSearchSnapshot const& snapshot = *searchOwnerListRequest.snapshot;
 
     AuctionSearcherResponse* searchResponse = new AuctionSearcherResponse();
     searchResponse->playerGuid = searchOwnerListRequest.ownerGuid;
@@ -214,13 +161,9 @@ void AuctionHouseWorkerThread::SearchOwnerListRequest(AuctionSearchOwnerListRequ
     uint32 count = 0;
     uint32 totalcount = 0;
 
-    for (auto const& pair : searchableAuctionMap)
+    for (uint32 const position : snapshot.GetOwnerEntries(searchOwnerListRequest.ownerGuid))
     {
-        if (pair.second->ownerGuid != searchOwnerListRequest.ownerGuid)
-            continue;
-
-        std::shared_ptr<SearchableAuctionEntry> const& auctionEntry = pair.second;
-        auctionEntry->BuildAuctionInfo(searchResponse->packet);
+        snapshot.GetEntry(position).BuildAuctionInfo(searchResponse->packet);
         ++count;
         ++totalcount;
     }
@@ -234,7 +177,7 @@ void AuctionHouseWorkerThread::SearchOwnerListRequest(AuctionSearchOwnerListRequ
 
 void AuctionHouseWorkerThread::SearchBidderListRequest(AuctionSearchBidderListRequest const& searchBidderListRequest)
 {
-    SearchableAuctionEntriesMap const& searchableAuctionMap = GetSearchableAuctionMap(searchBidderListRequest.listFaction);
+    AuctionSearchSnapshot const& snapshot = *searchBidderListRequest.snapshot;
 
     AuctionSearcherResponse* searchResponse = new AuctionSearcherResponse();
     searchResponse->playerGuid = searchBidderListRequest.ownerGuid;
@@ -246,23 +189,18 @@ void AuctionHouseWorkerThread::SearchBidderListRequest(AuctionSearchBidderListRe
 
     for (uint32 const auctionId : searchBidderListRequest.outbiddedAuctionIds)
     {
-        SearchableAuctionEntriesMap::const_iterator itr = searchableAuctionMap.find(auctionId);
-        if (itr == searchableAuctionMap.end())
+        SearchableAuctionEntry const* auctionEntry = snapshot.FindEntry(auctionId);
+        if (!auctionEntry)
             continue;
 
-        std::shared_ptr<SearchableAuctionEntry> const& auctionEntry = itr->second;
         auctionEntry->BuildAuctionInfo(searchResponse->packet);
         ++count;
         ++totalcount;
     }
 
-    for (auto const& pair : searchableAuctionMap)
+    for (uint32 const position : snapshot.GetBidderEntries(searchBidderListRequest.ownerGuid))
     {
-        if (pair.second->bidderGuid != searchBidderListRequest.ownerGuid)
-            continue;
-
-        std::shared_ptr<SearchableAuctionEntry> const& auctionEntry = pair.second;
-        auctionEntry->BuildAuctionInfo(searchResponse->packet);
+        snapshot.GetEntry(position).BuildAuctionInfo(searchResponse->packet);
         ++count;
         ++totalcount;
     }
@@ -274,7 +212,37 @@ void AuctionHouseWorkerThread::SearchBidderListRequest(AuctionSearchBidderListRe
     _responseQueue->Enqueue(searchResponse);
 }
 
-void AuctionHouseWorkerThread::BuildListAuctionItems(AuctionSearchListRequest const& searchRequest, SortableAuctionEntriesList& auctionEntries, SearchableAuctionEntriesMap const& auctionMap) const
+std::shared_ptr<AuctionSearchResult> AuctionHouseWorkerThread::GetSearchResult(AuctionSearchListRequest const& searchListRequest, TimePoint now, bool& cached)
+{
+    if (_resultCache->IsEnabled())
+    {
+        if (std::shared_ptr<AuctionSearchResult> result = _resultCache->Find(searchListRequest, now))
+        {
+            cached = true;
+            return result;
+        }
+    }
+
+    cached = false;
+
+    std::shared_ptr<AuctionSearchResult> result = std::make_shared<AuctionSearchResult>();
+    result->snapshot = searchListRequest.snapshot;
+    result->listFaction = searchListRequest.listFaction;
+    result->loc_idx = searchListRequest.playerInfo.loc_idx;
+    result->searchInfo = searchListRequest.searchInfo;
+    BuildListAuctionItems(searchListRequest, result->entries, *result->snapshot);
+
+    // Results fitting on one page are sent unsorted, the client sorts them itself
+    if (searchListRequest.searchInfo.sorting.empty() || result->entries.size() <= MAX_AUCTIONS_PER_PAGE)
+        result->sortedCount = result->entries.size();
+
+    if (_resultCache->IsEnabled())
+        _resultCache->Store(searchListRequest.playerInfo.playerGuid, result, now);
+
+    return result;
+}
+
+void AuctionHouseWorkerThread::BuildListAuctionItems(AuctionSearchListRequest const& searchRequest, SortableAuctionEntriesList& auctionEntries, AuctionSearchSnapshot const& snapshot) const
 {
     // pussywizard: optimization, this is a simplified case for the default search state (no filters)
     if (searchRequest.searchInfo.itemClass == 0xffffffff && searchRequest.searchInfo.itemSubClass == 0xffffffff
@@ -282,66 +250,524 @@ void AuctionHouseWorkerThread::BuildListAuctionItems(AuctionSearchListRequest co
         && searchRequest.searchInfo.levelmin == 0x00 && searchRequest.searchInfo.levelmax == 0x00
         && searchRequest.searchInfo.usable == 0x00 && searchRequest.searchInfo.wsearchedname.empty())
     {
-        for (auto const& pair : auctionMap)
-            auctionEntries.push_back(pair.second.get());
+        auctionEntries.reserve(snapshot.GetSize());
+        for (uint32 position = 0; position < snapshot.GetSize(); ++position)
+            auctionEntries.push_back(&snapshot.GetEntry(position));
 
         return;
     }
 
-    for (auto const& pair : auctionMap)
-    {
-        std::shared_ptr<SearchableAuctionEntry> const& Aentry = pair.second;
-        SearchableAuctionEntryItem const& Aitem = Aentry->item;
-        ItemTemplate const* proto = Aitem.itemTemplate;
+    AuctionSearchSnapshot::PostingList positions;
+    snapshot.FindEntries(searchRequest.searchInfo, searchRequest.playerInfo.loc_idx, positions);
 
-        if (searchRequest.searchInfo.itemClass != 0xffffffff && proto->Class != searchRequest.searchInfo.itemClass)
-            continue;
+    for (uint32 const position : positions)
+    {
+        SearchableAuctionEntry const& Aentry = snapshot.GetEntry(position);
+        SearchableAuctionEntryItem const& Aitem = Aentry.item;
 
-        if (searchRequest.searchInfo.itemSubClass != 0xffffffff && proto->SubClass != searchRequest.searchInfo.itemSubClass)
-            continue;
+        if (searchRequest.searchInfo.usable != 0x00)
+        {
+            if (!searchRequest.playerInfo.usablePlayerInfo.value().PlayerCanUseItem(Aitem.itemTemplate))
+                continue;
+        }
 
-        if (searchRequest.searchInfo.inventoryType != 0xffffffff && proto->InventoryType != searchRequest.searchInfo.inventoryType)
+        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+        // No need to do any of this if no search term was entered
+        if (!searchRequest.searchInfo.wsearchedname.empty())
         {
-            // xinef: exception, robes are counted as chests
-            if (searchRequest.searchInfo.inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
+            if (Aitem.itemName[searchRequest.playerInfo.loc_idx].find(searchRequest.searchInfo.wsearchedname) == std::wstring::npos)
                 continue;
         }
 
-        if (searchRequest.searchInfo.quality != 0xffffffff && proto->Quality < searchRequest.searchInfo.quality)
-            continue;
+        auctionEntries.push_back(&Aentry);
+    }
+}
+
+AuctionSearchSnapshot::AuctionSearchSnapshot(SearchableAuctionEntriesMap const& auctions, std::shared_ptr<AuctionItemNameIndex const> nameIndex, uint32 nameLocaleMask) :
+    _maxQuality(0), _maxRequiredLevel(0), _nameIndex(std::move(nameIndex)), _nameLocaleMask(nameLocaleMask)
+{
+    _entries.reserve(auctions.size());
+    _itemFilterFields.reserve(auctions.size());
+
+    for (auto const& [auctionId, entry] : auctions)
+    {
+        ItemTemplate const* proto = entry->item.itemTemplate;
+        uint32 const position = _entries.size();
+
+        ItemFilterFields fields;
+        fields.itemClass = uint8(std::min<uint32>(proto->Class, 0xFF));
+        fields.itemSubClass = uint8(std::min<uint32>(proto->SubClass, 0xFF));
+        fields.inventoryType = uint8(std::min<uint32>(proto->InventoryType, 0xFF));
+        fields.quality = uint8(std::min<uint32>(proto->Quality, 0xFF));
+        fields.requiredLevel = uint8(std::min<uint32>(proto->RequiredLevel, 0xFF));
+
+        _byItemClass[fields.itemClass].push_back(position);
+        _byItemSubClass[(fields.itemClass << 8) | fields.itemSubClass].push_back(position);
+        _byInventoryType[fields.inventoryType].push_back(position);
+        _byQuality[fields.quality].push_back(position);
+        _byRequiredLevel[fields.requiredLevel].push_back(position);
+        _maxQuality = std::max(_maxQuality, fields.quality);
+        _maxRequiredLevel = std::max(_maxRequiredLevel, fields.requiredLevel);
+
+        for (uint32 locale = 0; locale < TOTAL_LOCALES; ++locale)
+            if (_nameLocaleMask & (1 << locale))
+                _byItemName[locale][entry->item.itemNameIds[locale]].push_back(position);
+
+        _byOwner[entry->ownerGuid].push_back(position);
+        if (entry->bidderGuid)
+            _byBidder[entry->bidderGuid].push_back(position);
+
+        _entries.push_back(entry);
+        _itemFilterFields.push_back(fields);
+    }
+}
+
+SearchableAuctionEntry const* AuctionSearchSnapshot::FindEntry(uint32 auctionId) const
+{
+    auto itr = std::lower_bound(_entries.begin(), _entries.end(), auctionId, [](std::shared_ptr<SearchableAuctionEntry const> const& entry, uint32 id)
+    {
+        return entry->Id < id;
+    });
+
+    if (itr == _entries.end() || (*itr)->Id != auctionId)
+        return nullptr;
+
+    return itr->get();
+}
+
+void AuctionSearchSnapshot::FindEntries(AuctionHouseSearchInfo const& searchInfo, int locale, PostingList& positions) const
+{
+    // every filter narrows the search to the posting lists of its values, only the smallest set is walked
+    std::vector<PostingList const*> candidates;
+    std::size_t candidateCount = 0;
+    bool indexed = false;
+
+    auto considerPostings = [&](std::vector<PostingList const*> const& lists)
+    {
+        std::size_t count = 0;
+        for (PostingList const* list : lists)
+            count += list->size();
 
-        if (searchRequest.searchInfo.levelmin != 0x00 && (proto->RequiredLevel < searchRequest.searchInfo.levelmin
-            || (searchRequest.searchInfo.levelmax != 0x00 && proto->RequiredLevel > searchRequest.searchInfo.levelmax)))
+        if (!indexed || count < candidateCount)
         {
-            continue;
+            candidates = lists;
+            candidateCount = count;
+            indexed = true;
         }
+    };
 
-        if (searchRequest.searchInfo.usable != 0x00)
+    if (searchInfo.itemClass != 0xffffffff)
+    {
+        if (searchInfo.itemSubClass != 0xffffffff)
+            considerPostings({ &GetPostings(_byItemSubClass, (searchInfo.itemClass << 8) | searchInfo.itemSubClass) });
+        else
+            considerPostings({ &GetPostings(_byItemClass, searchInfo.itemClass) });
+    }
+
+    if (searchInfo.inventoryType != 0xffffffff)
+    {
+        // xinef: exception, robes are counted as chests
+        if (searchInfo.inventoryType == INVTYPE_CHEST)
+            considerPostings({ &GetPostings(_byInventoryType, INVTYPE_CHEST), &GetPostings(_byInventoryType, INVTYPE_ROBE) });
+        else
+            considerPostings({ &GetPostings(_byInventoryType, searchInfo.inventoryType) });
+    }
+
+    if (searchInfo.quality != 0xffffffff)
+    {
+        std::vector<PostingList const*> lists;
+        for (uint32 quality = searchInfo.quality; quality <= _maxQuality; ++quality)
+            lists.push_back(&GetPostings(_byQuality, quality));
+
+        considerPostings(lists);
+    }
+
+    if (searchInfo.levelmin != 0x00)
+    {
+        std::vector<PostingList const*> lists;
+        uint32 levelmax = searchInfo.levelmax != 0x00 ? searchInfo.levelmax : _maxRequiredLevel;
+        for (uint32 level = searchInfo.levelmin; level <= levelmax; ++level)
+            lists.push_back(&GetPostings(_byRequiredLevel, level));
+
+        considerPostings(lists);
+    }
+
+    std::vector<uint32> nameIds;
+    if (locale >= 0 && locale < TOTAL_LOCALES && (_nameLocaleMask & (1 << locale)) && _nameIndex->FindNameIds(searchInfo.wsearchedname, nameIds))
+    {
+        // an entry has one name per locale, so it is in one list at most
+        std::vector<PostingList const*> lists;
+        for (uint32 const nameId : nameIds)
         {
-            if (!searchRequest.playerInfo.usablePlayerInfo.value().PlayerCanUseItem(proto))
-                continue;
+            PostingList const& postings = GetPostings(_byItemName[locale], nameId);
+            if (!postings.empty())
+                lists.push_back(&postings);
         }
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!searchRequest.searchInfo.wsearchedname.empty())
+        considerPostings(lists);
+    }
+
+    if (!indexed)
+    {
+        for (uint32 position = 0; position < _entries.size(); ++position)
+            if (MatchesItemFilters(_itemFilterFields[position], searchInfo))
+                positions.push_back(position);
+
+        return;
+    }
+
+    positions.reserve(candidateCount);
+    for (PostingList const* list : candidates)
+        for (uint32 const position : *list)
+            if (MatchesItemFilters(_itemFilterFields[position], searchInfo))
+                positions.push_back(position);
+
+    // the lists of different values are disjoint, keep the auction id order of a single list
+    if (candidates.size() > 1)
+        std::sort(positions.begin(), positions.end());
+}
+
+AuctionSearchSnapshot::PostingList const& AuctionSearchSnapshot::GetOwnerEntries(ObjectGuid ownerGuid) const
+{
+    auto itr = _byOwner.find(ownerGuid);
+    return itr != _byOwner.end() ? itr->second : EmptyPostingList;
+}
+
+AuctionSearchSnapshot::PostingList const& AuctionSearchSnapshot::GetBidderEntries(ObjectGuid bidderGuid) const
+{
+    auto itr = _byBidder.find(bidderGuid);
+    return itr != _byBidder.end() ? itr->second : EmptyPostingList;
+}
+
+bool AuctionSearchSnapshot::MatchesItemFilters(ItemFilterFields const& fields, AuctionHouseSearchInfo const& searchInfo) const
+{
+    if (searchInfo.itemClass != 0xffffffff && fields.itemClass != searchInfo.itemClass)
+        return false;
+
+    if (searchInfo.itemSubClass != 0xffffffff && fields.itemSubClass != searchInfo.itemSubClass)
+        return false;
+
+    if (searchInfo.inventoryType != 0xffffffff && fields.inventoryType != searchInfo.inventoryType)
+    {
+        // xinef: exception, robes are counted as chests
+        if (searchInfo.inventoryType != INVTYPE_CHEST || fields.inventoryType != INVTYPE_ROBE)
+            return false;
+    }
+
+    if (searchInfo.quality != 0xffffffff && fields.quality < searchInfo.quality)
+        return false;
+
+    if (searchInfo.levelmin != 0x00 && (fields.requiredLevel < searchInfo.levelmin
+        || (searchInfo.levelmax != 0x00 && fields.requiredLevel > searchInfo.levelmax)))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+AuctionSearchSnapshot::PostingList const& AuctionSearchSnapshot::GetPostings(PostingIndex const& index, uint32 key)
+{
+    auto itr = index.find(key);
+    return itr != index.end() ? itr->second : EmptyPostingList;
+}
+
+uint32 AuctionItemNameIndex::GetNameId(std::wstring const& name)
+{
+    auto itr = _nameIds.find(name);
+    if (itr != _nameIds.end())
+        return itr->second;
+
+    std::unique_lock<std::shared_mutex> lock(_lock);
+    uint32 const nameId = _names.size();
+    _names.push_back(name);
+    _trigrams.Add(nameId, name);
+    _nameIds.emplace(name, nameId);
+    return nameId;
+}
+
+bool AuctionItemNameIndex::FindNameIds(std::wstring_view pattern, std::vector<uint32>& nameIds) const
+{
+    std::shared_lock<std::shared_mutex> lock(_lock);
+    if (!_trigrams.FindCandidates(pattern, nameIds))
+        return false;
+
+    // there are few distinct names, checking them here spares checking every auction with them
+    nameIds.erase(std::remove_if(nameIds.begin(), nameIds.end(), [&](uint32 nameId)
+    {
+        return _names[nameId].find(pattern) == std::wstring::npos;
+    }), nameIds.end());
+
+    return true;
+}
+
+bool AuctionSearchResult::IsSameSearch(AuctionSearchListRequest const& searchListRequest) const
+{
+    AuctionHouseSearchInfo const& other = searchListRequest.searchInfo;
+
+    return listFaction == searchListRequest.listFaction && loc_idx == searchListRequest.playerInfo.loc_idx
+        && searchInfo.wsearchedname == other.wsearchedname && searchInfo.levelmin == other.levelmin && searchInfo.levelmax == other.levelmax
+        && searchInfo.usable == other.usable && searchInfo.inventoryType == other.inventoryType && searchInfo.itemClass == other.itemClass
+        && searchInfo.itemSubClass == other.itemSubClass && searchInfo.quality == other.quality && searchInfo.sorting == other.sorting;
+}
+
+void AuctionSearchResult::SortEntries(std::size_t end, AuctionSorter const& sorter)
+{
+    if (end <= sortedCount)
+        return;
+
+    SortableAuctionEntriesList::iterator sortedEnd = entries.begin() + sortedCount;
+    SortableAuctionEntriesList::iterator pageEnd = entries.begin() + end;
+
+    // every entry left after pageEnd sorts after the ones before it, the next page continues from there
+    std::nth_element(sortedEnd, pageEnd, entries.end(), sorter);
+    std::sort(sortedEnd, pageEnd, sorter);
+    sortedCount = end;
+}
+
+std::shared_ptr<AuctionSearchResult> AuctionSearchResultCache::Find(AuctionSearchListRequest const& searchListRequest, TimePoint now)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _results.find(searchListRequest.playerInfo.playerGuid);
+    if (itr == _results.end())
+        return nullptr;
+
+    std::shared_ptr<AuctionSearchResult> result = itr->second;
+
+    // results of outdated snapshots are dropped right away, they keep the whole snapshot alive
+    if (now >= result->expireTime || result->snapshot != searchListRequest.snapshot || IsOutdated(*result))
+    {
+        _results.erase(itr);
+        return nullptr;
+    }
+
+    if (!result->IsSameSearch(searchListRequest))
+        return nullptr;
+
+    result->expireTime = now + Milliseconds(_duration.load(std::memory_order_relaxed));
+    return result;
+}
+
+void AuctionSearchResultCache::Store(ObjectGuid playerGuid, std::shared_ptr<AuctionSearchResult> result, TimePoint now)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    // the snapshot was replaced while the result was built
+    if (IsOutdated(*result))
+    {
+        _results.erase(playerGuid);
+        return;
+    }
+
+    result->expireTime = now + Milliseconds(_duration.load(std::memory_order_relaxed));
+    _results[playerGuid] = std::move(result);
+}
+
+void AuctionSearchResultCache::RemoveExpired(TimePoint now)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    for (auto itr = _results.begin(); itr != _results.end();)
+    {
+        if (now >= itr->second->expireTime || IsOutdated(*itr->second))
+            itr = _results.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+void AuctionSearchResultCache::SetCurrentSnapshot(AuctionHouseFaction faction, AuctionSearchSnapshot const* snapshot)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    AuctionSearchSnapshot const*& currentSnapshot = _currentSnapshot[static_cast<uint8>(faction)];
+    if (currentSnapshot == snapshot)
+        return;
+
+    currentSnapshot = snapshot;
+    for (auto itr = _results.begin(); itr != _results.end();)
+    {
+        if (IsOutdated(*itr->second))
+            itr = _results.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+AuctionSearchSnapshotBuilder::AuctionSearchSnapshotBuilder(ProducerConsumerQueue<AuctionSearcherRequest*>* requestQueue, AuctionSearchResultCache* resultCache) :
+    _nameIndex(std::make_shared<AuctionItemNameIndex>()), _nameLocaleMask(0), _requestQueue(requestQueue), _resultCache(resultCache)
+{
+    _stopped = false;
+    _builderThread = std::thread(&AuctionSearchSnapshotBuilder::Run, this);
+}
+
+void AuctionSearchSnapshotBuilder::Stop()
+{
+    _stopped = true;
+
+    // wakes the builder thread and deletes the requests it did not take yet
+    _pendingRequests.Cancel();
+    _builderThread.join();
+}
+
+void AuctionSearchSnapshotBuilder::AddAuctionSearchUpdateToQueue(std::shared_ptr<AuctionSearcherUpdate> const auctionSearchUpdate)
+{
+    _auctionUpdatesQueue.add(auctionSearchUpdate);
+}
+
+void AuctionSearchSnapshotBuilder::AddSearchRequestToQueue(AuctionSearcherRequest* searchRequest)
+{
+    _pendingRequests.Push(searchRequest);
+}
+
+void AuctionSearchSnapshotBuilder::Run()
+{
+    while (!_stopped)
+    {
+        AuctionSearcherRequest* searchRequest = nullptr;
+        _pendingRequests.WaitAndPop(searchRequest);
+
+        // only returns without a request once the queue was cancelled
+        if (!searchRequest)
+            break;
+
+        ProcessSearchRequests(searchRequest);
+    }
+}
+
+void AuctionSearchSnapshotBuilder::ProcessSearchUpdates()
+{
+    std::shared_ptr<AuctionSearcherUpdate> auctionSearchUpdate;
+    while (_auctionUpdatesQueue.next(auctionSearchUpdate))
+    {
+        switch (auctionSearchUpdate->updateType)
         {
-            if (Aitem.itemName[searchRequest.playerInfo.loc_idx].find(searchRequest.searchInfo.wsearchedname) == std::wstring::npos)
-                continue;
+        case AuctionSearcherUpdate::Type::ADD:
+        {
+            std::shared_ptr<AuctionSearchAdd> const auctionAdd = std::static_pointer_cast<AuctionSearchAdd>(auctionSearchUpdate);
+            SearchUpdateAdd(*auctionAdd);
+            break;
         }
+        case AuctionSearcherUpdate::Type::REMOVE:
+        {
+            std::shared_ptr<AuctionSearchRemove> const auctionRemove = std::static_pointer_cast<AuctionSearchRemove>(auctionSearchUpdate);
+            SearchUpdateRemove(*auctionRemove);
+            break;
+        }
+        case AuctionSearcherUpdate::Type::UPDATE_BID:
+        {
+            std::shared_ptr<AuctionSearchUpdateBid> const auctionUpdateBid = std::static_pointer_cast<AuctionSearchUpdateBid>(auctionSearchUpdate);
+            SearchUpdateBid(*auctionUpdateBid);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+void AuctionSearchSnapshotBuilder::SearchUpdateAdd(AuctionSearchAdd const& auctionAdd)
+{
+    // the entry is not shared yet, the world thread let go of it when queuing the update
+    std::shared_ptr<SearchableAuctionEntry> const& searchableAuctionEntry = auctionAdd.searchableAuctionEntry;
+    for (uint32 locale = 0; locale < TOTAL_LOCALES; ++locale)
+        searchableAuctionEntry->item.itemNameIds[locale] = _nameIndex->GetNameId(searchableAuctionEntry->item.itemName[locale]);
+
+    GetSearchableAuctionMap(auctionAdd.listFaction)[searchableAuctionEntry->Id] = searchableAuctionEntry;
+    SetSnapshotOutdated(auctionAdd.listFaction);
+}
+
+void AuctionSearchSnapshotBuilder::SearchUpdateRemove(AuctionSearchRemove const& auctionRemove)
+{
+    if (GetSearchableAuctionMap(auctionRemove.listFaction).erase(auctionRemove.auctionId))
+        SetSnapshotOutdated(auctionRemove.listFaction);
+}
+
+void AuctionSearchSnapshotBuilder::SearchUpdateBid(AuctionSearchUpdateBid const& auctionUpdateBid)
+{
+    SearchableAuctionEntriesMap& searchableAuctionMap = GetSearchableAuctionMap(auctionUpdateBid.listFaction);
+    SearchableAuctionEntriesMap::iterator itr = searchableAuctionMap.find(auctionUpdateBid.auctionId);
+    if (itr == searchableAuctionMap.end())
+        return;
+
+    // Snapshots in use by the worker threads must not change, the entry is replaced by an updated copy
+    std::shared_ptr<SearchableAuctionEntry> searchableAuctionEntry = std::make_shared<SearchableAuctionEntry>(*itr->second);
+    searchableAuctionEntry->bid = auctionUpdateBid.bid;
+    searchableAuctionEntry->bidderGuid = auctionUpdateBid.bidderGuid;
+
+    itr->second = searchableAuctionEntry;
+    SetSnapshotOutdated(auctionUpdateBid.listFaction);
+}
+
+void AuctionSearchSnapshotBuilder::ProcessSearchRequests(AuctionSearcherRequest* firstRequest)
+{
+    // requests queued while the previous ones were handed over share their snapshots
+    std::vector<AuctionSearcherRequest*> searchRequests = { firstRequest };
+    AuctionSearcherRequest* searchRequest = nullptr;
+    while (_pendingRequests.Pop(searchRequest))
+        searchRequests.push_back(searchRequest);
+
+    // The updates are applied after taking the requests, so every change queued before a request is in its snapshot
+    ProcessSearchUpdates();
+
+    // Names are only indexed in the locales players search in, the first name search of a locale adds it
+    for (AuctionSearcherRequest const* request : searchRequests)
+    {
+        if (request->requestType != AuctionSearcherRequest::Type::LIST)
+            continue;
+
+        AuctionSearchListRequest const* searchListRequest = static_cast<AuctionSearchListRequest const*>(request);
+        int const locale = searchListRequest->playerInfo.loc_idx;
+        if (locale < 0 || locale >= TOTAL_LOCALES || (_nameLocaleMask & (1 << locale))
+            || searchListRequest->searchInfo.wsearchedname.size() < TrigramIndex::MIN_PATTERN_LENGTH)
+            continue;
+
+        _nameLocaleMask |= 1 << locale;
+        for (std::shared_ptr<AuctionSearchSnapshot const>& snapshot : _snapshot)
+            snapshot.reset();
+    }
+
+    // cached results must not keep outdated snapshots alive until the next search of their faction
+    for (uint8 faction = 0; faction < MAX_AUCTION_HOUSE_FACTIONS; ++faction)
+        if (!_snapshot[faction])
+            _resultCache->SetCurrentSnapshot(AuctionHouseFaction(faction), nullptr);
 
-        auctionEntries.push_back(Aentry.get());
+    for (AuctionSearcherRequest* request : searchRequests)
+    {
+        request->snapshot = GetSnapshot(request->listFaction);
+        _requestQueue->Push(request);
     }
 }
 
+std::shared_ptr<AuctionSearchSnapshot const> const& AuctionSearchSnapshotBuilder::GetSnapshot(AuctionHouseFaction faction)
+{
+    // Snapshots are only rebuilt when searched after a change, older ones are freed with the last request using them
+    std::shared_ptr<AuctionSearchSnapshot const>& snapshot = _snapshot[static_cast<uint8>(faction)];
+    if (!snapshot)
+    {
+        snapshot = std::make_shared<AuctionSearchSnapshot const>(GetSearchableAuctionMap(faction), _nameIndex, _nameLocaleMask);
+        _resultCache->SetCurrentSnapshot(faction, snapshot.get());
+    }
+
+    return snapshot;
+}
+
 AuctionHouseSearcher::AuctionHouseSearcher()
 {
+    _resultCache.SetDuration(Milliseconds(sWorld->getIntConfig(CONFIG_AUCTIONHOUSE_SEARCH_CACHE_DURATION)));
+    _nextResultCacheCleanup = std::chrono::steady_clock::now();
+    _snapshotBuilder = std::make_unique<AuctionSearchSnapshotBuilder>(&_requestQueue, &_resultCache);
+
     for (uint32 i = 0; i < sWorld->getIntConfig(CONFIG_AUCTIONHOUSE_WORKERTHREADS); ++i)
-        _workerThreads.push_back(std::make_unique<AuctionHouseWorkerThread>(&_requestQueue, &_responseQueue));
+        _workerThreads.push_back(std::make_unique<AuctionHouseWorkerThread>(&_requestQueue, &_responseQueue, &_resultCache));
 }
 
 AuctionHouseSearcher::~AuctionHouseSearcher()
 {
+    // the builder hands requests to the worker threads, it stops first
+    _snapshotBuilder->Stop();
+
     _requestQueue.Cancel();
     for (std::unique_ptr<AuctionHouseWorkerThread> const& workerThread : _workerThreads)
         workerThread->Stop();
@@ -349,6 +775,14 @@ AuctionHouseSearcher::~AuctionHouseSearcher()
 
 void AuctionHouseSearcher::Update()
 {
+    TimePoint const now = std::chrono::steady_clock::now();
+    if (now >= _nextResultCacheCleanup)
+    {
+        _resultCache.SetDuration(Milliseconds(sWorld->getIntConfig(CONFIG_AUCTIONHOUSE_SEARCH_CACHE_DURATION)));
+        _resultCache.RemoveExpired(now);
+        _nextResultCacheCleanup = now + 10s;
+    }
+
     AuctionSearcherResponse* response = nullptr;
     while (_responseQueue.Dequeue(response))
     {
@@ -362,7 +796,7 @@ void AuctionHouseSearcher::Update()
 
 void AuctionHouseSearcher::QueueSearchRequest(AuctionSearcherRequest* searchRequestInfo)
 {
-    _requestQueue.Push(searchRequestInfo);
+    _snapshotBuilder->AddSearchRequestToQueue(searchRequestInfo);
 }
 
 void AuctionHouseSearcher::AddAuction(AuctionEntry const* auctionEntry)
@@ -371,7 +805,7 @@ void AuctionHouseSearcher::AddAuction(AuctionEntry const* auctionEntry)
     if (!item)
         return;
 
-    // SearchableAuctionEntry is a shared_ptr as it will be shared among all the worker threads and needs to be self-managed
+    // SearchableAuctionEntry is a shared_ptr as it will be shared among all the snapshots and needs to be self-managed
     std::shared_ptr<SearchableAuctionEntry> searchableAuctionEntry = std::make_shared<SearchableAuctionEntry>();
     searchableAuctionEntry->Id = auctionEntry->Id;
 
@@ -403,32 +837,17 @@ void AuctionHouseSearcher::AddAuction(AuctionEntry const* auctionEntry)
 
     searchableAuctionEntry->SetItemNames();
 
-    // Let the worker threads know we have a new auction
-    NotifyAllWorkers(std::make_shared<AuctionSearchAdd>(searchableAuctionEntry));
+    _snapshotBuilder->AddAuctionSearchUpdateToQueue(std::make_shared<AuctionSearchAdd>(searchableAuctionEntry));
 }
 
 void AuctionHouseSearcher::RemoveAuction(AuctionEntry const* auctionEntry)
 {
-    NotifyAllWorkers(std::make_shared<AuctionSearchRemove>(auctionEntry->Id, auctionEntry->GetFactionId()));
+    _snapshotBuilder->AddAuctionSearchUpdateToQueue(std::make_shared<AuctionSearchRemove>(auctionEntry->Id, auctionEntry->GetFactionId()));
 }
 
 void AuctionHouseSearcher::UpdateBid(AuctionEntry const* auctionEntry)
 {
-    // Updating bids is a bit unique, we really only need to update a single worker as every worker thread contains
-    // a map of shared pointers to the same SearchableAuctionEntry's, so updating one will update them all.
-    NotifyOneWorker(std::make_shared<AuctionSearchUpdateBid>(auctionEntry->Id, auctionEntry->GetFactionId(), auctionEntry->bid, auctionEntry->bidder));
-}
-
-void AuctionHouseSearcher::NotifyAllWorkers(std::shared_ptr<AuctionSearcherUpdate> const auctionSearchUpdate)
-{
-    for (std::unique_ptr<AuctionHouseWorkerThread> const& workerThread : _workerThreads)
-        workerThread->AddAuctionSearchUpdateToQueue(auctionSearchUpdate);
-}
-
-void AuctionHouseSearcher::NotifyOneWorker(std::shared_ptr<AuctionSearcherUpdate> const auctionSearchUpdate)
-{
-    // Just notify the first worker in the list, no big deal which
-    (*_workerThreads.begin())->AddAuctionSearchUpdateToQueue(auctionSearchUpdate);
+    _snapshotBuilder->AddAuctionSearchUpdateToQueue(std::make_shared<AuctionSearchUpdateBid>(auctionEntry->Id, auctionEntry->GetFactionId(), auctionEntry->bid, auctionEntry->bidder));
 }
 
 void SearchableAuctionEntry::BuildAuctionInfo(WorldPacket& data) const
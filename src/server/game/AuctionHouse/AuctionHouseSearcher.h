@@ -24,12 +24,18 @@
 #include "LockedQueue.h"
 #include "MPSCQueue.h"
 #include "PCQueue.h"
+#include "TrigramIndex.h"
+#include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
 struct ItemTemplate;
+class AuctionSearchSnapshot;
+class AuctionSorter;
 
 enum AuctionSortOrder
 {
@@ -54,6 +60,8 @@ struct AuctionSortInfo
 
     AuctionSortOrder sortOrder{ AUCTION_SORT_MAX };
     bool isDesc{ true };
+
+    bool operator==(AuctionSortInfo const& right) const { return sortOrder == right.sortOrder && isDesc == right.isDesc; }
 };
 
 struct AuctionEntryItemEnchants
@@ -66,6 +74,7 @@ struct AuctionEntryItemEnchants
 struct SearchableAuctionEntryItem
 {
     std::wstring itemName[TOTAL_LOCALES];
+    uint32 itemNameIds[TOTAL_LOCALES];      // ids of itemName in the AuctionItemNameIndex
     uint32 entry;
     AuctionEntryItemEnchants enchants[MAX_INSPECTED_ENCHANTMENT_SLOT];
     int32 randomPropertyId;
@@ -150,6 +159,7 @@ struct AuctionSearcherRequest
 
     Type requestType;
     AuctionHouseFaction listFaction;
+    std::shared_ptr<AuctionSearchSnapshot const> snapshot; // set when the request is handed to the worker threads
 };
 
 struct AuctionSearchListRequest : AuctionSearcherRequest
@@ -226,8 +236,139 @@ struct AuctionSearchUpdateBid : AuctionSearcherUpdate
     ObjectGuid bidderGuid;
 };
 
-typedef std::unordered_map<uint32, std::shared_ptr<SearchableAuctionEntry>> SearchableAuctionEntriesMap;
-typedef std::vector<SearchableAuctionEntry*> SortableAuctionEntriesList;
+typedef std::map<uint32, std::shared_ptr<SearchableAuctionEntry const>> SearchableAuctionEntriesMap;
+
+/*
+ * Distinct lowercased item names of all auctions in all locales, with a trigram index over them. A name gets
+ * its id the first time an auction with it is added and is kept afterwards, there are only as many of them
+ * as item and random suffix combinations. Names are added by the snapshot builder thread and searched by the worker threads.
+ */
+class AuctionItemNameIndex
+{
+public:
+    uint32 GetNameId(std::wstring const& name);
+
+    /// Ids of the names containing pattern, false if pattern is too short to be looked up
+    bool FindNameIds(std::wstring_view pattern, std::vector<uint32>& nameIds) const;
+
+private:
+    std::unordered_map<std::wstring, uint32> _nameIds;     // only used by the snapshot builder thread
+    std::vector<std::wstring> _names;                       // by id
+    TrigramIndex _trigrams;
+    mutable std::shared_mutex _lock;                        // guards _names and _trigrams
+};
+typedef std::vector<SearchableAuctionEntry const*> SortableAuctionEntriesList;
+
+/*
+ * Immutable view of the auctions of one auction house faction, built by the snapshot builder thread and shared by all
+ * worker threads until none of their requests uses it anymore. Next to the entries it keeps the item fields
+ * searches filter on in a compact array, and for each of them the positions of the entries with a given
+ * value, so filtered searches only look at the entries that can match.
+ */
+class AuctionSearchSnapshot
+{
+public:
+    typedef std::vector<uint32> PostingList;    // positions of entries, ascending
+
+    /// Names are only indexed in the locales of nameLocaleMask, searches in other locales compare the names of all filtered entries
+    AuctionSearchSnapshot(SearchableAuctionEntriesMap const& auctions, std::shared_ptr<AuctionItemNameIndex const> nameIndex, uint32 nameLocaleMask);
+
+    [[nodiscard]] uint32 GetSize() const { return _entries.size(); }
+    [[nodiscard]] SearchableAuctionEntry const& GetEntry(uint32 position) const { return *_entries[position]; }
+    [[nodiscard]] SearchableAuctionEntry const* FindEntry(uint32 auctionId) const;
+
+    /// Positions of the entries matching the item class, subclass, inventory type, quality and level filters, ascending.
+    /// Searched names of at least three characters narrow them down to the entries whose name in locale contains it,
+    /// if the names of locale are indexed.
+    void FindEntries(AuctionHouseSearchInfo const& searchInfo, int locale, PostingList& positions) const;
+
+    [[nodiscard]] PostingList const& GetOwnerEntries(ObjectGuid ownerGuid) const;
+    [[nodiscard]] PostingList const& GetBidderEntries(ObjectGuid bidderGuid) const;
+
+private:
+    struct ItemFilterFields
+    {
+        uint8 itemClass;
+        uint8 itemSubClass;
+        uint8 inventoryType;
+        uint8 quality;
+        uint8 requiredLevel;
+    };
+
+    typedef std::unordered_map<uint32, PostingList> PostingIndex;
+
+    [[nodiscard]] bool MatchesItemFilters(ItemFilterFields const& fields, AuctionHouseSearchInfo const& searchInfo) const;
+    static PostingList const& GetPostings(PostingIndex const& index, uint32 key);
+
+    std::vector<std::shared_ptr<SearchableAuctionEntry const>> _entries;   // ordered by auction id
+    std::vector<ItemFilterFields> _itemFilterFields;                        // same order as _entries
+
+    PostingIndex _byItemClass;
+    PostingIndex _byItemSubClass;                                           // item class << 8 | subclass
+    PostingIndex _byInventoryType;
+    PostingIndex _byQuality;
+    PostingIndex _byRequiredLevel;
+    uint8 _maxQuality;
+    uint8 _maxRequiredLevel;
+
+    std::shared_ptr<AuctionItemNameIndex const> _nameIndex;
+    uint32 _nameLocaleMask;
+    PostingIndex _byItemName[TOTAL_LOCALES];                                // name id, only the locales of _nameLocaleMask
+
+    std::unordered_map<ObjectGuid, PostingList> _byOwner;
+    std::unordered_map<ObjectGuid, PostingList> _byBidder;
+};
+
+/*
+ * Result of a list search, sorted as far as the pages sent from it reached. The entries past sortedCount
+ * all sort after the ones before it, so the next page only needs a partial sort of the remaining entries.
+ */
+struct AuctionSearchResult
+{
+    std::shared_ptr<AuctionSearchSnapshot const> snapshot;  // owns the entries
+    AuctionHouseFaction listFaction;
+    int loc_idx;
+    AuctionHouseSearchInfo searchInfo;                      // listfrom is not part of the search
+    SortableAuctionEntriesList entries;
+    std::size_t sortedCount = 0;
+    TimePoint expireTime;
+    std::mutex lock;                                        // guards entries and sortedCount
+
+    [[nodiscard]] bool IsSameSearch(AuctionSearchListRequest const& searchListRequest) const;
+    /// Sorts the entries up to end, only the ones from sortedCount on are moved
+    void SortEntries(std::size_t end, AuctionSorter const& sorter);
+};
+
+/*
+ * Last list search of each player, shared by the worker threads so a player can page through the results
+ * without filtering and sorting again. Results only answer requests made against the same snapshot, and only
+ * results of the current snapshot of their faction are kept, as each of them keeps its whole snapshot alive.
+ */
+class AuctionSearchResultCache
+{
+public:
+    AuctionSearchResultCache() : _duration(0), _currentSnapshot() { }
+
+    void SetDuration(Milliseconds duration) { _duration.store(duration.count(), std::memory_order_relaxed); }
+    [[nodiscard]] bool IsEnabled() const { return _duration.load(std::memory_order_relaxed) > 0; }
+
+    std::shared_ptr<AuctionSearchResult> Find(AuctionSearchListRequest const& searchListRequest, TimePoint now);
+    void Store(ObjectGuid playerGuid, std::shared_ptr<AuctionSearchResult> result, TimePoint now);
+    void RemoveExpired(TimePoint now);
+
+    /// Called by the snapshot builder when the snapshot of faction changes, null while it is outdated and not built again yet
+    void SetCurrentSnapshot(AuctionHouseFaction faction, AuctionSearchSnapshot const* snapshot);
+
+private:
+    [[nodiscard]] bool IsOutdated(AuctionSearchResult const& result) const { return result.snapshot.get() != _currentSnapshot[static_cast<uint8>(result.listFaction)]; }
+
+    std::atomic<int64> _duration;   // milliseconds
+    std::mutex _lock;
+    std::unordered_map<ObjectGuid, std::shared_ptr<AuctionSearchResult>> _results;
+
+    // only compared, a snapshot still used by a result cannot be freed and another one built at its address
+    AuctionSearchSnapshot const* _currentSnapshot[MAX_AUCTION_HOUSE_FACTIONS];
+};
 
 class AuctionSorter
 {
@@ -243,11 +384,44 @@ private:
 class AuctionHouseWorkerThread
 {
 public:
-    AuctionHouseWorkerThread(ProducerConsumerQueue<AuctionSearcherRequest*>* requestQueue, MPSCQueue<AuctionSearcherResponse>* responseQueue);
+    AuctionHouseWorkerThread(ProducerConsumerQueue<AuctionSearcherRequest*>* requestQueue, MPSCQueue<AuctionSearcherResponse>* responseQueue, AuctionSearchResultCache* resultCache);
+
+    void Stop();
+
+private:
+    void Run();
+
+    void ProcessSearchRequest(AuctionSearcherRequest* searchRequest);
+    void SearchListRequest(AuctionSearchListRequest const& searchListRequest);
+    void SearchOwnerListRequest(AuctionSearchOwnerListRequest const& searchOwnerListRequest);
+    void SearchBidderListRequest(AuctionSearchBidderListRequest const& searchBidderListRequest);
+
+    void BuildListAuctionItems(AuctionSearchListRequest const& searchRequest, SortableAuctionEntriesList& auctionEntries, AuctionSearchSnapshot const& snapshot) const;
+    std::shared_ptr<AuctionSearchResult> GetSearchResult(AuctionSearchListRequest const& searchListRequest, TimePoint now, bool& cached);
+
+    ProducerConsumerQueue<AuctionSearcherRequest*>* _requestQueue;
+    MPSCQueue<AuctionSearcherResponse>* _responseQueue;
+    AuctionSearchResultCache* _resultCache;
+
+    std::thread _workerThread;
+    std::atomic<bool> _stopped;
+};
+
+/*
+ * Keeps the auctions of every faction up to date with the changes queued by the world thread and hands the search
+ * requests to the worker threads, together with the snapshot they are answered from. A snapshot holds every change
+ * queued before the request and is only rebuilt when a request follows a change, always on this thread, so the
+ * world thread never pays for more than queuing the change.
+ */
+class AuctionSearchSnapshotBuilder
+{
+public:
+    AuctionSearchSnapshotBuilder(ProducerConsumerQueue<AuctionSearcherRequest*>* requestQueue, AuctionSearchResultCache* resultCache);
 
     void Stop();
 
     void AddAuctionSearchUpdateToQueue(std::shared_ptr<AuctionSearcherUpdate> const auctionSearchUpdate);
+    void AddSearchRequestToQueue(AuctionSearcherRequest* searchRequest);
 
 private:
     void Run();
@@ -257,22 +431,24 @@ private:
     void SearchUpdateRemove(AuctionSearchRemove const& auctionRemove);
     void SearchUpdateBid(AuctionSearchUpdateBid const& auctionUpdateBid);
 
-    void ProcessSearchRequests();
-    void SearchListRequest(AuctionSearchListRequest const& searchListRequest);
-    void SearchOwnerListRequest(AuctionSearchOwnerListRequest const& searchOwnerListRequest);
-    void SearchBidderListRequest(AuctionSearchBidderListRequest const& searchBidderListRequest);
+    void ProcessSearchRequests(AuctionSearcherRequest* firstRequest);
 
-    void BuildListAuctionItems(AuctionSearchListRequest const& searchRequest, SortableAuctionEntriesList& auctionEntries, SearchableAuctionEntriesMap const& auctionMap) const;
-
-    SearchableAuctionEntriesMap& GetSearchableAuctionMap(AuctionHouseFaction faction) { return _searchableAuctionMap[static_cast<uint8>(faction)]; };
+    SearchableAuctionEntriesMap& GetSearchableAuctionMap(AuctionHouseFaction faction) { return _searchableAuctionMap[static_cast<uint8>(faction)]; }
+    void SetSnapshotOutdated(AuctionHouseFaction faction) { _snapshot[static_cast<uint8>(faction)].reset(); }
+    std::shared_ptr<AuctionSearchSnapshot const> const& GetSnapshot(AuctionHouseFaction faction);
 
+    // only used by the builder thread, the worker threads get the snapshots with the requests
     SearchableAuctionEntriesMap _searchableAuctionMap[MAX_AUCTION_HOUSE_FACTIONS];
-    LockedQueue<std::shared_ptr<AuctionSearcherUpdate>> _auctionUpdatesQueue;
+    std::shared_ptr<AuctionSearchSnapshot const> _snapshot[MAX_AUCTION_HOUSE_FACTIONS];
+    std::shared_ptr<AuctionItemNameIndex> _nameIndex;                       // shared with the snapshots
+    uint32 _nameLocaleMask;                                                 // locales names were searched in, the snapshots index their names
 
+    LockedQueue<std::shared_ptr<AuctionSearcherUpdate>> _auctionUpdatesQueue;  // queued by the world thread
+    ProducerConsumerQueue<AuctionSearcherRequest*> _pendingRequests;       // queued by the map threads
     ProducerConsumerQueue<AuctionSearcherRequest*>* _requestQueue;
-    MPSCQueue<AuctionSearcherResponse>* _responseQueue;
+    AuctionSearchResultCache* _resultCache;
 
-    std::thread _workerThread;
+    std::thread _builderThread;
     std::atomic<bool> _stopped;
 };
 
@@ -290,12 +466,12 @@ public:
     void RemoveAuction(AuctionEntry const* auctionEntry);
     void UpdateBid(AuctionEntry const* auctionEntry);
 
-    void NotifyAllWorkers(std::shared_ptr<AuctionSearcherUpdate> const auctionSearchUpdate);
-    void NotifyOneWorker(std::shared_ptr<AuctionSearcherUpdate> const auctionSearchUpdate);
-
 private:
     ProducerConsumerQueue<AuctionSearcherRequest*> _requestQueue;
     MPSCQueue<AuctionSearcherResponse> _responseQueue;
+    AuctionSearchResultCache _resultCache;
+    TimePoint _nextResultCacheCleanup;
+    std::unique_ptr<AuctionSearchSnapshotBuilder> _snapshotBuilder;
     std::vector<std::unique_ptr<AuctionHouseWorkerThread>> _workerThreads;
 };
 
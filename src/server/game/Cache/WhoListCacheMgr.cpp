@@ -21,6 +21,8 @@
 #include "ObjectAccessor.h"
 #include "World.h"
 #include "WorldSessionMgr.h"
+#include <algorithm>
+#include <iterator>
 
 WhoListCacheMgr* WhoListCacheMgr::instance()
 {
@@ -33,6 +35,8 @@ void WhoListCacheMgr::Update()
     // clear current list
     _whoListStorage.clear();
     _whoListStorage.reserve(sWorldSessionMgr->GetPlayerCount() + 1);
+    _playerNameIndex.Clear();
+    _guildNameIndex.Clear();
 
     for (auto const& [guid, player] : ObjectAccessor::GetPlayers())
     {
@@ -55,9 +59,36 @@ void WhoListCacheMgr::Update()
 
         wstrToLower(wideGuildName);
 
+        uint32 position = _whoListStorage.size();
+        _playerNameIndex.Add(position, widePlayerName);
+        _guildNameIndex.Add(position, wideGuildName);
+
         _whoListStorage.emplace_back(player->GetGUID(), player->GetTeamId(), player->GetSession()->GetSecurity(), player->GetLevel(),
             player->getClass(), player->getRace(),
             (player->IsSpectator() ? AREA_DALARAN : player->GetZoneId()), player->getGender(), player->IsVisible(),
             widePlayerName, wideGuildName, playerName, guildName);
     }
 }
+
+bool WhoListCacheMgr::FindCandidates(std::wstring const& playerName, std::wstring const& guildName, std::vector<uint32>& candidates) const
+{
+    std::vector<uint32> guildCandidates;
+    bool const byPlayer = _playerNameIndex.FindCandidates(playerName, candidates);
+    bool const byGuild = _guildNameIndex.FindCandidates(guildName, guildCandidates);
+
+    if (!byPlayer)
+    {
+        candidates.swap(guildCandidates);
+        return byGuild;
+    }
+
+    if (byGuild)
+    {
+        // set_intersection may not write into one of its inputs
+        std::vector<uint32> intersection;
+        std::set_intersection(candidates.begin(), candidates.end(), guildCandidates.begin(), guildCandidates.end(), std::back_inserter(intersection));
+        candidates.swap(intersection);
+    }
+
+    return true;
+}
@@ -21,6 +21,7 @@
 #include "Common.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
+#include "TrigramIndex.h"
 
 class WhoListPlayerInfo
 {
@@ -89,8 +90,18 @@ public:
     void Update();
     WhoListInfoVector const& GetWhoList() const { return _whoListStorage; }
 
+    /**
+     * @brief Finds the positions in the who list whose lowercased player and guild names may contain the given ones.
+     * @return false if neither name is long enough to be looked up, all positions have to be checked then.
+     */
+    bool FindCandidates(std::wstring const& playerName, std::wstring const& guildName, std::vector<uint32>& candidates) const;
+
 protected:
     WhoListInfoVector _whoListStorage;
+
+    // both indexed by position in _whoListStorage, rebuilt with it
+    TrigramIndex _playerNameIndex;
+    TrigramIndex _guildNameIndex;
 };
 
 #define sWhoListCacheMgr WhoListCacheMgr::instance()
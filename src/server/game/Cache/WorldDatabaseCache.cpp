@@ -0,0 +1,326 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldDatabaseCache.h"
+#include "CryptoHash.h"
+#include "DatabaseEnv.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include "QueryResult.h"
+#include "Timer.h"
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    constexpr char CACHE_MAGIC[4] = { 'A', 'C', 'W', 'C' };
+    constexpr uint32 CACHE_VERSION = 1;
+
+    class CacheFileReader
+    {
+    public:
+        CacheFileReader(char const* data, std::size_t size) : _data(data), _size(size), _offset(0) { }
+
+        template<typename T>
+        bool Read(T& value)
+        {
+            if (_size - _offset < sizeof(T))
+                return false;
+
+            memcpy(&value, _data + _offset, sizeof(T));
+            _offset += sizeof(T);
+            return true;
+        }
+
+        bool Read(std::string_view& value, std::size_t length)
+        {
+            if (_size - _offset < length)
+                return false;
+
+            value = std::string_view(_data + _offset, length);
+            _offset += length;
+            return true;
+        }
+
+        bool Read(std::string& value)
+        {
+            uint32 length;
+            std::string_view view;
+            if (!Read(length) || !Read(view, length))
+                return false;
+
+            value = view;
+            return true;
+        }
+
+        [[nodiscard]] bool IsAtEnd() const { return _offset == _size; }
+
+    private:
+        char const* _data;
+        std::size_t _size;
+        std::size_t _offset;
+    };
+
+    class CacheFileWriter
+    {
+    public:
+        explicit CacheFileWriter(std::ofstream& stream) : _stream(stream) { }
+
+        template<typename T>
+        void Write(T const& value) { _stream.write(reinterpret_cast<char const*>(&value), sizeof(T)); }
+
+        void Write(std::string_view value)
+        {
+            Write(uint32(value.size()));
+            _stream.write(value.data(), value.size());
+        }
+
+    private:
+        std::ofstream& _stream;
+    };
+}
+
+WorldDatabaseCache* WorldDatabaseCache::instance()
+{
+    static WorldDatabaseCache instance;
+    return &instance;
+}
+
+void WorldDatabaseCache::Initialize(std::string path)
+{
+    uint32 oldMSTime = getMSTime();
+
+    _path = std::move(path);
+    _key = CalculateKey();
+    _active = true;
+
+    if (_rebuild)
+        LOG_INFO("server.loading", ">> Rebuilding the world database cache {}", _path);
+    else if (ReadFile(_path, _key, _entries))
+        LOG_INFO("server.loading", ">> Using the world database cache {} ({} queries) in {} ms", _path, _entries.size(), GetMSTimeDiffToNow(oldMSTime));
+    else
+        LOG_INFO("server.loading", ">> World database cache {} is missing or outdated, it will be written after loading", _path);
+
+    LOG_INFO("server.loading", " ");
+}
+
+void WorldDatabaseCache::Finish()
+{
+    if (!_active)
+        return;
+
+    _active = false;
+
+    // a cached table changed during loading, the rows read before may already be outdated
+    if (_invalidated)
+    {
+        // deleting a file still mapped fails on some platforms
+        _entries.clear();
+
+        std::error_code error;
+        std::filesystem::remove(_path, error);
+        LOG_INFO("server.loading", ">> Not writing the world database cache {}, a cached table changed while loading", _path);
+    }
+    else if (_changed || _rebuild)
+    {
+        uint32 oldMSTime = getMSTime();
+
+        // Written next to the old file as long as its entries are still mapped, and moved in place once they are released
+        std::string tempPath = _path + ".tmp";
+        bool written = WriteFile(tempPath, _key, _entries);
+        std::size_t count = _entries.size();
+        _entries.clear();
+
+        std::error_code error;
+        if (written)
+            std::filesystem::rename(tempPath, _path, error);
+
+        if (!written || error)
+            LOG_ERROR("server.loading", "Could not write the world database cache {}: {}", _path, error ? error.message() : "write failed");
+        else
+            LOG_INFO("server.loading", ">> Wrote the world database cache {} ({} queries) in {} ms", _path, count, GetMSTimeDiffToNow(oldMSTime));
+    }
+
+    _entries.clear();
+}
+
+void WorldDatabaseCache::Invalidate()
+{
+    // only set by Initialize() during startup
+    if (_path.empty() || _invalidated.exchange(true))
+        return;
+
+    std::error_code error;
+    if (std::filesystem::remove(_path, error))
+        LOG_INFO("server.loading", "Deleted the world database cache {}, a cached table was changed", _path);
+    else if (error)
+        LOG_ERROR("server.loading", "Could not delete the world database cache {}: {}", _path, error.message());
+}
+
+QueryResult WorldDatabaseCache::Query(std::string_view sql)
+{
+    if (!_active)
+        return WorldDatabase.Query(sql);
+
+    std::shared_ptr<ResultSetRows const> rows;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        auto itr = _entries.find(std::string(sql));
+        if (itr != _entries.end())
+            rows = itr->second;
+    }
+
+    if (!rows)
+    {
+        QueryResult result = WorldDatabase.Query(sql);
+        rows = result ? ResultSetRows::Read(*result) : std::make_shared<ResultSetRows const>();
+
+        std::lock_guard<std::mutex> guard(_lock);
+        _entries[std::string(sql)] = rows;
+        _changed = true;
+    }
+
+    if (!rows->RowCount)
+        return QueryResult(nullptr);
+
+    QueryResult result = std::make_shared<ResultSet>(std::move(rows));
+    result->NextRow();
+    return result;
+}
+
+WorldDatabaseCache::Key WorldDatabaseCache::CalculateKey()
+{
+    Acore::Crypto::SHA1 hash;
+    auto addValue = [&hash](std::string_view value)
+    {
+        hash.UpdateData(value);
+        hash.UpdateData(std::string_view("\n", 1));
+    };
+
+    addValue(GitRevision::GetHash());
+
+    if (QueryResult result = WorldDatabase.Query("SELECT `name`, `hash` FROM `updates` ORDER BY `name`"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            addValue(fields[0].Get<std::string_view>());
+            addValue(fields[1].Get<std::string_view>());
+        } while (result->NextRow());
+    }
+
+    hash.Finalize();
+    return hash.GetDigest();
+}
+
+bool WorldDatabaseCache::ReadFile(std::string const& path, Key const& key, std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>>& entries)
+{
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error) || !std::filesystem::file_size(path, error))
+        return false;
+
+    std::shared_ptr<boost::iostreams::mapped_file_source> file = std::make_shared<boost::iostreams::mapped_file_source>();
+    try
+    {
+        file->open(path);
+    }
+    catch (std::exception const& e)
+    {
+        LOG_ERROR("server.loading", "Could not map the world database cache {}: {}", path, e.what());
+        return false;
+    }
+
+    CacheFileReader reader(file->data(), file->size());
+
+    char magic[4];
+    uint32 version;
+    Key fileKey;
+    uint32 count;
+    if (!reader.Read(magic) || memcmp(magic, CACHE_MAGIC, sizeof(magic)) || !reader.Read(version) || version != CACHE_VERSION
+        || !reader.Read(fileKey) || fileKey != key || !reader.Read(count))
+        return false;
+
+    std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>> fileEntries;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        std::string sql;
+        uint32 fieldCount;
+        if (!reader.Read(sql) || !reader.Read(fieldCount))
+            return false;
+
+        std::shared_ptr<ResultSetRows> rows = std::make_shared<ResultSetRows>();
+        rows->Fields.resize(fieldCount);
+        for (uint32 index = 0; index < fieldCount; ++index)
+        {
+            QueryResultFieldMetadata& meta = rows->Fields[index];
+            meta.Index = index;
+            if (!reader.Read(meta.TableName) || !reader.Read(meta.TableAlias) || !reader.Read(meta.Name) || !reader.Read(meta.Alias)
+                || !reader.Read(meta.TypeName) || !reader.Read(meta.Type))
+                return false;
+        }
+
+        uint64 size;
+        if (!reader.Read(rows->RowCount) || !reader.Read(size) || !reader.Read(rows->Data, size) || !rows->IsValid())
+            return false;
+
+        rows->Storage = file;
+        fileEntries[std::move(sql)] = std::move(rows);
+    }
+
+    if (!reader.IsAtEnd())
+        return false;
+
+    entries = std::move(fileEntries);
+    return true;
+}
+
+bool WorldDatabaseCache::WriteFile(std::string const& path, Key const& key, std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>> const& entries)
+{
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream)
+        return false;
+
+    CacheFileWriter writer(stream);
+    writer.Write(CACHE_MAGIC);
+    writer.Write(CACHE_VERSION);
+    writer.Write(key);
+    writer.Write(uint32(entries.size()));
+
+    for (auto const& [sql, rows] : entries)
+    {
+        writer.Write(std::string_view(sql));
+        writer.Write(uint32(rows->Fields.size()));
+        for (QueryResultFieldMetadata const& meta : rows->Fields)
+        {
+            writer.Write(std::string_view(meta.TableName));
+            writer.Write(std::string_view(meta.TableAlias));
+            writer.Write(std::string_view(meta.Name));
+            writer.Write(std::string_view(meta.Alias));
+            writer.Write(std::string_view(meta.TypeName));
+            writer.Write(meta.Type);
+        }
+
+        writer.Write(rows->RowCount);
+        writer.Write(uint64(rows->Data.size()));
+        stream.write(rows->Data.data(), rows->Data.size());
+    }
+
+    stream.close();
+    return !stream.fail();
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WorldDatabaseCache_h__
+#define WorldDatabaseCache_h__
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct ResultSetRows;
+
+/**
+ * @brief Keeps the results of the big world database template and spawn queries in a file between restarts.
+ *
+ * The file is memory mapped at startup and its rows are handed to the loaders as regular query results, so
+ * the loaders keep their validation unchanged while skipping the SQL round trips. It is only used when it was
+ * written for the same core revision and the same applied world database updates (`updates` table); otherwise
+ * the queries go to the database and a new file is written once loading is done.
+ *
+ * The content of the cached tables is not compared, reading all of them would cost a large part of the time the
+ * file saves. The core deletes the file when it changes these tables itself, like spawns added in game; other
+ * edits need --rebuild-world-cache.
+ */
+class AC_GAME_API WorldDatabaseCache
+{
+public:
+    typedef std::array<uint8, 20> Key;
+
+    static WorldDatabaseCache* instance();
+
+    /// Maps the cache file if it matches the world database, must be called before the first Query()
+    void Initialize(std::string path);
+
+    /// Writes a new cache file if any query was answered by the database, later queries always use the database
+    void Finish();
+
+    /// WorldDatabase.Query() for startup queries reading only the cached tables
+    QueryResult Query(std::string_view sql);
+
+    /// Ignores the current file and writes a new one, for --rebuild-world-cache
+    void SetRebuild(bool rebuild) { _rebuild = rebuild; }
+
+    /// Deletes the file after a cached table was changed, the next start queries the database again
+    void Invalidate();
+
+    /// Reads the entries of a cache file written for key, false if it is missing, outdated or damaged
+    static bool ReadFile(std::string const& path, Key const& key, std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>>& entries);
+    static bool WriteFile(std::string const& path, Key const& key, std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>> const& entries);
+
+private:
+    static Key CalculateKey();
+
+    std::mutex _lock;
+    std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>> _entries;
+    std::string _path;
+    Key _key = {};
+    bool _active = false;
+    bool _changed = false;
+    bool _rebuild = false;
+    std::atomic<bool> _invalidated = false;
+};
+
+#define sWorldDatabaseCache WorldDatabaseCache::instance()
+
+#endif // WorldDatabaseCache_h__
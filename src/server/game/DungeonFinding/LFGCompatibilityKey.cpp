@@ -0,0 +1,93 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LFGCompatibilityKey.h"
+
+namespace lfg
+{
+    namespace
+    {
+        // Roles are tank = 1, healer = 2 and damage = 4 here. Byte (subset - 1) of a role load counts the players
+        // who can only take roles of that subset. A group can be formed if no subset holds more players than it has
+        // slots (Hall's marriage theorem), 1 + 1 + 3 for tanks, healers and damage.
+        constexpr uint8 ROLE_SUBSETS = 7;
+        constexpr uint8 NO_ROLE_LOAD = 6;                       // more than any subset has slots, never fits
+
+        constexpr uint8 GetSubsetSlots(uint8 subset)
+        {
+            return ((subset & 1) ? LFG_TANKS_NEEDED : 0) + ((subset & 2) ? LFG_HEALERS_NEEDED : 0) + ((subset & 4) ? LFG_DPS_NEEDED : 0);
+        }
+
+        constexpr uint64 BuildRoleSlotBias()
+        {
+            uint64 bias = 0;
+            for (uint8 subset = 1; subset <= ROLE_SUBSETS; ++subset)
+                bias |= uint64(0x7F - GetSubsetSlots(subset)) << (8 * (subset - 1));
+
+            return bias;
+        }
+
+        constexpr std::array<uint64, 8> BuildRoleLoads()
+        {
+            std::array<uint64, 8> loads = { };
+            for (uint8 roles = 0; roles < 8; ++roles)
+                for (uint8 subset = 1; subset <= ROLE_SUBSETS; ++subset)
+                    if (!roles)
+                        loads[roles] |= uint64(NO_ROLE_LOAD) << (8 * (subset - 1));
+                    else if (!(roles & ~subset))
+                        loads[roles] |= uint64(1) << (8 * (subset - 1));
+
+            return loads;
+        }
+
+        constexpr std::array<uint64, 8> RoleLoads = BuildRoleLoads();
+
+        // Up to ten players of two keys with at most NO_ROLE_LOAD each and the bias stay below 256 per byte
+        static_assert(2 * (LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED) * NO_ROLE_LOAD + 0x7F < 0x100);
+    }
+
+    uint64 const LfgCompatibilityKey::ROLE_SLOT_BIAS = BuildRoleSlotBias();
+
+    LfgCompatibilityKey::LfgCompatibilityKey(LfgDungeonSet const& dungeonSet, LfgRolesMap const& roles)
+    {
+        for (uint32 dungeonId : dungeonSet)
+        {
+            uint32 bit = dungeonId % (DUNGEON_MASK_WORDS * 64);
+            dungeons[bit / 64] |= uint64(1) << (bit % 64);
+        }
+
+        for (LfgRolesMap::const_iterator itr = roles.begin(); itr != roles.end(); ++itr)
+        {
+            roleLoad += GetRoleLoad(itr->second);
+            ++players;
+        }
+    }
+
+    void LfgCompatibilityKey::Merge(LfgCompatibilityKey const& other)
+    {
+        for (uint32 i = 0; i < DUNGEON_MASK_WORDS; ++i)
+            dungeons[i] &= other.dungeons[i];
+
+        roleLoad += other.roleLoad;
+        players += other.players;
+    }
+
+    uint64 LfgCompatibilityKey::GetRoleLoad(uint8 roles)
+    {
+        return RoleLoads[(roles & (PLAYER_ROLE_TANK | PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE)) >> 1];
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LFGCOMPATIBILITYKEY_H
+#define _LFGCOMPATIBILITYKEY_H
+
+#include "LFG.h"
+
+namespace lfg
+{
+    /*
+        Dungeons, player count and roles of a queue entry or of a combination of entries, packed so that
+        combinations which can never form a group are ruled out without walking their sets and maps.
+        CanMatch() only rejects what LFGQueue::CheckCompatibility would reject as well, anything it lets
+        through still gets the full check.
+    */
+    struct LfgCompatibilityKey
+    {
+        static constexpr uint32 DUNGEON_MASK_WORDS = 8;                 // dungeon ids modulo 512, LFGDungeons.dbc ids are lower
+
+        LfgCompatibilityKey() = default;
+        LfgCompatibilityKey(LfgDungeonSet const& dungeonSet, LfgRolesMap const& roles);
+
+        // Key of this and other queued together: common dungeons, all players and roles
+        void Merge(LfgCompatibilityKey const& other);
+
+        [[nodiscard]] bool CanMatch(LfgCompatibilityKey const& other) const
+        {
+            if (players + other.players > LFG_TANKS_NEEDED + LFG_HEALERS_NEEDED + LFG_DPS_NEEDED)
+                return false;
+
+            // a byte of the role load exceeds the slots of its roles if its top bit is set after adding the bias
+            if ((roleLoad + other.roleLoad + ROLE_SLOT_BIAS) & 0x8080808080808080ULL)
+                return false;
+
+            // written as a plain loop over a fixed number of words so the compiler vectorizes it
+            uint64 common = 0;
+            for (uint32 i = 0; i < DUNGEON_MASK_WORDS; ++i)
+                common |= dungeons[i] & other.dungeons[i];
+
+            return common != 0;
+        }
+
+        /// Role load of a single player with the given PLAYER_ROLE_* flags
+        static uint64 GetRoleLoad(uint8 roles);
+
+        std::array<uint64, DUNGEON_MASK_WORDS> dungeons = { };
+        uint64 roleLoad = 0;                                            // see GetRoleLoad()
+        uint8 players = 0;
+
+    private:
+        static uint64 const ROLE_SLOT_BIAS;
+    };
+}
+
+#endif
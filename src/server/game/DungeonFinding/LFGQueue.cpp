@@ -149,27 +149,56 @@ namespace lfg
     void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
     {
         LOG_DEBUG("lfg", "COMPATIBLES REMOVE for: {}", guid.ToString());
-        for (LfgCompatibleContainer::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(guid))
+        for (LfgCompatible& compatible : CompatibleList)
+            if (compatible.guids->hasGuid(guid))
             {
-                LOG_DEBUG("lfg", "Removed Compatible: {}, because of: {}", it->toString(), guid.ToString());
-                it->clear(); // set to 0, this will be removed while iterating in FindNewGroups
+                LOG_DEBUG("lfg", "Removed Compatible: {}, because of: {}", compatible.guids->toString(), guid.ToString());
+                compatible.guids->clear(); // set to 0, this will be removed in RemoveEmptyCompatibles
+                compatible.key.players = 0;
             }
-        for (LfgCompatibleContainer::iterator itr = CompatibleTempList.begin(); itr != CompatibleTempList.end(); )
+
+        CompatibleTempList.erase(std::remove_if(CompatibleTempList.begin(), CompatibleTempList.end(), [guid](LfgCompatible const& compatible)
+        {
+            if (!compatible.guids->hasGuid(guid))
+                return false;
+
+            LOG_DEBUG("lfg", "Erased Temp Compatible: {}, because of: {}", compatible.guids->toString(), guid.ToString());
+            return true;
+        }), CompatibleTempList.end());
+    }
+
+    void LFGQueue::AddToCompatibles(Lfg5Guids const& key)
+    {
+        LOG_DEBUG("lfg", "COMPATIBLES ADD: {}", key.toString());
+
+        LfgCompatible compatible;
+        bool first = true;
+        for (uint8 i = 0; i < 5 && key.guids[i]; ++i)
         {
-            LfgCompatibleContainer::iterator it = itr++;
-            if (it->hasGuid(guid))
+            LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(key.guids[i]);
+            if (itQueue == QueueDataStore.end())
+                continue;
+
+            // the key starts from the first guid still queued, merging into the empty key would clear the dungeons
+            if (first)
             {
-                LOG_DEBUG("lfg", "Erased Temp Compatible: {}, because of: {}", it->toString(), guid.ToString());
-                CompatibleTempList.erase(it);
+                compatible.key = itQueue->second.compatibilityKey;
+                first = false;
             }
+            else
+                compatible.key.Merge(itQueue->second.compatibilityKey);
         }
+
+        compatible.guids = std::make_unique<Lfg5Guids>(key);
+        CompatibleTempList.push_back(std::move(compatible));
     }
 
-    void LFGQueue::AddToCompatibles(Lfg5Guids const& key)
+    void LFGQueue::RemoveEmptyCompatibles()
     {
-        LOG_DEBUG("lfg", "COMPATIBLES ADD: {}", key.toString());
-        CompatibleTempList.push_back(key);
+        CompatibleList.erase(std::remove_if(CompatibleList.begin(), CompatibleList.end(), [](LfgCompatible const& compatible)
+        {
+            return compatible.guids->empty();
+        }), CompatibleList.end());
     }
 
     uint8 LFGQueue::FindGroups()
@@ -183,10 +212,12 @@ namespace lfg
             bool pushCompatiblesToFront = (std::find(restoredAfterProposal.begin(), restoredAfterProposal.end(), newGuid) != restoredAfterProposal.end());
             LOG_DEBUG("lfg", "newToQueueStore: {}, front: {}", newGuid.ToString(), pushCompatiblesToFront ? 1 : 0);
             RemoveFromNewQueue(newGuid);
+            RemoveEmptyCompatibles();
 
             FindNewGroups(newGuid);
 
-            CompatibleList.splice((pushCompatiblesToFront ? CompatibleList.begin() : CompatibleList.end()), CompatibleTempList);
+            CompatibleList.insert((pushCompatiblesToFront ? CompatibleList.begin() : CompatibleList.end()),
+                std::make_move_iterator(CompatibleTempList.begin()), std::make_move_iterator(CompatibleTempList.end()));
             CompatibleTempList.clear();
 
             return newGroupsProcessed; // pussywizard: only one per update, shouldn't be a problem
@@ -206,15 +237,9 @@ namespace lfg
         // we have to take into account that FindNewGroups is called every X minutes if number of compatibles is low!
         // build set of already present compatibles for this guid
         std::set<Lfg5Guids> currentCompatibles;
-        for (Lfg5GuidsList::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(newGuid))
-            {
-                // unset roles here so they are not copied, restore after insertion
-                LfgRolesMap* r = it->roles;
-                it->roles = nullptr;
-                currentCompatibles.insert(*it);
-                it->roles = r;
-            }
+        for (LfgCompatible const& compatible : CompatibleList)
+            if (compatible.guids->hasGuid(newGuid))
+                currentCompatibles.insert(Lfg5Guids(*compatible.guids, false)); // roles are not copied
 
         LfgCompatibility selfCompatibility = LFG_COMPATIBILITY_PENDING;
         if (currentCompatibles.empty())
@@ -224,16 +249,20 @@ namespace lfg
                 return selfCompatibility;
         }
 
-        for (Lfg5GuidsList::iterator it = CompatibleList.begin(); it != CompatibleList.end(); )
+        LfgQueueDataContainer::const_iterator itNewQueue = QueueDataStore.find(newGuid);
+        bool const hasNewKey = itNewQueue != QueueDataStore.end();
+        LfgCompatibilityKey const newKey = hasNewKey ? itNewQueue->second.compatibilityKey : LfgCompatibilityKey();
+
+        // CheckCompatibility only adds to CompatibleTempList, CompatibleList keeps its size while it is scanned
+        for (std::size_t i = 0; i < CompatibleList.size(); ++i)
         {
-            Lfg5GuidsList::iterator itr = it++;
-            if (itr->empty())
-            {
-                LOG_DEBUG("lfg", "ERASE from CompatibleList");
-                CompatibleList.erase(itr);
+            LfgCompatible const& compatible = CompatibleList[i];
+
+            // removed while scanning, or ruled out by the packed dungeons, player count and roles
+            if (!compatible.key.players || (hasNewKey && !newKey.CanMatch(compatible.key)))
                 continue;
-            }
-            LfgCompatibility compatibility = CheckCompatibility(*itr, newGuid, foundMask, foundCount, currentCompatibles);
+
+            LfgCompatibility compatibility = CheckCompatibility(*compatible.guids, newGuid, foundMask, foundCount, currentCompatibles);
             if (compatibility == LFG_COMPATIBLES_MATCH)
                 return LFG_COMPATIBLES_MATCH;
             if ((foundMask & 0x3FFF3FFF3FFF3FFF) == 0x3FFF3FFF3FFF3FFF) // each combination of dps+heal+tank already found 4 times
@@ -480,15 +509,7 @@ namespace lfg
             m_QueueStatusTimer += diff;
 
         LOG_DEBUG("lfg", "UPDATE UpdateQueueTimers");
-        for (Lfg5GuidsList::iterator it = CompatibleList.begin(); it != CompatibleList.end(); )
-        {
-            Lfg5GuidsList::iterator itr = it++;
-            if (itr->empty())
-            {
-                LOG_DEBUG("lfg", "UpdateQueueTimers ERASE compatible");
-                CompatibleList.erase(itr);
-            }
-        }
+        RemoveEmptyCompatibles();
 
         if (!sendQueueStatus)
         {
@@ -574,11 +595,11 @@ namespace lfg
     uint32 LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
     {
         uint32 numOfCompatibles = 0;
-        for (LfgCompatibleContainer::const_iterator itr = CompatibleList.begin(); itr != CompatibleList.end(); ++itr)
-            if (itr->hasGuid(itrQueue->first))
+        for (LfgCompatible const& compatible : CompatibleList)
+            if (compatible.guids->hasGuid(itrQueue->first))
             {
                 ++numOfCompatibles;
-                UpdateBestCompatibleInQueue(itrQueue, *itr);
+                UpdateBestCompatibleInQueue(itrQueue, *compatible.guids);
             }
         return numOfCompatibles;
     }
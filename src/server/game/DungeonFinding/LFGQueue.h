@@ -19,6 +19,8 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include "LFGCompatibilityKey.h"
+#include <memory>
 
 namespace lfg
 {
@@ -42,7 +44,7 @@ namespace lfg
 
         LfgQueueData(time_t _joinTime, LfgDungeonSet  _dungeons, LfgRolesMap  _roles):
             joinTime(_joinTime), lastRefreshTime(_joinTime), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED),
-            dps(LFG_DPS_NEEDED), dungeons(std::move(_dungeons)), roles(std::move(_roles))
+            dps(LFG_DPS_NEEDED), dungeons(std::move(_dungeons)), roles(std::move(_roles)), compatibilityKey(dungeons, roles)
         { }
 
         time_t joinTime;                                       // Player queue join time (to calculate wait times)
@@ -53,6 +55,14 @@ namespace lfg
         LfgDungeonSet dungeons;                                // Selected Player/Group Dungeon/s
         LfgRolesMap roles;                                     // Selected Player Role/s
         Lfg5Guids bestCompatible;                              // Best compatible combination of people queued
+        LfgCompatibilityKey compatibilityKey;                  // Packed dungeons and roles
+    };
+
+    // Combination of queued groups found compatible, its key is what FindNewGroups scans
+    struct LfgCompatible
+    {
+        LfgCompatibilityKey key;                               // players is 0 once removed
+        std::unique_ptr<Lfg5Guids> guids;
     };
 
     struct LfgWaitTime
@@ -64,7 +74,7 @@ namespace lfg
 
     typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
     typedef std::map<ObjectGuid, LfgQueueData> LfgQueueDataContainer;
-    typedef std::list<Lfg5Guids> LfgCompatibleContainer;
+    typedef std::vector<LfgCompatible> LfgCompatibleContainer;
 
     /**
         Stores all data related to queue
@@ -99,6 +109,7 @@ namespace lfg
 
         void RemoveFromCompatibles(ObjectGuid guid);
         void AddToCompatibles(Lfg5Guids const& key);
+        void RemoveEmptyCompatibles();
 
         uint32 FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
         void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, Lfg5Guids const& key);
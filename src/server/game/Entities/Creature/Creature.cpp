@@ -46,6 +46,7 @@
 #include "Vehicle.h"
 #include "WaypointMovementGenerator.h"
 #include "World.h"
+#include "WorldDatabaseCache.h"
 #include "WorldPacket.h"
 #include "WorldSessionMgr.h"
 
@@ -1515,6 +1516,7 @@ void Creature::SaveToDB(uint32 mapid, uint8 spawnMask, uint32 phaseMask)
     trans->Append(stmt);
 
     WorldDatabase.CommitTransaction(trans);
+    sWorldDatabaseCache->Invalidate();
     sScriptMgr->OnCreatureSaveToDB(this);
 }
 
@@ -1880,6 +1882,7 @@ void Creature::DeleteFromDB()
     trans->Append(stmt);
 
     WorldDatabase.CommitTransaction(trans);
+    sWorldDatabaseCache->Invalidate();
 }
 
 bool Creature::IsInvisibleDueToDespawn() const
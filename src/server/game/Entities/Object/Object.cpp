@@ -490,26 +490,27 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
 
     ByteBuffer fieldBuffer;
     UpdateMask updateMask;
-    updateMask.SetCount(m_valuesCount);
 
     uint32* flags = nullptr;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    BuildUpdateMask(updateMask, updateType, flags, visibleFlag);
+    updateMask.ForEachSetBit([&](uint32 index)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-                ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
-        {
-            updateMask.SetBit(index);
-            fieldBuffer << m_uint32Values[index];
-        }
-    }
+        fieldBuffer << m_uint32Values[index];
+    });
 
     *data << uint8(updateMask.GetBlockCount());
     updateMask.AppendToPacket(data);
     data->append(fieldBuffer);
 }
 
+void Object::BuildUpdateMask(UpdateMask& updateMask, uint8 updateType, uint32 const* flags, uint32 visibleFlag, uint32 forcedFlags) const
+{
+    UpdateFieldFlagMasks::Get(flags).BuildUpdateMask(updateMask, m_valuesCount, m_uint32Values,
+        updateType == UPDATETYPE_VALUES ? &_changesMask : nullptr, _fieldNotifyFlags, visibleFlag, forcedFlags);
+}
+
 void Object::AddToObjectUpdateIfNeeded()
 {
     if (m_inWorld && !m_objectUpdated)
@@ -522,6 +523,7 @@ void Object::AddToObjectUpdateIfNeeded()
 void Object::ClearUpdateMask(bool remove)
 {
     _changesMask.Clear();
+    InvalidateValuesUpdateCache();
 
     if (m_objectUpdated)
     {
@@ -533,18 +535,19 @@ void Object::ClearUpdateMask(bool remove)
 
 void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map)
 {
-    UpdateDataMapType::iterator iter = data_map.find(player);
-
-    if (iter == data_map.end())
-    {
-        std::pair<UpdateDataMapType::iterator, bool> p = data_map.insert(UpdateDataMapType::value_type(player, UpdateData()));
-        ASSERT(p.second);
-        iter = p.first;
-    }
+    // Slots are reused between ticks by Map::SendObjectUpdates, only players new to the map get one constructed
+    UpdateDataMapType::iterator iter = data_map.try_emplace(player).first;
 
     BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
+Object::ValuesUpdateCacheStats& Object::GetValuesUpdateCacheStats()
+{
+    // Objects are only built by the thread updating their map
+    thread_local ValuesUpdateCacheStats stats;
+    return stats;
+}
+
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
 {
     uint32 visibleFlag = UF_FLAG_PUBLIC;
@@ -96,8 +96,6 @@ class MotionTransport;
 
 struct PositionFullTerrainStatus;
 
-typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
-
 static constexpr Milliseconds HEARTBEAT_INTERVAL = 5s + 200ms;
 
 class Object
@@ -184,6 +182,17 @@ public:
     void ApplyModFlag64(uint16 index, uint64 flag, bool apply);
 
     void ClearUpdateMask(bool remove);
+    /// Drops the values update blocks a subclass cached for the pending changes, see Unit::BuildValuesUpdate()
+    virtual void InvalidateValuesUpdateCache() { }
+
+    /// Values update blocks served from or added to the per visibility class cache of units, counted per thread
+    struct ValuesUpdateCacheStats
+    {
+        uint32 Hits = 0;
+        uint32 Misses = 0;
+    };
+
+    static ValuesUpdateCacheStats& GetValuesUpdateCacheStats();
 
     [[nodiscard]] uint16 GetValuesCount() const { return m_valuesCount; }
 
@@ -245,6 +254,8 @@ protected:
     bool _LoadIntoDataField(std::string const& data, uint32 startOffset, uint32 count);
 
     uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
+    /// Fields of a values update or create block for a viewer, see UpdateFieldFlagMasks::BuildUpdateMask
+    void BuildUpdateMask(UpdateMask& updateMask, uint8 updateType, uint32 const* flags, uint32 visibleFlag, uint32 forcedFlags = 0) const;
 
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
     virtual void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target);
@@ -20,6 +20,7 @@
 
 #include "ByteBuffer.h"
 #include "Define.h"
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <list>
@@ -284,12 +285,14 @@ public:
 
     virtual void Set(ObjectGuid::LowType val) { _nextGuid = val; }
     virtual ObjectGuid::LowType Generate() = 0;
+    // Reserves count consecutive counters in one step and returns the first one, for writers allocating many guids at once
+    virtual ObjectGuid::LowType GenerateBlock(uint32 count) = 0;
     [[nodiscard]] ObjectGuid::LowType GetNextAfterMaxUsed() const { return _nextGuid; }
     virtual ~ObjectGuidGeneratorBase() = default;
 
 protected:
     static void HandleCounterOverflow(HighGuid high);
-    ObjectGuid::LowType _nextGuid;
+    std::atomic<ObjectGuid::LowType> _nextGuid;
 };
 
 template<HighGuid high>
@@ -300,10 +303,20 @@ public:
 
     ObjectGuid::LowType Generate() override
     {
-        if (_nextGuid >= ObjectGuid::GetMaxCounter(high) - 1)
+        ObjectGuid::LowType guid = _nextGuid++;
+        if (guid >= ObjectGuid::GetMaxCounter(high) - 1)
             HandleCounterOverflow(high);
 
-        return _nextGuid++;
+        return guid;
+    }
+
+    ObjectGuid::LowType GenerateBlock(uint32 count) override
+    {
+        ObjectGuid::LowType first = _nextGuid.fetch_add(count);
+        if (uint64(first) + count >= ObjectGuid::GetMaxCounter(high))
+            HandleCounterOverflow(high);
+
+        return first;
     }
 };
 
@@ -20,7 +20,9 @@
 
 #include "ByteBuffer.h"
 #include "ObjectGuid.h"
+#include <unordered_map>
 
+class Player;
 class WorldPacket;
 
 enum OBJECT_UPDATE_TYPE
@@ -65,4 +67,6 @@ protected:
     GuidVector m_outOfRangeGUIDs;
     ByteBuffer m_data;
 };
+
+typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 #endif
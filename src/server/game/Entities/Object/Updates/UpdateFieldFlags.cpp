@@ -16,6 +16,9 @@
  */
 
 #include "UpdateFieldFlags.h"
+#include "Errors.h"
+#include "UpdateMask.h"
+#include <bit>
 
 uint32 ItemUpdateFieldFlags[CONTAINER_END] =
 {
@@ -1566,3 +1569,72 @@ uint32 CorpseUpdateFieldFlags[CORPSE_END] =
     UF_FLAG_DYNAMIC,                                        // CORPSE_FIELD_DYNAMIC_FLAGS
     UF_FLAG_NONE,                                           // CORPSE_FIELD_PAD
 };
+
+UpdateFieldFlagMasks::UpdateFieldFlagMasks(uint32 const* flags, uint32 count)
+{
+    uint32 blockCount = (count + UpdateMask::CLIENT_UPDATE_MASK_BITS - 1) / UpdateMask::CLIENT_UPDATE_MASK_BITS;
+    for (std::vector<uint32>& blocks : _blocks)
+        blocks.resize(blockCount, 0);
+
+    for (uint32 index = 0; index < count; ++index)
+        for (uint32 bit = 0; bit < UF_FLAG_BITS; ++bit)
+            if (flags[index] & (1 << bit))
+                _blocks[bit][index / UpdateMask::CLIENT_UPDATE_MASK_BITS] |= 1 << (index % UpdateMask::CLIENT_UPDATE_MASK_BITS);
+}
+
+uint32 UpdateFieldFlagMasks::GetBlock(uint32 flags, uint32 block) const
+{
+    uint32 bits = 0;
+    for (flags &= (1 << UF_FLAG_BITS) - 1; flags; flags &= flags - 1)
+        bits |= _blocks[std::countr_zero(flags)][block];
+
+    return bits;
+}
+
+void UpdateFieldFlagMasks::BuildUpdateMask(UpdateMask& mask, uint32 count, uint32 const* values, UpdateMask const* changes,
+    uint32 notifyFlags, uint32 visibleFlag, uint32 forcedFlags) const
+{
+    mask.SetCount(count);
+
+    for (uint32 block = 0; block < mask.GetBlockCount(); ++block)
+    {
+        uint32 first = block * UpdateMask::CLIENT_UPDATE_MASK_BITS;
+        uint32 fields = std::min<uint32>(count - first, UpdateMask::CLIENT_UPDATE_MASK_BITS);
+
+        uint32 candidates = 0;
+        if (changes)
+            candidates = changes->GetBlock(block);
+        else
+            for (uint32 i = 0; i < fields; ++i)
+                candidates |= uint32(values[first + i] != 0) << i;
+
+        uint32 bits = GetBlock(notifyFlags, block) | GetBlock(visibleFlag & forcedFlags, block) | (candidates & GetBlock(visibleFlag, block));
+
+        // The tables can be longer than the object (creatures use the player table)
+        if (fields < UpdateMask::CLIENT_UPDATE_MASK_BITS)
+            bits &= (uint32(1) << fields) - 1;
+
+        mask.SetBlock(block, bits);
+    }
+}
+
+UpdateFieldFlagMasks const& UpdateFieldFlagMasks::Get(uint32 const* flags)
+{
+    static UpdateFieldFlagMasks const itemMasks(ItemUpdateFieldFlags, CONTAINER_END);
+    static UpdateFieldFlagMasks const unitMasks(UnitUpdateFieldFlags, PLAYER_END);
+    static UpdateFieldFlagMasks const gameObjectMasks(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+    static UpdateFieldFlagMasks const dynamicObjectMasks(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+    static UpdateFieldFlagMasks const corpseMasks(CorpseUpdateFieldFlags, CORPSE_END);
+
+    if (flags == UnitUpdateFieldFlags)
+        return unitMasks;
+    if (flags == ItemUpdateFieldFlags)
+        return itemMasks;
+    if (flags == GameObjectUpdateFieldFlags)
+        return gameObjectMasks;
+    if (flags == DynamicObjectUpdateFieldFlags)
+        return dynamicObjectMasks;
+
+    ASSERT(flags == CorpseUpdateFieldFlags);
+    return corpseMasks;
+}
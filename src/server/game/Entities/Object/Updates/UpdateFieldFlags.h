@@ -20,6 +20,10 @@
 
 #include "Define.h"
 #include "UpdateFields.h"
+#include <array>
+#include <vector>
+
+class UpdateMask;
 
 enum UpdatefieldFlags
 {
@@ -41,4 +45,30 @@ extern uint32 GameObjectUpdateFieldFlags[GAMEOBJECT_END];
 extern uint32 DynamicObjectUpdateFieldFlags[DYNAMICOBJECT_END];
 extern uint32 CorpseUpdateFieldFlags[CORPSE_END];
 
+#define UF_FLAG_BITS 9
+
+/// The fields of one of the tables above carrying each flag, as bit packed update mask blocks
+class UpdateFieldFlagMasks
+{
+public:
+    UpdateFieldFlagMasks(uint32 const* flags, uint32 count);
+
+    /// Fields of the given update mask block carrying any of the flags
+    [[nodiscard]] uint32 GetBlock(uint32 flags, uint32 block) const;
+
+    /**
+     * Fills mask with the fields to send to a viewer, a block of 32 fields at a time: fields carrying any of
+     * notifyFlags, fields carrying any of visibleFlag & forcedFlags, and the other fields carrying any of
+     * visibleFlag that are set in changes (values update) or non zero in values (create, changes is null).
+     */
+    void BuildUpdateMask(UpdateMask& mask, uint32 count, uint32 const* values, UpdateMask const* changes,
+        uint32 notifyFlags, uint32 visibleFlag, uint32 forcedFlags = 0) const;
+
+    /// Masks of one of ItemUpdateFieldFlags, UnitUpdateFieldFlags, ...
+    static UpdateFieldFlagMasks const& Get(uint32 const* flags);
+
+private:
+    std::array<std::vector<uint32>, UF_FLAG_BITS> _blocks;
+};
+
 #endif // _UPDATEFIELDFLAGS_H
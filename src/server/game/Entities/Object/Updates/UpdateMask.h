@@ -20,7 +20,9 @@
 
 #include "ByteBuffer.h"
 #include "Errors.h"
+#include <bit>
 
+/// Bit packed set of update fields, laid out in the 32 bit blocks the client reads
 class UpdateMask
 {
 public:
@@ -37,26 +39,40 @@ public:
     UpdateMask(UpdateMask const& right)
     {
         SetCount(right.GetCount());
-        memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * 32);
+        memcpy(_blocks, right._blocks, sizeof(ClientUpdateMaskType) * _blockCount);
     }
 
-    ~UpdateMask() { delete[] _bits; }
+    ~UpdateMask() { delete[] _blocks; }
 
-    void SetBit(uint32 index) { _bits[index] = 1; }
-    void UnsetBit(uint32 index) { _bits[index] = 0; }
-    [[nodiscard]] bool GetBit(uint32 index) const { return _bits[index] != 0; }
+    void SetBit(uint32 index) { _blocks[index / CLIENT_UPDATE_MASK_BITS] |= ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS); }
+    void UnsetBit(uint32 index) { _blocks[index / CLIENT_UPDATE_MASK_BITS] &= ~(ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS)); }
+    [[nodiscard]] bool GetBit(uint32 index) const { return (_blocks[index / CLIENT_UPDATE_MASK_BITS] >> (index % CLIENT_UPDATE_MASK_BITS)) & 1; }
+
+    [[nodiscard]] ClientUpdateMaskType GetBlock(uint32 block) const { return _blocks[block]; }
+    void SetBlock(uint32 block, ClientUpdateMaskType bits) { _blocks[block] = bits; }
+
+    /// Calls visitor(index) for every set bit in ascending order, skipping empty blocks a word at a time
+    template<typename Visitor>
+    void ForEachSetBit(Visitor&& visitor) const
+    {
+        for (uint32 i = 0; i < _blockCount; ++i)
+            for (ClientUpdateMaskType bits = _blocks[i]; bits; bits &= bits - 1)
+                visitor(i * CLIENT_UPDATE_MASK_BITS + uint32(std::countr_zero(bits)));
+    }
+
+    [[nodiscard]] bool IsEmpty() const
+    {
+        for (uint32 i = 0; i < _blockCount; ++i)
+            if (_blocks[i])
+                return false;
+
+        return true;
+    }
 
     void AppendToPacket(ByteBuffer* data)
     {
         for (uint32 i = 0; i < GetBlockCount(); ++i)
-        {
-            ClientUpdateMaskType maskPart = 0;
-            for (uint32 j = 0; j < CLIENT_UPDATE_MASK_BITS; ++j)
-                if (_bits[CLIENT_UPDATE_MASK_BITS * i + j])
-                    maskPart |= 1 << j;
-
-            *data << maskPart;
-        }
+            *data << _blocks[i];
     }
 
     [[nodiscard]] uint32 GetBlockCount() const { return _blockCount; }
@@ -64,19 +80,22 @@ public:
 
     void SetCount(uint32 valuesCount)
     {
-        delete[] _bits;
+        uint32 blockCount = (valuesCount + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS;
+        if (blockCount != _blockCount || !_blocks)
+        {
+            delete[] _blocks;
+            _blocks = new ClientUpdateMaskType[blockCount];
+        }
 
         _fieldCount = valuesCount;
-        _blockCount = (valuesCount + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS;
-
-        _bits = new uint8[_blockCount * CLIENT_UPDATE_MASK_BITS];
-        memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+        _blockCount = blockCount;
+        memset(_blocks, 0, sizeof(ClientUpdateMaskType) * _blockCount);
     }
 
     void Clear()
     {
-        if (_bits)
-            memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+        if (_blocks)
+            memset(_blocks, 0, sizeof(ClientUpdateMaskType) * _blockCount);
     }
 
     UpdateMask& operator=(UpdateMask const& right)
@@ -85,15 +104,18 @@ public:
             return *this;
 
         SetCount(right.GetCount());
-        memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+        memcpy(_blocks, right._blocks, sizeof(ClientUpdateMaskType) * _blockCount);
         return *this;
     }
 
     UpdateMask& operator&=(UpdateMask const& right)
     {
         ASSERT(right.GetCount() <= GetCount());
-        for (uint32 i = 0; i < _fieldCount; ++i)
-            _bits[i] &= right._bits[i];
+        for (uint32 i = 0; i < right._blockCount; ++i)
+            _blocks[i] &= right._blocks[i];
+
+        for (uint32 i = right._blockCount; i < _blockCount; ++i)
+            _blocks[i] = 0;
 
         return *this;
     }
@@ -101,8 +123,8 @@ public:
     UpdateMask& operator|=(UpdateMask const& right)
     {
         ASSERT(right.GetCount() <= GetCount());
-        for (uint32 i = 0; i < _fieldCount; ++i)
-            _bits[i] |= right._bits[i];
+        for (uint32 i = 0; i < right._blockCount; ++i)
+            _blocks[i] |= right._blocks[i];
 
         return *this;
     }
@@ -117,7 +139,7 @@ public:
 private:
     uint32 _fieldCount{0};
     uint32 _blockCount{0};
-    uint8* _bits{nullptr};
+    ClientUpdateMaskType* _blocks{nullptr};
 };
 
 #endif
@@ -65,6 +65,7 @@
 #include "OutdoorPvPMgr.h"
 #include "Pet.h"
 #include "PetitionMgr.h"
+#include "PlayerSaveScheduler.h"
 #include "QuestDef.h"
 #include "Realm.h"
 #include "ReputationMgr.h"
@@ -186,6 +187,7 @@ Player::Player(WorldSession* session): Unit(), m_mover(this)
     m_zoneUpdateTimer = 0;
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    m_lastSaveTime = 0ms;
 
     m_areaUpdateId = 0;
     m_team = TEAM_NEUTRAL;
@@ -208,6 +210,8 @@ Player::Player(WorldSession* session): Unit(), m_mover(this)
     m_auraRaidUpdateMask = 0;
     m_bPassOnGroupLoot = false;
 
+    m_savedAurasStale = false;
+
     m_GuildIdInvited = 0;
     m_ArenaTeamIdInvited = 0;
 
@@ -4736,7 +4740,8 @@ void Player::SpawnCorpseBones(bool triggerSave /*= true*/)
 
             _SaveAuras(trans, false);
 
-            CharacterDatabase.CommitTransaction(trans);
+            // like a regular save, a failed commit makes the next save rewrite all auras
+            sPlayerSaveScheduler->CommitSave(GetGUID(), trans, false);
         }
 }
 
@@ -36,6 +36,7 @@
 #include "PlayerSettings.h"
 #include "PlayerTaxi.h"
 #include "QuestDef.h"
+#include "SavedAuraData.h"
 #include "SpellAuras.h"
 #include "SpellInfo.h"
 #include "TradeData.h"
@@ -1583,6 +1584,8 @@ public:
     void SaveInventoryAndGoldToDB(CharacterDatabaseTransaction trans);                    // fast save function for item/money cheating preventing
     void SaveGoldToDB(CharacterDatabaseTransaction trans);
     void _SaveSkills(CharacterDatabaseTransaction trans);
+    // The next save deletes and rewrites all character_aura rows, used when a save may not have reached the database
+    void InvalidateSavedAuras() { m_savedAurasStale = true; }
 
     static void Customize(CharacterCustomizeInfo const* customizeInfo, CharacterDatabaseTransaction trans);
     static void SavePositionInDB(uint32 mapid, float x, float y, float z, float o, uint32 zone, ObjectGuid guid);
@@ -2365,6 +2368,7 @@ public:
 
     [[nodiscard]] uint32 GetSaveTimer() const { return m_nextSave; }
     void SetSaveTimer(uint32 timer) { m_nextSave = timer; }
+    [[nodiscard]] Milliseconds GetLastSaveTime() const { return m_lastSaveTime; }
 
     // Recall position
     uint32 m_recallMap;
@@ -2787,6 +2791,7 @@ protected:
 
     TeamId m_team;
     uint32 m_nextSave; // pussywizard
+    Milliseconds m_lastSaveTime;
     uint16 m_additionalSaveTimer; // pussywizard
     uint8 m_additionalSaveMask; // pussywizard
     uint16 m_hostileReferenceCheckTimer; // pussywizard
@@ -2814,6 +2819,9 @@ protected:
 
     SkillStatusMap mSkillStatus;
 
+    SavedAuraList m_savedAuras;                         // character_aura rows of the last save, sorted by key
+    bool m_savedAurasStale;                             // m_savedAuras may differ from the database, see InvalidateSavedAuras()
+
     uint32 m_GuildIdInvited;
     uint32 m_ArenaTeamIdInvited;
 
@@ -0,0 +1,177 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveScheduler.h"
+#include "DatabaseEnv.h"
+#include "GameTime.h"
+#include "Log.h"
+#include "Metric.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "World.h"
+
+PlayerSaveScheduler::PlayerSaveScheduler() = default;
+PlayerSaveScheduler::~PlayerSaveScheduler() = default;
+
+PlayerSaveScheduler* PlayerSaveScheduler::instance()
+{
+    static PlayerSaveScheduler instance;
+    return &instance;
+}
+
+void PlayerSaveScheduler::LoadConfig()
+{
+    Configure(Milliseconds(sWorld->getIntConfig(CONFIG_INTERVAL_SAVE)), sWorld->getIntConfig(CONFIG_PLAYER_SAVE_RATE_LIMIT),
+        sWorld->getIntConfig(CONFIG_PLAYER_SAVE_MAX_IN_FLIGHT));
+}
+
+void PlayerSaveScheduler::Configure(Milliseconds interval, uint32 savesPerSecond, uint32 maxInFlight)
+{
+    _interval = interval;
+    _maxInFlight = maxInFlight;
+
+    if (_savesPerSecond != savesPerSecond)
+    {
+        _savesPerSecond = savesPerSecond;
+        _tokens.store(int64(savesPerSecond) * TOKEN_COST, std::memory_order_relaxed);
+    }
+}
+
+uint32 PlayerSaveScheduler::GetSaveDelay(ObjectGuid guid) const
+{
+    return GetSaveDelay(guid.GetCounter(), GameTime::GetGameTimeMS());
+}
+
+uint32 PlayerSaveScheduler::GetSaveDelay(ObjectGuid::LowType guid, Milliseconds now) const
+{
+    uint64 interval = uint64(_interval.count());
+    if (!interval)
+        return 0;
+
+    // multiplicative hashing, consecutive guids land far apart in the interval
+    uint64 phase = (uint64(guid) * UI64LIT(0x9E3779B97F4A7C15)) % interval;
+    uint64 delay = (phase + interval - uint64(now.count()) % interval) % interval;
+
+    // a save right before the slot (login, manual save) moves the next one to the slot after
+    if (delay < interval / 10)
+        delay += interval;
+
+    return uint32(std::max<uint64>(delay, 1));
+}
+
+bool PlayerSaveScheduler::TryAcquireAutoSave()
+{
+    if (_maxInFlight && _inFlight.load(std::memory_order_relaxed) >= _maxInFlight)
+    {
+        _deferred.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (!_savesPerSecond)
+        return true;
+
+    int64 tokens = _tokens.load(std::memory_order_relaxed);
+    do
+    {
+        if (tokens < TOKEN_COST)
+        {
+            _deferred.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!_tokens.compare_exchange_weak(tokens, tokens - TOKEN_COST, std::memory_order_relaxed));
+
+    return true;
+}
+
+void PlayerSaveScheduler::CommitSave(ObjectGuid guid, CharacterDatabaseTransaction trans, bool logout)
+{
+    // nothing to commit when the save was postponed, like during a far teleport
+    if (!trans->GetSize())
+        return;
+
+    if (logout)
+    {
+        // may go below zero, autosaves then wait until the logouts are paid for
+        if (_savesPerSecond)
+            _tokens.fetch_sub(TOKEN_COST, std::memory_order_relaxed);
+
+        _logoutSaves.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    _inFlight.fetch_add(1, std::memory_order_relaxed);
+
+    TimePoint start = std::chrono::steady_clock::now();
+    TransactionCallback callback = CharacterDatabase.AsyncCommitTransaction(trans);
+
+    std::lock_guard<std::mutex> lock(_callbackLock);
+    _saveCallbacks.AddCallback(std::move(callback)).AfterComplete([this, guid, start](bool success)
+    {
+        OnSaveCompleted(guid, start, success);
+    });
+}
+
+void PlayerSaveScheduler::OnSaveCompleted(ObjectGuid guid, TimePoint start, bool success)
+{
+    _inFlight.fetch_sub(1, std::memory_order_relaxed);
+
+    if (!success)
+    {
+        LOG_ERROR("entities.player", "PlayerSaveScheduler: save transaction of player {} failed", guid.ToString());
+
+        // the saved aura rows were taken as written when the transaction was built
+        if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
+            player->InvalidateSavedAuras();
+    }
+
+    if (sMetric->IsEnabled())
+    {
+        static MetricSeriesId const latencyMetric = sMetric->RegisterSeries("player_save_latency", {}, MetricSeriesType::Histogram);
+        METRIC_RECORD(latencyMetric, std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+void PlayerSaveScheduler::Update(uint32 diff)
+{
+    if (_savesPerSecond)
+    {
+        // at most one second worth of tokens is kept, an idle period must not allow a burst afterwards
+        int64 const maxTokens = int64(_savesPerSecond) * TOKEN_COST;
+        int64 const refill = int64(diff) * _savesPerSecond;
+
+        int64 tokens = _tokens.load(std::memory_order_relaxed);
+        while (tokens < maxTokens && !_tokens.compare_exchange_weak(tokens, std::min(tokens + refill, maxTokens), std::memory_order_relaxed));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_callbackLock);
+        _saveCallbacks.ProcessReadyCallbacks();
+    }
+
+    uint32 deferred = _deferred.exchange(0, std::memory_order_relaxed);
+    uint32 logoutSaves = _logoutSaves.exchange(0, std::memory_order_relaxed);
+
+    if (sMetric->IsEnabled())
+    {
+        static MetricSeriesId const inFlightMetric = sMetric->RegisterSeries("player_save_in_flight");
+        static MetricSeriesId const deferredMetric = sMetric->RegisterSeries("player_save_deferred");
+        static MetricSeriesId const logoutMetric = sMetric->RegisterSeries("player_save_logout");
+
+        METRIC_RECORD(inFlightMetric, GetInFlightSaves());
+        METRIC_RECORD(deferredMetric, deferred);
+        METRIC_RECORD(logoutMetric, logoutSaves);
+    }
+}
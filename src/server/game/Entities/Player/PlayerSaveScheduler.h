@@ -0,0 +1,91 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ACORE_PLAYER_SAVE_SCHEDULER_H
+#define __ACORE_PLAYER_SAVE_SCHEDULER_H
+
+#include "AsyncCallbackProcessor.h"
+#include "Common.h"
+#include "DatabaseEnvFwd.h"
+#include "Duration.h"
+#include "ObjectGuid.h"
+#include <atomic>
+#include <mutex>
+
+/*
+ * Spreads the periodic player saves over the save interval and limits how many of them reach the
+ * character database. Every player saves at a fixed phase of the interval derived from its guid,
+ * so the save timers do not line up after a restart or a login wave.
+ *
+ * Autosaves need a token from a bucket refilled by the world thread and are retried a moment later
+ * when none is left or too many saves are still being committed. Logout saves never wait but use
+ * up tokens as well, so they go first when the database falls behind.
+ */
+class PlayerSaveScheduler
+{
+public:
+    static constexpr uint32 RETRY_DELAY = 1 * IN_MILLISECONDS;
+
+    PlayerSaveScheduler();
+    ~PlayerSaveScheduler();
+
+    static PlayerSaveScheduler* instance();
+
+    void LoadConfig();
+    /// @param interval        autosave interval, 0 disables autosaves
+    /// @param savesPerSecond  autosave tokens added per second, 0 for no limit
+    /// @param maxInFlight     committed saves not completed yet above which autosaves wait, 0 for no limit
+    void Configure(Milliseconds interval, uint32 savesPerSecond, uint32 maxInFlight);
+
+    /// Time until the next autosave slot of the player, never less than a tenth of the interval
+    [[nodiscard]] uint32 GetSaveDelay(ObjectGuid guid) const;
+    [[nodiscard]] uint32 GetSaveDelay(ObjectGuid::LowType guid, Milliseconds now) const;
+
+    /// Called from the map threads once the autosave timer of a player expired, retry after RETRY_DELAY if it fails
+    bool TryAcquireAutoSave();
+    /// Commits the transaction of a player save and tracks it until it completed, a failed save makes the next one rewrite the auras
+    void CommitSave(ObjectGuid guid, CharacterDatabaseTransaction trans, bool logout);
+
+    /// Refills the tokens, completes finished saves and reports the metrics, called by the world thread
+    void Update(uint32 diff);
+
+    [[nodiscard]] uint32 GetInFlightSaves() const { return _inFlight.load(std::memory_order_relaxed); }
+
+private:
+    PlayerSaveScheduler(PlayerSaveScheduler const&) = delete;
+    PlayerSaveScheduler& operator=(PlayerSaveScheduler const&) = delete;
+
+    static constexpr int64 TOKEN_COST = 1000;          // tokens are counted in thousandths to refill them every tick
+
+    void OnSaveCompleted(ObjectGuid guid, TimePoint start, bool success);
+
+    Milliseconds _interval = 0ms;
+    uint32 _savesPerSecond = 0;
+    uint32 _maxInFlight = 0;
+
+    std::atomic<int64> _tokens = 0;
+    std::atomic<uint32> _inFlight = 0;
+    std::atomic<uint32> _deferred = 0;                  // failed TryAcquireAutoSave() calls since the last update
+    std::atomic<uint32> _logoutSaves = 0;
+
+    std::mutex _callbackLock;
+    AsyncCallbackProcessor<TransactionCallback> _saveCallbacks;
+};
+
+#define sPlayerSaveScheduler PlayerSaveScheduler::instance()
+
+#endif
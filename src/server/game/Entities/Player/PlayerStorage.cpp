@@ -41,12 +41,15 @@
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "MapMgr.h"
+#include "Metric.h"
+#include "MultiRowStatement.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
 #include "OutdoorPvP.h"
 #include "Pet.h"
 #include "Player.h"
+#include "PlayerSaveScheduler.h"
 #include "QueryHolder.h"
 #include "QuestDef.h"
 #include "ReputationMgr.h"
@@ -5322,9 +5325,9 @@ bool Player::LoadFromDB(ObjectGuid playerGuid, CharacterDatabaseQueryHolder cons
     // since last logout (in seconds)
     uint32 time_diff = uint32(now - logoutTime); //uint64 is excessive for a time_diff in seconds.. uint32 allows for 136~ year difference.
 
-    // randomize first save time in range [CONFIG_INTERVAL_SAVE] around [CONFIG_INTERVAL_SAVE]
-    // this must help in case next save after mass player load after server startup
-    m_nextSave = urand(m_nextSave / 2, m_nextSave * 3 / 2);
+    // first save at the player's slot of the save interval, so saves after a mass login
+    // (like after server startup) are spread evenly instead of all being due at once
+    m_nextSave = sPlayerSaveScheduler->GetSaveDelay(GetGUID());
 
     // set value, including drunk invisibility detection
     // calculate sobering. after 15 minutes logged out, the player will be sober again
@@ -5717,6 +5720,9 @@ void Player::_LoadAuras(PreparedQueryResult result, uint32 timediff)
                                                     maxDuration, remainTime, remainCharges FROM character_aura WHERE guid = '{}'", GetGUID().GetCounter());
     */
 
+    m_savedAuras.clear();
+    m_savedAurasStale = false;
+
     if (result)
     {
         do
@@ -5740,6 +5746,10 @@ void Player::_LoadAuras(PreparedQueryResult result, uint32 timediff)
             int32 remaintime = fields[13].Get<int32>();
             uint8 remaincharges = fields[14].Get<uint8>();
 
+            // rows of auras not applied again are deleted by the next save
+            m_savedAuras.push_back({ caster_guid.GetRawValue(), itemGuid.GetRawValue(), spellid, effmask, recalculatemask, stackcount, remaincharges,
+                { damage[0], damage[1], damage[2] }, { baseDamage[0], baseDamage[1], baseDamage[2] }, maxduration, remaintime });
+
             SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellid);
             if (!spellInfo)
             {
@@ -5787,6 +5797,8 @@ void Player::_LoadAuras(PreparedQueryResult result, uint32 timediff)
                 LOG_DEBUG("entities.player", "Added aura spellid {}, effectmask {}", spellInfo->Id, effmask);
             }
         } while (result->NextRow());
+
+        SortSavedAuras(m_savedAuras);
     }
 }
 
@@ -7070,13 +7082,14 @@ void Player::SaveToDB(bool create, bool logout)
 
     SaveToDB(trans, create, logout);
 
-    CharacterDatabase.CommitTransaction(trans);
+    sPlayerSaveScheduler->CommitSave(GetGUID(), trans, logout);
 }
 
 void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logout)
 {
     // delay auto save at any saves (manual, in code, or autosave)
-    m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    m_nextSave = sPlayerSaveScheduler->GetSaveDelay(GetGUID());
+    m_lastSaveTime = GameTime::GetGameTimeMS();
 
     //lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
@@ -7098,6 +7111,8 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (!create)
         sScriptMgr->OnPlayerSave(this);
 
+    std::size_t firstStatement = trans->GetSize();
+
     _SaveCharacter(create, trans);
 
     if (m_mailsUpdated)                                     //save mails only when needed
@@ -7129,6 +7144,15 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
+    if (sMetric->IsEnabled())
+    {
+        static MetricSeriesId const statementsMetric = sMetric->RegisterSeries("player_save_statements", {}, MetricSeriesType::Histogram);
+        static MetricSeriesId const bytesMetric = sMetric->RegisterSeries("player_save_bytes", {}, MetricSeriesType::Histogram);
+
+        METRIC_RECORD(statementsMetric, trans->GetSize() - firstStatement);
+        METRIC_RECORD(bytesMetric, trans->GetDataSize(firstStatement));
+    }
+
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
@@ -7151,42 +7175,22 @@ void Player::SaveGoldToDB(CharacterDatabaseTransaction trans)
 
 void Player::_SaveActions(CharacterDatabaseTransaction trans)
 {
-    CharacterDatabasePreparedStatement* stmt = nullptr;
+    MultiRowStatement replaced(CHAR_REP_CHAR_ACTION, CHAR_REP_CHAR_ACTION_BATCH);
+    MultiRowStatement deleted(CHAR_DEL_CHAR_ACTION_BY_BUTTON_SPEC, CHAR_DEL_CHAR_ACTION_BY_BUTTON_SPEC_BATCH);
 
     for (ActionButtonList::iterator itr = m_actionButtons.begin(); itr != m_actionButtons.end();)
     {
         switch (itr->second.uState)
         {
             case ACTIONBUTTON_NEW:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_ACTION);
-                stmt->SetData(0, GetGUID().GetCounter());
-                stmt->SetData(1, m_activeSpec);
-                stmt->SetData(2, itr->first);
-                stmt->SetData(3, itr->second.GetAction());
-                stmt->SetData(4, uint8(itr->second.GetType()));
-                trans->Append(stmt);
-
-                itr->second.uState = ACTIONBUTTON_UNCHANGED;
-                ++itr;
-                break;
             case ACTIONBUTTON_CHANGED:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHAR_ACTION);
-                stmt->SetData(0, itr->second.GetAction());
-                stmt->SetData(1, uint8(itr->second.GetType()));
-                stmt->SetData(2, GetGUID().GetCounter());
-                stmt->SetData(3, itr->first);
-                stmt->SetData(4, m_activeSpec);
-                trans->Append(stmt);
+                replaced.AddRow(GetGUID().GetCounter(), m_activeSpec, itr->first, itr->second.GetAction(), uint8(itr->second.GetType()));
 
                 itr->second.uState = ACTIONBUTTON_UNCHANGED;
                 ++itr;
                 break;
             case ACTIONBUTTON_DELETED:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_ACTION_BY_BUTTON_SPEC);
-                stmt->SetData(0, GetGUID().GetCounter());
-                stmt->SetData(1, itr->first);
-                stmt->SetData(2, m_activeSpec);
-                trans->Append(stmt);
+                deleted.AddRow(GetGUID().GetCounter(), itr->first, m_activeSpec);
 
                 m_actionButtons.erase(itr++);
                 break;
@@ -7195,13 +7199,15 @@ void Player::_SaveActions(CharacterDatabaseTransaction trans)
                 break;
         }
     }
+
+    deleted.AppendTo(CharacterDatabase, trans);
+    replaced.AppendTo(CharacterDatabase, trans);
 }
 
 void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->SetData(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    SavedAuraList auras;
+    auras.reserve(m_savedAuras.size() + 8);
 
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
@@ -7212,47 +7218,66 @@ void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
         if (!logout && aura->GetDuration() < 60 * IN_MILLISECONDS )
             continue;
 
-        int32 damage[MAX_SPELL_EFFECTS];
-        int32 baseDamage[MAX_SPELL_EFFECTS];
-        uint8 effMask = 0;
-        uint8 recalculateMask = 0;
+        SavedAuraData& data = auras.emplace_back();
+        data.CasterGuid = aura->GetCasterGUID().GetRawValue();
+        data.ItemGuid = aura->GetCastItemGUID().GetRawValue();
+        data.SpellId = aura->GetId();
+        data.EffectMask = 0;
+        data.RecalculateMask = 0;
+        data.StackAmount = aura->GetStackAmount();
+        data.Charges = aura->GetCharges();
+        data.MaxDuration = aura->GetMaxDuration();
+        data.Duration = aura->GetDuration();
+
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                baseDamage[i] = effect->GetBaseAmount();
-                damage[i] = effect->GetAmount();
-                effMask |= 1 << i;
+                data.BaseAmount[i] = effect->GetBaseAmount();
+                data.Amount[i] = effect->GetAmount();
+                data.EffectMask |= 1 << i;
                 if (effect->CanBeRecalculated())
-                    recalculateMask |= 1 << i;
+                    data.RecalculateMask |= 1 << i;
             }
             else
             {
-                baseDamage[i] = 0;
-                damage[i] = 0;
+                data.BaseAmount[i] = 0;
+                data.Amount[i] = 0;
             }
         }
+    }
+
+    SortSavedAuras(auras);
 
-        uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
-        stmt->SetData(index++, GetGUID().GetCounter());
-        stmt->SetData(index++, itr->second->GetCasterGUID().GetRawValue());
-        stmt->SetData(index++, itr->second->GetCastItemGUID().GetRawValue());
-        stmt->SetData(index++, itr->second->GetId());
-        stmt->SetData(index++, effMask);
-        stmt->SetData(index++, recalculateMask);
-        stmt->SetData(index++, itr->second->GetStackAmount());
-        stmt->SetData(index++, damage[0]);
-        stmt->SetData(index++, damage[1]);
-        stmt->SetData(index++, damage[2]);
-        stmt->SetData(index++, baseDamage[0]);
-        stmt->SetData(index++, baseDamage[1]);
-        stmt->SetData(index++, baseDamage[2]);
-        stmt->SetData(index++, itr->second->GetMaxDuration());
-        stmt->SetData(index++, itr->second->GetDuration());
-        stmt->SetData(index, itr->second->GetCharges());
+    if (m_savedAurasStale)
+    {
+        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+        stmt->SetData(0, GetGUID().GetCounter());
         trans->Append(stmt);
+
+        m_savedAuras.clear();
+        m_savedAurasStale = false;
     }
+
+    // Only rows which are gone or differ from the last save are written
+    MultiRowStatement replaced(CHAR_REP_CHAR_AURA, CHAR_REP_CHAR_AURA_BATCH);
+    MultiRowStatement deleted(CHAR_DEL_CHAR_AURA_BY_KEY, CHAR_DEL_CHAR_AURA_BY_KEY_BATCH);
+
+    DiffSavedAuras(m_savedAuras, auras,
+        [&](SavedAuraData const& aura)
+        {
+            deleted.AddRow(GetGUID().GetCounter(), aura.CasterGuid, aura.ItemGuid, aura.SpellId, aura.EffectMask);
+        },
+        [&](SavedAuraData const& aura)
+        {
+            replaced.AddRow(GetGUID().GetCounter(), aura.CasterGuid, aura.ItemGuid, aura.SpellId, aura.EffectMask, aura.RecalculateMask, aura.StackAmount,
+                aura.Amount[0], aura.Amount[1], aura.Amount[2], aura.BaseAmount[0], aura.BaseAmount[1], aura.BaseAmount[2], aura.MaxDuration, aura.Duration, aura.Charges);
+        });
+
+    deleted.AppendTo(CharacterDatabase, trans);
+    replaced.AppendTo(CharacterDatabase, trans);
+
+    m_savedAuras.swap(auras);
 }
 
 void Player::_SaveInventory(CharacterDatabaseTransaction trans)
@@ -7476,10 +7501,12 @@ void Player::_SaveQuestStatus(CharacterDatabaseTransaction trans)
 
     QuestStatusSaveMap::iterator saveItr;
     QuestStatusMap::iterator statusItr;
-    CharacterDatabasePreparedStatement* stmt = nullptr;
 
     bool keepAbandoned = !(sWorld->GetCleaningFlags() & CharacterDatabaseCleaner::CLEANING_FLAG_QUESTSTATUS);
 
+    MultiRowStatement replaced(CHAR_REP_CHAR_QUESTSTATUS, CHAR_REP_CHAR_QUESTSTATUS_BATCH);
+    MultiRowStatement deleted(CHAR_DEL_CHAR_QUESTSTATUS_BY_QUEST, CHAR_DEL_CHAR_QUESTSTATUS_BY_QUEST_BATCH);
+
     for (saveItr = m_QuestStatusSave.begin(); saveItr != m_QuestStatusSave.end(); ++saveItr)
     {
         if (saveItr->second)
@@ -7487,50 +7514,40 @@ void Player::_SaveQuestStatus(CharacterDatabaseTransaction trans)
             statusItr = m_QuestStatus.find(saveItr->first);
             if (statusItr != m_QuestStatus.end() && (keepAbandoned || statusItr->second.Status != QUEST_STATUS_NONE))
             {
-                uint8 index = 0;
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_QUESTSTATUS);
+                QuestStatusData const& status = statusItr->second;
+                static_assert(QUEST_OBJECTIVES_COUNT == 4 && QUEST_ITEM_OBJECTIVES_COUNT == 6, "character_queststatus columns do not match the quest objectives");
 
-                stmt->SetData(index++, GetGUID().GetCounter());
-                stmt->SetData(index++, statusItr->first);
-                stmt->SetData(index++, uint8(statusItr->second.Status));
-                stmt->SetData(index++, statusItr->second.Explored);
-                stmt->SetData(index++, uint32(statusItr->second.Timer / IN_MILLISECONDS + GameTime::GetGameTime().count()));
-
-                for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; i++)
-                    stmt->SetData(index++, statusItr->second.CreatureOrGOCount[i]);
-
-                for (uint8 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; i++)
-                    stmt->SetData(index++, statusItr->second.ItemCount[i]);
-
-                stmt->SetData(index, statusItr->second.PlayerCount);
-                trans->Append(stmt);
+                replaced.AddRow(GetGUID().GetCounter(), statusItr->first, uint8(status.Status), status.Explored, uint32(status.Timer / IN_MILLISECONDS + GameTime::GetGameTime().count()),
+                    status.CreatureOrGOCount[0], status.CreatureOrGOCount[1], status.CreatureOrGOCount[2], status.CreatureOrGOCount[3],
+                    status.ItemCount[0], status.ItemCount[1], status.ItemCount[2], status.ItemCount[3], status.ItemCount[4], status.ItemCount[5],
+                    status.PlayerCount);
             }
         }
         else
-        {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS_BY_QUEST);
-            stmt->SetData(0, GetGUID().GetCounter());
-            stmt->SetData(1, saveItr->first);
-            trans->Append(stmt);
-        }
+            deleted.AddRow(GetGUID().GetCounter(), saveItr->first);
     }
 
     m_QuestStatusSave.clear();
 
+    deleted.AppendTo(CharacterDatabase, trans);
+    replaced.AppendTo(CharacterDatabase, trans);
+
+    MultiRowStatement rewarded(CHAR_INS_CHAR_QUESTSTATUS_REWARDED, CHAR_INS_CHAR_QUESTSTATUS_REWARDED_BATCH);
+    MultiRowStatement rewardRemoved(CHAR_DEL_CHAR_QUESTSTATUS_REWARDED_BY_QUEST, CHAR_DEL_CHAR_QUESTSTATUS_REWARDED_BY_QUEST_BATCH);
+
     for (saveItr = m_RewardedQuestsSave.begin(); saveItr != m_RewardedQuestsSave.end(); ++saveItr)
     {
         if (saveItr->second)
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_QUESTSTATUS_REWARDED);
+            rewarded.AddRow(GetGUID().GetCounter(), saveItr->first);
         else // xinef: what the is this? quest can be removed by spelleffect if (!keepAbandoned)
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS_REWARDED_BY_QUEST);
-
-        stmt->SetData(0, GetGUID().GetCounter());
-        stmt->SetData(1, saveItr->first);
-        trans->Append(stmt);
+            rewardRemoved.AddRow(GetGUID().GetCounter(), saveItr->first);
     }
 
     m_RewardedQuestsSave.clear();
 
+    rewardRemoved.AppendTo(CharacterDatabase, trans);
+    rewarded.AppendTo(CharacterDatabase, trans);
+
     if (!isTransaction)
         CharacterDatabase.CommitTransaction(trans);
 }
@@ -7654,7 +7671,9 @@ void Player::_SaveMonthlyQuestStatus(CharacterDatabaseTransaction trans)
 
 void Player::_SaveSkills(CharacterDatabaseTransaction trans)
 {
-    CharacterDatabasePreparedStatement* stmt = nullptr;
+    MultiRowStatement replaced(CHAR_REP_CHAR_SKILLS, CHAR_REP_CHAR_SKILLS_BATCH);
+    MultiRowStatement deleted(CHAR_DEL_CHAR_SKILL_BY_SKILL, CHAR_DEL_CHAR_SKILL_BY_SKILL_BATCH);
+
     // we don't need transactions here.
     for (SkillStatusMap::iterator itr = mSkillStatus.begin(); itr != mSkillStatus.end();)
     {
@@ -7666,10 +7685,7 @@ void Player::_SaveSkills(CharacterDatabaseTransaction trans)
 
         if (itr->second.uState == SKILL_DELETED)
         {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SKILL_BY_SKILL);
-            stmt->SetData(0, GetGUID().GetCounter());
-            stmt->SetData(1, itr->first);
-            trans->Append(stmt);
+            deleted.AddRow(GetGUID().GetCounter(), uint16(itr->first));
 
             mSkillStatus.erase(itr++);
             continue;
@@ -7679,38 +7695,21 @@ void Player::_SaveSkills(CharacterDatabaseTransaction trans)
         uint16 value = SKILL_VALUE(valueData);
         uint16 max = SKILL_MAX(valueData);
 
-        switch (itr->second.uState)
-        {
-            case SKILL_NEW:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_SKILLS);
-                stmt->SetData(0, GetGUID().GetCounter());
-                stmt->SetData(1, uint16(itr->first));
-                stmt->SetData(2, value);
-                stmt->SetData(3, max);
-                trans->Append(stmt);
-
-                break;
-            case SKILL_CHANGED:
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UDP_CHAR_SKILLS);
-                stmt->SetData(0, value);
-                stmt->SetData(1, max);
-                stmt->SetData(2, GetGUID().GetCounter());
-                stmt->SetData(3, uint16(itr->first));
-                trans->Append(stmt);
-
-                break;
-            default:
-                break;
-        }
+        // SKILL_NEW and SKILL_CHANGED
+        replaced.AddRow(GetGUID().GetCounter(), uint16(itr->first), value, max);
         itr->second.uState = SKILL_UNCHANGED;
 
         ++itr;
     }
+
+    deleted.AppendTo(CharacterDatabase, trans);
+    replaced.AppendTo(CharacterDatabase, trans);
 }
 
 void Player::_SaveSpells(CharacterDatabaseTransaction trans)
 {
-    CharacterDatabasePreparedStatement* stmt = nullptr;
+    MultiRowStatement replaced(CHAR_REP_CHAR_SPELL, CHAR_REP_CHAR_SPELL_BATCH);
+    MultiRowStatement deleted(CHAR_DEL_CHAR_SPELL_BY_SPELL, CHAR_DEL_CHAR_SPELL_BY_SPELL_BATCH);
 
     for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
     {
@@ -7721,24 +7720,13 @@ void Player::_SaveSpells(CharacterDatabaseTransaction trans)
             continue;
         }
 
-        // xinef: Delete statement for removed / updated spell
-        if (itr->second->State == PLAYERSPELL_REMOVED || itr->second->State == PLAYERSPELL_CHANGED)
-        {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_BY_SPELL);
-            stmt->SetData(0, GetGUID().GetCounter());
-            stmt->SetData(1, itr->first);
-            trans->Append(stmt);
-        }
+        // xinef: delete statement for removed spell
+        if (itr->second->State == PLAYERSPELL_REMOVED)
+            deleted.AddRow(GetGUID().GetCounter(), itr->first);
 
-        // xinef: insert statement for new / updated spell
+        // xinef: replace statement for new / updated spell
         if (itr->second->State == PLAYERSPELL_NEW || itr->second->State == PLAYERSPELL_CHANGED)
-        {
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_SPELL);
-            stmt->SetData(0, GetGUID().GetCounter());
-            stmt->SetData(1, itr->first);
-            stmt->SetData(2, itr->second->specMask);
-            trans->Append(stmt);
-        }
+            replaced.AddRow(GetGUID().GetCounter(), itr->first, itr->second->specMask);
 
         if (itr->second->State == PLAYERSPELL_REMOVED)
         {
@@ -7751,6 +7739,9 @@ void Player::_SaveSpells(CharacterDatabaseTransaction trans)
             ++itr;
         }
     }
+
+    deleted.AppendTo(CharacterDatabase, trans);
+    replaced.AppendTo(CharacterDatabase, trans);
 }
 
 // save player stats -- only for external usage
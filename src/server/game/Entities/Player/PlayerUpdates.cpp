@@ -30,6 +30,7 @@
 #include "OutdoorPvPMgr.h"
 #include "Pet.h"
 #include "Player.h"
+#include "PlayerSaveScheduler.h"
 #include "ScriptMgr.h"
 #include "SkillDiscovery.h"
 #include "SpellAuraEffects.h"
@@ -322,9 +323,15 @@ void Player::Update(uint32 p_time)
     {
         if (p_time >= m_nextSave)
         {
-            // m_nextSave reset in SaveToDB call
-            SaveToDB(false, false);
-            LOG_DEBUG("entities.player", "Player::Update: Player '{}' ({}) saved", GetName(), GetGUID().ToString());
+            // the scheduler limits how many autosaves reach the database, try again shortly if it is busy
+            if (sPlayerSaveScheduler->TryAcquireAutoSave())
+            {
+                // m_nextSave reset in SaveToDB call
+                SaveToDB(false, false);
+                LOG_DEBUG("entities.player", "Player::Update: Player '{}' ({}) saved", GetName(), GetGUID().ToString());
+            }
+            else
+                m_nextSave = PlayerSaveScheduler::RETRY_DELAY;
         }
         else
         {
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SAVED_AURA_DATA_H__
+#define __SAVED_AURA_DATA_H__
+
+#include "DBCStructure.h"
+#include "Define.h"
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
+
+// A character_aura row as it is in the database, saves only write the rows that changed
+struct SavedAuraData
+{
+    uint64 CasterGuid;
+    uint64 ItemGuid;
+    uint32 SpellId;
+    uint8 EffectMask;
+    uint8 RecalculateMask;
+    uint8 StackAmount;
+    uint8 Charges;
+    std::array<int32, MAX_SPELL_EFFECTS> Amount;
+    std::array<int32, MAX_SPELL_EFFECTS> BaseAmount;
+    int32 MaxDuration;
+    int32 Duration;
+
+    // primary key of the row
+    [[nodiscard]] auto GetKey() const { return std::tie(CasterGuid, ItemGuid, SpellId, EffectMask); }
+    bool operator==(SavedAuraData const& right) const = default;
+};
+
+typedef std::vector<SavedAuraData> SavedAuraList;
+
+// Sorts the rows by key and keeps one row of each key, the table cannot hold more
+inline void SortSavedAuras(SavedAuraList& auras)
+{
+    std::sort(auras.begin(), auras.end(), [](SavedAuraData const& left, SavedAuraData const& right) { return left.GetKey() < right.GetKey(); });
+    auras.erase(std::unique(auras.begin(), auras.end(), [](SavedAuraData const& left, SavedAuraData const& right) { return left.GetKey() == right.GetKey(); }), auras.end());
+}
+
+/*
+ * Compares the rows of the last save with the current ones, both sorted by SortSavedAuras().
+ * Calls removed for each saved row whose key is gone and changed for each current row that is new or differs from its saved row.
+ */
+template<class Removed, class Changed>
+void DiffSavedAuras(SavedAuraList const& saved, SavedAuraList const& current, Removed&& removed, Changed&& changed)
+{
+    auto savedItr = saved.begin();
+    for (SavedAuraData const& aura : current)
+    {
+        for (; savedItr != saved.end() && savedItr->GetKey() < aura.GetKey(); ++savedItr)
+            removed(*savedItr);
+
+        if (savedItr != saved.end() && savedItr->GetKey() == aura.GetKey())
+        {
+            bool unchanged = *savedItr == aura;
+            ++savedItr;
+            if (unchanged)
+                continue;
+        }
+
+        changed(aura);
+    }
+
+    for (; savedItr != saved.end(); ++savedItr)
+        removed(*savedItr);
+}
+
+#endif
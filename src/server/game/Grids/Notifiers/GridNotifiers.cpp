@@ -199,7 +199,7 @@ void MessageDistDeliverer::Visit(VisiblePlayersMap const& m)
         if (skipped_receiver == target)
             continue;
 
-        target->SendDirectMessage(i_message);
+        target->GetSession()->SendPacket(GetSharedMessage());
     }
 }
 
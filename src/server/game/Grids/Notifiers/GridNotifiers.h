@@ -100,6 +100,7 @@ namespace Acore
     {
         WorldObject const* i_source;
         WorldPacket const* i_message;
+        SharedWorldPacket i_sharedMessage; // copied on first delivery, then shared by all receivers
         uint32 i_phaseMask;
         float i_distSq;
         TeamId teamId;
@@ -126,7 +127,15 @@ namespace Acore
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->GetSession()->SendPacket(i_message);
+            player->GetSession()->SendPacket(GetSharedMessage());
+        }
+
+        SharedWorldPacket const& GetSharedMessage()
+        {
+            if (!i_sharedMessage)
+                i_sharedMessage = std::make_shared<WorldPacket const>(*i_message);
+
+            return i_sharedMessage;
         }
     };
 
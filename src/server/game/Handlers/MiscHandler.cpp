@@ -285,8 +285,17 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
     data << uint32(matchCount);         // placeholder, count of players matching criteria
     data << uint32(displaycount);       // placeholder, count of players displayed
 
-    for (auto const& target : sWhoListCacheMgr->GetWhoList())
+    // name filters narrow the list down to the players whose names share all trigrams with them,
+    // the exact substring checks below still apply to these candidates
+    WhoListInfoVector const& whoList = sWhoListCacheMgr->GetWhoList();
+    std::vector<uint32> candidates;
+    bool const indexed = sWhoListCacheMgr->FindCandidates(wpacketPlayerName, wpacketGuildName, candidates);
+    std::size_t const count = indexed ? candidates.size() : whoList.size();
+
+    for (std::size_t position = 0; position < count; ++position)
     {
+        WhoListPlayerInfo const& target = whoList[indexed ? candidates[position] : position];
+
         if (AccountMgr::IsPlayerAccount(security))
         {
             // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
@@ -30,6 +30,8 @@
 #include "LFGMgr.h"
 #include "MapGrid.h"
 #include "MapInstanced.h"
+#include "MapMgr.h"
+#include "MapUpdater.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "MMapFactory.h"
@@ -43,9 +45,69 @@
 #include "Vehicle.h"
 #include "VMapMgr2.h"
 #include "Weather.h"
+#include <condition_variable>
+#include <numeric>
 
 #define MAP_INVALID_ZONE        0xFFFFFFFF
 
+namespace
+{
+    // Below this many updatable objects splitting the map into regions costs more than it saves
+    constexpr std::size_t MIN_OBJECTS_FOR_REGION_UPDATE = 256;
+
+    // Only creatures that keep to themselves are updated inside a region, anything that is linked
+    // to other units (combat, owners, charmers, vehicles, formations) or seen from afar stays serial
+    bool CanUpdateInRegion(WorldObject const* obj)
+    {
+        Creature const* creature = obj->ToCreature();
+        if (!creature || !creature->IsInWorld() || !creature->IsAlive() || creature->IsInCombat())
+            return false;
+
+        if (creature->IsSummon() || creature->IsVehicle() || creature->GetVehicle() || creature->GetTransport())
+            return false;
+
+        if (creature->GetCharmerOrOwnerGUID() || creature->GetFormation() || creature->IsVisibilityOverridden())
+            return false;
+
+        return true;
+    }
+
+    // Shared by the map thread and the helper requests, helpers that start after every region
+    // was claimed return immediately so the job must outlive the map's own update
+    struct RegionUpdateJob
+    {
+        std::vector<std::vector<WorldObject*>> Regions;
+        std::vector<std::vector<WorldObject*>> IdleObjects;
+        std::atomic<std::size_t> NextRegion{ 0 };
+        std::size_t FinishedRegions = 0;
+        std::mutex Lock;
+        std::condition_variable Finished;
+        uint32 Diff = 0;
+        bool Recheck = false;
+
+        void Run()
+        {
+            for (std::size_t i = NextRegion++; i < Regions.size(); i = NextRegion++)
+            {
+                for (WorldObject* obj : Regions[i])
+                {
+                    if (!obj->IsInWorld())
+                        continue;
+
+                    obj->Update(Diff);
+
+                    if (Recheck && !obj->IsUpdateNeeded())
+                        IdleObjects[i].push_back(obj);
+                }
+
+                std::lock_guard<std::mutex> lock(Lock);
+                if (++FinishedRegions == Regions.size())
+                    Finished.notify_all();
+            }
+        }
+    };
+}
+
 ZoneDynamicInfo::ZoneDynamicInfo() : MusicId(0), WeatherId(WEATHER_STATE_FINE),
                                      WeatherGrade(0.0f), OverrideLightId(0), LightFadeInTime(0) { }
 
@@ -59,12 +121,17 @@ Map::~Map()
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
     MMAP::MMapFactory::createOrGetMMapMgr()->unloadMapInstance(GetId(), i_InstanceId);
+
+    for (MetricSeriesId series : { _updateTimeMetric, _creaturesMetric, _gameObjectsMetric, _updatePacketsMetric, _updateBytesMetric, _updateNewSlotsMetric,
+        _updateCacheHitsMetric, _updateCacheMissesMetric })
+        sMetric->ReleaseSeries(series);
 }
 
 Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     _mapGridManager(this), i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
     m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), _instanceResetPeriod(0),
-    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id)),
+    _regionUpdateActive(false)
 {
     m_parentMap = (_parent ? _parent : this);
 
@@ -75,6 +142,16 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     Map::InitVisibilityDistance();
 
     _corpseUpdateTimer.SetInterval(20 * MINUTE * IN_MILLISECONDS);
+
+    std::vector<MetricTag> tags = { METRIC_TAG("map_id", std::to_string(id)), METRIC_TAG("map_instanceid", std::to_string(InstanceId)) };
+    _updateTimeMetric = sMetric->RegisterSeries("map_update_time_diff", { METRIC_TAG("map_id", std::to_string(id)) }, MetricSeriesType::Histogram);
+    _creaturesMetric = sMetric->RegisterSeries("map_creatures", tags);
+    _gameObjectsMetric = sMetric->RegisterSeries("map_gameobjects", tags);
+    _updatePacketsMetric = sMetric->RegisterSeries("map_update_packets", tags);
+    _updateBytesMetric = sMetric->RegisterSeries("map_update_bytes", tags);
+    _updateNewSlotsMetric = sMetric->RegisterSeries("map_update_new_slots", tags);
+    _updateCacheHitsMetric = sMetric->RegisterSeries("map_update_cache_hits", tags);
+    _updateCacheMissesMetric = sMetric->RegisterSeries("map_update_cache_misses", tags);
 }
 
 // Hook called after map is created AND after added to map list
@@ -174,11 +251,13 @@ void Map::DeleteFromWorld(Player* player)
 
 void Map::EnsureGridCreated(GridCoord const& gridCoord)
 {
+    auto guard = LockForRegionUpdate();
     _mapGridManager.CreateGrid(gridCoord.x_coord, gridCoord.y_coord);
 }
 
 bool Map::EnsureGridLoaded(Cell const& cell)
 {
+    auto guard = LockForRegionUpdate();
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
 
     if (_mapGridManager.LoadGrid(cell.GridX(), cell.GridY()))
@@ -299,6 +378,8 @@ void Map::InitializeObject(GameObject*  /*obj*/)
 template<class T>
 bool Map::AddToMap(T* obj, bool checkTransport)
 {
+    auto guard = LockForRegionUpdate();
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -504,13 +585,8 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 
     sScriptMgr->OnMapUpdate(this, t_diff);
 
-    METRIC_VALUE("map_creatures", uint64(GetObjectsStore().Size<Creature>()),
-        METRIC_TAG("map_id", std::to_string(GetId())),
-        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
-
-    METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
-        METRIC_TAG("map_id", std::to_string(GetId())),
-        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    METRIC_RECORD(_creaturesMetric, GetObjectsStore().Size<Creature>());
+    METRIC_RECORD(_gameObjectsMetric, GetObjectsStore().Size<GameObject>());
 }
 
 void Map::UpdateNonPlayerObjects(uint32 const diff)
@@ -519,7 +595,23 @@ void Map::UpdateNonPlayerObjects(uint32 const diff)
         _AddObjectToUpdateList(obj);
     _pendingAddUpdatableObjectList.clear();
 
-    if (_updatableObjectListRecheckTimer.Passed())
+    if (CanUpdateRegionsInParallel() && UpdateRegionsInParallel(diff, _updatableObjectListRecheckTimer.Passed()))
+    {
+        // Only the objects left out of every region remain, their updates merely queue changes of the update list
+        for (WorldObject* obj : _serialUpdatableObjects)
+        {
+            if (!obj->IsInWorld())
+                continue;
+
+            obj->Update(diff);
+
+            if (_updatableObjectListRecheckTimer.Passed() && !obj->IsUpdateNeeded())
+                RemoveIdleObjectFromUpdateList(obj);
+        }
+
+        _serialUpdatableObjects.clear();
+    }
+    else if (_updatableObjectListRecheckTimer.Passed())
     {
         for (uint32 i = 0; i < _updatableObjectList.size();)
         {
@@ -541,7 +633,6 @@ void Map::UpdateNonPlayerObjects(uint32 const diff)
             else
                 ++i;
         }
-        _updatableObjectListRecheckTimer.Reset();
     }
     else
     {
@@ -554,6 +645,131 @@ void Map::UpdateNonPlayerObjects(uint32 const diff)
             obj->Update(diff);
         }
     }
+
+    if (_updatableObjectListRecheckTimer.Passed())
+        _updatableObjectListRecheckTimer.Reset();
+}
+
+bool Map::CanUpdateRegionsInParallel() const
+{
+    if (Instanceable() || !sWorld->getBoolConfig(CONFIG_MAP_UPDATE_REGIONS))
+        return false;
+
+    if (_updatableObjectList.size() < MIN_OBJECTS_FOR_REGION_UPDATE)
+        return false;
+
+    MapUpdater* updater = sMapMgr->GetMapUpdater();
+    return updater->activated() && updater->thread_count() > 1;
+}
+
+// Groups the creatures that can be updated on their own by grid, grids close enough for their creatures
+// to see or reach the same object end up in the same region and regions are updated on all map update
+// threads at once. Moves between cells, delayed visibility and removals are still applied serially
+// once every region is done, the map's own containers are protected by LockForRegionUpdate meanwhile.
+bool Map::UpdateRegionsInParallel(uint32 const diff, bool recheck)
+{
+    // Two creatures in grids further apart than this can not see or reach the same object
+    float const reach = 2.0f * std::max(GetVisibilityRange(), MAX_VISIBILITY_DISTANCE);
+    int32 const radius = 1 + int32(std::ceil(reach / SIZE_OF_GRIDS));
+
+    std::vector<std::pair<uint32, WorldObject*>> candidates;
+    std::vector<uint32> parent(MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS);
+    std::vector<bool> occupied(parent.size(), false);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    for (WorldObject* obj : _updatableObjectList)
+    {
+        if (!CanUpdateInRegion(obj))
+        {
+            _serialUpdatableObjects.push_back(obj);
+            continue;
+        }
+
+        GridCoord gridCoord = Acore::ComputeGridCoord(obj->GetPositionX(), obj->GetPositionY());
+        uint32 gridId = gridCoord.x_coord * MAX_NUMBER_OF_GRIDS + gridCoord.y_coord;
+        candidates.emplace_back(gridId, obj);
+        occupied[gridId] = true;
+    }
+
+    auto findRoot = [&parent](uint32 gridId)
+    {
+        while (parent[gridId] != gridId)
+            gridId = parent[gridId] = parent[parent[gridId]];
+        return gridId;
+    };
+
+    for (uint32 gridId = 0; gridId < parent.size(); ++gridId)
+    {
+        if (!occupied[gridId])
+            continue;
+
+        int32 const x = gridId / MAX_NUMBER_OF_GRIDS;
+        int32 const y = gridId % MAX_NUMBER_OF_GRIDS;
+        for (int32 nx = std::max(0, x - radius); nx <= std::min<int32>(MAX_NUMBER_OF_GRIDS - 1, x + radius); ++nx)
+        {
+            for (int32 ny = std::max(0, y - radius); ny <= std::min<int32>(MAX_NUMBER_OF_GRIDS - 1, y + radius); ++ny)
+            {
+                uint32 neighbourId = nx * MAX_NUMBER_OF_GRIDS + ny;
+                if (occupied[neighbourId])
+                    parent[findRoot(neighbourId)] = findRoot(gridId);
+            }
+        }
+    }
+
+    std::shared_ptr<RegionUpdateJob> job = std::make_shared<RegionUpdateJob>();
+    std::unordered_map<uint32, std::size_t> regionByRoot;
+    for (auto const& [gridId, obj] : candidates)
+    {
+        auto itr = regionByRoot.try_emplace(findRoot(gridId), job->Regions.size()).first;
+        if (itr->second == job->Regions.size())
+            job->Regions.emplace_back();
+
+        job->Regions[itr->second].push_back(obj);
+    }
+
+    if (job->Regions.size() < 2)
+    {
+        _serialUpdatableObjects.clear();
+        return false;
+    }
+
+    // Largest regions first so the last region claimed is a short one
+    std::sort(job->Regions.begin(), job->Regions.end(), [](std::vector<WorldObject*> const& left, std::vector<WorldObject*> const& right)
+    {
+        return left.size() > right.size();
+    });
+
+    job->IdleObjects.resize(job->Regions.size());
+    job->Diff = diff;
+    job->Recheck = recheck;
+
+    _regionUpdateActive = true;
+
+    MapUpdater* updater = sMapMgr->GetMapUpdater();
+    updater->schedule_helpers([job]() { job->Run(); }, std::min(job->Regions.size(), updater->thread_count()) - 1);
+    job->Run();
+
+    {
+        std::unique_lock<std::mutex> lock(job->Lock);
+        job->Finished.wait(lock, [&job] { return job->FinishedRegions == job->Regions.size(); });
+    }
+
+    _regionUpdateActive = false;
+
+    for (std::vector<WorldObject*> const& idleObjects : job->IdleObjects)
+        for (WorldObject* obj : idleObjects)
+            if (!obj->IsUpdateNeeded())
+                RemoveIdleObjectFromUpdateList(obj);
+
+    return true;
+}
+
+// The object may already have left the list while other objects were updated
+void Map::RemoveIdleObjectFromUpdateList(WorldObject* obj)
+{
+    UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
+    if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::Updating)
+        _RemoveObjectFromUpdateList(obj);
 }
 
 void Map::AddObjectToPendingUpdateList(WorldObject* obj)
@@ -561,6 +777,8 @@ void Map::AddObjectToPendingUpdateList(WorldObject* obj)
     if (!obj->CanBeAddedToMapUpdateList())
         return;
 
+    auto guard = LockForRegionUpdate();
+
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
     if (mapUpdatableObject->GetUpdateState() != UpdatableMapObject::UpdateState::NotUpdating)
         return;
@@ -601,6 +819,8 @@ void Map::RemoveObjectFromMapUpdateList(WorldObject* obj)
     if (!obj->CanBeAddedToMapUpdateList())
         return;
 
+    auto guard = LockForRegionUpdate();
+
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
     if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::PendingAdd)
         _pendingAddUpdatableObjectList.erase(obj);
@@ -611,6 +831,7 @@ void Map::RemoveObjectFromMapUpdateList(WorldObject* obj)
 // Used in VisibilityDistanceType::Large and VisibilityDistanceType::Gigantic
 void Map::AddWorldObjectToFarVisibleMap(WorldObject* obj)
 {
+    auto guard = LockForRegionUpdate();
     if (Creature* creature = obj->ToCreature())
     {
         if (!creature->IsInGrid())
@@ -633,6 +854,7 @@ void Map::AddWorldObjectToFarVisibleMap(WorldObject* obj)
 
 void Map::RemoveWorldObjectFromFarVisibleMap(WorldObject* obj)
 {
+    auto guard = LockForRegionUpdate();
     if (Creature* creature = obj->ToCreature())
     {
         Cell curr_cell = creature->GetCurrentCell();
@@ -650,11 +872,13 @@ void Map::RemoveWorldObjectFromFarVisibleMap(WorldObject* obj)
 // Used in VisibilityDistanceType::Infinite
 void Map::AddWorldObjectToZoneWideVisibleMap(uint32 zoneId, WorldObject* obj)
 {
+    auto guard = LockForRegionUpdate();
     _zoneWideVisibleWorldObjectsMap[zoneId].insert(obj);
 }
 
 void Map::RemoveWorldObjectFromZoneWideVisibleMap(uint32 zoneId, WorldObject* obj)
 {
+    auto guard = LockForRegionUpdate();
     ZoneWideVisibleWorldObjectsMap::iterator itr = _zoneWideVisibleWorldObjectsMap.find(zoneId);
     if (itr == _zoneWideVisibleWorldObjectsMap.end())
         return;
@@ -720,6 +944,8 @@ void Map::AfterPlayerUnlinkFromMap()
 template<class T>
 void Map::RemoveFromMap(T* obj, bool remove)
 {
+    auto guard = LockForRegionUpdate();
+
     obj->RemoveFromWorld();
 
     obj->RemoveFromGrid();
@@ -864,6 +1090,7 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 
 void Map::AddCreatureToMoveList(Creature* c)
 {
+    auto guard = LockForRegionUpdate();
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _creaturesToMove.push_back(c);
     c->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -877,6 +1104,7 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 
 void Map::AddGameObjectToMoveList(GameObject* go)
 {
+    auto guard = LockForRegionUpdate();
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _gameObjectsToMove.push_back(go);
     go->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -890,6 +1118,7 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 {
+    auto guard = LockForRegionUpdate();
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _dynamicObjectsToMove.push_back(dynObj);
     dynObj->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1212,7 +1441,11 @@ bool Map::GetAreaInfo(uint32 phaseMask, float x, float y, float z, uint32& flags
     int32 dgroupId;
 
     bool hasVmapAreaInfo = vmgr->GetAreaInfo(GetId(), x, y, vmap_z, vflags, vadtId, vrootId, vgroupId);
-    bool hasDynamicAreaInfo = _dynamicTree.GetAreaInfo(x, y, dynamic_z, phaseMask, dflags, dadtId, drootId, dgroupId);
+    bool hasDynamicAreaInfo;
+    {
+        auto guard = LockDynamicTreeForRead();
+        hasDynamicAreaInfo = _dynamicTree.GetAreaInfo(x, y, dynamic_z, phaseMask, dflags, dadtId, drootId, dgroupId);
+    }
     auto useVmap = [&]() { check_z = vmap_z; flags = vflags; adtId = vadtId; rootId = vrootId; groupId = vgroupId; };
     auto useDyn = [&]() { check_z = dynamic_z; flags = dflags; adtId = dadtId; rootId = drootId; groupId = dgroupId; };
 
@@ -1567,6 +1800,7 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
             ignoreFlags = VMAP::ModelIgnoreFlags::M2;
         }
 
+        auto guard = LockDynamicTreeForRead();
         if (!_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, ignoreFlags))
         {
             return false;
@@ -1582,6 +1816,7 @@ bool Map::GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float
     G3D::Vector3 dstPos(x2, y2, z2);
 
     G3D::Vector3 resultPos;
+    auto guard = LockDynamicTreeForRead();
     bool result = _dynamicTree.GetObjectHitPos(phasemask, startPos, dstPos, resultPos, modifyDist);
 
     rx = resultPos.x;
@@ -1594,7 +1829,7 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=tr
 {
     float h1, h2;
     h1 = GetHeight(x, y, z, vmap, maxSearchDist);
-    h2 = _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
+    h2 = GetGameObjectFloor(phasemask, x, y, z, maxSearchDist);
     return std::max<float>(h1, h2);
 }
 
@@ -1715,24 +1950,54 @@ void Map::SendRemoveTransports(Player* player)
 
 void Map::SendObjectUpdates()
 {
-    UpdateDataMapType update_players;
+    if (_updateObjects.empty())
+        return;
+
+    // BuildUpdate() may remove the object from _updateObjects, work on a copy instead of erasing one by one
+    _updateObjectsQueue.assign(_updateObjects.begin(), _updateObjects.end());
+    _updateObjects.clear();
 
-    while (!_updateObjects.empty())
+    Object::ValuesUpdateCacheStats& cacheStats = Object::GetValuesUpdateCacheStats();
+    cacheStats = Object::ValuesUpdateCacheStats();
+
+    std::size_t reusedSlots = _updatePlayers.size();
+    for (Object* obj : _updateObjectsQueue)
     {
-        Object* obj = *_updateObjects.begin();
         ASSERT(obj->IsInWorld());
-
-        _updateObjects.erase(_updateObjects.begin());
-        obj->BuildUpdate(update_players);
+        obj->BuildUpdate(_updatePlayers);
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    _updateObjectsQueue.clear();
+
+    uint64 packets = 0;
+    uint64 bytes = 0;
+    std::size_t newSlots = _updatePlayers.size() - reusedSlots;
+    for (UpdateDataMapType::iterator iter = _updatePlayers.begin(); iter != _updatePlayers.end();)
     {
+        // Slot of a player that got nothing this tick, it may have left the map
+        if (!iter->second.HasData())
+        {
+            iter = _updatePlayers.erase(iter);
+            continue;
+        }
+
+        WorldPacket packet;
         iter->second.BuildPacket(packet);
-        iter->first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
+        iter->second.Clear();                               // keeps the buffer for the next tick
+
+        ++packets;
+        bytes += packet.size();
+
+        // Handed over to the socket without another copy
+        iter->first->GetSession()->SendPacket(std::make_shared<WorldPacket const>(std::move(packet)));
+        ++iter;
     }
+
+    METRIC_RECORD(_updatePacketsMetric, packets);
+    METRIC_RECORD(_updateBytesMetric, bytes);
+    METRIC_RECORD(_updateNewSlotsMetric, newSlots);
+    METRIC_RECORD(_updateCacheHitsMetric, cacheStats.Hits);
+    METRIC_RECORD(_updateCacheMissesMetric, cacheStats.Misses);
 }
 
 uint32 Map::ApplyDynamicModeRespawnScaling(WorldObject const* obj, uint32 respawnDelay) const
@@ -1791,6 +2056,8 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    auto guard = LockForRegionUpdate();
+
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
     i_objectsToRemove.insert(obj);
@@ -1849,8 +2116,13 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    if (m_mapRefMgr.IsEmpty())
+        return;
+
+    // One copy shared by all sockets instead of one per player
+    SharedWorldPacket packet = std::make_shared<WorldPacket const>(*data);
     for (MapRefMgr::const_iterator itr = m_mapRefMgr.begin(); itr != m_mapRefMgr.end(); ++itr)
-        itr->GetSource()->GetSession()->SendPacket(data);
+        itr->GetSource()->GetSession()->SendPacket(packet);
 }
 
 template bool Map::AddToMap(Corpse*, bool);
@@ -2356,23 +2628,63 @@ void BattlegroundMap::RemoveAllPlayers()
                     player->TeleportTo(player->GetEntryPoint());
 }
 
+std::unique_lock<std::recursive_mutex> Map::LockForRegionUpdate() const
+{
+    std::unique_lock<std::recursive_mutex> lock(_regionUpdateLock, std::defer_lock);
+    if (_regionUpdateActive)
+        lock.lock();
+
+    return lock;
+}
+
+std::unique_lock<std::mutex> Map::LockNavMeshQuery() const
+{
+    std::unique_lock<std::mutex> lock(_navMeshQueryLock, std::defer_lock);
+    if (_regionUpdateActive)
+        lock.lock();
+
+    return lock;
+}
+
+std::shared_lock<std::shared_mutex> Map::LockDynamicTreeForRead() const
+{
+    std::shared_lock<std::shared_mutex> lock(_dynamicTreeLock, std::defer_lock);
+    if (_regionUpdateActive)
+        lock.lock();
+
+    return lock;
+}
+
+std::unique_lock<std::shared_mutex> Map::LockDynamicTreeForWrite() const
+{
+    std::unique_lock<std::shared_mutex> lock(_dynamicTreeLock, std::defer_lock);
+    if (_regionUpdateActive)
+        lock.lock();
+
+    return lock;
+}
+
 Corpse* Map::GetCorpse(ObjectGuid const guid)
 {
+    auto guard = LockForRegionUpdate();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const guid)
 {
+    auto guard = LockForRegionUpdate();
     return _objectsStore.Find<Creature>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const guid)
 {
+    auto guard = LockForRegionUpdate();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const guid)
 {
+    auto guard = LockForRegionUpdate();
     return dynamic_cast<Pet*>(_objectsStore.Find<Creature>(guid));
 }
 
@@ -2387,6 +2699,7 @@ Transport* Map::GetTransport(ObjectGuid guid)
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    auto guard = LockForRegionUpdate();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
@@ -2409,7 +2722,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _creatureRespawnTimes[spawnId] = respawnTime;
+    {
+        auto guard = LockForRegionUpdate();
+        _creatureRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -2421,7 +2737,10 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
 
 void Map::RemoveCreatureRespawnTime(ObjectGuid::LowType spawnId)
 {
-    _creatureRespawnTimes.erase(spawnId);
+    {
+        auto guard = LockForRegionUpdate();
+        _creatureRespawnTimes.erase(spawnId);
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -2443,7 +2762,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _goRespawnTimes[spawnId] = respawnTime;
+    {
+        auto guard = LockForRegionUpdate();
+        _goRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -2455,7 +2777,10 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
 
 void Map::RemoveGORespawnTime(ObjectGuid::LowType spawnId)
 {
-    _goRespawnTimes.erase(spawnId);
+    {
+        auto guard = LockForRegionUpdate();
+        _goRespawnTimes.erase(spawnId);
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -2758,6 +3083,7 @@ void Map::RemoveOldCorpses()
 
 void Map::ScheduleCreatureRespawn(ObjectGuid creatureGuid, Milliseconds respawnTimer, Position pos)
 {
+    auto guard = LockForRegionUpdate();
     _creatureRespawnScheduler.Schedule(respawnTimer, [this, creatureGuid, pos](TaskContext)
     {
         if (Creature* creature = GetCreature(creatureGuid))
@@ -28,6 +28,7 @@
 #include "GridRefMgr.h"
 #include "MapGridManager.h"
 #include "MapRefMgr.h"
+#include "Metric.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
 #include "PathGenerator.h"
@@ -35,10 +36,12 @@
 #include "SharedDefines.h"
 #include "TaskScheduler.h"
 #include "Timer.h"
+#include "UpdateData.h"
 #include "GridTerrainData.h"
 #include <bitset>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 
 class Unit;
@@ -231,6 +234,11 @@ public:
     [[nodiscard]] std::shared_mutex& GetMMapLock() const { return *(const_cast<std::shared_mutex*>(&MMapLock)); }
     // pussywizard:
     std::unordered_set<Unit*> i_objectsForDelayedVisibility;
+    void AddObjectToDelayedVisibility(Unit* unit)
+    {
+        auto guard = LockForRegionUpdate();
+        i_objectsForDelayedVisibility.insert(unit);
+    }
     void HandleDelayedVisibility();
 
     // some calls like isInWater should not use vmaps due to processor power
@@ -261,6 +269,7 @@ public:
     virtual void RemoveAllPlayers();
 
     [[nodiscard]] uint32 GetInstanceId() const { return i_InstanceId; }
+    [[nodiscard]] MetricSeriesId GetUpdateTimeMetric() const { return _updateTimeMetric; }
     [[nodiscard]] uint8 GetSpawnMode() const { return (i_spawnMode); }
 
     enum EnterState
@@ -384,14 +393,15 @@ public:
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CheckCollisionAndGetValidCoords(WorldObject const* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true) const;
-    void Balance() { _dynamicTree.balance(); }
-    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
-    [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
+    void Balance() { auto guard = LockDynamicTreeForWrite(); _dynamicTree.balance(); }
+    void RemoveGameObjectModel(const GameObjectModel& model) { auto guard = LockDynamicTreeForWrite(); _dynamicTree.remove(model); }
+    void InsertGameObjectModel(const GameObjectModel& model) { auto guard = LockDynamicTreeForWrite(); _dynamicTree.insert(model); }
+    [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { auto guard = LockDynamicTreeForRead(); return _dynamicTree.contains(model);}
     [[nodiscard]] DynamicMapTree const& GetDynamicMapTree() const { return _dynamicTree; }
     bool GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist);
     [[nodiscard]] float GetGameObjectFloor(uint32 phasemask, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
     {
+        auto guard = LockDynamicTreeForRead();
         return _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
     }
     /*
@@ -400,6 +410,7 @@ public:
     [[nodiscard]] time_t GetLinkedRespawnTime(ObjectGuid guid) const;
     [[nodiscard]] time_t GetCreatureRespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        auto guard = LockForRegionUpdate();
         std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _creatureRespawnTimes.find(dbGuid);
         if (itr != _creatureRespawnTimes.end())
             return itr->second;
@@ -409,6 +420,7 @@ public:
 
     [[nodiscard]] time_t GetGORespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        auto guard = LockForRegionUpdate();
         std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _goRespawnTimes.find(dbGuid);
         if (itr != _goRespawnTimes.end())
             return itr->second;
@@ -470,19 +482,28 @@ public:
     inline ObjectGuid::LowType GenerateLowGuid()
     {
         static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+        auto guard = LockForRegionUpdate();
         return GetGuidSequenceGenerator<high>().Generate();
     }
 
     void AddUpdateObject(Object* obj)
     {
+        auto guard = LockForRegionUpdate();
         _updateObjects.insert(obj);
     }
 
     void RemoveUpdateObject(Object* obj)
     {
+        auto guard = LockForRegionUpdate();
         _updateObjects.erase(obj);
     }
 
+    // Held by the code touching state shared by the whole map while its regions are updated in parallel
+    // (see MapUpdate.Regions), the lock is not taken at all during the regular serial update
+    [[nodiscard]] std::unique_lock<std::recursive_mutex> LockForRegionUpdate() const;
+    // The navmesh query of a map is shared by all of its creatures, regions updated in parallel take turns on it
+    [[nodiscard]] std::unique_lock<std::mutex> LockNavMeshQuery() const;
+
     size_t GetUpdatableObjectsCount() const { return _updatableObjectList.size(); }
 
     virtual std::string GetDebugInfo() const;
@@ -525,6 +546,13 @@ private:
 
     void SendObjectUpdates();
 
+    bool CanUpdateRegionsInParallel() const;
+    bool UpdateRegionsInParallel(uint32 const diff, bool recheck);
+    void RemoveIdleObjectFromUpdateList(WorldObject* obj);
+
+    [[nodiscard]] std::shared_lock<std::shared_mutex> LockDynamicTreeForRead() const;
+    [[nodiscard]] std::unique_lock<std::shared_mutex> LockDynamicTreeForWrite() const;
+
 protected:
     // Type specific code for add/remove to/from grid
     template<class T>
@@ -607,11 +635,32 @@ private:
     std::unordered_set<Corpse*> _corpseBones;
 
     std::unordered_set<Object*> _updateObjects;
+    // Kept between SendObjectUpdates() calls so the buffers of the players on the map are reused every tick
+    std::vector<Object*> _updateObjectsQueue;
+    UpdateDataMapType _updatePlayers;
+
+    // Interned once per map instead of formatting the tags on every update
+    MetricSeriesId _updateTimeMetric;
+    MetricSeriesId _creaturesMetric;
+    MetricSeriesId _gameObjectsMetric;
+    MetricSeriesId _updatePacketsMetric;
+    MetricSeriesId _updateBytesMetric;
+    MetricSeriesId _updateNewSlotsMetric;
+    MetricSeriesId _updateCacheHitsMetric;
+    MetricSeriesId _updateCacheMissesMetric;
 
     UpdatableObjectList _updatableObjectList;
     PendingAddUpdatableObjectList _pendingAddUpdatableObjectList;
     IntervalTimer _updatableObjectListRecheckTimer;
     ZoneWideVisibleWorldObjectsMap _zoneWideVisibleWorldObjectsMap;
+
+    // Parallel region update, only ever enabled on continents while MapUpdate.Regions is set
+    bool _regionUpdateActive;
+    mutable std::recursive_mutex _regionUpdateLock;
+    mutable std::shared_mutex _dynamicTreeLock;
+    mutable std::mutex _navMeshQueryLock;
+    // Objects of the current tick that are not in any region, reused between ticks
+    UpdatableObjectList _serialUpdatableObjects;
 };
 
 enum InstanceResetMethod
@@ -58,7 +58,7 @@ void MapMgr::Initialize()
 
     // Start mtmaps if needed
     if (num_threads > 0)
-        m_updater.activate(num_threads);
+        m_updater.activate(num_threads, sWorld->getBoolConfig(CONFIG_MAP_UPDATE_AFFINITY));
 }
 
 void MapMgr::InitializeVisibilityDistanceInfo()
@@ -276,7 +276,10 @@ void MapMgr::Update(uint32 diff)
     }
 
     if (m_updater.activated())
+    {
         m_updater.wait();
+        m_updater.LogWorkerMetrics();
+    }
 
     if (mapUpdateStep < 3)
     {
@@ -30,25 +30,39 @@ public:
     virtual ~UpdateRequest() = default;
 
     virtual void call() = 0;
+
+    // Invoked by the worker once call() returned, pooled requests hand themselves back here
+    virtual void release() { delete this; }
 };
 
 class MapUpdateRequest : public UpdateRequest
 {
 public:
     MapUpdateRequest(Map& m, MapUpdater& u, uint32 d, uint32 sd)
-        : m_map(m), m_updater(u), m_diff(d), s_diff(sd)
+        : m_map(&m), m_updater(u), m_diff(d), s_diff(sd)
+    {
+    }
+
+    void Reset(Map& m, uint32 d, uint32 sd)
     {
+        m_map = &m;
+        m_diff = d;
+        s_diff = sd;
     }
 
     void call() override
     {
-        METRIC_TIMER("map_update_time_diff", METRIC_TAG("map_id", std::to_string(m_map.GetId())));
-        m_map.Update(m_diff, s_diff);
-        m_updater.update_finished();
+        METRIC_RECORD_TIMER(m_map->GetUpdateTimeMetric());
+        m_map->Update(m_diff, s_diff);
+    }
+
+    void release() override
+    {
+        m_updater.release_map_request(this);
     }
 
 private:
-    Map& m_map;
+    Map* m_map;
     MapUpdater& m_updater;
     uint32 m_diff;
     uint32 s_diff;
@@ -57,8 +71,8 @@ private:
 class MapPreloadRequest : public UpdateRequest
 {
 public:
-    MapPreloadRequest(uint32 mapId, MapUpdater& updater)
-        : _mapId(mapId), _updater(updater)
+    MapPreloadRequest(uint32 mapId)
+        : _mapId(mapId)
     {
     }
 
@@ -67,49 +81,79 @@ public:
         Map* map = sMapMgr->CreateBaseMap(_mapId);
         LOG_INFO("server.loading", ">> Loading All Grids For Map {} ({})", map->GetId(), map->GetMapName());
         map->LoadAllGrids();
-        _updater.update_finished();
     }
 
 private:
     uint32 _mapId;
-    MapUpdater& _updater;
 };
 
 class LFGUpdateRequest : public UpdateRequest
 {
 public:
-    LFGUpdateRequest(MapUpdater& u, uint32 d) : m_updater(u), m_diff(d) {}
+    LFGUpdateRequest(uint32 d) : m_diff(d) {}
 
     void call() override
     {
         sLFGMgr->Update(m_diff, 1);
-        m_updater.update_finished();
     }
 private:
-    MapUpdater& m_updater;
     uint32 m_diff;
 };
 
-MapUpdater::MapUpdater() : pending_requests(0), _cancelationToken(false)
+class MapHelperRequest : public UpdateRequest
+{
+public:
+    MapHelperRequest(std::function<void()> const& work) : _work(work) {}
+
+    void call() override
+    {
+        _work();
+    }
+
+private:
+    std::function<void()> _work;
+};
+
+MapUpdater::MapUpdater() : _nextWorker(0), _mapAffinity(false), pending_requests(0), _cancelationToken(false),
+    _queuedRequests(0), _sleepingWorkers(0)
 {
 }
 
-void MapUpdater::activate(std::size_t num_threads)
+MapUpdater::~MapUpdater()
 {
+    for (MapUpdateRequest* request : _mapRequestPool)
+        delete request;
+}
+
+void MapUpdater::activate(std::size_t num_threads, bool mapAffinity)
+{
+    _mapAffinity = mapAffinity;
+
+    _workers.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+        _workers.push_back(std::make_unique<Worker>());
+        _workers.back()->MetricTag = std::to_string(i);
+    }
+
     _workerThreads.reserve(num_threads);
     for (std::size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
 void MapUpdater::deactivate()
 {
-    _cancelationToken = true;
-
     wait();  // This is where we wait for tasks to complete
 
-    _queue.Cancel();  // Cancel the queue to prevent further task processing
+    _cancelationToken = true;
+
+    {
+        // Wake up sleeping workers so they can observe the cancellation
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _sleepCondition.notify_all();
+    }
 
     // Join all worker threads
     for (auto& thread : _workerThreads)
@@ -119,6 +163,15 @@ void MapUpdater::deactivate()
             thread.join();
         }
     }
+
+    // Requests left behind by the cancellation are never executed
+    for (auto& worker : _workers)
+    {
+        for (UpdateRequest* request : worker->Requests)
+            request->release();
+
+        worker->Requests.clear();
+    }
 }
 
 void MapUpdater::wait()
@@ -132,25 +185,66 @@ void MapUpdater::wait()
 }
 
 void MapUpdater::schedule_task(UpdateRequest* request)
+{
+    schedule_task(request, SelectWorker());
+}
+
+void MapUpdater::schedule_task(UpdateRequest* request, std::size_t workerIndex)
 {
     // Atomic increment for pending_requests
     pending_requests.fetch_add(1, std::memory_order_release);
-    _queue.Push(request);
+
+    {
+        Worker& worker = *_workers[workerIndex];
+        std::lock_guard<std::mutex> lock(worker.Lock);
+        worker.Requests.push_back(request);
+    }
+
+    // Only touch the sleep lock when somebody actually sleeps, both counters are sequentially
+    // consistent so either the worker sees the queued request or we see the sleeping worker
+    ++_queuedRequests;
+    if (_sleepingWorkers.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _sleepCondition.notify_all();
+    }
 }
 
 void MapUpdater::schedule_update(Map& map, uint32 diff, uint32 s_diff)
 {
-    schedule_task(new MapUpdateRequest(map, *this, diff, s_diff));
+    MapUpdateRequest* request = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(_mapRequestPoolLock);
+        if (!_mapRequestPool.empty())
+        {
+            request = _mapRequestPool.back();
+            _mapRequestPool.pop_back();
+        }
+    }
+
+    if (request)
+        request->Reset(map, diff, s_diff);
+    else
+        request = new MapUpdateRequest(map, *this, diff, s_diff);
+
+    schedule_task(request, SelectWorker(map));
 }
 
 void MapUpdater::schedule_map_preload(uint32 mapid)
 {
-    schedule_task(new MapPreloadRequest(mapid, *this));
+    schedule_task(new MapPreloadRequest(mapid));
 }
 
 void MapUpdater::schedule_lfg_update(uint32 diff)
 {
-    schedule_task(new LFGUpdateRequest(*this, diff));
+    schedule_task(new LFGUpdateRequest(diff));
+}
+
+void MapUpdater::schedule_helpers(std::function<void()> const& work, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        schedule_task(new MapHelperRequest(work));
 }
 
 bool MapUpdater::activated()
@@ -169,22 +263,130 @@ void MapUpdater::update_finished()
     }
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::release_map_request(MapUpdateRequest* request)
+{
+    std::lock_guard<std::mutex> lock(_mapRequestPoolLock);
+    _mapRequestPool.push_back(request);
+}
+
+void MapUpdater::LogWorkerMetrics()
+{
+    for (auto const& worker : _workers)
+    {
+        [[maybe_unused]] uint64 busyTime = worker->BusyTime.exchange(0, std::memory_order_relaxed);
+        [[maybe_unused]] uint64 idleTime = worker->IdleTime.exchange(0, std::memory_order_relaxed);
+        [[maybe_unused]] uint32 executed = worker->Executed.exchange(0, std::memory_order_relaxed);
+        [[maybe_unused]] uint32 steals = worker->Steals.exchange(0, std::memory_order_relaxed);
+
+        METRIC_VALUE("map_updater_busy_time", busyTime, METRIC_TAG("worker", worker->MetricTag));
+        METRIC_VALUE("map_updater_idle_time", idleTime, METRIC_TAG("worker", worker->MetricTag));
+        METRIC_VALUE("map_updater_requests", executed, METRIC_TAG("worker", worker->MetricTag));
+        METRIC_VALUE("map_updater_steals", steals, METRIC_TAG("worker", worker->MetricTag));
+    }
+}
+
+std::size_t MapUpdater::SelectWorker(Map const& map)
+{
+    if (!_mapAffinity)
+        return SelectWorker();
+
+    // Keep every map/instance on the same worker tick after tick so its grids stay warm in that core's cache
+    uint32 key = map.GetId() * 0x9E3779B1u + map.GetInstanceId();
+    return key % _workers.size();
+}
+
+UpdateRequest* MapUpdater::PopOwnRequest(std::size_t workerIndex)
+{
+    Worker& worker = *_workers[workerIndex];
+    std::lock_guard<std::mutex> lock(worker.Lock);
+    if (worker.Requests.empty())
+        return nullptr;
+
+    UpdateRequest* request = worker.Requests.front();
+    worker.Requests.pop_front();
+    return request;
+}
+
+UpdateRequest* MapUpdater::StealRequest(std::size_t thiefIndex)
+{
+    for (std::size_t i = 1; i < _workers.size(); ++i)
+    {
+        Worker& victim = *_workers[(thiefIndex + i) % _workers.size()];
+
+        // An idle owner will pick up its own requests, stealing from it would only break the affinity
+        if (!victim.Busy.load(std::memory_order_acquire))
+            continue;
+
+        std::lock_guard<std::mutex> lock(victim.Lock);
+        if (victim.Requests.empty())
+            continue;
+
+        UpdateRequest* request = victim.Requests.back();
+        victim.Requests.pop_back();
+        return request;
+    }
+
+    return nullptr;
+}
+
+void MapUpdater::WorkerThread(std::size_t workerIndex)
 {
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
 
+    Worker& worker = *_workers[workerIndex];
+    TimePoint idleStart = std::chrono::steady_clock::now();
+
     while (!_cancelationToken)
     {
-        UpdateRequest* request = nullptr;
+        UpdateRequest* request = PopOwnRequest(workerIndex);
+        if (!request)
+        {
+            request = StealRequest(workerIndex);
+            if (request)
+                ++worker.Steals;
+        }
 
-        _queue.WaitAndPop(request);  // Wait for and pop a request from the queue
+        if (!request)
+        {
+            // Requests are queued but their owners are about to pick them up
+            if (_queuedRequests.load() > 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_sleepLock);
+            ++_sleepingWorkers;
+            _sleepCondition.wait(lock, [this] {
+                return _queuedRequests.load() > 0 || _cancelationToken;
+            });
+            --_sleepingWorkers;
+            continue;
+        }
 
-        if (!_cancelationToken && request)
+        --_queuedRequests;
+
+        if (_cancelationToken)
         {
-            request->call();  // Execute the request
-            delete request;  // Clean up after processing
+            request->release();
+            update_finished();
+            break;
         }
+
+        worker.Busy.store(true, std::memory_order_release);
+        TimePoint busyStart = std::chrono::steady_clock::now();
+        worker.IdleTime += std::chrono::duration_cast<Microseconds>(busyStart - idleStart).count();
+
+        request->call();  // Execute the request
+        request->release();  // Clean up or recycle after processing
+
+        idleStart = std::chrono::steady_clock::now();
+        worker.BusyTime += std::chrono::duration_cast<Microseconds>(idleStart - busyStart).count();
+        ++worker.Executed;
+        worker.Busy.store(false, std::memory_order_release);
+
+        update_finished();
     }
 }
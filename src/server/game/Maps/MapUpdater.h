@@ -19,38 +19,86 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
-#include "PCQueue.h"
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
-#include <atomic>
+#include <vector>
 
 class Map;
 class UpdateRequest;
+class MapUpdateRequest;
 
 class MapUpdater
 {
 public:
     MapUpdater();
-    ~MapUpdater() = default;
+    ~MapUpdater();
 
     void schedule_task(UpdateRequest* request);
     void schedule_update(Map& map, uint32 diff, uint32 s_diff);
     void schedule_map_preload(uint32 mapid);
     void schedule_lfg_update(uint32 diff);
+    // Queues `count` requests that each run `work`, used by a map to spread its own update over idle threads
+    void schedule_helpers(std::function<void()> const& work, std::size_t count);
     void wait();
-    void activate(std::size_t num_threads);
+    void activate(std::size_t num_threads, bool mapAffinity = false);
     void deactivate();
     bool activated();
+    std::size_t thread_count() const { return _workerThreads.size(); }
     void update_finished();
 
+    void release_map_request(MapUpdateRequest* request);
+
+    // Sends busy/idle time, executed requests and steals of every worker since the previous call
+    void LogWorkerMetrics();
+
 private:
-    void WorkerThread();
-    ProducerConsumerQueue<UpdateRequest*> _queue;
+    // Each worker owns a deque: it pops its own requests from the front and
+    // idle workers steal from the back of busy workers' deques.
+    struct Worker
+    {
+        std::mutex Lock;
+        std::deque<UpdateRequest*> Requests;
+        std::atomic<bool> Busy{ false };
+
+        std::atomic<uint64> BusyTime{ 0 }; // microseconds
+        std::atomic<uint64> IdleTime{ 0 }; // microseconds
+        std::atomic<uint32> Executed{ 0 };
+        std::atomic<uint32> Steals{ 0 };
+        std::string MetricTag;
+    };
+
+    void WorkerThread(std::size_t workerIndex);
+    void schedule_task(UpdateRequest* request, std::size_t workerIndex);
+    std::size_t SelectWorker() { return _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size(); }
+    std::size_t SelectWorker(Map const& map);
+    UpdateRequest* PopOwnRequest(std::size_t workerIndex);
+    UpdateRequest* StealRequest(std::size_t thiefIndex);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _workerThreads;
+    std::atomic<std::size_t> _nextWorker;
+    bool _mapAffinity;
+
     std::atomic<int> pending_requests;  // Use std::atomic for pending_requests to avoid lock contention
     std::atomic<bool> _cancelationToken;  // Atomic flag for cancellation to avoid race conditions
-    std::vector<std::thread> _workerThreads;
     std::mutex _lock; // Mutex and condition variable for synchronization
     std::condition_variable _condition;
+
+    // Idle workers sleep here until a request is queued anywhere
+    std::atomic<uint32> _queuedRequests;
+    std::atomic<uint32> _sleepingWorkers;
+    std::mutex _sleepLock;
+    std::condition_variable _sleepCondition;
+
+    // MapUpdateRequest objects are recycled across ticks instead of new/delete per map per tick
+    std::mutex _mapRequestPoolLock;
+    std::vector<MapUpdateRequest*> _mapRequestPool;
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
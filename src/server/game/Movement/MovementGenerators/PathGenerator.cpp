@@ -83,6 +83,8 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
         return true;
     }
 
+    auto guard = _source->GetMap()->LockNavMeshQuery();
+
     UpdateFilter();
 
     BuildPolyPath(start, dest);
@@ -0,0 +1,606 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterRequestParser.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // Guards SkipValue() recursion against hostile bodies like [[[[[[...
+    constexpr uint32 JSON_MAX_DEPTH = 64;
+
+    /*
+     * Recursive descent reader over the raw body. Values are consumed as they are met and written
+     * straight into the request fields, nothing is materialized in between. Strings without escape
+     * sequences are appended to their destination in one go.
+     */
+    class CharacterRequestReader
+    {
+    public:
+        explicit CharacterRequestReader(std::string_view json) : _json(json), _pos(0), _depth(0), _error(nullptr), _errorPos(0) { }
+
+        bool Read(CharacterRequest& request)
+        {
+            SkipWhitespace();
+            if (!Peek('{'))
+                return Fail("expected '{' at the start of the request");
+
+            return ReadRequest(request) && ReadEnd();
+        }
+
+        bool ReadBatch(std::vector<CharacterRequest>& requests)
+        {
+            SkipWhitespace();
+            if (!Peek('{'))
+                return Fail("expected '{' at the start of the request");
+
+            bool result = ReadObject([&](std::string_view key)
+            {
+                if (key == "characters")
+                {
+                    return ReadArray([&]()
+                    {
+                        SkipWhitespace();
+                        if (!Peek('{'))
+                            return Fail("expected a character object");
+
+                        return ReadRequest(requests.emplace_back());
+                    });
+                }
+                return SkipValue();
+            });
+
+            return result && ReadEnd();
+        }
+
+        char const* GetError() const { return _error; }
+        std::size_t GetErrorOffset() const { return _errorPos; }
+
+    private:
+        bool ReadRequest(CharacterRequest& request)
+        {
+            bool hasCharacter = false;
+            bool result = ReadObject([&](std::string_view key)
+            {
+                if (key == "name")
+                    return ReadString(request.name);
+                if (key == "phase")
+                    return ReadUInt32(request.phase);
+                if (key == "character")
+                {
+                    hasCharacter = true;
+                    return ReadCharacter(request.character);
+                }
+                if (key == "items")
+                    return ReadArray([&]() { return ReadItem(request.items.emplace_back()); });
+                if (key == "talents")
+                    return ReadArray([&]() { return ReadTalent(request.talents.emplace_back()); });
+                if (key == "glyphs")
+                    return ReadArray([&]() { return ReadGlyph(request.glyphs.emplace_back()); });
+                return SkipValue();
+            });
+
+            if (result && !hasCharacter)
+                request.character.name = request.name;
+
+            return result;
+        }
+
+        bool ReadEnd()
+        {
+            SkipWhitespace();
+            if (_pos != _json.size())
+                return Fail("unexpected data after the request object");
+
+            return true;
+        }
+
+        bool ReadCharacter(CharacterData& character)
+        {
+            return ReadObject([&](std::string_view key)
+            {
+                if (key == "name")
+                    return ReadString(character.name);
+                if (key == "level")
+                    return ReadUInt32(character.level);
+                if (key == "gameClass")
+                    return ReadString(character.gameClass);
+                if (key == "race")
+                    return ReadString(character.race);
+                if (key == "faction")
+                    return ReadString(character.faction);
+                return SkipValue();
+            });
+        }
+
+        bool ReadItem(ItemData& item)
+        {
+            return ReadObject([&](std::string_view key)
+            {
+                if (key == "name")
+                    return ReadString(item.name);
+                if (key == "id")
+                    return ReadUInt32(item.id);
+                if (key == "slot")
+                    return ReadString(item.slot);
+                if (key == "enchant")
+                {
+                    return ReadObject([&](std::string_view enchantKey)
+                    {
+                        if (enchantKey == "name")
+                            return ReadString(item.enchant.name);
+                        if (enchantKey == "id")
+                            return ReadUInt32(item.enchant.id);
+                        if (enchantKey == "itemId")
+                            return ReadUInt32(item.enchant.itemId);
+                        if (enchantKey == "spellId")
+                            return ReadUInt32(item.enchant.spellId);
+                        return SkipValue();
+                    });
+                }
+                return SkipValue();
+            });
+        }
+
+        bool ReadTalent(TalentData& talent)
+        {
+            return ReadObject([&](std::string_view key)
+            {
+                if (key == "name")
+                    return ReadString(talent.name);
+                if (key == "id")
+                    return ReadUInt32(talent.id);
+                if (key == "rank")
+                    return ReadUInt32(talent.rank);
+                if (key == "spellId")
+                    return ReadUInt32(talent.spellId);
+                return SkipValue();
+            });
+        }
+
+        bool ReadGlyph(GlyphData& glyph)
+        {
+            return ReadObject([&](std::string_view key)
+            {
+                if (key == "name")
+                    return ReadString(glyph.name);
+                if (key == "id")
+                    return ReadUInt32(glyph.id);
+                if (key == "type")
+                    return ReadString(glyph.type);
+                return SkipValue();
+            });
+        }
+
+        bool Fail(char const* message)
+        {
+            if (!_error)
+            {
+                _error = message;
+                _errorPos = _pos;
+            }
+
+            return false;
+        }
+
+        void SkipWhitespace()
+        {
+            while (_pos < _json.size() && (_json[_pos] == ' ' || _json[_pos] == '\t' || _json[_pos] == '\n' || _json[_pos] == '\r'))
+                ++_pos;
+        }
+
+        bool Peek(char c) const { return _pos < _json.size() && _json[_pos] == c; }
+
+        // Consumes the given token after optional whitespace
+        bool Consume(char c)
+        {
+            SkipWhitespace();
+            if (!Peek(c))
+                return false;
+
+            ++_pos;
+            return true;
+        }
+
+        bool ConsumeLiteral(std::string_view literal)
+        {
+            if (_json.compare(_pos, literal.size(), literal) != 0)
+                return false;
+
+            _pos += literal.size();
+            return true;
+        }
+
+        // null is accepted for every field and leaves it untouched
+        bool ConsumeNull()
+        {
+            SkipWhitespace();
+            return ConsumeLiteral("null");
+        }
+
+        template<class KeyHandler>
+        bool ReadObject(KeyHandler&& handler)
+        {
+            if (ConsumeNull())
+                return true;
+
+            if (!Consume('{'))
+                return Fail("expected an object");
+
+            if (++_depth > JSON_MAX_DEPTH)
+                return Fail("nesting too deep");
+
+            if (!Consume('}'))
+            {
+                do
+                {
+                    SkipWhitespace();
+                    std::string_view key;
+                    if (!ReadKey(key))
+                        return false;
+
+                    if (!Consume(':'))
+                        return Fail("expected ':' after object key");
+
+                    if (!handler(key))
+                        return false;
+                } while (Consume(','));
+
+                if (!Consume('}'))
+                    return Fail("expected ',' or '}' in object");
+            }
+
+            --_depth;
+            return true;
+        }
+
+        template<class ElementHandler>
+        bool ReadArray(ElementHandler&& handler)
+        {
+            if (ConsumeNull())
+                return true;
+
+            if (!Consume('['))
+                return Fail("expected an array");
+
+            if (++_depth > JSON_MAX_DEPTH)
+                return Fail("nesting too deep");
+
+            if (!Consume(']'))
+            {
+                do
+                {
+                    if (!handler())
+                        return false;
+                } while (Consume(','));
+
+                if (!Consume(']'))
+                    return Fail("expected ',' or ']' in array");
+            }
+
+            --_depth;
+            return true;
+        }
+
+        // Keys point into the body unless they contain escapes, then into _keyBuffer
+        bool ReadKey(std::string_view& key)
+        {
+            if (!Peek('"'))
+                return Fail("expected a string as object key");
+
+            std::size_t start = _pos + 1;
+            std::size_t end = start;
+            while (end < _json.size() && _json[end] != '"' && _json[end] != '\\')
+                ++end;
+
+            if (end < _json.size() && _json[end] == '"')
+            {
+                key = _json.substr(start, end - start);
+                _pos = end + 1;
+                return true;
+            }
+
+            _keyBuffer.clear();
+            if (!ReadStringContent(_keyBuffer))
+                return false;
+
+            key = _keyBuffer;
+            return true;
+        }
+
+        bool ReadString(std::string& out)
+        {
+            if (ConsumeNull())
+                return true;
+
+            if (!Peek('"'))
+                return Fail("expected a string");
+
+            out.clear();
+            return ReadStringContent(out);
+        }
+
+        // Expects _pos on the opening quote, appends the decoded content to out
+        bool ReadStringContent(std::string& out)
+        {
+            ++_pos;
+            for (;;)
+            {
+                std::size_t start = _pos;
+                while (_pos < _json.size() && _json[_pos] != '"' && _json[_pos] != '\\' && static_cast<uint8>(_json[_pos]) >= 0x20)
+                    ++_pos;
+
+                out.append(_json.data() + start, _pos - start);
+
+                if (_pos >= _json.size())
+                    return Fail("unterminated string");
+
+                char c = _json[_pos];
+                if (c == '"')
+                {
+                    ++_pos;
+                    return true;
+                }
+
+                if (c != '\\')
+                    return Fail("control character in string");
+
+                if (++_pos >= _json.size())
+                    return Fail("unterminated string");
+
+                switch (_json[_pos++])
+                {
+                    case '"':  out += '"';  break;
+                    case '\\': out += '\\'; break;
+                    case '/':  out += '/';  break;
+                    case 'b':  out += '\b'; break;
+                    case 'f':  out += '\f'; break;
+                    case 'n':  out += '\n'; break;
+                    case 'r':  out += '\r'; break;
+                    case 't':  out += '\t'; break;
+                    case 'u':
+                        if (!ReadUnicodeEscape(out))
+                            return false;
+                        break;
+                    default:
+                        --_pos;
+                        return Fail("invalid escape sequence");
+                }
+            }
+        }
+
+        bool ReadHex4(uint32& value)
+        {
+            if (_pos + 4 > _json.size())
+                return Fail("invalid unicode escape");
+
+            value = 0;
+            for (std::size_t i = 0; i < 4; ++i, ++_pos)
+            {
+                char c = _json[_pos];
+                value <<= 4;
+                if (c >= '0' && c <= '9')
+                    value |= c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    value |= c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    value |= c - 'A' + 10;
+                else
+                    return Fail("invalid unicode escape");
+            }
+
+            return true;
+        }
+
+        // Decodes \uXXXX (after the 'u'), including surrogate pairs, as UTF-8
+        bool ReadUnicodeEscape(std::string& out)
+        {
+            uint32 codePoint;
+            if (!ReadHex4(codePoint))
+                return false;
+
+            if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+                return Fail("unpaired surrogate in unicode escape");
+
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+            {
+                uint32 low;
+                if (!ConsumeLiteral("\\u") || !ReadHex4(low) || low < 0xDC00 || low > 0xDFFF)
+                    return Fail("unpaired surrogate in unicode escape");
+
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+
+            if (codePoint < 0x80)
+                out += static_cast<char>(codePoint);
+            else if (codePoint < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (codePoint >> 6));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (codePoint >> 12));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (codePoint >> 18));
+                out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+
+            return true;
+        }
+
+        bool IsDigit() const { return _pos < _json.size() && _json[_pos] >= '0' && _json[_pos] <= '9'; }
+
+        bool ReadUInt32(uint32& out)
+        {
+            if (ConsumeNull())
+                return true;
+
+            if (Peek('-'))
+                return Fail("expected a non-negative integer");
+
+            if (!IsDigit())
+                return Fail("expected a number");
+
+            if (Peek('0') && _pos + 1 < _json.size() && _json[_pos + 1] >= '0' && _json[_pos + 1] <= '9')
+                return Fail("leading zeros are not allowed");
+
+            uint64 value = 0;
+            std::size_t start = _pos;
+            while (IsDigit())
+            {
+                value = value * 10 + (_json[_pos++] - '0');
+                if (value > std::numeric_limits<uint32>::max())
+                {
+                    _pos = start;
+                    return Fail("number out of range");
+                }
+            }
+
+            if (Peek('.') || Peek('e') || Peek('E'))
+                return Fail("expected an integer");
+
+            out = static_cast<uint32>(value);
+            return true;
+        }
+
+        // Validates and skips any JSON value of a key the request does not use
+        bool SkipValue()
+        {
+            SkipWhitespace();
+            if (_pos >= _json.size())
+                return Fail("unexpected end of data");
+
+            switch (_json[_pos])
+            {
+                case '{':
+                    return ReadObject([this](std::string_view) { return SkipValue(); });
+                case '[':
+                    return ReadArray([this]() { return SkipValue(); });
+                case '"':
+                    _skipBuffer.clear();
+                    return ReadStringContent(_skipBuffer);
+                case 't':
+                    return ConsumeLiteral("true") || Fail("invalid literal");
+                case 'f':
+                    return ConsumeLiteral("false") || Fail("invalid literal");
+                case 'n':
+                    return ConsumeLiteral("null") || Fail("invalid literal");
+                default:
+                    break;
+            }
+
+            // number: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+            if (Peek('-'))
+                ++_pos;
+
+            if (Peek('0'))
+                ++_pos;
+            else if (IsDigit())
+            {
+                while (IsDigit())
+                    ++_pos;
+            }
+            else
+                return Fail("unexpected character");
+
+            if (Peek('.'))
+            {
+                ++_pos;
+                if (!IsDigit())
+                    return Fail("expected digits after decimal point");
+
+                while (IsDigit())
+                    ++_pos;
+            }
+
+            if (Peek('e') || Peek('E'))
+            {
+                ++_pos;
+                if (Peek('+') || Peek('-'))
+                    ++_pos;
+
+                if (!IsDigit())
+                    return Fail("expected digits in exponent");
+
+                while (IsDigit())
+                    ++_pos;
+            }
+
+            return true;
+        }
+
+        std::string_view _json;
+        std::size_t _pos;
+        uint32 _depth;
+        char const* _error;
+        std::size_t _errorPos;
+        std::string _keyBuffer;
+        std::string _skipBuffer;
+    };
+}
+
+std::string CharacterRequestParseError::ToString() const
+{
+    return Acore::StringFormat("{} at line {}, column {}", Message, Line, Column);
+}
+
+static void FillParseError(std::string_view json, CharacterRequestReader const& reader, CharacterRequestParseError& error)
+{
+    error.Offset = std::min(reader.GetErrorOffset(), json.size());
+    error.Message = reader.GetError();
+    error.Line = 1;
+    error.Column = 1;
+    for (std::size_t i = 0; i < error.Offset; ++i)
+    {
+        if (json[i] == '\n')
+        {
+            ++error.Line;
+            error.Column = 1;
+        }
+        else
+            ++error.Column;
+    }
+}
+
+bool ParseCharacterRequest(std::string_view json, CharacterRequest& request, CharacterRequestParseError& error)
+{
+    CharacterRequestReader reader(json);
+    if (reader.Read(request))
+        return true;
+
+    FillParseError(json, reader, error);
+    return false;
+}
+
+bool ParseCharacterBatchRequest(std::string_view json, std::vector<CharacterRequest>& requests, CharacterRequestParseError& error)
+{
+    CharacterRequestReader reader(json);
+    if (reader.ReadBatch(requests))
+        return true;
+
+    FillParseError(json, reader, error);
+    return false;
+}
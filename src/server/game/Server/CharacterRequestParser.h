@@ -0,0 +1,97 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHARACTER_REQUEST_PARSER_H
+#define CHARACTER_REQUEST_PARSER_H
+
+#include "Define.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct ItemData
+{
+    std::string name;
+    uint32 id = 0;
+    std::string slot;
+    struct EnchantData {
+        std::string name;
+        uint32 id = 0;
+        uint32 itemId = 0;
+        uint32 spellId = 0;
+    } enchant;
+};
+
+struct TalentData
+{
+    std::string name;
+    uint32 id = 0;
+    uint32 rank = 0;
+    uint32 spellId = 0;
+};
+
+struct GlyphData
+{
+    std::string name;
+    uint32 id = 0;
+    std::string type; // MAJOR or MINOR
+};
+
+struct CharacterData
+{
+    std::string name;
+    uint32 level = 0;
+    std::string gameClass;
+    std::string race;
+    std::string faction;
+};
+
+struct CharacterRequest
+{
+    std::string name;
+    uint32 phase = 0;
+    CharacterData character;
+    std::vector<ItemData> items;
+    std::vector<TalentData> talents;
+    std::vector<GlyphData> glyphs;
+};
+
+struct CharacterRequestParseError
+{
+    std::size_t Offset = 0; // byte offset of the error in the body
+    uint32 Line = 0;        // 1-based
+    uint32 Column = 0;      // 1-based, in bytes
+    std::string Message;
+
+    std::string ToString() const;
+};
+
+/**
+ * @brief Parses a character web service JSON body in a single pass, filling the request directly.
+ *
+ * Unknown keys are skipped, null values leave the field at its default. Numeric fields must be
+ * non-negative integers fitting in 32 bits. When the body has no "character" object the top level
+ * "name" is used as character name.
+ *
+ * @return false if the body is not valid JSON or a field has the wrong type, error then holds the position.
+ */
+bool ParseCharacterRequest(std::string_view json, CharacterRequest& request, CharacterRequestParseError& error);
+
+/// Parses a batch body of the form {"characters": [request, request, ...]}, see ParseCharacterRequest()
+bool ParseCharacterBatchRequest(std::string_view json, std::vector<CharacterRequest>& requests, CharacterRequestParseError& error);
+
+#endif // CHARACTER_REQUEST_PARSER_H
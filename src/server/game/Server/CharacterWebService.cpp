@@ -29,16 +29,174 @@
 #include "DatabaseEnv.h"
 #include "ObjectGuid.h"
 #include "CharacterCache.h"
+#include "StringFormat.h"
 #include <boost/beast/version.hpp>
+#include <deque>
 #include <sstream>
-#include <thread>
-#include <regex>
 #include <unordered_map>
 #include <random>
 
-CharacterWebService::CharacterWebService(Acore::Asio::IoContext& ioContext, uint16 port)
-    : _ioContext(ioContext), _acceptor(ioContext, tcp::endpoint(tcp::v4(), port)), _port(port), _running(false)
+// Maximum number of requests read ahead of their responses on a single keep-alive connection
+static constexpr std::size_t WEB_SERVICE_PIPELINE_LIMIT = 8;
+static constexpr uint64 WEB_SERVICE_BODY_LIMIT = 1024 * 1024;
+// Item guids reserved from the item guid generator at once by each worker thread
+static constexpr uint32 WEB_SERVICE_ITEM_GUID_BLOCK = 256;
+// How often completed database transactions are checked for their responses
+static constexpr std::chrono::milliseconds WEB_SERVICE_CALLBACK_INTERVAL(10);
+
+class CharacterWebSession : public std::enable_shared_from_this<CharacterWebSession>
+{
+public:
+    CharacterWebSession(tcp::socket&& socket, CharacterWebService& service)
+        : _stream(std::move(socket)), _service(service), _firstSequence(0), _reading(false), _writing(false), _closing(false)
+    {
+    }
+
+    void Start()
+    {
+        boost::asio::dispatch(_stream.get_executor(), boost::beast::bind_front_handler(&CharacterWebSession::DoRead, shared_from_this()));
+    }
+
+private:
+    void DoRead()
+    {
+        // Stop reading ahead until the client consumed some responses
+        if (_closing || _responses.size() >= WEB_SERVICE_PIPELINE_LIMIT)
+        {
+            _reading = false;
+            return;
+        }
+
+        _reading = true;
+        _parser.emplace();
+        _parser->body_limit(WEB_SERVICE_BODY_LIMIT);
+        _stream.expires_after(std::chrono::seconds(_service._settings.ReadTimeout));
+        http::async_read(_stream, _buffer, *_parser, boost::beast::bind_front_handler(&CharacterWebSession::OnRead, shared_from_this()));
+    }
+
+    void OnRead(boost::beast::error_code ec, std::size_t /*bytesTransferred*/)
+    {
+        _reading = false;
+
+        if (ec == http::error::end_of_stream)
+        {
+            _closing = true;
+            if (_responses.empty())
+                DoClose();
+            return;
+        }
+
+        if (ec)
+        {
+            if (ec != boost::beast::error::timeout && ec != boost::asio::error::operation_aborted)
+                LOG_DEBUG("server.worldserver", "Character Web Service read error: {}", ec.message());
+
+            // Tell the client why before closing when the request itself was rejected, not the connection
+            if (ec == http::error::body_limit)
+                RejectRequest(http::status::payload_too_large, "{\"success\":false,\"error\":\"Request body too large\"}");
+            else if (ec.category() == http::make_error_code(http::error::bad_target).category() && ec != http::error::partial_message)
+                RejectRequest(http::status::bad_request, "{\"success\":false,\"error\":\"Malformed HTTP request\"}");
+
+            return;
+        }
+
+        CharacterWebService::Request request = _parser->release();
+        if (!request.keep_alive())
+            _closing = true;
+
+        // Responses are written back in request order, processing may finish in any order
+        std::size_t sequence = _firstSequence + _responses.size();
+        _responses.emplace_back();
+
+        _service.HandleRequest(std::move(request), [self = shared_from_this(), sequence](CharacterWebService::Response&& response)
+        {
+            boost::asio::post(self->_stream.get_executor(), [self, sequence, response = std::move(response)]() mutable
+            {
+                self->OnResponseReady(sequence, std::move(response));
+            });
+        });
+
+        DoRead();
+    }
+
+    // Queues an error response after the pending ones and closes the connection once it is written
+    void RejectRequest(http::status status, std::string body)
+    {
+        CharacterWebService::Request request;
+        request.version(11);
+        request.keep_alive(false);
+
+        _closing = true;
+        _responses.push_back(std::make_unique<CharacterWebService::Response>(CharacterWebService::BuildResponse(request, status, std::move(body))));
+        DoWrite();
+    }
+
+    void OnResponseReady(std::size_t sequence, CharacterWebService::Response&& response)
+    {
+        _responses[sequence - _firstSequence] = std::make_unique<CharacterWebService::Response>(std::move(response));
+        DoWrite();
+    }
+
+    void DoWrite()
+    {
+        if (_writing || _responses.empty() || !_responses.front())
+            return;
+
+        _writing = true;
+        _stream.expires_after(std::chrono::seconds(_service._settings.ReadTimeout));
+        http::async_write(_stream, *_responses.front(), boost::beast::bind_front_handler(&CharacterWebSession::OnWrite, shared_from_this()));
+    }
+
+    void OnWrite(boost::beast::error_code ec, std::size_t /*bytesTransferred*/)
+    {
+        _writing = false;
+
+        if (ec)
+        {
+            LOG_DEBUG("server.worldserver", "Character Web Service write error: {}", ec.message());
+            return;
+        }
+
+        bool needEof = _responses.front()->need_eof();
+        _responses.pop_front();
+        ++_firstSequence;
+
+        if (needEof || (_closing && _responses.empty()))
+        {
+            DoClose();
+            return;
+        }
+
+        DoWrite();
+
+        if (!_reading)
+            DoRead();
+    }
+
+    void DoClose()
+    {
+        boost::beast::error_code ec;
+        _stream.socket().shutdown(tcp::socket::shutdown_send, ec);
+    }
+
+    boost::beast::tcp_stream _stream;
+    boost::beast::flat_buffer _buffer;
+    std::optional<http::request_parser<http::string_body>> _parser;
+    CharacterWebService& _service;
+    std::deque<std::unique_ptr<CharacterWebService::Response>> _responses;
+    std::size_t _firstSequence;
+    bool _reading;
+    bool _writing;
+    bool _closing;
+};
+
+CharacterWebService::CharacterWebService(CharacterWebServiceSettings const& settings)
+    : _settings(settings), _ioContext(), _acceptor(_ioContext), _activeRequests(0), _callbackTimer(_ioContext), _running(false)
 {
+    _settings.NetworkThreads = std::max<uint32>(_settings.NetworkThreads, 1);
+    _settings.WorkerThreads = std::max<uint32>(_settings.WorkerThreads, 1);
+    _settings.MaxConcurrentRequests = std::max<uint32>(_settings.MaxConcurrentRequests, 1);
+    _settings.ReadTimeout = std::max<uint32>(_settings.ReadTimeout, 1);
 }
 
 CharacterWebService::~CharacterWebService()
@@ -50,9 +208,23 @@ bool CharacterWebService::Start()
 {
     try 
     {
+        tcp::endpoint endpoint(tcp::v4(), _settings.Port);
+        _acceptor.open(endpoint.protocol());
+        _acceptor.set_option(boost::asio::socket_base::reuse_address(true));
+        _acceptor.bind(endpoint);
+        _acceptor.listen(boost::asio::socket_base::max_listen_connections);
+
         _running = true;
+        _workGuard.emplace(_ioContext.get_executor());
+        _workerPool = std::make_unique<boost::asio::thread_pool>(_settings.WorkerThreads);
+
+        for (uint32 i = 0; i < _settings.NetworkThreads; ++i)
+            _networkThreads.emplace_back([this]() { _ioContext.run(); });
+
         DoAccept();
-        LOG_INFO("server.worldserver", "Character Web Service started on port {}", _port);
+        ScheduleCallbackProcessing();
+        LOG_INFO("server.worldserver", "Character Web Service started on port {} ({} network threads, {} worker threads, {} concurrent requests)",
+            _settings.Port, _settings.NetworkThreads, _settings.WorkerThreads, _settings.MaxConcurrentRequests);
         return true;
     }
     catch (std::exception const& e)
@@ -64,413 +236,424 @@ bool CharacterWebService::Start()
 
 void CharacterWebService::Stop()
 {
-    if (!_running)
+    if (!_running.exchange(false))
         return;
 
-    _running = false;
-    boost::system::error_code ec;
-    _acceptor.close(ec);
+    boost::asio::post(_acceptor.get_executor(), [this]()
+    {
+        boost::system::error_code ec;
+        _acceptor.close(ec);
+        _callbackTimer.cancel();
+    });
+
+    // Let requests being processed finish, their responses are dropped with the sessions below
+    if (_workerPool)
+        _workerPool->join();
+
+    _workGuard.reset();
+    _ioContext.stop();
+
+    for (std::thread& thread : _networkThreads)
+        if (thread.joinable())
+            thread.join();
+
+    _networkThreads.clear();
     LOG_INFO("server.worldserver", "Character Web Service stopped");
 }
 
 void CharacterWebService::DoAccept()
 {
-    _acceptor.async_accept(
+    _acceptor.async_accept(boost::asio::make_strand(_ioContext.get_executor()),
         [this](boost::system::error_code ec, tcp::socket socket)
         {
             if (!ec && _running)
-            {
-                std::thread(&CharacterWebService::HandleRequest, this, std::move(socket)).detach();
-            }
+                std::make_shared<CharacterWebSession>(std::move(socket), *this)->Start();
 
             if (_running)
                 DoAccept();
         });
 }
 
-void CharacterWebService::HandleRequest(tcp::socket socket)
+CharacterWebService::Response CharacterWebService::BuildResponse(Request const& request, http::status status, std::string body)
 {
-    try
-    {
-        boost::beast::flat_buffer buffer;
-        http::request<http::string_body> request;
-        
-        http::read(socket, buffer, request);
-
-        std::string response_body;
-        http::status status = http::status::ok;
-
-        if (request.method() == http::verb::post && request.target() == "/character/gear")
-        {
-            ProcessCharacterRequest(request.body(), response_body);
-        }
-        else
-        {
-            status = http::status::not_found;
-            response_body = "{\"error\":\"Endpoint not found\"}";
-        }
+    Response response{status, request.version()};
+    response.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+    response.set(http::field::content_type, "application/json");
+    response.set(http::field::access_control_allow_origin, "*");
+    response.keep_alive(request.keep_alive());
+    response.body() = std::move(body);
+    response.prepare_payload();
+    return response;
+}
 
-        http::response<http::string_body> response{status, request.version()};
-        response.set(http::field::server, BOOST_BEAST_VERSION_STRING);
-        response.set(http::field::content_type, "application/json");
-        response.set(http::field::access_control_allow_origin, "*");
-        response.body() = response_body;
-        response.prepare_payload();
+void CharacterWebService::HandleRequest(Request&& request, ResponseHandler&& handler)
+{
+    if (request.method() == http::verb::get && request.target() == "/status")
+    {
+        handler(BuildResponse(request, http::status::ok, Acore::StringFormat("{{\"activeRequests\":{},\"maxConcurrentRequests\":{}}}",
+            _activeRequests.load(), _settings.MaxConcurrentRequests)));
+        return;
+    }
 
-        http::write(socket, response);
-        socket.shutdown(tcp::socket::shutdown_send);
+    bool batch = request.target() == "/character/gear/batch";
+    if (request.method() != http::verb::post || (!batch && request.target() != "/character/gear"))
+    {
+        handler(BuildResponse(request, http::status::not_found, "{\"error\":\"Endpoint not found\"}"));
+        return;
     }
-    catch (std::exception const& e)
+
+    // Backpressure: refuse instead of queueing unbounded database work
+    if (_activeRequests.fetch_add(1) >= _settings.MaxConcurrentRequests)
     {
-        LOG_ERROR("server.worldserver", "Error handling web request: {}", e.what());
+        --_activeRequests;
+        Response response = BuildResponse(request, http::status::service_unavailable, "{\"success\":false,\"error\":\"Too many concurrent requests\"}");
+        response.set(http::field::retry_after, "1");
+        handler(std::move(response));
+        return;
     }
-}
 
-std::string CharacterWebService::ExtractJsonString(const std::string& json, const std::string& key)
-{
-    std::regex pattern("\"" + key + "\"\\s*:\\s*\"([^\"]+)\"");
-    std::smatch matches;
-    if (std::regex_search(json, matches, pattern))
-        return matches[1].str();
-    return "";
-}
+    boost::asio::post(*_workerPool, [this, batch, request = std::move(request), handler = std::move(handler)]() mutable
+    {
+        // The request stays in flight until its transaction completed, the body handler may run on a network thread
+        auto sharedRequest = std::make_shared<Request>(std::move(request));
+        auto responded = std::make_shared<std::atomic<bool>>(false);
+        BodyHandler bodyHandler = [this, sharedRequest, responded, handler = std::move(handler)](std::string&& responseBody)
+        {
+            if (responded->exchange(true))
+                return;
 
-uint32 CharacterWebService::ExtractJsonNumber(const std::string& json, const std::string& key)
-{
-    std::regex pattern("\"" + key + "\"\\s*:\\s*(\\d+)");
-    std::smatch matches;
-    if (std::regex_search(json, matches, pattern))
-        return std::stoul(matches[1].str());
-    return 0;
-}
+            --_activeRequests;
+            handler(BuildResponse(*sharedRequest, http::status::ok, std::move(responseBody)));
+        };
 
-std::vector<std::string> CharacterWebService::ExtractJsonArray(const std::string& json, const std::string& arrayName)
-{
-    std::vector<std::string> items;
-    std::regex arrayPattern("\"" + arrayName + "\"\\s*:\\s*\\[([^\\]]+)\\]");
-    std::smatch arrayMatch;
-    
-    if (std::regex_search(json, arrayMatch, arrayPattern))
-    {
-        std::string arrayContent = arrayMatch[1].str();
-        
-        // Parse JSON objects with proper brace matching to handle nested objects
-        size_t pos = 0;
-        while (pos < arrayContent.length())
+        try
         {
-            size_t start = arrayContent.find('{', pos);
-            if (start == std::string::npos) break;
-            
-            // Count braces to find the matching closing brace
-            int braceCount = 1;
-            size_t end = start + 1;
-            while (end < arrayContent.length() && braceCount > 0)
-            {
-                if (arrayContent[end] == '{') braceCount++;
-                else if (arrayContent[end] == '}') braceCount--;
-                end++;
-            }
-            
-            if (braceCount == 0)
-            {
-                std::string item = arrayContent.substr(start, end - start);
-                items.push_back(item);
-                pos = end;
-            }
+            if (batch)
+                ProcessBatchRequest(sharedRequest->body(), BodyHandler(bodyHandler));
             else
-            {
-                break; // Malformed JSON
-            }
+                ProcessCharacterRequest(sharedRequest->body(), BodyHandler(bodyHandler));
         }
-    }
-    
-    return items;
+        catch (std::exception const& e)
+        {
+            LOG_ERROR("server.worldserver", "Error handling web request: {}", e.what());
+            bodyHandler("{\"success\":false,\"error\":\"Internal error\"}");
+        }
+    });
 }
 
-void CharacterWebService::ProcessCharacterRequest(const std::string& body, std::string& response)
+void CharacterWebService::ScheduleCallbackProcessing()
 {
-    try
+    _callbackTimer.expires_after(WEB_SERVICE_CALLBACK_INTERVAL);
+    _callbackTimer.async_wait([this](boost::system::error_code const& ec)
     {
-        CharacterRequest request;
-        
-        // Extract basic character info
-        request.character.name = ExtractJsonString(body, "name");
-        request.phase = ExtractJsonNumber(body, "phase");
-        
-        // Extract character details from nested object
-        std::regex charPattern("\"character\"\\s*:\\s*\\{([^}]+)\\}");
-        std::smatch charMatch;
-        if (std::regex_search(body, charMatch, charPattern))
+        if (ec || !_running)
+            return;
+
         {
-            std::string charData = charMatch[1].str();
-            request.character.name = ExtractJsonString(charData, "name");
-            request.character.level = ExtractJsonNumber(charData, "level");
-            request.character.gameClass = ExtractJsonString(charData, "gameClass");
-            request.character.race = ExtractJsonString(charData, "race");
-            request.character.faction = ExtractJsonString(charData, "faction");
+            std::lock_guard<std::mutex> lock(_callbackLock);
+            _transactionCallbacks.ProcessReadyCallbacks();
         }
 
-        // Extract items array
-        std::vector<std::string> itemStrings = ExtractJsonArray(body, "items");
-        for (const auto& itemStr : itemStrings)
-        {            
-            ItemData item;
-            item.name = ExtractJsonString(itemStr, "name");
-            item.id = ExtractJsonNumber(itemStr, "id");
-            item.slot = ExtractJsonString(itemStr, "slot");
-            
-            // Extract enchant if present
-            std::regex enchantPattern("\"enchant\"\\s*:\\s*\\{([^}]+)\\}");
-            std::smatch enchantMatch;
-            if (std::regex_search(itemStr, enchantMatch, enchantPattern))
-            {
-                std::string enchantData = enchantMatch[1].str();
-                item.enchant.name = ExtractJsonString(enchantData, "name");
-                item.enchant.id = ExtractJsonNumber(enchantData, "id");
-                item.enchant.itemId = ExtractJsonNumber(enchantData, "itemId");
-                item.enchant.spellId = ExtractJsonNumber(enchantData, "spellId");
-            }
-            
-            request.items.push_back(item);
-        }
+        ScheduleCallbackProcessing();
+    });
+}
 
-        // Extract talents array if present
-        std::vector<std::string> talentStrings = ExtractJsonArray(body, "talents");
-        for (const auto& talentStr : talentStrings)
-        {
-            TalentData talent;
-            talent.name = ExtractJsonString(talentStr, "name");
-            talent.id = ExtractJsonNumber(talentStr, "id");
-            talent.rank = ExtractJsonNumber(talentStr, "rank");
-            talent.spellId = ExtractJsonNumber(talentStr, "spellId");
-            request.talents.push_back(talent);
-        }
+void CharacterWebService::ProcessCharacterRequest(const std::string& body, BodyHandler&& handler)
+{
+    CharacterRequest request;
+    CharacterRequestParseError error;
+    if (!ParseCharacterRequest(body, request, error))
+    {
+        LOG_DEBUG("server.worldserver", "Character Web Service rejected malformed request: {}", error.ToString());
+        handler(Acore::StringFormat("{{\"success\":false,\"error\":\"Invalid JSON: {}\",\"line\":{},\"column\":{}}}",
+            error.Message, error.Line, error.Column));
+        return;
+    }
 
-        // Extract glyphs array if present
-        std::vector<std::string> glyphStrings = ExtractJsonArray(body, "glyphs");
-        for (const auto& glyphStr : glyphStrings)
-        {
-            GlyphData glyph;
-            glyph.name = ExtractJsonString(glyphStr, "name");
-            glyph.id = ExtractJsonNumber(glyphStr, "id");
-            glyph.type = ExtractJsonString(glyphStr, "type");
-            request.glyphs.push_back(glyph);
-        }
+    std::vector<CharacterApplyResult> results(1);
+    CharacterApplyResult& result = results.front();
+    result.Name = request.character.name;
+
+    if (!ValidateCharacterRequest(request, result.Error))
+    {
+        LOG_ERROR("server.worldserver", "Character Web Service rejected character '{}': {}", request.character.name, result.Error);
+        handler(Acore::StringFormat("{{\"success\":false,\"character\":\"{}\",\"itemsApplied\":0,\"talentsApplied\":0,\"glyphsApplied\":0,\"error\":\"{}\"}}",
+            request.character.name, result.Error));
+        return;
+    }
+
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    std::unordered_set<uint32> clearedAccounts;
+    AppendCharacterToTransaction(request, trans, result, clearedAccounts);
+
+    CommitCharacters(trans, std::move(results), [handler = std::move(handler)](bool committed, std::vector<CharacterApplyResult>& results)
+    {
+        CharacterApplyResult const& result = results.front();
 
-        bool success = ApplyCharacterGear(request);
-        
         // Build response JSON manually
         std::ostringstream oss;
-        oss << "{\"success\":" << (success ? "true" : "false") 
-            << ",\"character\":\"" << request.character.name << "\""
-            << ",\"itemsApplied\":" << (success ? request.items.size() : 0)
-            << ",\"talentsApplied\":" << (success ? request.talents.size() : 0)
-            << ",\"glyphsApplied\":" << (success ? request.glyphs.size() : 0);
-        
-        if (success)
+        oss << "{\"success\":" << (committed ? "true" : "false")
+            << ",\"character\":\"" << result.Name << "\""
+            << ",\"itemsApplied\":" << (committed ? result.ItemsApplied : 0)
+            << ",\"talentsApplied\":" << (committed ? result.TalentsApplied : 0)
+            << ",\"glyphsApplied\":" << (committed ? result.GlyphsApplied : 0);
+
+        if (committed)
             oss << ",\"message\":\"Character configuration, gear, talents and glyphs updated successfully\"";
         else
             oss << ",\"error\":\"Failed to update character configuration, gear, talents and glyphs\"";
-            
+
         oss << "}";
-        response = oss.str();
+        handler(oss.str());
+    });
+}
+
+void CharacterWebService::ProcessBatchRequest(const std::string& body, BodyHandler&& handler)
+{
+    std::vector<CharacterRequest> requests;
+    CharacterRequestParseError error;
+    if (!ParseCharacterBatchRequest(body, requests, error))
+    {
+        LOG_DEBUG("server.worldserver", "Character Web Service rejected malformed batch request: {}", error.ToString());
+        handler(Acore::StringFormat("{{\"success\":false,\"error\":\"Invalid JSON: {}\",\"line\":{},\"column\":{}}}",
+            error.Message, error.Line, error.Column));
+        return;
     }
-    catch (std::exception const& e)
+
+    if (requests.empty() || requests.size() > _settings.MaxBatchSize)
+    {
+        handler(Acore::StringFormat("{{\"success\":false,\"error\":\"A batch must contain between 1 and {} characters\"}}", _settings.MaxBatchSize));
+        return;
+    }
+
+    // Invalid characters are reported individually, all valid ones go into a single transaction
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    std::vector<CharacterApplyResult> results(requests.size());
+    std::unordered_set<std::string> names;
+    std::unordered_set<uint32> clearedAccounts;
+
+    for (std::size_t i = 0; i < requests.size(); ++i)
     {
-        response = "{\"success\":false,\"error\":\"Processing error: " + std::string(e.what()) + "\"}";
+        CharacterRequest const& request = requests[i];
+        CharacterApplyResult& result = results[i];
+        result.Name = request.character.name;
+
+        if (!ValidateCharacterRequest(request, result.Error))
+            continue;
+
+        if (!names.insert(request.character.name).second)
+        {
+            result.Error = "Duplicate character name in batch";
+            continue;
+        }
+
+        AppendCharacterToTransaction(request, trans, result, clearedAccounts);
     }
+
+    LOG_INFO("server.worldserver", "Character Web Service committing batch of {} characters ({} rejected)", names.size(), requests.size() - names.size());
+
+    CommitCharacters(trans, std::move(results), [handler = std::move(handler)](bool committed, std::vector<CharacterApplyResult>& results)
+    {
+        std::size_t applied = 0;
+        std::string resultsJson;
+        for (CharacterApplyResult const& result : results)
+        {
+            if (!resultsJson.empty())
+                resultsJson += ',';
+
+            if (result.Error.empty())
+            {
+                ++applied;
+                resultsJson += Acore::StringFormat("{{\"character\":\"{}\",\"success\":true,\"guid\":{},\"itemsApplied\":{},\"talentsApplied\":{},\"glyphsApplied\":{}}}",
+                    result.Name, result.Guid, result.ItemsApplied, result.TalentsApplied, result.GlyphsApplied);
+            }
+            else
+                resultsJson += Acore::StringFormat("{{\"character\":\"{}\",\"success\":false,\"error\":\"{}\"}}", result.Name, result.Error);
+        }
+
+        handler(Acore::StringFormat("{{\"success\":{},\"committed\":{},\"charactersApplied\":{},\"charactersFailed\":{},\"results\":[{}]}}",
+            applied == results.size() ? "true" : "false", committed ? "true" : "false", applied, results.size() - applied, resultsJson));
+    });
 }
 
-bool CharacterWebService::ApplyCharacterGear(const CharacterRequest& request)
+bool CharacterWebService::ValidateCharacterRequest(const CharacterRequest& request, std::string& error)
 {
-    // First check if player is online - they must be OFFLINE
-    Player* player = ObjectAccessor::FindPlayerByName(request.character.name);
-    if (player)
+    if (request.character.name.empty())
     {
-        LOG_ERROR("server.worldserver", "Character '{}' must be offline for gear changes", request.character.name);
+        error = "Missing character name";
         return false;
     }
 
-    // Check if character exists and get account info
-    uint32 characterGuid = 0;
-    QueryResult result = CharacterDatabase.Query("SELECT guid, account FROM characters WHERE name = '{}'", request.character.name);
-    
-    uint32 accountId = 0;
-    bool characterExists = false;
-    
-    if (result)
-    {
-        Field* fields = result->Fetch();
-        characterGuid = fields[0].Get<uint32>();
-        accountId = fields[1].Get<uint32>();
-        characterExists = true;
-        
-        LOG_INFO("server.worldserver", "Found existing character '{}' with GUID {}, will delete and recreate", request.character.name, characterGuid);
-    }
-    else
+    // Player must be OFFLINE
+    if (ObjectAccessor::FindPlayerByName(request.character.name))
     {
-        // If character doesn't exist, we need an account ID - for now, use account 1
-        // In a real implementation, you'd get this from the request or authentication
-        accountId = 1;
-        LOG_INFO("server.worldserver", "Character '{}' not found, will create new character", request.character.name);
+        error = Acore::StringFormat("Character '{}' must be offline for gear changes", request.character.name);
+        return false;
     }
 
-    bool success = true;
-    
-    // WSC-CL
-    // Check config to determine deletion behavior
-    bool deleteAllCharacters = sWorld->getBoolConfig(CONFIG_WEB_SERVICE_DELETE_ALL_CHARS);
-    
-    if (deleteAllCharacters)
+    if (!GetClassId(request.character.gameClass) || !GetRaceId(request.character.race))
     {
-        // Delete ALL existing characters for this account before importing the new one
-        LOG_INFO("server.worldserver", "Deleting all existing characters for account {} before import", accountId);
-        
-        CharacterDatabaseTransaction deleteAllTrans = CharacterDatabase.BeginTransaction();
-        
-        // Delete from all character-related tables using account ID directly where possible
-        // For tables that need character GUIDs, we use subqueries
-        deleteAllTrans->Append("DELETE FROM character_account_data WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_action WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_aura WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_homebind WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_instance WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_inventory WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM item_instance WHERE owner_guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_pet WHERE owner IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_queststatus WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_queststatus_rewarded WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_reputation WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_spell WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_spell_cooldown WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_stats WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_skills WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_glyphs WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_talent WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_achievement WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_achievement_progress WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_equipmentsets WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM mail WHERE receiver IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        deleteAllTrans->Append("DELETE FROM character_social WHERE guid IN (SELECT guid FROM characters WHERE account = {}) OR friend IN (SELECT guid FROM characters WHERE account = {})", accountId, accountId);
-        deleteAllTrans->Append("DELETE FROM guild_member WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
-        
-        // Finally delete the character records themselves
-        deleteAllTrans->Append("DELETE FROM characters WHERE account = {}", accountId);
-        
-        CharacterDatabase.CommitTransaction(deleteAllTrans);
-        LOG_INFO("server.worldserver", "Successfully deleted all existing characters for account {}", accountId);
+        error = Acore::StringFormat("Invalid class '{}' or race '{}'", request.character.gameClass, request.character.race);
+        return false;
     }
-    else
+
+    // Everything that could fail later is checked here, so nothing of a rejected character reaches the transaction
+    for (ItemData const& itemData : request.items)
     {
-        // Only delete the character with the same name if it exists
-        if (characterExists)
+        if (GetEquipmentSlot(itemData.slot) >= EQUIPMENT_SLOT_END)
         {
-            LOG_INFO("server.worldserver", "Found existing character '{}' with GUID {}, will delete and recreate", request.character.name, characterGuid);
-            CharacterDatabaseTransaction deleteTrans = CharacterDatabase.BeginTransaction();
-            if (!DeleteCharacterFromDatabase(request.character.name, accountId, deleteTrans))
-            {
-                LOG_ERROR("server.worldserver", "Failed to delete existing character '{}'", request.character.name);
-                return false;
-            }
-            CharacterDatabase.CommitTransaction(deleteTrans);
-            LOG_INFO("server.worldserver", "Successfully deleted existing character '{}'", request.character.name);
+            error = Acore::StringFormat("Invalid equipment slot '{}'", itemData.slot);
+            return false;
         }
-        else
+
+        if (!sObjectMgr->GetItemTemplate(itemData.id))
         {
-            LOG_INFO("server.worldserver", "Character '{}' not found, will create new character", request.character.name);
+            error = Acore::StringFormat("Item template not found for ID {}", itemData.id);
+            return false;
         }
     }
-    
-    // Determine if we should enable customization based on config
-    bool enableCustomization = sWorld->getBoolConfig(CONFIG_RACE_CUSTOMIZATION);
-    LOG_INFO("server.worldserver", "CONFIG_RACE_CUSTOMIZATION = {}, enableCustomization = {}", 
-             enableCustomization ? 1 : 0, enableCustomization ? "true" : "false");
-    
-    // Create new character in first transaction
-    CharacterDatabaseTransaction createTrans = CharacterDatabase.BeginTransaction();
-    uint32 newCharacterGuid = 0;
-    if (!CreateCharacterInDatabase(request, accountId, createTrans, newCharacterGuid, enableCustomization))
+
+    return true;
+}
+
+void CharacterWebService::AppendCharacterToTransaction(const CharacterRequest& request, CharacterDatabaseTransaction& trans, CharacterApplyResult& result, std::unordered_set<uint32>& clearedAccounts)
+{
+    // Existing characters are resolved from the character cache instead of querying the database
+    uint32 accountId = 1; // no authentication yet, new characters go to account 1
+    if (CharacterCacheEntry const* existing = sCharacterCache->GetCharacterCacheByName(request.character.name))
     {
-        LOG_ERROR("server.worldserver", "Failed to create character '{}'", request.character.name);
-        return false;
+        accountId = existing->AccountId;
+        result.ReplacedGuid = existing->Guid.GetCounter();
+        LOG_INFO("server.worldserver", "Found existing character '{}' with GUID {}, will delete and recreate", request.character.name, result.ReplacedGuid);
     }
-    CharacterDatabase.CommitTransaction(createTrans);
-    
-    characterGuid = newCharacterGuid;
-    LOG_INFO("server.worldserver", "Created new character '{}' with GUID {}", request.character.name, characterGuid);
-    
-    // Update the character cache so deletion/customization works properly
-    uint8 classId = GetClassId(request.character.gameClass);
-    uint8 raceId = GetRaceId(request.character.race);
-    uint8 gender = 0; // Default to male for now (will be set properly if customization is enabled)
-    sCharacterCache->AddCharacterCacheEntry(ObjectGuid(HighGuid::Player, characterGuid), accountId, request.character.name, gender, raceId, classId, request.character.level);
-    LOG_INFO("server.worldserver", "Added character '{}' to character cache", request.character.name);
-    
-    // Now apply gear, spells, etc. in a second transaction
-    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
-    
-    // Grant all class spells available for the character's level and class
-    if (classId > 0 && raceId > 0)
+    else
+        LOG_INFO("server.worldserver", "Character '{}' not found, will create new character", request.character.name);
+
+    // WSC-CL
+    // Check config to determine deletion behavior
+    if (sWorld->getBoolConfig(CONFIG_WEB_SERVICE_DELETE_ALL_CHARS))
     {
-        GrantAllClassSpells(characterGuid, request.character.level, classId, raceId, trans);
+        // Delete ALL existing characters for this account before importing the new one, only once per
+        // transaction so characters of the same batch do not delete each other
+        if (clearedAccounts.insert(accountId).second)
+        {
+            LOG_INFO("server.worldserver", "Deleting all existing characters for account {} before import", accountId);
+
+            // Delete from all character-related tables using account ID directly where possible
+            // For tables that need character GUIDs, we use subqueries
+            trans->Append("DELETE FROM character_account_data WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_action WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_aura WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_homebind WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_instance WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_inventory WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM item_instance WHERE owner_guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_pet WHERE owner IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_queststatus WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_queststatus_rewarded WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_reputation WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_spell WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_spell_cooldown WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_stats WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_skills WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_glyphs WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_talent WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_achievement WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_achievement_progress WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_equipmentsets WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM mail WHERE receiver IN (SELECT guid FROM characters WHERE account = {})", accountId);
+            trans->Append("DELETE FROM character_social WHERE guid IN (SELECT guid FROM characters WHERE account = {}) OR friend IN (SELECT guid FROM characters WHERE account = {})", accountId, accountId);
+            trans->Append("DELETE FROM guild_member WHERE guid IN (SELECT guid FROM characters WHERE account = {})", accountId);
+
+            // Finally delete the character records themselves
+            trans->Append("DELETE FROM characters WHERE account = {}", accountId);
+        }
     }
-    
+    else if (result.ReplacedGuid)
+    {
+        // Only delete the character with the same name
+        DeleteCharacterFromDatabase(request.character.name, result.ReplacedGuid, trans);
+    }
+
+    // Determine if we should enable customization based on config
+    bool enableCustomization = sWorld->getBoolConfig(CONFIG_RACE_CUSTOMIZATION);
+
+    uint32 characterGuid = 0;
+    CreateCharacterInDatabase(request, accountId, trans, characterGuid, result.Gender, enableCustomization);
+
+    result.Guid = characterGuid;
+    result.AccountId = accountId;
+    result.Class = GetClassId(request.character.gameClass);
+    result.Race = GetRaceId(request.character.race);
+    result.Level = request.character.level;
+
+    // Grant all class spells available for the character's level and class
+    GrantAllClassSpells(characterGuid, request.character.level, result.Class, result.Race, trans);
+
     // Apply talents if provided
     if (!request.talents.empty())
-    {
         ApplyCharacterTalents(characterGuid, request.talents, trans);
-    }
-    
+
     // Apply glyphs if provided
     if (!request.glyphs.empty())
-    {
         ApplyCharacterGlyphs(characterGuid, request.glyphs, trans);
-    }
-    
+
     // Grant necessary proficiencies before applying gear
     GrantRequiredProficiencies(characterGuid, request.items, trans);
-    
-    // Apply gear changes directly to database
+
+    // Apply gear changes directly to database, items were validated already
     for (const auto& itemData : request.items)
-    {
-        if (!ApplyItemToDatabase(characterGuid, itemData, trans))
-        {
-            LOG_ERROR("server.worldserver", "Failed to apply item '{}' to character '{}'", itemData.name, request.character.name);
-            success = false;
-        }
-    }
+        ApplyItemToDatabase(characterGuid, itemData, trans);
+
+    // Update equipment cache so character appears equipped on character select
+    UpdateEquipmentCache(characterGuid, request.items, trans);
+
+    // Remove all non-equipped items (bags, their contents and bank), keep only equipped items
+    trans->Append("DELETE FROM character_inventory WHERE guid = {} AND (bag <> 0 OR slot >= {})", characterGuid, uint32(EQUIPMENT_SLOT_END));
+
+    result.ItemsApplied = request.items.size();
+    result.TalentsApplied = request.talents.size();
+    result.GlyphsApplied = request.glyphs.size();
+}
 
-    if (success)
+void CharacterWebService::CommitCharacters(CharacterDatabaseTransaction trans, std::vector<CharacterApplyResult>&& results, CommitHandler&& handler)
+{
+    auto onComplete = [results = std::move(results), handler = std::move(handler)](bool committed) mutable
     {
-        // Update equipment cache so character appears equipped on character select
-        UpdateEquipmentCache(characterGuid, request.items, trans);
-        
-        // Remove all non-equipped items (bags and inventory contents)
-        // Keep only equipped items by deleting inventory entries for bag slots (slots 19-22 and their contents)
-        for (uint8 slot = 19; slot <= 22; ++slot) // Bag slots
-        {
-            trans->Append("DELETE FROM character_inventory WHERE guid = {} AND slot = {}", characterGuid, slot);
-        }
-        
-        // Delete any items in bag slots (slots 23-38 for bag 1, 39-54 for bag 2, etc.)
-        for (uint8 slot = 23; slot <= 150; ++slot) // All possible bag inventory slots
+        for (CharacterApplyResult& result : results)
         {
-            trans->Append("DELETE FROM character_inventory WHERE guid = {} AND slot = {}", characterGuid, slot);
+            if (!result.Error.empty())
+                continue;
+
+            if (!committed)
+            {
+                result.Error = "Transaction failed";
+                continue;
+            }
+
+            // Update the character cache so deletion/customization works properly
+            if (result.ReplacedGuid)
+                sCharacterCache->DeleteCharacterCacheEntry(ObjectGuid(HighGuid::Player, result.ReplacedGuid), result.Name);
+
+            sCharacterCache->AddCharacterCacheEntry(ObjectGuid(HighGuid::Player, result.Guid), result.AccountId, result.Name, result.Gender, result.Race, result.Class, result.Level);
+            LOG_INFO("server.worldserver", "Successfully applied configuration and gear to character '{}' (GUID {})", result.Name, result.Guid);
         }
-        
-        // Also delete bank items (slots 39-66 for bank, 67-74 for bank bags)
-        trans->Append("DELETE FROM character_inventory WHERE guid = {} AND slot >= 39", characterGuid);
-        
-        CharacterDatabase.CommitTransaction(trans);
-        LOG_INFO("server.worldserver", "Successfully applied configuration and gear to character '{}'", request.character.name);
-    }
-    else
+
+        if (!committed)
+            LOG_ERROR("server.worldserver", "Character Web Service transaction failed, changes rolled back");
+
+        handler(committed, results);
+    };
+
+    // Nothing valid to write, answer right away
+    if (!trans->GetSize())
     {
-        // Transaction will automatically rollback if not committed
-        LOG_ERROR("server.worldserver", "Failed to update configuration and gear for character '{}', changes rolled back", request.character.name);
+        onComplete(false);
+        return;
     }
 
-    return success;
+    std::lock_guard<std::mutex> lock(_callbackLock);
+    _transactionCallbacks.AddCallback(CharacterDatabase.AsyncCommitTransaction(trans)).AfterComplete(std::move(onComplete));
 }
 
 void CharacterWebService::GrantRequiredProficiencies(uint32 characterGuid, const std::vector<ItemData>& items, CharacterDatabaseTransaction& trans)
@@ -548,20 +731,19 @@ void CharacterWebService::GrantRequiredProficiencies(uint32 characterGuid, const
 
 uint32 CharacterWebService::GenerateItemGuid()
 {
-    // Generate a unique item GUID by querying the highest existing GUID and incrementing
-    static uint32 guidCounter = 0;
-    if (guidCounter == 0)
+    // Item guids come from the same generator the game uses, so they can never collide with items created in game.
+    // Each worker thread reserves a block at a time and hands guids out of it without any synchronization,
+    // unused rest of a block only leaves a gap in the guid range.
+    thread_local ObjectGuid::LowType nextGuid = 0;
+    thread_local ObjectGuid::LowType blockEnd = 0;
+
+    if (nextGuid == blockEnd)
     {
-        QueryResult result = CharacterDatabase.Query("SELECT MAX(guid) FROM item_instance");
-        if (result)
-        {
-            Field* field = result->Fetch();
-            guidCounter = field[0].Get<uint32>();
-        }
-        if (guidCounter < 1000000)
-            guidCounter = 1000000; // Start from a safe high number
+        nextGuid = sObjectMgr->GetGenerator<HighGuid::Item>().GenerateBlock(WEB_SERVICE_ITEM_GUID_BLOCK);
+        blockEnd = nextGuid + WEB_SERVICE_ITEM_GUID_BLOCK;
     }
-    return ++guidCounter;
+
+    return nextGuid++;
 }
 
 bool CharacterWebService::ApplyItemToDatabase(uint32 characterGuid, const ItemData& itemData, CharacterDatabaseTransaction& trans)
@@ -954,97 +1136,81 @@ void CharacterWebService::ApplyCharacterTalents(uint32 characterGuid, const std:
              talents.size(), characterGuid);
 }
 
-uint32 CharacterWebService::GetGlyphSpellId(uint32 itemId)
+GlyphPropertiesEntry const* CharacterWebService::GetGlyphProperties(uint32 itemId)
 {
-    // Query the item_template table to get the spell that the item casts
-    // For glyphs, this spell will have SPELL_EFFECT_APPLY_GLYPH effect
-    QueryResult result = WorldDatabase.Query(
-        "SELECT class, spellid_1, spellid_2, spellid_3, spellid_4, spellid_5, spelltrigger_1, spelltrigger_2 FROM item_template WHERE entry = {}",
-        itemId
-    );
-    
-    if (!result)
+    // Resolved from the loaded item templates and spell store, no world database round trip
+    ItemTemplate const* itemTemplate = sObjectMgr->GetItemTemplate(itemId);
+    if (!itemTemplate)
     {
         LOG_WARN("server.worldserver", "Item {} not found in item_template", itemId);
-        return 0;
+        return nullptr;
     }
-    
-    Field* fields = result->Fetch();
-    uint32 itemClass = fields[0].Get<uint32>();
-    
-    // Check if it's a glyph (class 16)
-    if (itemClass != 16)
+
+    if (itemTemplate->Class != ITEM_CLASS_GLYPH)
     {
-        LOG_WARN("server.worldserver", "Item {} is not a glyph (class {}), expected class 16", itemId, itemClass);
-        return 0;
+        LOG_WARN("server.worldserver", "Item {} is not a glyph (class {}), expected class {}", itemId, itemTemplate->Class, uint32(ITEM_CLASS_GLYPH));
+        return nullptr;
     }
-    
-    // Find the spell with ITEM_SPELLTRIGGER_ON_USE (trigger = 0)
+
+    // Find the spell with ITEM_SPELLTRIGGER_ON_USE in the first two slots, otherwise fall back to any other spell
     uint32 useSpellId = 0;
-    for (int i = 0; i < 5; ++i)
+    for (uint8 i = 0; i < MAX_ITEM_PROTO_SPELLS; ++i)
     {
-        uint32 spellId = fields[1 + i].Get<uint32>();
-        if (spellId > 0)
+        _Spell const& spell = itemTemplate->Spells[i];
+        if (spell.SpellId <= 0)
+            continue;
+
+        if (i < 2)
         {
-            // Check spell trigger if it's one of the first two spells
-            if (i < 2)
-            {
-                uint32 trigger = fields[6 + i].Get<uint32>();
-                if (trigger == 0) // ITEM_SPELLTRIGGER_ON_USE
-                {
-                    useSpellId = spellId;
-                    LOG_DEBUG("server.worldserver", "Found use spell {} in spellid_{} for glyph item {}", spellId, i + 1, itemId);
-                    break;
-                }
-            }
-            else if (useSpellId == 0)
+            if (spell.SpellTrigger == ITEM_SPELLTRIGGER_ON_USE)
             {
-                // Fallback to any spell if no ON_USE trigger found
-                useSpellId = spellId;
-                LOG_DEBUG("server.worldserver", "Using spell {} from spellid_{} for glyph item {}", spellId, i + 1, itemId);
+                useSpellId = spell.SpellId;
+                break;
             }
         }
+        else if (useSpellId == 0)
+            useSpellId = spell.SpellId;
     }
-    
+
     if (useSpellId == 0)
     {
         LOG_WARN("server.worldserver", "Glyph item {} has no spells", itemId);
-        return 0;
+        return nullptr;
     }
-    
+
     // Now get the spell info to find the MiscValue which contains the glyph ID
     SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(useSpellId);
     if (!spellInfo)
     {
         LOG_WARN("server.worldserver", "Spell {} not found for glyph item {}", useSpellId, itemId);
-        return 0;
+        return nullptr;
     }
-    
+
     // Find the SPELL_EFFECT_APPLY_GLYPH effect
     for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
     {
-        if (spellInfo->Effects[i].Effect == SPELL_EFFECT_APPLY_GLYPH)
+        if (spellInfo->Effects[i].Effect != SPELL_EFFECT_APPLY_GLYPH)
+            continue;
+
+        uint32 glyphId = spellInfo->Effects[i].MiscValue;
+        if (GlyphPropertiesEntry const* gp = sGlyphPropertiesStore.LookupEntry(glyphId))
         {
-            uint32 glyphId = spellInfo->Effects[i].MiscValue;
-            
-            // Look up the glyph properties to get the actual glyph spell
-            if (GlyphPropertiesEntry const* gp = sGlyphPropertiesStore.LookupEntry(glyphId))
-            {
-                LOG_DEBUG("server.worldserver", "Found glyph spell {} for item {} (glyph id {})", 
-                          gp->SpellId, itemId, glyphId);
-                return gp->SpellId;
-            }
-            else
-            {
-                LOG_WARN("server.worldserver", "Glyph properties not found for glyph id {} (item {})", 
-                         glyphId, itemId);
-                return 0;
-            }
+            LOG_DEBUG("server.worldserver", "Found glyph spell {} for item {} (glyph id {})", gp->SpellId, itemId, glyphId);
+            return gp;
         }
+
+        LOG_WARN("server.worldserver", "Glyph properties not found for glyph id {} (item {})", glyphId, itemId);
+        return nullptr;
     }
-    
+
     LOG_WARN("server.worldserver", "No SPELL_EFFECT_APPLY_GLYPH found in spell {} for item {}", useSpellId, itemId);
-    return 0;
+    return nullptr;
+}
+
+uint32 CharacterWebService::GetGlyphSpellId(uint32 itemId)
+{
+    GlyphPropertiesEntry const* glyphProps = GetGlyphProperties(itemId);
+    return glyphProps ? glyphProps->SpellId : 0;
 }
 
 void CharacterWebService::ApplyCharacterGlyphs(uint32 characterGuid, const std::vector<GlyphData>& glyphs, CharacterDatabaseTransaction& trans)
@@ -1063,103 +1229,21 @@ void CharacterWebService::ApplyCharacterGlyphs(uint32 characterGuid, const std::
     
     for (const auto& glyph : glyphs)
     {
-        // Get both glyph entry ID and spell ID
-        uint32 glyphEntryId = 0;
-        uint32 glyphSpellId = 0;
-        
-        // Query the item to get the use spell
-        QueryResult itemResult = WorldDatabase.Query(
-            "SELECT class, spellid_1, spellid_2, spellid_3, spellid_4, spellid_5, spelltrigger_1, spelltrigger_2 FROM item_template WHERE entry = {}",
-            glyph.id
-        );
-        
-        if (!itemResult)
-        {
-            LOG_ERROR("server.worldserver", "Glyph item {} not found, skipping", glyph.id);
-            continue;
-        }
-        
-        Field* fields = itemResult->Fetch();
-        uint32 itemClass = fields[0].Get<uint32>();
-        
-        if (itemClass != 16) // Not a glyph
-        {
-            LOG_ERROR("server.worldserver", "Item {} is not a glyph (class {}), skipping", glyph.id, itemClass);
-            continue;
-        }
-        
-        // Find the use spell
-        uint32 useSpellId = 0;
-        for (int i = 0; i < 5; ++i)
-        {
-            uint32 spellId = fields[1 + i].Get<uint32>();
-            if (spellId > 0)
-            {
-                if (i < 2)
-                {
-                    uint32 trigger = fields[6 + i].Get<uint32>();
-                    if (trigger == 0) // ITEM_SPELLTRIGGER_ON_USE
-                    {
-                        useSpellId = spellId;
-                        break;
-                    }
-                }
-                else if (useSpellId == 0)
-                {
-                    useSpellId = spellId;
-                }
-            }
-        }
-        
-        if (useSpellId == 0)
-        {
-            LOG_ERROR("server.worldserver", "No use spell found for glyph item {}, skipping", glyph.id);
-            continue;
-        }
-        
-        // Get the spell info to find the glyph entry ID
-        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(useSpellId);
-        if (!spellInfo)
-        {
-            LOG_ERROR("server.worldserver", "Spell {} not found for glyph item {}, skipping", useSpellId, glyph.id);
-            continue;
-        }
-        
-        // Find SPELL_EFFECT_APPLY_GLYPH effect to get the glyph entry ID
-        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        {
-            if (spellInfo->Effects[i].Effect == SPELL_EFFECT_APPLY_GLYPH)
-            {
-                glyphEntryId = spellInfo->Effects[i].MiscValue;
-                
-                // Look up the glyph properties to get the glyph spell
-                if (GlyphPropertiesEntry const* gp = sGlyphPropertiesStore.LookupEntry(glyphEntryId))
-                {
-                    glyphSpellId = gp->SpellId;
-                    break;
-                }
-            }
-        }
-        
-        if (glyphEntryId == 0 || glyphSpellId == 0)
+        GlyphPropertiesEntry const* glyphProps = GetGlyphProperties(glyph.id);
+        if (!glyphProps || !glyphProps->SpellId)
         {
             LOG_ERROR("server.worldserver", "Could not find glyph data for item {}, skipping", glyph.id);
             continue;
         }
+
+        uint32 glyphEntryId = glyphProps->Id;
+        uint32 glyphSpellId = glyphProps->SpellId;
         
         // Add the glyph spell to the character's spell list
         trans->Append("INSERT INTO character_spell (guid, spell, specMask) VALUES ({}, {}, 255) "
                      "ON DUPLICATE KEY UPDATE specMask = 255", 
                      characterGuid, glyphSpellId);
         
-        // Get the actual glyph type from GlyphProperties
-        GlyphPropertiesEntry const* glyphProps = sGlyphPropertiesStore.LookupEntry(glyphEntryId);
-        if (!glyphProps)
-        {
-            LOG_ERROR("server.worldserver", "Could not find GlyphProperties for glyph {}, skipping", glyphEntryId);
-            continue;
-        }
-        
         // TypeFlags: 0 = Major, 1 = Minor
         bool isMajor = (glyphProps->TypeFlags == 0);
         
@@ -1209,18 +1293,8 @@ void CharacterWebService::ApplyCharacterGlyphs(uint32 characterGuid, const std::
              glyphs.size(), majorCount, minorCount, characterGuid);
 }
 
-bool CharacterWebService::DeleteCharacterFromDatabase(const std::string& characterName, uint32 accountId, CharacterDatabaseTransaction& trans)
+void CharacterWebService::DeleteCharacterFromDatabase(const std::string& characterName, uint32 characterGuid, CharacterDatabaseTransaction& trans)
 {
-    // Get character GUID first
-    QueryResult result = CharacterDatabase.Query("SELECT guid FROM characters WHERE name = '{}'", characterName);
-    if (!result)
-    {
-        LOG_ERROR("server.worldserver", "Character '{}' not found for deletion", characterName);
-        return false;
-    }
-    
-    uint32 characterGuid = result->Fetch()[0].Get<uint32>();
-    
     // Delete ALL character-related data comprehensively
     // Order matters - delete child records before parent records
     
@@ -1265,10 +1339,9 @@ bool CharacterWebService::DeleteCharacterFromDatabase(const std::string& charact
     trans->Append("DELETE FROM characters WHERE guid = {}", characterGuid);
     
     LOG_INFO("server.worldserver", "Queued deletion of character '{}' (GUID {}) from all tables", characterName, characterGuid);
-    return true;
 }
 
-bool CharacterWebService::CreateCharacterInDatabase(const CharacterRequest& request, uint32 accountId, CharacterDatabaseTransaction& trans, uint32& outGuid, bool enableCustomization)
+bool CharacterWebService::CreateCharacterInDatabase(const CharacterRequest& request, uint32 accountId, CharacterDatabaseTransaction& trans, uint32& outGuid, uint8& outGender, bool enableCustomization)
 {
     uint8 classId = GetClassId(request.character.gameClass);
     uint8 raceId = GetRaceId(request.character.race);
@@ -1350,6 +1423,7 @@ bool CharacterWebService::CreateCharacterInDatabase(const CharacterRequest& requ
         "12, 0, 100, 100, '', '', '', 0, 0, {})",
         newGuid, accountId, request.character.name, raceId, classId, gender, request.character.level, atLoginFlags
     );
+    outGender = gender;
     
     // Create character_homebind entry
     trans->Append(
@@ -18,72 +18,71 @@
 #ifndef CHARACTER_WEB_SERVICE_H
 #define CHARACTER_WEB_SERVICE_H
 
+#include "CharacterRequestParser.h"
 #include "Common.h"
 #include "IoContext.h"
+#include "AsyncCallbackProcessor.h"
 #include "DatabaseEnvFwd.h"
 #include <boost/asio.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <boost/beast.hpp>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 using tcp = boost::asio::ip::tcp;
 namespace http = boost::beast::http;
 
 class Player;
 class Item;
+struct GlyphPropertiesEntry;
 
-struct ItemData
+struct CharacterWebServiceSettings
 {
-    std::string name;
-    uint32 id;
-    std::string slot;
-    struct EnchantData {
-        std::string name;
-        uint32 id;
-        uint32 itemId = 0;
-        uint32 spellId = 0;
-    } enchant;
+    uint16 Port = 8080;
+    uint32 NetworkThreads = 1;          // threads running the asynchronous HTTP sessions
+    uint32 WorkerThreads = 2;           // threads processing requests (database work)
+    uint32 MaxConcurrentRequests = 16;  // requests processed at once, further ones get 503
+    uint32 ReadTimeout = 30;            // seconds a connection may stay idle before it is closed
+    uint32 MaxBatchSize = 500;          // characters accepted by a single batch request
 };
 
-struct TalentData
+// Outcome of one character of a request, reported once its transaction completed
+struct CharacterApplyResult
 {
-    std::string name;
-    uint32 id;
-    uint32 rank;
-    uint32 spellId;
-};
-
-struct GlyphData
-{
-    std::string name;
-    uint32 id;
-    std::string type; // MAJOR or MINOR
-};
-
-struct CharacterData
-{
-    std::string name;
-    uint32 level;
-    std::string gameClass;
-    std::string race;
-    std::string faction;
-};
-
-struct CharacterRequest
-{
-    std::string name;
-    uint32 phase;
-    CharacterData character;
-    std::vector<ItemData> items;
-    std::vector<TalentData> talents;
-    std::vector<GlyphData> glyphs;
+    std::string Name;
+    std::string Error;                  // empty if the character was queued for the transaction
+    uint32 Guid = 0;
+    uint32 ReplacedGuid = 0;            // existing character with the same name that gets deleted
+    uint32 AccountId = 0;
+    uint8 Race = 0;
+    uint8 Class = 0;
+    uint8 Gender = 0;
+    uint8 Level = 0;
+    std::size_t ItemsApplied = 0;
+    std::size_t TalentsApplied = 0;
+    std::size_t GlyphsApplied = 0;
 };
 
 class CharacterWebService
 {
+    friend class CharacterWebSession;
+
 public:
-    CharacterWebService(Acore::Asio::IoContext& ioContext, uint16 port);
+    typedef http::request<http::string_body> Request;
+    typedef http::response<http::string_body> Response;
+    typedef std::function<void(Response&&)> ResponseHandler;
+    typedef std::function<void(std::string&&)> BodyHandler;
+    typedef std::function<void(bool /*committed*/, std::vector<CharacterApplyResult>& /*results*/)> CommitHandler;
+
+    explicit CharacterWebService(CharacterWebServiceSettings const& settings);
     ~CharacterWebService();
 
     bool Start();
@@ -91,15 +90,15 @@ public:
 
 private:
     void DoAccept();
-    void HandleRequest(tcp::socket socket);
-    void ProcessCharacterRequest(const std::string& body, std::string& response);
-    
-    // JSON parsing helpers
-    std::string ExtractJsonString(const std::string& json, const std::string& key);
-    uint32 ExtractJsonNumber(const std::string& json, const std::string& key);
-    std::vector<std::string> ExtractJsonArray(const std::string& json, const std::string& arrayName);
+    void HandleRequest(Request&& request, ResponseHandler&& handler);
+    static Response BuildResponse(Request const& request, http::status status, std::string body);
+    void ProcessCharacterRequest(const std::string& body, BodyHandler&& handler);
+    void ProcessBatchRequest(const std::string& body, BodyHandler&& handler);
+    bool ValidateCharacterRequest(const CharacterRequest& request, std::string& error);
+    void AppendCharacterToTransaction(const CharacterRequest& request, CharacterDatabaseTransaction& trans, CharacterApplyResult& result, std::unordered_set<uint32>& clearedAccounts);
+    void CommitCharacters(CharacterDatabaseTransaction trans, std::vector<CharacterApplyResult>&& results, CommitHandler&& handler);
+    void ScheduleCallbackProcessing();
     
-    bool ApplyCharacterGear(const CharacterRequest& request);
     bool UpdateCharacterConfiguration(uint32 characterGuid, const CharacterData& charData, CharacterDatabaseTransaction& trans);
     void GrantRequiredProficiencies(uint32 characterGuid, const std::vector<ItemData>& items, CharacterDatabaseTransaction& trans);
     void UpdateEquipmentCache(uint32 characterGuid, const std::vector<ItemData>& items, CharacterDatabaseTransaction& trans);
@@ -112,14 +111,22 @@ private:
     void GrantAllClassSpells(uint32 characterGuid, uint8 level, uint8 classId, uint8 raceId, CharacterDatabaseTransaction& trans);
     void ApplyCharacterTalents(uint32 characterGuid, const std::vector<TalentData>& talents, CharacterDatabaseTransaction& trans);
     void ApplyCharacterGlyphs(uint32 characterGuid, const std::vector<GlyphData>& glyphs, CharacterDatabaseTransaction& trans);
+    GlyphPropertiesEntry const* GetGlyphProperties(uint32 itemId);
     uint32 GetGlyphSpellId(uint32 itemId);
-    bool DeleteCharacterFromDatabase(const std::string& characterName, uint32 accountId, CharacterDatabaseTransaction& trans);
-    bool CreateCharacterInDatabase(const CharacterRequest& request, uint32 accountId, CharacterDatabaseTransaction& trans, uint32& outGuid, bool enableCustomization = false);
+    void DeleteCharacterFromDatabase(const std::string& characterName, uint32 characterGuid, CharacterDatabaseTransaction& trans);
+    bool CreateCharacterInDatabase(const CharacterRequest& request, uint32 accountId, CharacterDatabaseTransaction& trans, uint32& outGuid, uint8& outGender, bool enableCustomization = false);
     
-    Acore::Asio::IoContext& _ioContext;
+    CharacterWebServiceSettings _settings;
+    Acore::Asio::IoContext _ioContext;
     tcp::acceptor _acceptor;
-    uint16 _port;
-    bool _running;
+    std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> _workGuard;
+    std::vector<std::thread> _networkThreads;
+    std::unique_ptr<boost::asio::thread_pool> _workerPool;
+    std::atomic<uint32> _activeRequests;
+    boost::asio::steady_timer _callbackTimer;
+    std::mutex _callbackLock;
+    AsyncCallbackProcessor<TransactionCallback> _transactionCallbacks;
+    std::atomic<bool> _running;
 };
 
 #endif // CHARACTER_WEB_SERVICE_H
\ No newline at end of file
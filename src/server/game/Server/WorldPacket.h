@@ -21,6 +21,7 @@
 #include "ByteBuffer.h"
 #include "Duration.h"
 #include "Opcodes.h"
+#include <memory>
 
 class WorldPacket : public ByteBuffer
 {
@@ -82,4 +83,7 @@ protected:
     TimePoint m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
 };
 
+/// Immutable packet that can be queued on many sockets at once without being copied for each of them
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
+
 #endif
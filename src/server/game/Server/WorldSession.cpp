@@ -250,9 +250,26 @@ ObjectGuid::LowType WorldSession::GetGuidLow() const
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
 {
-    if (!m_Socket)
+    if (!CanSendPacket(*packet))
         return;
 
+    m_Socket->SendPacket(*packet);
+}
+
+/// Send a packet shared with other sessions, the socket keeps a reference instead of a copy
+void WorldSession::SendPacket(SharedWorldPacket const& packet)
+{
+    if (!CanSendPacket(*packet))
+        return;
+
+    m_Socket->SendPacket(packet);
+}
+
+bool WorldSession::CanSendPacket(WorldPacket const& packet)
+{
+    if (!m_Socket)
+        return false;
+
 #if defined(ACORE_DEBUG)
     // Code for network use statistic
     static uint64 sendPacketCount = 0;
@@ -269,10 +286,10 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     if ((cur_time - lastTime) < 60)
     {
         sendPacketCount += 1;
-        sendPacketBytes += packet->size();
+        sendPacketBytes += packet.size();
 
         sendLastPacketCount += 1;
-        sendLastPacketBytes += packet->size();
+        sendLastPacketBytes += packet.size();
     }
     else
     {
@@ -285,16 +302,11 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
         lastTime = cur_time;
         sendLastPacketCount = 1;
-        sendLastPacketBytes = packet->wpos();               // wpos is real written size
+        sendLastPacketBytes = packet.wpos();                // wpos is real written size
     }
 #endif                                                      // !ACORE_DEBUG
 
-    if (!sScriptMgr->CanPacketSend(this, *packet))
-    {
-        return;
-    }
-
-    m_Socket->SendPacket(*packet);
+    return sScriptMgr->CanPacketSend(this, packet);
 }
 
 /// Add an incoming packet to the queue
@@ -23,6 +23,7 @@
 #include "DatabaseEnv.h"
 #include "GameTime.h"
 #include "IPLocation.h"
+#include "Metric.h"
 #include "Opcodes.h"
 #include "PacketLog.h"
 #include "Random.h"
@@ -38,60 +39,110 @@
 
 using boost::asio::ip::tcp;
 
-void compressBuff(void* dst, uint32* dst_size, void* src, int src_size)
+// Bodies from this size on are written straight from the packet instead of being copied into the send buffer
+#define WORLD_SOCKET_GATHER_MIN_SIZE 1024
+
+namespace
 {
-    z_stream c_stream;
+    // Totals since the last metric log, see EncryptableAndCompressiblePacket::LogCompressionMetrics
+    std::atomic<uint64> CompressedPackets(0);
+    std::atomic<uint64> CompressionBytesIn(0);
+    std::atomic<uint64> CompressionBytesOut(0);
+    std::atomic<uint64> CompressionTime(0);
+
+    /*
+     * Deflate state kept for the lifetime of a thread. Setting up a z_stream allocates about 256 KB,
+     * doing it for every packet was the dominant cost of compressing update packets.
+     */
+    class UpdatePacketCompressor
+    {
+    public:
+        UpdatePacketCompressor() : _level(0)
+        {
+            _stream.zalloc = (alloc_func)0;
+            _stream.zfree = (free_func)0;
+            _stream.opaque = (voidpf)0;
+        }
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+        ~UpdatePacketCompressor()
+        {
+            if (_level)
+                deflateEnd(&_stream);
+        }
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+        UpdatePacketCompressor(UpdatePacketCompressor const&) = delete;
+        UpdatePacketCompressor& operator=(UpdatePacketCompressor const&) = delete;
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+        // Compresses src into dst in a single pass, dst must hold compressBound(src_size) bytes
+        bool Compress(void* dst, uint32* dst_size, void* src, int src_size, int level)
+        {
+            if (!Prepare(level))
+                return false;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+            _stream.next_out = (Bytef*)dst;
+            _stream.avail_out = *dst_size;
+            _stream.next_in = (Bytef*)src;
+            _stream.avail_in = (uInt)src_size;
 
-    if (c_stream.avail_in != 0)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
-    }
+            int z_res = deflate(&_stream, Z_FINISH);
+            if (z_res != Z_STREAM_END)
+            {
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
+                return false;
+            }
 
-    z_res = deflate(&c_stream, Z_FINISH);
-    if (z_res != Z_STREAM_END)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+            *dst_size = _stream.total_out;
+            return true;
+        }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateEnd) Error code: {} ({})", z_res, zError(z_res));
+    private:
+        bool Prepare(int level)
+        {
+            if (_level == level)
+            {
+                int z_res = deflateReset(&_stream);
+                if (z_res == Z_OK)
+                    return true;
+
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateReset) Error code: {} ({})", z_res, zError(z_res));
+            }
+
+            // First use on this thread or the compression level was reloaded
+            if (_level)
+            {
+                deflateEnd(&_stream);
+                _level = 0;
+            }
+
+            int z_res = deflateInit(&_stream, level);
+            if (z_res != Z_OK)
+            {
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
+                return false;
+            }
+
+            _level = level;
+            return true;
+        }
+
+        z_stream _stream;
+        int _level;
+    };
+}
+
+void compressBuff(void* dst, uint32* dst_size, void* src, int src_size)
+{
+    thread_local UpdatePacketCompressor compressor;
+
+    // default Z_BEST_SPEED (1)
+    if (!compressor.Compress(dst, dst_size, src, src_size, sWorld->getIntConfig(CONFIG_COMPRESSION)))
         *dst_size = 0;
-        return;
-    }
+}
 
-    *dst_size = c_stream.total_out;
+bool EncryptableAndCompressiblePacket::NeedsCompression() const
+{
+    WorldPacket const& packet = GetPacket();
+    return packet.GetOpcode() == SMSG_UPDATE_OBJECT && packet.size() > sWorld->getIntConfig(CONFIG_COMPRESSION_THRESHOLD);
 }
 
 void EncryptableAndCompressiblePacket::CompressIfNeeded()
@@ -99,21 +150,48 @@ void EncryptableAndCompressiblePacket::CompressIfNeeded()
     if (!NeedsCompression())
         return;
 
-    uint32 pSize = size();
+    WorldPacket const& packet = GetPacket();
+    uint32 pSize = packet.size();
+    auto start = std::chrono::steady_clock::now();
 
     uint32 destsize = compressBound(pSize);
-    ByteBuffer buf(destsize + sizeof(uint32));
+    WorldPacket buf(SMSG_COMPRESSED_UPDATE_OBJECT, destsize + sizeof(uint32));
     buf.resize(destsize + sizeof(uint32));
 
     buf.put<uint32>(0, pSize);
-    compressBuff(const_cast<uint8*>(buf.contents()) + sizeof(uint32), &destsize, (void*)contents(), pSize);
+    compressBuff(const_cast<uint8*>(buf.contents()) + sizeof(uint32), &destsize, (void*)packet.contents(), pSize);
     if (destsize == 0)
         return;
 
     buf.resize(destsize + sizeof(uint32));
 
-    ByteBuffer::operator=(std::move(buf));
-    SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+    // A shared packet is left untouched for the other receivers, the compressed copy is ours
+    _packet = std::move(buf);
+    _sharedPacket.reset();
+
+    ++CompressedPackets;
+    CompressionBytesIn += pSize;
+    CompressionBytesOut += _packet.size();
+    CompressionTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+SharedWorldPacket EncryptableAndCompressiblePacket::ReleasePacket()
+{
+    if (_sharedPacket)
+        return std::move(_sharedPacket);
+
+    return std::make_shared<WorldPacket const>(std::move(_packet));
+}
+
+void EncryptableAndCompressiblePacket::LogCompressionMetrics()
+{
+    uint64 bytesIn = CompressionBytesIn.exchange(0);
+    uint64 bytesOut = CompressionBytesOut.exchange(0);
+
+    METRIC_VALUE("update_compression_packets", CompressedPackets.exchange(0));
+    METRIC_VALUE("update_compression_bytes_in", bytesIn);
+    METRIC_VALUE("update_compression_bytes_saved", bytesIn > bytesOut ? bytesIn - bytesOut : 0);
+    METRIC_VALUE("update_compression_time", CompressionTime.exchange(0));
 }
 
 WorldSocket::WorldSocket(tcp::socket&& socket)
@@ -172,23 +250,40 @@ bool WorldSocket::Update()
         do
         {
             queued->CompressIfNeeded();
-            ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+            WorldPacket const& packet = queued->GetPacket();
+            ServerPktHeader header(packet.size() + 2, packet.GetOpcode());
             if (queued->NeedsEncryption())
                 _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
-            currentPacketSize = queued->size() + header.getHeaderLength();
+            // Large bodies are not copied, header and body go out with one gathered write
+            if (packet.size() >= WORLD_SOCKET_GATHER_MIN_SIZE)
+            {
+                if (buffer.GetActiveSize() > 0)
+                    QueuePacket(std::move(buffer));
+
+                std::size_t bodySize = packet.size();
+                SharedWorldPacket body = queued->ReleasePacket();
+                QueuePacket(SocketWriteBuffer(header.header, header.getHeaderLength(), std::shared_ptr<uint8 const>(body, body->contents()), bodySize));
+
+                delete queued;
+                continue;
+            }
+
+            currentPacketSize = packet.size() + header.getHeaderLength();
 
             if (buffer.GetRemainingSpace() < currentPacketSize)
             {
-                QueuePacket(std::move(buffer));
+                if (buffer.GetActiveSize() > 0)
+                    QueuePacket(std::move(buffer));
+
                 buffer.Resize(_sendBufferSize);
             }
 
             if (buffer.GetRemainingSpace() >= currentPacketSize)
             {
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!packet.empty())
+                    buffer.Write(packet.contents(), packet.size());
             }
             else    // Single packet larger than current buffer size
             {
@@ -200,8 +295,8 @@ bool WorldSocket::Update()
                     _sendBufferSize = currentPacketSize;
 
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!packet.empty())
+                    buffer.Write(packet.contents(), packet.size());
             }
 
             delete queued;
@@ -523,7 +618,27 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
-    _bufferQueue.Enqueue(new EncryptableAndCompressiblePacket(packet, _authCrypt.IsInitialized()));
+    QueueSendPacket(new EncryptableAndCompressiblePacket(packet, _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::SendPacket(SharedWorldPacket const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    QueueSendPacket(new EncryptableAndCompressiblePacket(packet, _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::QueueSendPacket(EncryptableAndCompressiblePacket* queued)
+{
+    // Sending threads (map updates) work in parallel, the network thread flushes many sockets one after another
+    if (sWorld->getBoolConfig(CONFIG_COMPRESSION_ON_SENDER_THREAD))
+        queued->CompressIfNeeded();
+
+    _bufferQueue.Enqueue(queued);
 }
 
 void WorldSocket::HandleAuthSession(WorldPacket & recvPacket)
@@ -29,23 +29,38 @@
 
 using boost::asio::ip::tcp;
 
-class EncryptableAndCompressiblePacket : public WorldPacket
+class EncryptableAndCompressiblePacket
 {
 public:
-    EncryptableAndCompressiblePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt)
+    EncryptableAndCompressiblePacket(WorldPacket const& packet, bool encrypt) : _packet(packet), _encrypt(encrypt)
     {
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    EncryptableAndCompressiblePacket(SharedWorldPacket packet, bool encrypt) : _sharedPacket(std::move(packet)), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    WorldPacket const& GetPacket() const { return _sharedPacket ? *_sharedPacket : _packet; }
+
     bool NeedsEncryption() const { return _encrypt; }
 
-    bool NeedsCompression() const { return GetOpcode() == SMSG_UPDATE_OBJECT && size() > 100; }
+    bool NeedsCompression() const;
 
     void CompressIfNeeded();
 
+    /// Hands the packet over to the socket write queue, shared packets are not copied
+    SharedWorldPacket ReleasePacket();
+
+    // Sends and resets the compression counters (packets, bytes in, bytes saved, time spent in microseconds)
+    static void LogCompressionMetrics();
+
     std::atomic<EncryptableAndCompressiblePacket*> SocketQueueLink;
 
 private:
+    WorldPacket _packet;                // own copy, also holds the packet once it was compressed
+    SharedWorldPacket _sharedPacket;    // body shared with the other receivers of a broadcast
     bool _encrypt;
 };
 
@@ -82,6 +97,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(SharedWorldPacket const& packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
@@ -108,6 +124,7 @@ private:
 
     /// sends and logs network.opcode without accessing WorldSession
     void SendPacketAndLogOpcode(WorldPacket const& packet);
+    void QueueSendPacket(EncryptableAndCompressiblePacket* queued);
     void HandleSendAuthSession();
     void HandleAuthSession(WorldPacket& recvPacket);
     void HandleAuthSessionCallback(std::shared_ptr<AuthSession> authSession, PreparedQueryResult result);
@@ -70,6 +70,7 @@
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PlayerDump.h"
+#include "PlayerSaveScheduler.h"
 #include "PoolMgr.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
@@ -91,7 +92,9 @@
 #include "WaypointMovementGenerator.h"
 #include "WeatherMgr.h"
 #include "WhoListCacheMgr.h"
+#include "WorldDatabaseCache.h"
 #include "WorldGlobals.h"
+#include "WorldLoader.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include "WorldSessionMgr.h"
@@ -189,6 +192,8 @@ void World::LoadConfigSettings(bool reload)
 
     _worldConfig.Initialize(reload);
 
+    sPlayerSaveScheduler->LoadConfig();
+
     for (uint8 i = 0; i < MAX_MOVE_TYPE; ++i)
         playerBaseMoveSpeed[i] = baseMoveSpeed[i] * getRate(RATE_MOVESPEED_PLAYER);
 
@@ -382,12 +387,6 @@ void World::SetInitialWorldSettings()
     LoadDBCStores(_dataPath);
     DetectDBCLang();
 
-    // Load cinematic cameras
-    LoadM2Cameras(_dataPath);
-
-    // Load IP Location Database
-    sIPLocation->Load();
-
     std::vector<uint32> mapIds;
     for (auto const& map : sMapStore)
     {
@@ -399,477 +398,269 @@ void World::SetInitialWorldSettings()
     MMAP::MMapMgr* mmmgr = MMAP::MMapFactory::createOrGetMMapMgr();
     mmmgr->InitializeThreadUnsafe(mapIds);
 
-    LOG_INFO("server.loading", "Loading Game Graveyard...");
-    sGraveyard->LoadGraveyardFromDB();
-
-    LOG_INFO("server.loading", "Initializing PlayerDump Tables...");
-    PlayerDump::InitializeTables();
-
-    ///- Initilize static helper structures
-    AIRegistry::Initialize();
-
-    LOG_INFO("server.loading", "Loading SpellInfo Store...");
-    sSpellMgr->LoadSpellInfoStore();
-
-    LOG_INFO("server.loading", "Loading Spell Cooldown Overrides...");
-    sSpellMgr->LoadSpellCooldownOverrides();
-
-    LOG_INFO("server.loading", "Loading SpellInfo Data Corrections...");
-    sSpellMgr->LoadSpellInfoCorrections();
-
-    LOG_INFO("server.loading", "Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
-
-    LOG_INFO("server.loading", "Loading Spell Specific And Aura State...");
-    sSpellMgr->LoadSpellSpecificAndAuraState();
-
-    LOG_INFO("server.loading", "Loading SkillLineAbilityMultiMap Data...");
-    sSpellMgr->LoadSkillLineAbilityMap();
-
-    LOG_INFO("server.loading", "Loading SpellInfo Custom Attributes...");
-    sSpellMgr->LoadSpellInfoCustomAttributes();
-
-    LOG_INFO("server.loading", "Loading Player Totem models...");
-    sObjectMgr->LoadPlayerTotemModels();
-
-    LOG_INFO("server.loading", "Loading Player Shapeshift models...");
-    sObjectMgr->LoadPlayerShapeshiftModels();
-
-    LOG_INFO("server.loading", "Loading GameObject Models...");
-    LoadGameObjectModelList(_dataPath);
-
-    LOG_INFO("server.loading", "Loading Script Names...");
-    sObjectMgr->LoadScriptNames();
-
-    LOG_INFO("server.loading", "Loading Instance Template...");
-    sObjectMgr->LoadInstanceTemplate();
-
-    LOG_INFO("server.loading", "Loading Character Cache...");
-    sCharacterCache->LoadCharacterCacheStorage();
-
-    // Must be called before `creature_respawn`/`gameobject_respawn` tables
-    LOG_INFO("server.loading", "Loading Instances...");
-    sInstanceSaveMgr->LoadInstances();
-
-    LOG_INFO("server.loading", "Loading Broadcast Texts...");
-    sObjectMgr->LoadBroadcastTexts();
-    sObjectMgr->LoadBroadcastTextLocales();
-
-    LOG_INFO("server.loading", "Loading Localization Strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
-    sObjectMgr->LoadPetNamesLocales();
-
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    LOG_INFO("server.loading", ">> Localization Strings loaded in {} ms", GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server.loading", " ");
-
-    LOG_INFO("server.loading", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
-
-    LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
-
-    LOG_INFO("server.loading", "Loading Game Object Template Addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
-
-    LOG_INFO("server.loading", "Loading Transport Templates...");
-    sTransportMgr->LoadTransportTemplates();
-
-    LOG_INFO("server.loading", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
-
-    LOG_INFO("server.loading", "Loading Spell Group Types...");
-    sSpellMgr->LoadSpellGroups();
-
-    LOG_INFO("server.loading", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
-
-    LOG_INFO("server.loading", "Loading Spell Proc Event Conditions...");
-    sSpellMgr->LoadSpellProcEvents();
-
-    LOG_INFO("server.loading", "Loading Spell Proc Conditions and Data...");
-    sSpellMgr->LoadSpellProcs();
-
-    LOG_INFO("server.loading", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonuses();
-
-    LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
-
-    LOG_INFO("server.loading", "Loading Mixology Bonuses...");
-    sSpellMgr->LoadSpellMixology();
-
-    LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
-
-    LOG_INFO("server.loading", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
-
-    LOG_INFO("server.loading", "Loading Enchant Spells Proc Datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
-
-    LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    LOG_INFO("server.loading", "Loading Disables");
-    sDisableMgr->LoadDisables();                                  // must be before loading quests and items
-
-    LOG_INFO("server.loading", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr->LoadItemTemplates();
-
-    LOG_INFO("server.loading", "Loading Item Set Names...");                // must be after LoadItemPrototypes
-    sObjectMgr->LoadItemSetNames();
-
-    LOG_INFO("server.loading", "Loading Creature Model Based Info Data...");
-    sObjectMgr->LoadCreatureModelInfo();
-
-    LOG_INFO("server.loading", "Loading Creature Custom IDs Config...");
-    sObjectMgr->LoadCreatureCustomIDs();
-
-    LOG_INFO("server.loading", "Loading Creature Templates...");
-    sObjectMgr->LoadCreatureTemplates();
-
-    LOG_INFO("server.loading", "Loading Equipment Templates...");           // must be after LoadCreatureTemplates
-    sObjectMgr->LoadEquipmentTemplates();
-
-    LOG_INFO("server.loading", "Loading Creature Template Addons...");
-    sObjectMgr->LoadCreatureTemplateAddons();
-
-    LOG_INFO("server.loading", "Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
-
-    LOG_INFO("server.loading", "Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
-
-    LOG_INFO("server.loading", "Loading Reputation Spillover Data..." );
-    sObjectMgr->LoadReputationSpilloverTemplate();
-
-    LOG_INFO("server.loading", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
-
-    LOG_INFO("server.loading", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
-
-    LOG_INFO("server.loading", "Loading Creature Data...");
-    sObjectMgr->LoadCreatures();
-
-    LOG_INFO("server.loading", "Loading Creature sparring...");
-    sObjectMgr->LoadCreatureSparring();
-
-    LOG_INFO("server.loading", "Loading Temporary Summon Data...");
-    sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
-
-    LOG_INFO("server.loading", "Loading Pet Levelup Spells...");
-    sSpellMgr->LoadPetLevelupSpellMap();
-
-    LOG_INFO("server.loading", "Loading Pet default Spells additional to Levelup Spells...");
-    sSpellMgr->LoadPetDefaultSpells();
-
-    LOG_INFO("server.loading", "Loading Creature Addon Data...");
-    sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
-
-    LOG_INFO("server.loading", "Loading Creature Movement Overrides...");
-    sObjectMgr->LoadCreatureMovementOverrides(); // must be after LoadCreatures()
-
-    LOG_INFO("server.loading", "Loading Gameobject Data...");
-    sObjectMgr->LoadGameobjects();
-
-    LOG_INFO("server.loading", "Loading GameObject Addon Data...");
-    sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjectTemplate() and LoadGameobjects()
-
-    LOG_INFO("server.loading", "Loading GameObject Quest Items...");
-    sObjectMgr->LoadGameObjectQuestItems();
-
-    LOG_INFO("server.loading", "Loading Creature Quest Items...");
-    sObjectMgr->LoadCreatureQuestItems();
-
-    LOG_INFO("server.loading", "Loading Creature Linked Respawn...");
-    sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
-
-    LOG_INFO("server.loading", "Loading Weather Data...");
-    WeatherMgr::LoadWeatherData();
-
-    LOG_INFO("server.loading", "Loading Quests...");
-    sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    LOG_INFO("server.loading", "Checking Quest Disables");
-    sDisableMgr->CheckQuestDisables();                           // must be after loading quests
-
-    LOG_INFO("server.loading", "Loading Quest POI");
-    sObjectMgr->LoadQuestPOI();
-
-    LOG_INFO("server.loading", "Loading Quests Starters and Enders...");
-    sObjectMgr->LoadQuestStartersAndEnders();                    // must be after quest load
-
-    LOG_INFO("server.loading", "Loading Quest Greetings...");
-    sObjectMgr->LoadQuestGreetings();                               // must be loaded after creature_template, gameobject_template tables
-    LOG_INFO("server.loading", "Loading Quest Greeting Locales...");
-    sObjectMgr->LoadQuestGreetingsLocales();                        // must be loaded after creature_template, gameobject_template tables, quest_greeting
-
-    LOG_INFO("server.loading", "Loading Quest Money Rewards...");
-    sObjectMgr->LoadQuestMoneyRewards();
-
-    LOG_INFO("server.loading", "Loading Objects Pooling Data...");
-    sPoolMgr->LoadFromDB();
-
-    LOG_INFO("server.loading", "Loading Game Event Data...");               // must be after loading pools fully
-    sGameEventMgr->LoadHolidayDates();                           // Must be after loading DBC
-    sGameEventMgr->LoadFromDB();                                 // Must be after loading holiday dates
-
-    LOG_INFO("server.loading", "Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
-    sObjectMgr->LoadNPCSpellClickSpells();
-
-    LOG_INFO("server.loading", "Loading Vehicle Template Accessories...");
-    sObjectMgr->LoadVehicleTemplateAccessories();                // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
-
-    LOG_INFO("server.loading", "Loading Vehicle Accessories...");
-    sObjectMgr->LoadVehicleAccessories();                       // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
-
-    LOG_INFO("server.loading", "Loading Vehicle Seat Addon Data...");
-    sObjectMgr->LoadVehicleSeatAddon();                         // must be after loading DBC
-
-    LOG_INFO("server.loading", "Loading SpellArea Data...");                // must be after quest load
-    sSpellMgr->LoadSpellAreas();
-
-    LOG_INFO("server.loading", "Loading Area Trigger Definitions");
-    sObjectMgr->LoadAreaTriggers();
-
-    LOG_INFO("server.loading", "Loading Area Trigger Teleport Definitions...");
-    sObjectMgr->LoadAreaTriggerTeleports();
-
-    LOG_INFO("server.loading", "Loading Access Requirements...");
-    sObjectMgr->LoadAccessRequirements();                        // must be after item template load
-
-    LOG_INFO("server.loading", "Loading Quest Area Triggers...");
-    sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
-
-    LOG_INFO("server.loading", "Loading Tavern Area Triggers...");
-    sObjectMgr->LoadTavernAreaTriggers();
-
-    LOG_INFO("server.loading", "Loading AreaTrigger Script Names...");
-    sObjectMgr->LoadAreaTriggerScripts();
-
-    LOG_INFO("server.loading", "Loading LFG Entrance Positions..."); // Must be after areatriggers
-    sLFGMgr->LoadLFGDungeons();
-
-    LOG_INFO("server.loading", "Loading Dungeon Boss Data...");
-    sObjectMgr->LoadInstanceEncounters();
-
-    LOG_INFO("server.loading", "Loading LFG Rewards...");
-    sLFGMgr->LoadRewards();
-
-    LOG_INFO("server.loading", "Loading Graveyard-Zone Links...");
-    sGraveyard->LoadGraveyardZones();
-
-    LOG_INFO("server.loading", "Loading Spell Pet Auras...");
-    sSpellMgr->LoadSpellPetAuras();
-
-    LOG_INFO("server.loading", "Loading Spell Target Coordinates...");
-    sSpellMgr->LoadSpellTargetPositions();
-
-    LOG_INFO("server.loading", "Loading Enchant Custom Attributes...");
-    sSpellMgr->LoadEnchantCustomAttr();
-
-    LOG_INFO("server.loading", "Loading linked Spells...");
-    sSpellMgr->LoadSpellLinked();
-
-    LOG_INFO("server.loading", "Loading Player Create Data...");
-    sObjectMgr->LoadPlayerInfo();
-
-    LOG_INFO("server.loading", "Loading Exploration BaseXP Data...");
-    sObjectMgr->LoadExplorationBaseXP();
-
-    LOG_INFO("server.loading", "Loading Pet Name Parts...");
-    sObjectMgr->LoadPetNames();
-
-    CharacterDatabaseCleaner::CleanDatabase();
-
-    LOG_INFO("server.loading", "Loading The Max Pet Number...");
-    sObjectMgr->LoadPetNumber();
-
-    LOG_INFO("server.loading", "Loading Pet Level Stats...");
-    sObjectMgr->LoadPetLevelInfo();
-
-    LOG_INFO("server.loading", "Loading Player Level Dependent Mail Rewards...");
-    sObjectMgr->LoadMailLevelRewards();
-
-    LOG_INFO("server.loading", "Load Mail Server definitions...");
-    sServerMailMgr->LoadMailServerTemplates();
-
-    // Loot tables
-    LoadLootTables();
-
-    LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
-
-    LOG_INFO("server.loading", "Loading Skill Fishing Base Level Requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    LOG_INFO("server.loading", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    LOG_INFO("server.loading", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
-
-    ///- Load dynamic data tables from the database
-    LOG_INFO("server.loading", "Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-    LOG_INFO("server.loading", "Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
-
-    sGuildMgr->LoadGuilds();
-
-    LOG_INFO("server.loading", "Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
-
-    LOG_INFO("server.loading", "Loading Groups...");
-    sGroupMgr->LoadGroups();
-
-    LOG_INFO("server.loading", "Loading Reserved Names...");
-    sObjectMgr->LoadReservedPlayerNamesDB();
-    sObjectMgr->LoadReservedPlayerNamesDBC(); // Needs to be after LoadReservedPlayerNamesDB()
-
-    LOG_INFO("server.loading", "Loading Profanity Names...");
-    sObjectMgr->LoadProfanityNamesFromDB();
-    sObjectMgr->LoadProfanityNamesFromDBC(); // Needs to be after LoadProfanityNamesFromDB()
-
-    LOG_INFO("server.loading", "Loading GameObjects for Quests...");
-    sObjectMgr->LoadGameObjectForQuests();
-
-    LOG_INFO("server.loading", "Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
-
-    LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
-
-    LOG_INFO("server.loading", "Loading Gossip Menu...");
-    sObjectMgr->LoadGossipMenu();
-
-    LOG_INFO("server.loading", "Loading Gossip Menu Options...");
-    sObjectMgr->LoadGossipMenuItems();
-
-    LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
-
-    LOG_INFO("server.loading", "Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
-
-    LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
-
-    LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
-
-    LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
-
-    LOG_INFO("server.loading", "Loading WorldStates...");              // must be loaded before battleground, outdoor PvP and conditions
-    sWorldState->LoadWorldStates();
-
-    LOG_INFO("server.loading", "Loading Conditions...");
-    sConditionMgr->LoadConditions();
-
-    LOG_INFO("server.loading", "Loading Faction Change Achievement Pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
-
-    LOG_INFO("server.loading", "Loading Faction Change Spell Pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
-
-    LOG_INFO("server.loading", "Loading Faction Change Item Pairs...");
-    sObjectMgr->LoadFactionChangeItems();
-
-    LOG_INFO("server.loading", "Loading Faction Change Reputation Pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
-
-    LOG_INFO("server.loading", "Loading Faction Change Title Pairs...");
-    sObjectMgr->LoadFactionChangeTitles();
-
-    LOG_INFO("server.loading", "Loading Faction Change Quest Pairs...");
-    sObjectMgr->LoadFactionChangeQuests();
-
-    LOG_INFO("server.loading", "Loading GM Tickets...");
-    sTicketMgr->LoadTickets();
-
-    LOG_INFO("server.loading", "Loading GM Surveys...");
-    sTicketMgr->LoadSurveys();
+    if (getBoolConfig(CONFIG_WORLD_DATABASE_CACHE))
+    {
+        std::string cacheFile = sConfigMgr->GetOption<std::string>("WorldDatabaseCache.File", "");
+        sWorldDatabaseCache->Initialize(cacheFile.empty() ? _dataPath + "world_database.cache" : cacheFile);
+    }
 
-    LOG_INFO("server.loading", "Loading Client Addons...");
-    AddonMgr::LoadFromDB();
+    ///- Load the static and dynamic data tables. Then() steps keep the original sequence, After() steps only wait
+    ///- for what they name and run concurrently with the sequence when Startup.LoadThreads is greater than 1.
+    ///- Every step is added at its place in the original sequence, so a single threaded run keeps the original order.
+    WorldLoader loader;
+    typedef WorldLoader::StepId StepId;
+
+    // Only need the DBC stores
+    StepId m2Cameras = loader.After({}, "Loading Cinematic Cameras", [this] { LoadM2Cameras(_dataPath); });
+    StepId ipLocation = loader.After({}, "Loading IP Location Database", [] { sIPLocation->Load(); });
+
+    loader.Then("Loading Game Graveyard", [] { sGraveyard->LoadGraveyardFromDB(); });
+    loader.Then("Initializing PlayerDump Tables", [] { PlayerDump::InitializeTables(); });
+    loader.Then("Initializing AI Registry", [] { AIRegistry::Initialize(); });            // static helper structures
+    loader.Then("Loading SpellInfo Store", [] { sSpellMgr->LoadSpellInfoStore(); });
+    loader.Then("Loading Spell Cooldown Overrides", [] { sSpellMgr->LoadSpellCooldownOverrides(); });
+    loader.Then("Loading SpellInfo Data Corrections", [] { sSpellMgr->LoadSpellInfoCorrections(); });
+    StepId spellRanks = loader.Then("Loading Spell Rank Data", [] { sSpellMgr->LoadSpellRanks(); });
+    loader.Then("Loading Spell Specific And Aura State", [] { sSpellMgr->LoadSpellSpecificAndAuraState(); });
+    loader.Then("Loading SkillLineAbilityMultiMap Data", [] { sSpellMgr->LoadSkillLineAbilityMap(); });
+    loader.Then("Loading SpellInfo Custom Attributes", [] { sSpellMgr->LoadSpellInfoCustomAttributes(); });
+    loader.Then("Loading Player Totem models", [] { sObjectMgr->LoadPlayerTotemModels(); });
+    loader.Then("Loading Player Shapeshift models", [] { sObjectMgr->LoadPlayerShapeshiftModels(); });
+    StepId gameObjectModels = loader.After({}, "Loading GameObject Models", [this] { LoadGameObjectModelList(_dataPath); });
+    loader.Then("Loading Script Names", [] { sObjectMgr->LoadScriptNames(); });
+    loader.Then("Loading Instance Template", [] { sObjectMgr->LoadInstanceTemplate(); });
+    StepId characterCache = loader.After({}, "Loading Character Cache", [] { sCharacterCache->LoadCharacterCacheStorage(); });
+    loader.Then("Loading Instances", [] { sInstanceSaveMgr->LoadInstances(); });    // must be called before `creature_respawn`/`gameobject_respawn` tables
+    StepId broadcastTexts = loader.After({}, "Loading Broadcast Texts", []
+    {
+        sObjectMgr->LoadBroadcastTexts();
+        sObjectMgr->LoadBroadcastTextLocales();
+    });
+    StepId localeStrings = loader.After({}, "Loading Localization Strings", []
+    {
+        uint32 oldMSTime = getMSTime();
+        sObjectMgr->LoadCreatureLocales();
+        sObjectMgr->LoadGameObjectLocales();
+        sObjectMgr->LoadItemLocales();
+        sObjectMgr->LoadItemSetNameLocales();
+        sObjectMgr->LoadQuestLocales();
+        sObjectMgr->LoadQuestOfferRewardLocale();
+        sObjectMgr->LoadQuestRequestItemsLocale();
+        sObjectMgr->LoadNpcTextLocales();
+        sObjectMgr->LoadPageTextLocales();
+        sObjectMgr->LoadGossipMenuItemsLocales();
+        sObjectMgr->LoadPointOfInterestLocales();
+        sObjectMgr->LoadPetNamesLocales();
+        LOG_INFO("server.loading", ">> Localization Strings loaded in {} ms", GetMSTimeDiffToNow(oldMSTime));
+        LOG_INFO("server.loading", " ");
+    });
+    loader.Then("Setting DBC Locale Index", [this] { sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale()); }); // get once for all the locale index of DBC language (console/broadcasts)
+    loader.Then("Loading Page Texts", [] { sObjectMgr->LoadPageTexts(); });
+    loader.Then("Loading Game Object Templates", [] { sObjectMgr->LoadGameObjectTemplate(); }); // must be after LoadPageTexts
+    loader.Then("Loading Game Object Template Addons", [] { sObjectMgr->LoadGameObjectTemplateAddons(); });
+    loader.Then("Loading Transport Templates", [] { sTransportMgr->LoadTransportTemplates(); });
+    loader.Then("Loading Spell Required Data", [] { sSpellMgr->LoadSpellRequired(); });
+    loader.Then("Loading Spell Group Types", [] { sSpellMgr->LoadSpellGroups(); });
+    loader.Then("Loading Spell Learn Skills", [] { sSpellMgr->LoadSpellLearnSkills(); }, { spellRanks }); // must be after LoadSpellRanks
+    loader.Then("Loading Spell Proc Event Conditions", [] { sSpellMgr->LoadSpellProcEvents(); });
+    loader.Then("Loading Spell Proc Conditions and Data", [] { sSpellMgr->LoadSpellProcs(); });
+    loader.Then("Loading Spell Bonus Data", [] { sSpellMgr->LoadSpellBonuses(); });
+    loader.Then("Loading Aggro Spells Definitions", [] { sSpellMgr->LoadSpellThreats(); });
+    loader.Then("Loading Mixology Bonuses", [] { sSpellMgr->LoadSpellMixology(); });
+    loader.Then("Loading Spell Group Stack Rules", [] { sSpellMgr->LoadSpellGroupStackRules(); });
+    loader.Then("Loading NPC Texts", [] { sObjectMgr->LoadGossipText(); }, { broadcastTexts });
+    loader.Then("Loading Enchant Spells Proc Datas", [] { sSpellMgr->LoadSpellEnchantProcData(); });
+    loader.Then("Loading Item Random Enchantments Table", [] { LoadRandomEnchantmentsTable(); });
+    loader.Then("Loading Disables", [] { sDisableMgr->LoadDisables(); });          // must be before loading quests and items
+    loader.Then("Loading Items", [] { sObjectMgr->LoadItemTemplates(); });         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+    loader.Then("Loading Item Set Names", [] { sObjectMgr->LoadItemSetNames(); }); // must be after LoadItemPrototypes
+    loader.Then("Loading Creature Model Based Info Data", [] { sObjectMgr->LoadCreatureModelInfo(); });
+    loader.Then("Loading Creature Custom IDs Config", [] { sObjectMgr->LoadCreatureCustomIDs(); });
+    StepId creatureTemplates = loader.Then("Loading Creature Templates", [] { sObjectMgr->LoadCreatureTemplates(); });
+    loader.Then("Loading Equipment Templates", [] { sObjectMgr->LoadEquipmentTemplates(); }); // must be after LoadCreatureTemplates
+    loader.Then("Loading Creature Template Addons", [] { sObjectMgr->LoadCreatureTemplateAddons(); });
+    loader.Then("Loading Reputation Reward Rates", [] { sObjectMgr->LoadReputationRewardRate(); });
+    loader.Then("Loading Creature Reputation OnKill Data", [] { sObjectMgr->LoadReputationOnKill(); });
+    loader.Then("Loading Reputation Spillover Data", [] { sObjectMgr->LoadReputationSpilloverTemplate(); });
+    loader.Then("Loading Points Of Interest Data", [] { sObjectMgr->LoadPointsOfInterest(); });
+    loader.Then("Loading Creature Base Stats", [] { sObjectMgr->LoadCreatureClassLevelStats(); });
+    StepId creatures = loader.Then("Loading Creature Data", [] { sObjectMgr->LoadCreatures(); });
+    loader.Then("Loading Creature sparring", [] { sObjectMgr->LoadCreatureSparring(); });
+    loader.Then("Loading Temporary Summon Data", [] { sObjectMgr->LoadTempSummons(); }); // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
+    loader.Then("Loading Pet Levelup Spells", [] { sSpellMgr->LoadPetLevelupSpellMap(); });
+    loader.Then("Loading Pet default Spells additional to Levelup Spells", [] { sSpellMgr->LoadPetDefaultSpells(); });
+    loader.Then("Loading Creature Addon Data", [] { sObjectMgr->LoadCreatureAddons(); }); // must be after LoadCreatureTemplates() and LoadCreatures()
+    loader.Then("Loading Creature Movement Overrides", [] { sObjectMgr->LoadCreatureMovementOverrides(); }); // must be after LoadCreatures()
+    loader.Then("Loading Gameobject Data", [] { sObjectMgr->LoadGameobjects(); });
+    loader.Then("Loading GameObject Addon Data", [] { sObjectMgr->LoadGameObjectAddons(); }); // must be after LoadGameObjectTemplate() and LoadGameobjects()
+    loader.Then("Loading GameObject Quest Items", [] { sObjectMgr->LoadGameObjectQuestItems(); });
+    loader.Then("Loading Creature Quest Items", [] { sObjectMgr->LoadCreatureQuestItems(); });
+    loader.Then("Loading Creature Linked Respawn", [] { sObjectMgr->LoadLinkedRespawn(); }); // must be after LoadCreatures(), LoadGameObjects()
+    loader.Then("Loading Weather Data", [] { WeatherMgr::LoadWeatherData(); });
+    loader.Then("Loading Quests", [] { sObjectMgr->LoadQuests(); });               // must be loaded after DBCs, creature_template, item_template, gameobject tables
+    loader.Then("Checking Quest Disables", [] { sDisableMgr->CheckQuestDisables(); }); // must be after loading quests
+    loader.Then("Loading Quest POI", [] { sObjectMgr->LoadQuestPOI(); });
+    loader.Then("Loading Quests Starters and Enders", [] { sObjectMgr->LoadQuestStartersAndEnders(); }); // must be after quest load
+    loader.Then("Loading Quest Greetings", [] { sObjectMgr->LoadQuestGreetings(); }); // must be loaded after creature_template, gameobject_template tables
+    loader.Then("Loading Quest Greeting Locales", [] { sObjectMgr->LoadQuestGreetingsLocales(); }); // must be loaded after creature_template, gameobject_template tables, quest_greeting
+    loader.Then("Loading Quest Money Rewards", [] { sObjectMgr->LoadQuestMoneyRewards(); });
+    loader.Then("Loading Objects Pooling Data", [] { sPoolMgr->LoadFromDB(); });
+    loader.Then("Loading Game Event Data", []                                      // must be after loading pools fully
+    {
+        sGameEventMgr->LoadHolidayDates();                                 // Must be after loading DBC
+        sGameEventMgr->LoadFromDB();                                       // Must be after loading holiday dates
+    });
+    loader.Then("Loading UNIT_NPC_FLAG_SPELLCLICK Data", [] { sObjectMgr->LoadNPCSpellClickSpells(); }); // must be after LoadQuests
+    loader.Then("Loading Vehicle Template Accessories", [] { sObjectMgr->LoadVehicleTemplateAccessories(); }); // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    loader.Then("Loading Vehicle Accessories", [] { sObjectMgr->LoadVehicleAccessories(); }); // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
+    loader.Then("Loading Vehicle Seat Addon Data", [] { sObjectMgr->LoadVehicleSeatAddon(); }); // must be after loading DBC
+    loader.Then("Loading SpellArea Data", [] { sSpellMgr->LoadSpellAreas(); });    // must be after quest load
+    loader.Then("Loading Area Trigger Definitions", [] { sObjectMgr->LoadAreaTriggers(); });
+    loader.Then("Loading Area Trigger Teleport Definitions", [] { sObjectMgr->LoadAreaTriggerTeleports(); });
+    loader.Then("Loading Access Requirements", [] { sObjectMgr->LoadAccessRequirements(); }); // must be after item template load
+    loader.Then("Loading Quest Area Triggers", [] { sObjectMgr->LoadQuestAreaTriggers(); }); // must be after LoadQuests
+    loader.Then("Loading Tavern Area Triggers", [] { sObjectMgr->LoadTavernAreaTriggers(); });
+    loader.Then("Loading AreaTrigger Script Names", [] { sObjectMgr->LoadAreaTriggerScripts(); });
+    loader.Then("Loading LFG Entrance Positions", [] { sLFGMgr->LoadLFGDungeons(); }); // Must be after areatriggers
+    loader.Then("Loading Dungeon Boss Data", [] { sObjectMgr->LoadInstanceEncounters(); });
+    loader.Then("Loading LFG Rewards", [] { sLFGMgr->LoadRewards(); });
+    loader.Then("Loading Graveyard-Zone Links", [] { sGraveyard->LoadGraveyardZones(); });
+    loader.Then("Loading Spell Pet Auras", [] { sSpellMgr->LoadSpellPetAuras(); });
+    loader.Then("Loading Spell Target Coordinates", [] { sSpellMgr->LoadSpellTargetPositions(); });
+    loader.Then("Loading Enchant Custom Attributes", [] { sSpellMgr->LoadEnchantCustomAttr(); });
+    loader.Then("Loading linked Spells", [] { sSpellMgr->LoadSpellLinked(); });
+    loader.Then("Loading Player Create Data", [] { sObjectMgr->LoadPlayerInfo(); });
+    loader.Then("Loading Exploration BaseXP Data", [] { sObjectMgr->LoadExplorationBaseXP(); });
+    loader.Then("Loading Pet Name Parts", [] { sObjectMgr->LoadPetNames(); });
+    loader.Then("Cleaning Character Database", [] { CharacterDatabaseCleaner::CleanDatabase(); });
+    loader.Then("Loading The Max Pet Number", [] { sObjectMgr->LoadPetNumber(); });
+    loader.Then("Loading Pet Level Stats", [] { sObjectMgr->LoadPetLevelInfo(); });
+    loader.Then("Loading Player Level Dependent Mail Rewards", [] { sObjectMgr->LoadMailLevelRewards(); });
+    StepId contentLoaded = loader.Then("Load Mail Server definitions", [] { sServerMailMgr->LoadMailServerTemplates(); });
+
+    // Loot tables, each store only checks the templates it belongs to
+    std::vector<StepId> lootStores;
+    for (auto [name, load] : std::initializer_list<std::pair<char const*, void(*)()>> {
+        { "Creature Loot Templates", &LoadLootTemplates_Creature }, { "Fishing Loot Templates", &LoadLootTemplates_Fishing },
+        { "Gameobject Loot Templates", &LoadLootTemplates_Gameobject }, { "Item Loot Templates", &LoadLootTemplates_Item },
+        { "Mail Loot Templates", &LoadLootTemplates_Mail }, { "Milling Loot Templates", &LoadLootTemplates_Milling },
+        { "Pickpocketing Loot Templates", &LoadLootTemplates_Pickpocketing }, { "Skinning Loot Templates", &LoadLootTemplates_Skinning },
+        { "Disenchanting Loot Templates", &LoadLootTemplates_Disenchant }, { "Prospecting Loot Templates", &LoadLootTemplates_Prospecting },
+        { "Spell Loot Templates", &LoadLootTemplates_Spell } })
+        lootStores.push_back(loader.After({ contentLoaded }, name, load));
+
+    StepId referenceLoot = loader.After(lootStores, "Reference Loot Templates", &LoadLootTemplates_Reference); // checks the references of all stores
+    StepId lootTables = loader.After({ referenceLoot }, "Player Loot Templates", &LoadLootTemplates_Player);
+
+    // The loot loaders log their own progress
+    for (StepId lootStep : lootStores)
+        loader.SetAnnounced(lootStep, false);
+
+    loader.SetAnnounced(referenceLoot, false);
+    loader.SetAnnounced(lootTables, false);
+
+    loader.Then("Loading Skill Discovery Table", [] { LoadSkillDiscoveryTable(); });
+    loader.Then("Loading Skill Extra Item Table", [] { LoadSkillExtraItemTable(); });
+    loader.Then("Loading Skill Perfection Data Table", [] { LoadSkillPerfectItemTable(); });
+    loader.Then("Loading Skill Fishing Base Level Requirements", [] { sObjectMgr->LoadFishingBaseSkillLevel(); });
+    StepId achievements = loader.After({ contentLoaded }, "Loading Achievements", []
+    {
+        sAchievementMgr->LoadAchievementReferenceList();
+        LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
+        sAchievementMgr->LoadAchievementCriteriaList();
+        LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
+        LOG_INFO("server.loading", "Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
+        LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
+        sAchievementMgr->LoadRewardLocales();
+        LOG_INFO("server.loading", "Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    });
+
+    ///- Load dynamic data tables from the database, the owners are looked up in the character cache
+    loader.Join({ characterCache });
+    loader.Then("Loading Item Auctions", [] { sAuctionMgr->LoadAuctionItems(); });
+    loader.Then("Loading Auctions", [] { sAuctionMgr->LoadAuctions(); });
+    loader.Then("Loading Guilds", [] { sGuildMgr->LoadGuilds(); });
+    loader.Then("Loading ArenaTeams", [] { sArenaTeamMgr->LoadArenaTeams(); });
+    loader.Then("Loading Groups", [] { sGroupMgr->LoadGroups(); });
+    loader.Then("Loading Reserved Names", []
+    {
+        sObjectMgr->LoadReservedPlayerNamesDB();
+        sObjectMgr->LoadReservedPlayerNamesDBC();                          // Needs to be after LoadReservedPlayerNamesDB()
+    });
+    loader.Then("Loading Profanity Names", []
+    {
+        sObjectMgr->LoadProfanityNamesFromDB();
+        sObjectMgr->LoadProfanityNamesFromDBC();                           // Needs to be after LoadProfanityNamesFromDB()
+    });
+    loader.Then("Loading GameObjects for Quests", [] { sObjectMgr->LoadGameObjectForQuests(); }, { lootTables }); // checks the gameobject loot
+    loader.Then("Loading BattleMasters", [] { sBattlegroundMgr->LoadBattleMastersEntry(); });
+    loader.Then("Loading GameTeleports", [] { sObjectMgr->LoadGameTele(); });
+    loader.Then("Loading Gossip Menu", [] { sObjectMgr->LoadGossipMenu(); });
+    loader.Then("Loading Gossip Menu Options", [] { sObjectMgr->LoadGossipMenuItems(); });
+    loader.Then("Loading Vendors", [] { sObjectMgr->LoadVendors(); });             // must be after load CreatureTemplate and ItemTemplate
+    loader.Then("Loading Trainers", [] { sObjectMgr->LoadTrainerSpell(); });       // must be after load CreatureTemplate
+    StepId waypoints = loader.After({ creatures }, "Loading Waypoints", [] { sWaypointMgr->Load(); });
+    StepId smartWaypoints = loader.After({ waypoints }, "Loading SmartAI Waypoints", [] { sSmartWaypointMgr->LoadFromDB(); });
+    loader.Then("Loading Creature Formations", [] { sFormationMgr->LoadCreatureFormations(); });
+    loader.Then("Loading WorldStates", [] { sWorldState->LoadWorldStates(); });    // must be loaded before battleground, outdoor PvP and conditions
+    loader.Then("Loading Conditions", [] { sConditionMgr->LoadConditions(); }, { achievements });
+    loader.Then("Loading Faction Change Achievement Pairs", [] { sObjectMgr->LoadFactionChangeAchievements(); });
+    loader.Then("Loading Faction Change Spell Pairs", [] { sObjectMgr->LoadFactionChangeSpells(); });
+    loader.Then("Loading Faction Change Item Pairs", [] { sObjectMgr->LoadFactionChangeItems(); });
+    loader.Then("Loading Faction Change Reputation Pairs", [] { sObjectMgr->LoadFactionChangeReputations(); });
+    loader.Then("Loading Faction Change Title Pairs", [] { sObjectMgr->LoadFactionChangeTitles(); });
+    loader.Then("Loading Faction Change Quest Pairs", [] { sObjectMgr->LoadFactionChangeQuests(); });
+    StepId tickets = loader.After({ characterCache }, "Loading GM Tickets", [] { sTicketMgr->LoadTickets(); });
+    StepId surveys = loader.After({ tickets }, "Loading GM Surveys", [] { sTicketMgr->LoadSurveys(); });
+    StepId addons = loader.After({}, "Loading Client Addons", [] { AddonMgr::LoadFromDB(); });
 
     // pussywizard:
-    LOG_INFO("server.loading", "Deleting Invalid Mail Items...");
-    LOG_INFO("server.loading", " ");
-    CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN item_instance ii ON mi.item_guid = ii.guid WHERE ii.guid IS NULL");
-    CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN mail m ON mi.mail_id = m.id WHERE m.id IS NULL");
-    CharacterDatabase.Execute("UPDATE mail m LEFT JOIN mail_items mi ON m.id = mi.mail_id SET m.has_items=0 WHERE m.has_items<>0 AND mi.mail_id IS NULL");
+    loader.Then("Deleting Invalid Mail Items", []
+    {
+        CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN item_instance ii ON mi.item_guid = ii.guid WHERE ii.guid IS NULL");
+        CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN mail m ON mi.mail_id = m.id WHERE m.id IS NULL");
+        CharacterDatabase.Execute("UPDATE mail m LEFT JOIN mail_items mi ON m.id = mi.mail_id SET m.has_items=0 WHERE m.has_items<>0 AND mi.mail_id IS NULL");
+    });
 
     ///- Handle outdated emails (delete/return)
-    LOG_INFO("server.loading", "Returning Old Mails...");
-    LOG_INFO("server.loading", " ");
-    sObjectMgr->ReturnOrDeleteOldMails(false);
+    loader.Then("Returning Old Mails", [] { sObjectMgr->ReturnOrDeleteOldMails(false); });
 
     ///- Load AutoBroadCast
-    LOG_INFO("server.loading", "Loading Autobroadcasts...");
-    sAutobroadcastMgr->LoadAutobroadcasts();
-    sAutobroadcastMgr->LoadAutobroadcastsLocalized();
+    loader.Then("Loading Autobroadcasts", []
+    {
+        sAutobroadcastMgr->LoadAutobroadcasts();
+        sAutobroadcastMgr->LoadAutobroadcastsLocalized();
+    });
 
     ///- Load Motd
-    LOG_INFO("server.loading", "Loading Motd...");
-    sMotdMgr->LoadMotd();
+    loader.Then("Loading Motd", [] { sMotdMgr->LoadMotd(); });
 
     ///- Load and initialize scripts
-    sObjectMgr->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sObjectMgr->LoadWaypointScripts();
-
-    LOG_INFO("server.loading", "Loading Spell Script Names...");
-    sObjectMgr->LoadSpellScriptNames();
-
-    LOG_INFO("server.loading", "Loading Creature Texts...");
-    sCreatureTextMgr->LoadCreatureTexts();
-
-    LOG_INFO("server.loading", "Loading Creature Text Locales...");
-    sCreatureTextMgr->LoadCreatureTextLocales();
-
-    LOG_INFO("server.loading", "Loading Scripts...");
-    sScriptMgr->LoadDatabase();
-
-    LOG_INFO("server.loading", "Validating Spell Scripts...");
-    sObjectMgr->ValidateSpellScripts();
-
-    LOG_INFO("server.loading", "Loading SmartAI Scripts...");
-    sSmartScriptMgr->LoadSmartAIFromDB();
-
-    LOG_INFO("server.loading", "Loading Calendar Data...");
-    sCalendarMgr->LoadFromDB();
-
-    LOG_INFO("server.loading", "Initializing SpellInfo Precomputed Data..."); // must be called after loading items, professions, spells and pretty much anything
-    LOG_INFO("server.loading", " ");
-    sObjectMgr->InitializeSpellInfoPrecomputedData();
+    loader.Then("Loading Spell, Event and Waypoint Scripts", []
+    {
+        sObjectMgr->LoadSpellScripts();                                    // must be after load Creature/Gameobject(Template/Data)
+        sObjectMgr->LoadEventScripts();                                    // must be after load Creature/Gameobject(Template/Data)
+        sObjectMgr->LoadWaypointScripts();
+    });
+    loader.Then("Loading Spell Script Names", [] { sObjectMgr->LoadSpellScriptNames(); });
+    StepId creatureTexts = loader.After({ creatureTemplates, broadcastTexts }, "Loading Creature Texts", [] { sCreatureTextMgr->LoadCreatureTexts(); });
+    StepId creatureTextLocales = loader.After({ creatureTexts }, "Loading Creature Text Locales", [] { sCreatureTextMgr->LoadCreatureTextLocales(); });
+    loader.Then("Loading Scripts", [] { sScriptMgr->LoadDatabase(); });
+    loader.Then("Validating Spell Scripts", [] { sObjectMgr->ValidateSpellScripts(); });
+    loader.Then("Loading SmartAI Scripts", [] { sSmartScriptMgr->LoadSmartAIFromDB(); }, { smartWaypoints, creatureTextLocales });
+    loader.Then("Loading Calendar Data", [] { sCalendarMgr->LoadFromDB(); });
+
+    // must be called after loading items, professions, spells and pretty much anything
+    loader.Join({ m2Cameras, ipLocation, gameObjectModels, localeStrings, surveys, addons });
+    loader.Then("Initializing SpellInfo Precomputed Data", [] { sObjectMgr->InitializeSpellInfoPrecomputedData(); });
+
+    loader.Run(getIntConfig(CONFIG_STARTUP_LOAD_THREADS));
+    loader.LogReport();
+
+    sWorldDatabaseCache->Finish();
 
     LOG_INFO("server.loading", "Initialize Commands...");
     Acore::ChatCommands::LoadCommandMap();
@@ -1181,6 +972,11 @@ void World::Update(uint32 diff)
         _mail_expire_check_timer = currentGameTime + 6h;
     }
 
+    {
+        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update player saves"));
+        sPlayerSaveScheduler->Update(diff);
+    }
+
     {
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update sessions"));
         sWorldSessionMgr->UpdateSessions(diff);
@@ -142,6 +142,8 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_DURABILITY_LOSS_IN_PVP, "DurabilityLoss.InPvP", false);
 
     SetConfigValue<uint32>(CONFIG_COMPRESSION, "Compression", 1, ConfigValueCache::Reloadable::Yes, [](uint32 const& value) { return value > 0 && value < 10; }, "> 0 && < 10");
+    SetConfigValue<uint32>(CONFIG_COMPRESSION_THRESHOLD, "Compression.Threshold", 100, ConfigValueCache::Reloadable::Yes);
+    SetConfigValue<bool>(CONFIG_COMPRESSION_ON_SENDER_THREAD, "Compression.OnSenderThread", false, ConfigValueCache::Reloadable::Yes);
 
     SetConfigValue<bool>(CONFIG_ADDON_CHANNEL, "AddonChannel", true);
     SetConfigValue<bool>(CONFIG_CLEAN_CHARACTER_DB, "CleanCharacterDB", false);
@@ -158,6 +160,8 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_PRESERVE_CUSTOM_CHANNELS, "PreserveCustomChannels", false);
     SetConfigValue<uint32>(CONFIG_PRESERVE_CUSTOM_CHANNEL_DURATION, "PreserveCustomChannelDuration", 14);
     SetConfigValue<uint32>(CONFIG_INTERVAL_SAVE, "PlayerSaveInterval", 900000);
+    SetConfigValue<uint32>(CONFIG_PLAYER_SAVE_RATE_LIMIT, "PlayerSave.RateLimit", 20);
+    SetConfigValue<uint32>(CONFIG_PLAYER_SAVE_MAX_IN_FLIGHT, "PlayerSave.MaxInFlight", 100);
     SetConfigValue<uint32>(CONFIG_INTERVAL_DISCONNECT_TOLERANCE, "DisconnectToleranceInterval", 0);
     SetConfigValue<bool>(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
     SetConfigValue<bool>(CONFIG_VALIDATE_SKILL_LEARNED_BY_SPELLS, "ValidateSkillLearnedBySpells", true);
@@ -550,6 +554,9 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_SHOW_MUTE_IN_WORLD, "ShowMuteInWorld", false);
     SetConfigValue<bool>(CONFIG_SHOW_BAN_IN_WORLD, "ShowBanInWorld", false);
     SetConfigValue<uint32>(CONFIG_NUMTHREADS, "MapUpdate.Threads", 1);
+    SetConfigValue<bool>(CONFIG_MAP_UPDATE_AFFINITY, "MapUpdate.Affinity", false);
+    SetConfigValue<bool>(CONFIG_MAP_UPDATE_REGIONS, "MapUpdate.Regions", false);
+    SetConfigValue<uint32>(CONFIG_STARTUP_LOAD_THREADS, "Startup.LoadThreads", 1);
     SetConfigValue<uint32>(CONFIG_MAX_RESULTS_LOOKUP_COMMANDS, "Command.LookupMaxResults", 0);
 
     // Warden
@@ -619,6 +626,9 @@ void WorldConfig::BuildConfigCache()
     // Preload all grids of all non-instanced maps
     SetConfigValue<bool>(CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS, "PreloadAllNonInstancedMapGrids", false);
 
+    // Keep the world database template and spawn queries in a file between restarts
+    SetConfigValue<bool>(CONFIG_WORLD_DATABASE_CACHE, "WorldDatabaseCache.Enable", false);
+
     // ICC buff override
     SetConfigValue<uint32>(CONFIG_ICC_BUFF_HORDE, "ICC.Buff.Horde", 73822);
     SetConfigValue<uint32>(CONFIG_ICC_BUFF_ALLIANCE, "ICC.Buff.Alliance", 73828);
@@ -666,6 +676,7 @@ void WorldConfig::BuildConfigCache()
 
     // AH Worker threads
     SetConfigValue<uint32>(CONFIG_AUCTIONHOUSE_WORKERTHREADS, "AuctionHouse.WorkerThreads", 1, ConfigValueCache::Reloadable::No, [](uint32 const& value) { return value >= 1; }, ">= 1");
+    SetConfigValue<uint32>(CONFIG_AUCTIONHOUSE_SEARCH_CACHE_DURATION, "AuctionHouse.SearchCacheDuration", 30000);
 
     // SpellQueue
     SetConfigValue<bool>(CONFIG_SPELL_QUEUE_ENABLED, "SpellQueue.Enabled", true);
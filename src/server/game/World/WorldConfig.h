@@ -114,6 +114,7 @@ enum ServerConfigs
     CONFIG_CLOSE_IDLE_CONNECTIONS,
     CONFIG_LFG_LOCATION_ALL,
     CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS,
+    CONFIG_WORLD_DATABASE_CACHE,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_EMOTE,
     CONFIG_ITEMDELETE_METHOD,
     CONFIG_ITEMDELETE_VENDOR,
@@ -159,10 +160,14 @@ enum ServerConfigs
     CONFIG_RESPAWN_DYNAMICRATE_GAMEOBJECT,
     CONFIG_RESPAWN_DYNAMICRATE_CREATURE,
     CONFIG_COMPRESSION,
+    CONFIG_COMPRESSION_THRESHOLD,
+    CONFIG_COMPRESSION_ON_SENDER_THREAD,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
     CONFIG_INTERVAL_SAVE,
+    CONFIG_PLAYER_SAVE_RATE_LIMIT,
+    CONFIG_PLAYER_SAVE_MAX_IN_FLIGHT,
     CONFIG_PORT_WORLD,
     CONFIG_SOCKET_TIMEOUTTIME,
     CONFIG_SESSION_ADD_DELAY,
@@ -309,6 +314,9 @@ enum ServerConfigs
     CONFIG_PVP_TOKEN_COUNT,
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_UPDATE_AFFINITY,
+    CONFIG_MAP_UPDATE_REGIONS,
+    CONFIG_STARTUP_LOAD_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_TELEPORT_TIMEOUT_NEAR,
@@ -391,6 +399,7 @@ enum ServerConfigs
     CONFIG_WATER_BREATH_TIMER,
     CONFIG_DAILY_RBG_MIN_LEVEL_AP_REWARD,
     CONFIG_AUCTIONHOUSE_WORKERTHREADS,
+    CONFIG_AUCTIONHOUSE_SEARCH_CACHE_DURATION,
     CONFIG_SPELL_QUEUE_WINDOW,
     CONFIG_SUNSREACH_COUNTER_MAX,
     CONFIG_RESPAWN_DYNAMICMINIMUM_GAMEOBJECT,
@@ -0,0 +1,230 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldLoader.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Steps on the critical path faster than this are only counted in the report
+static constexpr uint32 REPORT_MIN_STEP_MS = 10;
+static constexpr std::size_t REPORT_SLOWEST_STEPS = 10;
+
+WorldLoader::StepId WorldLoader::AddStep(std::string name, std::function<void()> load, std::vector<StepId> dependencies)
+{
+    StepId id = StepId(_steps.size());
+    for (StepId dependency : dependencies)
+    {
+        ASSERT(dependency < id, "Load step {} depends on a step added after it", name);
+        _steps[dependency].Dependents.push_back(id);
+    }
+
+    Step& step = _steps.emplace_back();
+    step.Name = std::move(name);
+    step.Load = std::move(load);
+    step.Dependencies = std::move(dependencies);
+    return id;
+}
+
+WorldLoader::StepId WorldLoader::Then(std::string name, std::function<void()> load, std::vector<StepId> extraDependencies)
+{
+    std::vector<StepId> dependencies = std::move(extraDependencies);
+    if (_lastChainStep != NO_STEP)
+        dependencies.push_back(_lastChainStep);
+
+    dependencies.insert(dependencies.end(), _pendingJoins.begin(), _pendingJoins.end());
+    _pendingJoins.clear();
+
+    _lastChainStep = AddStep(std::move(name), std::move(load), std::move(dependencies));
+    return _lastChainStep;
+}
+
+WorldLoader::StepId WorldLoader::After(std::vector<StepId> dependencies, std::string name, std::function<void()> load)
+{
+    return AddStep(std::move(name), std::move(load), std::move(dependencies));
+}
+
+void WorldLoader::Join(std::vector<StepId> steps)
+{
+    _pendingJoins.insert(_pendingJoins.end(), steps.begin(), steps.end());
+}
+
+void WorldLoader::Run(uint32 threads)
+{
+    _threads = std::max<uint32>(threads, 1);
+    uint32 const startTime = getMSTime();
+
+    auto runStep = [this, startTime](Step& step)
+    {
+        step.StartMs = GetMSTimeDiffToNow(startTime);
+        if (step.Announced)
+            LOG_INFO("server.loading", "{}...", step.Name);
+
+        step.Load();
+        step.DurationMs = GetMSTimeDiffToNow(startTime) - step.StartMs;
+    };
+
+    if (_threads == 1)
+    {
+        for (Step& step : _steps)
+            runStep(step);
+
+        _elapsedMs = GetMSTimeDiffToNow(startTime);
+        return;
+    }
+
+    // Steps become ready once all their dependencies are done; ready steps are taken lowest id first so the
+    // main chain, which everything eventually joins, is preferred over branches added after its current step
+    std::vector<uint32> missingDependencies(_steps.size());
+    std::vector<StepId> ready;
+    for (StepId id = 0; id < _steps.size(); ++id)
+    {
+        missingDependencies[id] = uint32(_steps[id].Dependencies.size());
+        if (!missingDependencies[id])
+            ready.push_back(id);
+    }
+
+    std::mutex lock;
+    std::condition_variable readyCondition;
+    std::size_t remaining = _steps.size();
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;)
+        {
+            readyCondition.wait(guard, [&]() { return !ready.empty() || !remaining; });
+            if (!remaining)
+                return;
+
+            auto next = std::min_element(ready.begin(), ready.end());
+            StepId id = *next;
+            ready.erase(next);
+
+            guard.unlock();
+            runStep(_steps[id]);
+            guard.lock();
+
+            --remaining;
+            for (StepId dependent : _steps[id].Dependents)
+                if (!--missingDependencies[dependent])
+                    ready.push_back(dependent);
+
+            readyCondition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(_threads - 1);
+    for (uint32 i = 1; i < _threads; ++i)
+        workers.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : workers)
+        thread.join();
+
+    _elapsedMs = GetMSTimeDiffToNow(startTime);
+}
+
+std::vector<WorldLoader::StepId> WorldLoader::GetCriticalPath() const
+{
+    if (_steps.empty())
+        return {};
+
+    // Insertion order is a topological order, so one forward pass finds the longest path ending at each step
+    std::vector<uint64> pathMs(_steps.size());
+    std::vector<StepId> previous(_steps.size(), NO_STEP);
+    StepId last = 0;
+    for (StepId id = 0; id < _steps.size(); ++id)
+    {
+        for (StepId dependency : _steps[id].Dependencies)
+        {
+            if (previous[id] == NO_STEP || pathMs[dependency] > pathMs[previous[id]])
+                previous[id] = dependency;
+        }
+
+        pathMs[id] = _steps[id].DurationMs + (previous[id] != NO_STEP ? pathMs[previous[id]] : 0);
+        if (pathMs[id] >= pathMs[last])
+            last = id;
+    }
+
+    std::vector<StepId> path;
+    for (StepId id = last; id != NO_STEP; id = previous[id])
+        path.push_back(id);
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void WorldLoader::LogReport() const
+{
+    uint64 totalMs = 0;
+    for (Step const& step : _steps)
+        totalMs += step.DurationMs;
+
+    std::vector<StepId> criticalPath = GetCriticalPath();
+    uint64 criticalMs = 0;
+    for (StepId id : criticalPath)
+        criticalMs += _steps[id].DurationMs;
+
+    LOG_INFO("server.loading", " ");
+    LOG_INFO("server.loading", ">> Loaded {} startup steps in {} ms on {} thread(s), {} ms of work, critical path {} ms",
+        _steps.size(), _elapsedMs, _threads, totalMs, criticalMs);
+
+    std::vector<StepId> slowest(_steps.size());
+    for (StepId id = 0; id < _steps.size(); ++id)
+        slowest[id] = id;
+
+    std::size_t slowestCount = std::min(REPORT_SLOWEST_STEPS, slowest.size());
+    std::partial_sort(slowest.begin(), slowest.begin() + slowestCount, slowest.end(), [this](StepId left, StepId right)
+    {
+        return _steps[left].DurationMs > _steps[right].DurationMs;
+    });
+
+    LOG_INFO("server.loading", "Slowest steps:");
+    for (std::size_t i = 0; i < slowestCount; ++i)
+    {
+        Step const& step = _steps[slowest[i]];
+        LOG_INFO("server.loading", "    {:>7} ms  {} (started at {} ms)", step.DurationMs, step.Name, step.StartMs);
+    }
+
+    LOG_INFO("server.loading", "Critical path:");
+    uint32 shortSteps = 0;
+    uint64 shortStepsMs = 0;
+    for (StepId id : criticalPath)
+    {
+        Step const& step = _steps[id];
+        if (step.DurationMs < REPORT_MIN_STEP_MS)
+        {
+            ++shortSteps;
+            shortStepsMs += step.DurationMs;
+            continue;
+        }
+
+        LOG_INFO("server.loading", "    {:>7} ms  {}", step.DurationMs, step.Name);
+    }
+
+    if (shortSteps)
+        LOG_INFO("server.loading", "    {:>7} ms  {} steps under {} ms", shortStepsMs, shortSteps, REPORT_MIN_STEP_MS);
+
+    LOG_INFO("server.loading", " ");
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WORLD_LOADER_H
+#define WORLD_LOADER_H
+
+#include "Define.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs the load steps of the server startup as a dependency graph.
+ *
+ * Steps added with Then() form the main chain and run one after another in the order they were added,
+ * like the plain sequence of Load* calls they replace. Steps added with After() branch off the main chain
+ * and only wait for the steps they name, so they can run concurrently with it on other threads.
+ * A step may only depend on steps added before it, which keeps the insertion order a valid sequential
+ * order: with a single thread Run() executes the steps exactly in that order.
+ */
+class AC_GAME_API WorldLoader
+{
+public:
+    typedef uint32 StepId;
+
+    struct Step
+    {
+        std::string Name;
+        std::function<void()> Load;
+        std::vector<StepId> Dependencies;
+        std::vector<StepId> Dependents;
+        bool Announced = true;  // logs "<Name>..." when the step starts
+        uint32 StartMs = 0;     // relative to the start of Run()
+        uint32 DurationMs = 0;
+    };
+
+    /// Adds a step of the main chain, running after the previous one and the given extra dependencies
+    StepId Then(std::string name, std::function<void()> load, std::vector<StepId> extraDependencies = {});
+
+    /// Adds a step running as soon as the given steps are done
+    StepId After(std::vector<StepId> dependencies, std::string name, std::function<void()> load);
+
+    /// Makes the next main chain step wait for the given steps
+    void Join(std::vector<StepId> steps);
+
+    /// For steps whose loader already logs its start
+    void SetAnnounced(StepId id, bool announced) { _steps[id].Announced = announced; }
+
+    /// Executes all steps on the calling thread and threads - 1 additional ones
+    void Run(uint32 threads);
+
+    /// Longest chain of dependent steps by duration, the lower bound of the startup time for any thread count
+    [[nodiscard]] std::vector<StepId> GetCriticalPath() const;
+
+    [[nodiscard]] Step const& GetStep(StepId id) const { return _steps[id]; }
+    [[nodiscard]] std::size_t GetStepCount() const { return _steps.size(); }
+    [[nodiscard]] uint32 GetElapsedMs() const { return _elapsedMs; }
+
+    /// Logs the wall time, the slowest steps and the critical path to server.loading
+    void LogReport() const;
+
+private:
+    StepId AddStep(std::string name, std::function<void()> load, std::vector<StepId> dependencies);
+
+    std::vector<Step> _steps;
+    std::vector<StepId> _pendingJoins;
+    StepId _lastChainStep = NO_STEP;
+    uint32 _threads = 1;
+    uint32 _elapsedMs = 0;
+
+    static constexpr StepId NO_STEP = StepId(-1);
+};
+
+#endif // WORLD_LOADER_H
@@ -1392,7 +1392,7 @@ public:
 
         // save if the player has last been saved over 20 seconds ago
         uint32 saveInterval = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
-        if (saveInterval == 0 || (saveInterval > 20 * IN_MILLISECONDS && player->GetSaveTimer() <= saveInterval - 20 * IN_MILLISECONDS))
+        if (saveInterval == 0 || (saveInterval > 20 * IN_MILLISECONDS && GameTime::GetGameTimeMS() - player->GetLastSaveTime() >= 20s))
         {
             player->SaveToDB(false, false);
         }
@@ -26,6 +26,7 @@
 #include "Player.h"
 #include "TargetedMovementGenerator.h"                      // for HandleNpcUnFollowCommand
 #include "Transport.h"
+#include "WorldDatabaseCache.h"
 #include <string>
 
 using namespace Acore::ChatCommands;
@@ -309,6 +310,7 @@ public:
         stmt->SetData(0, uint8(WAYPOINT_MOTION_TYPE));
         stmt->SetData(1, uint32(lowGuid));
         WorldDatabase.Execute(stmt);
+        sWorldDatabaseCache->Invalidate();
 
         handler->SendSysMessage(LANG_WAYPOINT_ADDED);
 
@@ -456,6 +458,7 @@ public:
         stmt->SetData(1, creature->GetEntry());
 
         WorldDatabase.Execute(stmt);
+        sWorldDatabaseCache->Invalidate();
 
         return true;
     }
@@ -519,6 +522,7 @@ public:
         stmt->SetData(1, creature->GetEntry());
 
         WorldDatabase.Execute(stmt);
+        sWorldDatabaseCache->Invalidate();
 
         handler->SendSysMessage(LANG_VALUE_SAVED_REJOIN);
 
@@ -778,6 +782,7 @@ public:
         stmt->SetData(4, lowGuid);
 
         WorldDatabase.Execute(stmt);
+        sWorldDatabaseCache->Invalidate();
 
         handler->PSendSysMessage(LANG_COMMAND_CREATUREMOVED);
         return true;
@@ -996,6 +1001,7 @@ public:
         stmt->SetData(2, guidLow);
 
         WorldDatabase.Execute(stmt);
+        sWorldDatabaseCache->Invalidate();
 
         handler->PSendSysMessage(LANG_COMMAND_WANDER_DISTANCE, option);
         return true;
@@ -1035,6 +1041,7 @@ public:
         stmt->SetData(0, spawnTime);
         stmt->SetData(1, creature->GetSpawnId());
         WorldDatabase.Execute(stmt);
+        sWorldDatabaseCache->Invalidate();
 
         creature->SetRespawnDelay(spawnTime);
         handler->PSendSysMessage(LANG_COMMAND_SPAWNTIME, secsToTimeString(spawnTime, true));
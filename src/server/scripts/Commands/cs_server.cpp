@@ -18,6 +18,8 @@
 #include "Chat.h"
 #include "CommandScript.h"
 #include "Common.h"
+#include "DatabaseEnv.h"
+#include "DatabaseStatistics.h"
 #include "GameTime.h"
 #include "GitRevision.h"
 #include "Log.h"
@@ -46,6 +48,12 @@ public:
 
     ChatCommandTable GetCommands() const override
     {
+        static ChatCommandTable serverDatabaseCommandTable =
+        {
+            { "reset",        HandleServerDatabaseResetCommand,  SEC_ADMINISTRATOR, Console::Yes },
+            { "",             HandleServerDatabaseCommand,       SEC_ADMINISTRATOR, Console::Yes }
+        };
+
         static ChatCommandTable serverIdleRestartCommandTable =
         {
             { "cancel",       HandleServerShutDownCancelCommand, SEC_ADMINISTRATOR, Console::Yes },
@@ -80,6 +88,7 @@ public:
         static ChatCommandTable serverCommandTable =
         {
             { "corpses",      HandleServerCorpsesCommand,        SEC_GAMEMASTER,    Console::Yes },
+            { "database",     serverDatabaseCommandTable },
             { "debug",        HandleServerDebugCommand,          SEC_ADMINISTRATOR, Console::Yes },
             { "exit",         HandleServerExitCommand,           SEC_CONSOLE,       Console::Yes },
             { "idlerestart",  serverIdleRestartCommandTable },
@@ -254,6 +263,48 @@ public:
         return true;
     }
 
+    static void ShowDatabaseStatistics(ChatHandler* handler, DatabaseStatistics const& statistics, uint32 count)
+    {
+        handler->PSendSysMessage("Database {}: queue size {}, peak {}", statistics.GetDatabase(), statistics.GetQueueSize(), statistics.GetPeakQueueSize());
+
+        // the statements the database spent the most time on
+        std::vector<DatabaseSlotStatistics> slots = statistics.GetSlots();
+        count = std::min<uint32>(count, slots.size());
+        std::partial_sort(slots.begin(), slots.begin() + count, slots.end(), [](DatabaseSlotStatistics const& left, DatabaseSlotStatistics const& right)
+        {
+            return left.ExecutionTotal > right.ExecutionTotal;
+        });
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            DatabaseSlotStatistics const& slot = slots[i];
+            handler->PSendSysMessage("|- {}: {} executions, avg {}us, max {}us, {} slow. {} queued, avg wait {}us, max {}us",
+                DatabaseStatistics::GetSlotName(slot.Slot), slot.Executions, slot.ExecutionTotal.count() / std::max<uint64>(slot.Executions, 1),
+                slot.ExecutionMax.count(), slot.SlowExecutions, slot.Waits, slot.WaitTotal.count() / std::max<uint64>(slot.Waits, 1), slot.WaitMax.count());
+
+            if (!slot.Query.empty())
+                handler->PSendSysMessage("|  {}", slot.Query.substr(0, 120));
+        }
+    }
+
+    static bool HandleServerDatabaseCommand(ChatHandler* handler, Optional<uint32> count)
+    {
+        ShowDatabaseStatistics(handler, LoginDatabase.GetStatistics(), count.value_or(5));
+        ShowDatabaseStatistics(handler, CharacterDatabase.GetStatistics(), count.value_or(5));
+        ShowDatabaseStatistics(handler, WorldDatabase.GetStatistics(), count.value_or(5));
+        return true;
+    }
+
+    static bool HandleServerDatabaseResetCommand(ChatHandler* handler)
+    {
+        LoginDatabase.GetStatistics().Reset();
+        CharacterDatabase.GetStatistics().Reset();
+        WorldDatabase.GetStatistics().Reset();
+
+        handler->SendSysMessage("Database statistics reset.");
+        return true;
+    }
+
     static bool HandleServerInfoCommand(ChatHandler* handler)
     {
         std::string realmName = sWorld->GetRealmName();
@@ -19,6 +19,7 @@
 #include "CommandScript.h"
 #include "Player.h"
 #include "WaypointMgr.h"
+#include "WorldDatabaseCache.h"
 
 #if AC_COMPILER == AC_COMPILER_GNU
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
@@ -203,6 +204,7 @@ public:
         stmt->SetData(1, guidLow);
 
         WorldDatabase.Execute(stmt);
+        sWorldDatabaseCache->Invalidate();
 
         target->LoadPath(pathid);
         target->SetDefaultMovementType(WAYPOINT_MOTION_TYPE);
@@ -255,6 +257,7 @@ public:
                 stmt->SetData(1, guildLow);
 
                 WorldDatabase.Execute(stmt);
+                sWorldDatabaseCache->Invalidate();
 
                 target->LoadPath(0);
                 target->SetDefaultMovementType(IDLE_MOTION_TYPE);
@@ -866,6 +869,7 @@ public:
                         stmt->SetData(0, wpguid);
 
                         WorldDatabase.Execute(stmt);
+                        sWorldDatabaseCache->Invalidate();
                     }
                     else
                     {
@@ -1062,6 +1066,7 @@ public:
                     stmt->SetData(0, guid);
 
                     WorldDatabase.Execute(stmt);
+                    sWorldDatabaseCache->Invalidate();
                 }
                 else
                 {
@@ -41,12 +41,12 @@ bool DBCStorageBase::Load(char const* path, char**& indexTable)
 
     _fieldCount = dbc.GetCols();
 
-    // load raw non-string data
+    // load raw non-string data, nullptr when the records are used in place
     _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
 
-    // load strings from dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    // point strings into the dbc string block
+    dbc.AutoProduceStrings(_fileFormat, _dataTable);
+    _mappedFiles.push_back(dbc.GetMapping());
 
     // error in dbc file at loading if nullptr
     return indexTable != nullptr;
@@ -65,8 +65,8 @@ bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable)
         return false;
 
     // load strings from another locale dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    if (dbc.AutoProduceStrings(_fileFormat, _dataTable))
+        _mappedFiles.push_back(dbc.GetMapping());
 
     return true;
 }
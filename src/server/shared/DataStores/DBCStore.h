@@ -22,6 +22,7 @@
 #include "DBCStorageIterator.h"
 #include "Errors.h"
 #include <cstring>
+#include <memory>
 #include <vector>
 
 /// Interface class for common access
@@ -47,6 +48,7 @@ protected:
     char const* _fileFormat;
     char* _dataTable;
     std::vector<char*> _stringPool;
+    std::vector<std::shared_ptr<void>> _mappedFiles;   // records and strings used in place
     uint32 _indexTableSize;
 };
 
@@ -20,21 +20,87 @@
 
 #include "Log.h"
 #include "MessageBuffer.h"
+#include <array>
 #include <atomic>
 #include <boost/asio.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/container/static_vector.hpp>
+#include <cstring>
+#include <deque>
 #include <functional>
 #include <memory>
-#include <queue>
 #include <type_traits>
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+#define WRITE_GATHER_COUNT 16 // max buffers handed to a single write call
 #ifdef BOOST_ASIO_HAS_IOCP
 #define AC_SOCKET_USE_IOCP
 #endif
 
+typedef boost::container::static_vector<boost::asio::const_buffer, WRITE_GATHER_COUNT> SocketWriteBufferSequence;
+
+/*
+ * Element of the socket write queue. Either bytes owned by the socket, or a small per-socket prefix
+ * (like an encrypted packet header) followed by a refcounted body that can be shared by many sockets,
+ * so that broadcasting a large payload does not copy it once per receiver.
+ */
+class SocketWriteBuffer
+{
+public:
+    static constexpr std::size_t MAX_PREFIX_SIZE = 8;
+
+    SocketWriteBuffer(MessageBuffer&& buffer) : _buffer(std::move(buffer)), _prefixSize(0), _bodySize(0), _sent(0) { }
+
+    SocketWriteBuffer(uint8 const* prefix, std::size_t prefixSize, std::shared_ptr<uint8 const> body, std::size_t bodySize)
+        : _buffer(0), _prefixSize(std::min(prefixSize, MAX_PREFIX_SIZE)), _body(std::move(body)), _bodySize(bodySize), _sent(0)
+    {
+        std::memcpy(_prefix.data(), prefix, _prefixSize);
+    }
+
+    [[nodiscard]] std::size_t GetActiveSize() const
+    {
+        return _body ? _prefixSize + _bodySize - _sent : _buffer.GetActiveSize();
+    }
+
+    // Appends the unsent data as at most two buffers, returns its size
+    std::size_t AppendBuffers(SocketWriteBufferSequence& buffers)
+    {
+        if (!_body)
+        {
+            buffers.push_back(boost::asio::buffer(_buffer.GetReadPointer(), _buffer.GetActiveSize()));
+            return _buffer.GetActiveSize();
+        }
+
+        if (_sent < _prefixSize)
+            buffers.push_back(boost::asio::buffer(_prefix.data() + _sent, _prefixSize - _sent));
+
+        std::size_t bodySent = _sent > _prefixSize ? _sent - _prefixSize : 0;
+        if (bodySent < _bodySize)
+            buffers.push_back(boost::asio::buffer(_body.get() + bodySent, _bodySize - bodySent));
+
+        return GetActiveSize();
+    }
+
+    void ReadCompleted(std::size_t bytes)
+    {
+        if (_body)
+            _sent += bytes;
+        else
+            _buffer.ReadCompleted(bytes);
+    }
+
+private:
+    MessageBuffer _buffer;
+
+    std::array<uint8, MAX_PREFIX_SIZE> _prefix;
+    std::size_t _prefixSize;
+    std::shared_ptr<uint8 const> _body;
+    std::size_t _bodySize;
+    std::size_t _sent;
+};
+
 enum ProxyHeaderReadingState {
     PROXY_HEADER_READING_STATE_NOT_STARTED,
     PROXY_HEADER_READING_STATE_STARTED,
@@ -139,9 +205,9 @@ public:
             std::bind(callback, this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
     }
 
-    void QueuePacket(MessageBuffer&& buffer)
+    void QueuePacket(SocketWriteBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef AC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -184,8 +250,9 @@ protected:
         _isWritingAsync = true;
 
 #ifdef AC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        SocketWriteBufferSequence buffers;
+        GatherWriteBuffers(buffers);
+        _socket.async_write_some(buffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -205,6 +272,39 @@ protected:
     }
 
 private:
+    // Collects the front of the write queue into one scatter/gather write
+    std::size_t GatherWriteBuffers(SocketWriteBufferSequence& buffers)
+    {
+        std::size_t size = 0;
+        for (SocketWriteBuffer& queued : _writeQueue)
+        {
+            if (buffers.size() + 2 > buffers.capacity())
+                break;
+
+            size += queued.AppendBuffers(buffers);
+        }
+
+        return size;
+    }
+
+    // Drops fully written buffers from the write queue and advances the partially written one
+    void WriteCompleted(std::size_t bytes)
+    {
+        while (!_writeQueue.empty())
+        {
+            SocketWriteBuffer& queued = _writeQueue.front();
+            std::size_t size = queued.GetActiveSize();
+            if (size > bytes)
+            {
+                queued.ReadCompleted(bytes);
+                return;
+            }
+
+            bytes -= size;
+            _writeQueue.pop_front();
+        }
+    }
+
     void ReadHandlerInternal(boost::system::error_code error, std::size_t transferredBytes)
     {
         if (error)
@@ -335,10 +435,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            WriteCompleted(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -362,12 +459,11 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        SocketWriteBufferSequence buffers;
+        std::size_t bytesToSend = GatherWriteBuffers(buffers);
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(buffers, error);
 
         if (error)
         {
@@ -376,7 +472,7 @@ private:
                 return AsyncProcessQueue();
             }
 
-            _writeQueue.pop();
+            _writeQueue.pop_front();
 
             if (_closing && _writeQueue.empty())
             {
@@ -387,7 +483,7 @@ private:
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            _writeQueue.pop_front();
 
             if (_closing && _writeQueue.empty())
             {
@@ -396,14 +492,14 @@ private:
 
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
+
+        WriteCompleted(bytesSent);
+
+        if (bytesSent < bytesToSend) // now n > 0
         {
-            queuedMessage.ReadCompleted(bytesSent);
             return AsyncProcessQueue();
         }
 
-        _writeQueue.pop();
-
         if (_closing && _writeQueue.empty())
         {
             CloseSocket();
@@ -419,7 +515,7 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<SocketWriteBuffer> _writeQueue;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
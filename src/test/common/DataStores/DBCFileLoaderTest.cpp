@@ -0,0 +1,142 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DBCFileLoader.h"
+#include "gtest/gtest.h"
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct NumericEntry
+    {
+        uint32 ID;
+        uint32 Value;
+        float Multiplier;
+    };
+
+    // Packed like the structures in DBCStructure.h
+#pragma pack(push, 1)
+    struct StringEntry
+    {
+        uint32 ID;
+        char const* Name;
+        uint32 Value;
+    };
+#pragma pack(pop)
+
+    // Writes a WDBC file of 3 column records, strings are given as offsets into stringBlock
+    std::string WriteDbc(std::string_view name, std::vector<std::array<uint32, 3>> const& records, std::string const& stringBlock)
+    {
+        std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        uint32 header[5] = { 0x43424457, uint32(records.size()), 3, 3 * sizeof(uint32), uint32(stringBlock.size()) };
+        file.write(reinterpret_cast<char const*>(header), sizeof(header));
+        for (std::array<uint32, 3> const& record : records)
+            file.write(reinterpret_cast<char const*>(record.data()), sizeof(uint32) * record.size());
+
+        file.write(stringBlock.data(), stringBlock.size());
+        return path;
+    }
+
+    uint32 FloatBits(float value)
+    {
+        uint32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+TEST(DBCFileLoaderTest, NumericRecordsAreUsedInPlace)
+{
+    std::string path = WriteDbc("acore_dbc_numeric_test.dbc", { { 5, 50, FloatBits(1.5f) }, { 2, 20, FloatBits(0.5f) } }, std::string(1, '\0'));
+    char const* format = "nif";
+
+    uint32 count = 0;
+    char** indexTable = nullptr;
+    {
+        DBCFileLoader dbc;
+        ASSERT_TRUE(dbc.Load(path.c_str(), format));
+        EXPECT_TRUE(dbc.CanUseRecordsInPlace(format));
+        EXPECT_EQ(dbc.AutoProduceData(format, count, indexTable), nullptr);
+        ASSERT_NE(indexTable, nullptr);
+        ASSERT_EQ(count, 6u);
+
+        std::shared_ptr<void> mapping = dbc.GetMapping();
+        NumericEntry* entry = reinterpret_cast<NumericEntry*>(indexTable[5]);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->ID, 5u);
+        EXPECT_EQ(entry->Value, 50u);
+        EXPECT_FLOAT_EQ(entry->Multiplier, 1.5f);
+        EXPECT_EQ(indexTable[3], nullptr);
+
+        // Corrections write to the private copy, never to the file
+        entry->Value = 51;
+        EXPECT_EQ(reinterpret_cast<NumericEntry*>(indexTable[5])->Value, 51u);
+    }
+
+    DBCFileLoader reloaded;
+    ASSERT_TRUE(reloaded.Load(path.c_str(), format));
+    EXPECT_EQ(reloaded.getRecord(0).getUInt(1), 50u);
+
+    delete[] indexTable;
+    std::filesystem::remove(path);
+}
+
+TEST(DBCFileLoaderTest, StringsPointIntoTheFile)
+{
+    std::string strings("\0Wolf\0Bear\0", 11);
+    std::string path = WriteDbc("acore_dbc_string_test.dbc", { { 1, 1, 7 }, { 2, 6, 8 }, { 3, 0, 9 } }, strings);
+    char const* format = "nsi";
+
+    DBCFileLoader dbc;
+    ASSERT_TRUE(dbc.Load(path.c_str(), format));
+    EXPECT_FALSE(dbc.CanUseRecordsInPlace(format));
+
+    uint32 count = 0;
+    char** indexTable = nullptr;
+    char* dataTable = dbc.AutoProduceData(format, count, indexTable);
+    ASSERT_NE(dataTable, nullptr);
+    ASSERT_TRUE(dbc.AutoProduceStrings(format, dataTable));
+
+    StringEntry const* bear = reinterpret_cast<StringEntry const*>(indexTable[2]);
+    EXPECT_STREQ(bear->Name, "Bear");
+    EXPECT_EQ(bear->Value, 8u);
+    EXPECT_STREQ(reinterpret_cast<StringEntry const*>(indexTable[1])->Name, "Wolf");
+    EXPECT_STREQ(reinterpret_cast<StringEntry const*>(indexTable[3])->Name, "");
+
+    delete[] dataTable;
+    delete[] indexTable;
+    std::filesystem::remove(path);
+}
+
+TEST(DBCFileLoaderTest, RejectsTruncatedFiles)
+{
+    std::string path = WriteDbc("acore_dbc_truncated_test.dbc", { { 1, 2, 3 } }, std::string(1, '\0'));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 2);
+
+    DBCFileLoader dbc;
+    EXPECT_FALSE(dbc.Load(path.c_str(), "nii"));
+    EXPECT_FALSE(dbc.Load("acore_dbc_missing_test.dbc", "nii"));
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LogRecordQueue.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+TEST(LogRecordQueueTest, KeepsPushOrder)
+{
+    LogRecordQueue queue(4);
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_TRUE(queue.Push(LOG_LEVEL_INFO, 1s, "server", "first", ""));
+    EXPECT_TRUE(queue.Push(LOG_LEVEL_ERROR, 2s, "server.loading", "second", "42"));
+
+    std::vector<std::string> texts;
+    EXPECT_EQ(queue.Drain([&](LogRecord& record) { texts.push_back(record.Text); }), 2u);
+    EXPECT_EQ(texts, (std::vector<std::string>{ "first", "second" }));
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(LogRecordQueueTest, RefusesRecordsWhenFull)
+{
+    LogRecordQueue queue(2);
+    EXPECT_TRUE(queue.Push(LOG_LEVEL_INFO, 0s, "server", "1", ""));
+    EXPECT_TRUE(queue.Push(LOG_LEVEL_INFO, 0s, "server", "2", ""));
+    EXPECT_FALSE(queue.Push(LOG_LEVEL_INFO, 0s, "server", "3", ""));
+
+    queue.Drain([](LogRecord&) { });
+    EXPECT_TRUE(queue.Push(LOG_LEVEL_INFO, 0s, "server", "3", ""));
+}
+
+TEST(LogRecordQueueTest, RoundsCapacityUpToPowerOfTwo)
+{
+    LogRecordQueue queue(3);
+    EXPECT_EQ(queue.GetCapacity(), 4u);
+
+    // go around the ring a few times
+    for (uint32 i = 0; i < 10; ++i)
+    {
+        for (uint32 j = 0; j < 4; ++j)
+            EXPECT_TRUE(queue.Push(LOG_LEVEL_INFO, Seconds(i * 4 + j), "server", "", ""));
+
+        EXPECT_FALSE(queue.Push(LOG_LEVEL_INFO, 0s, "server", "", ""));
+
+        uint32 next = i * 4;
+        bool ordered = true;
+        EXPECT_EQ(queue.Drain([&](LogRecord& record) { ordered = ordered && record.Time == Seconds(next++); }), 4u);
+        EXPECT_TRUE(ordered);
+    }
+}
+
+TEST(LogRecordQueueTest, ConsumerSeesEveryRecordOfProducerThread)
+{
+    constexpr uint32 count = 20000;
+    LogRecordQueue queue(64);
+
+    std::thread producer([&queue]()
+    {
+        for (uint32 i = 0; i < count; ++i)
+            while (!queue.Push(LOG_LEVEL_DEBUG, Seconds(i), "server", std::to_string(i), ""))
+                std::this_thread::yield();
+    });
+
+    uint32 next = 0;
+    bool ordered = true;
+    while (next < count)
+    {
+        queue.Drain([&](LogRecord& record)
+        {
+            ordered = ordered && record.Time == Seconds(next) && record.Text == std::to_string(next);
+            ++next;
+        });
+    }
+
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.IsEmpty());
+}
@@ -0,0 +1,122 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventMap.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+    std::vector<uint32> ExecuteAll(EventMap& events)
+    {
+        std::vector<uint32> executed;
+        while (uint32 eventId = events.ExecuteEvent())
+            executed.push_back(eventId);
+
+        return executed;
+    }
+}
+
+TEST(EventMapTest, ExecutesByTimeThenScheduleOrder)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 2s);
+    events.ScheduleEvent(2, 1s);
+    events.ScheduleEvent(3, 2s);
+    events.ScheduleEvent(4, 1s);
+
+    events.Update(999);
+    EXPECT_EQ(events.ExecuteEvent(), 0u);
+
+    events.Update(1001);
+    EXPECT_EQ(ExecuteAll(events), (std::vector<uint32>{ 2, 4, 1, 3 }));
+    EXPECT_TRUE(events.Empty());
+}
+
+TEST(EventMapTest, DropsEventsOfOtherPhases)
+{
+    EventMap events;
+    events.SetPhase(2);
+    events.ScheduleEvent(1, 1s, 0, 1);
+    events.ScheduleEvent(2, 1s, 0, 2);
+    events.ScheduleEvent(3, 1s);
+
+    events.Update(1000);
+    EXPECT_EQ(ExecuteAll(events), (std::vector<uint32>{ 2, 3 }));
+    EXPECT_TRUE(events.Empty());
+}
+
+TEST(EventMapTest, RepeatKeepsGroupAndPhase)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 1s, 3);
+    events.Update(1000);
+    EXPECT_EQ(events.ExecuteEvent(), 1u);
+
+    events.Repeat(500ms);
+    events.CancelEventGroup(3);
+    EXPECT_TRUE(events.Empty());
+}
+
+TEST(EventMapTest, DelayEventsOfGroupGoAfterEventsOfTheirNewTime)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 1s, 1);
+    events.ScheduleEvent(2, 3s);
+    events.ScheduleEvent(3, 2s, 1);
+
+    events.DelayEvents(2000, 1);
+    EXPECT_EQ(events.GetNextEventTime(1), 3000u);
+    EXPECT_EQ(events.GetNextEventTime(3), 4000u);
+
+    events.Update(4000);
+    EXPECT_EQ(ExecuteAll(events), (std::vector<uint32>{ 2, 1, 3 }));
+}
+
+TEST(EventMapTest, DelayEventsToMax)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 1s, 1);
+    events.ScheduleEvent(2, 5s, 1);
+    events.ScheduleEvent(3, 2s, 2);
+    events.ScheduleEvent(4, 3s);
+    events.ScheduleEvent(5, 500ms, 1);
+
+    // Events of group 1 planned before 3s move to 3s, after the event already planned then
+    events.DelayEventsToMax(3000, 1);
+    EXPECT_EQ(events.GetNextEventTime(5), 3000u);
+    EXPECT_EQ(events.GetNextEventTime(1), 3000u);
+    EXPECT_EQ(events.GetNextEventTime(2), 5000u);
+
+    events.Update(5000);
+    EXPECT_EQ(ExecuteAll(events), (std::vector<uint32>{ 3, 4, 5, 1, 2 }));
+}
+
+TEST(EventMapTest, CancelEventAndTimeUntilEvent)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 1s);
+    events.ScheduleEvent(2, 2s);
+    events.ScheduleEvent(1, 3s);
+
+    events.Update(500);
+    EXPECT_EQ(events.GetTimeUntilEvent(2), 1500ms);
+
+    events.CancelEvent(1);
+    EXPECT_EQ(events.GetTimeUntilEvent(1), Milliseconds::max());
+    EXPECT_EQ(events.GetNextEventTime(), 2000u);
+}
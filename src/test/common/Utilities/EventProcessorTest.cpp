@@ -0,0 +1,267 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventProcessor.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct ExecutedEvent
+    {
+        uint32 Id;
+        uint64 Time;
+
+        bool operator==(ExecutedEvent const& right) const { return Id == right.Id && Time == right.Time; }
+    };
+
+    /// Logs its execution and adds itself again every period until it ran repeats times
+    class RecordingEvent : public BasicEvent
+    {
+    public:
+        RecordingEvent(EventProcessor& events, std::vector<ExecutedEvent>& log, uint32 id, uint32 period, uint32 repeats)
+            : _events(events), _log(log), _id(id), _period(period), _repeats(repeats) { }
+
+        bool Execute(uint64 e_time, uint32 /*p_time*/) override
+        {
+            _log.push_back({ _id, e_time });
+            if (!_repeats)
+                return true;
+
+            --_repeats;
+            _events.AddEvent(this, _events.CalculateTime(_period));
+            return false;
+        }
+
+    private:
+        EventProcessor& _events;
+        std::vector<ExecutedEvent>& _log;
+        uint32 _id;
+        uint32 _period;
+        uint32 _repeats;
+    };
+
+    /// The multimap based queue the timing wheel replaced, events of the same time run in insertion order
+    class ReferenceEventQueue
+    {
+    public:
+        struct Event
+        {
+            uint32 Id;
+            uint32 Period;
+            uint32 Repeats;
+        };
+
+        void AddEvent(Event event, uint64 time) { _events.emplace(time, event); }
+        uint64 CalculateTime(uint64 offset) const { return _time + offset; }
+
+        void Update(uint32 diff, std::vector<ExecutedEvent>& log)
+        {
+            _time += diff;
+            while (!_events.empty() && _events.begin()->first <= _time)
+            {
+                Event event = _events.begin()->second;
+                _events.erase(_events.begin());
+
+                log.push_back({ event.Id, _time });
+                if (event.Repeats)
+                {
+                    --event.Repeats;
+                    AddEvent(event, CalculateTime(event.Period));
+                }
+            }
+        }
+
+    private:
+        uint64 _time = 0;
+        std::multimap<uint64, Event> _events;
+    };
+}
+
+TEST(EventProcessorTest, ExecutesByTimeThenInsertionOrder)
+{
+    EventProcessor events;
+    std::vector<ExecutedEvent> log;
+
+    events.AddEventAtOffset(new RecordingEvent(events, log, 1, 0, 0), 300ms);
+    events.AddEventAtOffset(new RecordingEvent(events, log, 2, 0, 0), 100ms);
+    events.AddEventAtOffset(new RecordingEvent(events, log, 3, 0, 0), 300ms);
+    events.AddEventAtOffset(new RecordingEvent(events, log, 4, 0, 0), 100ms);
+    events.AddEventAtOffset(new RecordingEvent(events, log, 5, 0, 0), 5000ms);
+
+    events.Update(99);
+    EXPECT_TRUE(log.empty());
+
+    events.Update(1000);
+    EXPECT_EQ(log, (std::vector<ExecutedEvent>{ { 2, 1099 }, { 4, 1099 }, { 1, 1099 }, { 3, 1099 } }));
+    EXPECT_TRUE(events.HasEvents());
+
+    events.Update(4000);
+    EXPECT_EQ(log.back(), (ExecutedEvent{ 5, 5099 }));
+    EXPECT_FALSE(events.HasEvents());
+}
+
+TEST(EventProcessorTest, EventsAddedWhileUpdatingRunInTheSameUpdate)
+{
+    EventProcessor events;
+    std::vector<ExecutedEvent> log;
+
+    // Re-added for the same time, it has to run again before the update returns
+    events.AddEventAtOffset(new RecordingEvent(events, log, 1, 0, 2), 10ms);
+    events.Update(10);
+
+    EXPECT_EQ(log, (std::vector<ExecutedEvent>{ { 1, 10 }, { 1, 10 }, { 1, 10 } }));
+    EXPECT_FALSE(events.HasEvents());
+}
+
+TEST(EventProcessorTest, ModifyEventTimeMovesTheEvent)
+{
+    EventProcessor events;
+    std::vector<ExecutedEvent> log;
+
+    RecordingEvent* moved = new RecordingEvent(events, log, 1, 0, 0);
+    events.AddEventAtOffset(moved, 10s);
+    events.AddEventAtOffset(new RecordingEvent(events, log, 2, 0, 0), 200ms);
+
+    events.ModifyEventTime(moved, 100ms);
+    events.Update(150);
+    EXPECT_EQ(log, (std::vector<ExecutedEvent>{ { 1, 150 } }));
+
+    events.Update(50);
+    EXPECT_EQ(log.back(), (ExecutedEvent{ 2, 200 }));
+}
+
+TEST(EventProcessorTest, CancelEventGroupOnlyRemovesItsGroup)
+{
+    EventProcessor events;
+    std::vector<ExecutedEvent> log;
+
+    events.AddEvent(new RecordingEvent(events, log, 1, 0, 0), events.CalculateTime(100), true, 1);
+    events.AddEvent(new RecordingEvent(events, log, 2, 0, 0), events.CalculateTime(100), true, 2);
+    events.AddEvent(new RecordingEvent(events, log, 3, 0, 0), events.CalculateTime(1 << 25), true, 1);
+
+    events.CancelEventGroup(1);
+    events.Update(1 << 25);
+
+    EXPECT_EQ(log, (std::vector<ExecutedEvent>{ { 2, 1 << 25 } }));
+    EXPECT_FALSE(events.HasEvents());
+}
+
+TEST(EventProcessorTest, FarAwayEventsRunOnTime)
+{
+    EventProcessor events;
+    std::vector<ExecutedEvent> log;
+
+    // Beyond the last wheel level, while a periodic event keeps the wheel busy
+    uint64 farAway = (uint64(1) << 26) + 12345;
+    events.AddEvent(new RecordingEvent(events, log, 1, 0, 0), farAway);
+    events.AddEventAtOffset(new RecordingEvent(events, log, 2, 1000000, 100), 1000ms);
+
+    while (log.empty() || log.back().Id != 1)
+        events.Update(777);
+
+    EXPECT_GE(log.back().Time, farAway);
+    EXPECT_LT(log.back().Time, farAway + 777);
+}
+
+TEST(EventProcessorTest, KillAllEventsKeepsNonDeletableEvents)
+{
+    class PinnedEvent : public BasicEvent
+    {
+    public:
+        explicit PinnedEvent(bool& deleted) : _deleted(deleted) { }
+        ~PinnedEvent() override { _deleted = true; }
+        bool IsDeletable() const override { return _deletable; }
+
+        bool _deletable = false;
+
+    private:
+        bool& _deleted;
+    };
+
+    bool pinnedDeleted = false;
+    bool otherDeleted = false;
+
+    EventProcessor events;
+    PinnedEvent* pinned = new PinnedEvent(pinnedDeleted);
+    PinnedEvent* other = new PinnedEvent(otherDeleted);
+    other->_deletable = true;
+
+    events.AddEventAtOffset(pinned, 1s);
+    events.AddEventAtOffset(other, 1s);
+
+    events.KillAllEvents(false);
+    EXPECT_FALSE(pinnedDeleted);
+    EXPECT_TRUE(otherDeleted);
+    EXPECT_TRUE(events.HasEvents());
+
+    // Aborted but not deletable, it is checked again every update until it can go
+    events.Update(2000);
+    EXPECT_FALSE(pinnedDeleted);
+
+    pinned->_deletable = true;
+    events.Update(1);
+    EXPECT_TRUE(pinnedDeleted);
+    EXPECT_FALSE(events.HasEvents());
+}
+
+TEST(EventProcessorTest, CreaturesMatchReferenceQueue)
+{
+    // Thousands of creatures with boss-like event patterns: short periodic casts, longer phase
+    // timers, events planned for the current time and a few far away ones
+    constexpr uint32 creatureCount = 2000;
+    std::mt19937 random(1234);
+
+    std::vector<std::unique_ptr<EventProcessor>> creatures;
+    std::vector<ReferenceEventQueue> references(creatureCount);
+    std::vector<std::vector<ExecutedEvent>> logs(creatureCount);
+    std::vector<std::vector<ExecutedEvent>> referenceLogs(creatureCount);
+
+    for (uint32 i = 0; i < creatureCount; ++i)
+        creatures.push_back(std::make_unique<EventProcessor>());
+
+    auto addEvent = [&](uint32 creature, uint32 id)
+    {
+        static constexpr uint32 periods[] = { 0, 1500, 2000, 8000, 30000, 45000, 1u << 25 };
+        uint32 period = periods[random() % std::size(periods)];
+        uint32 offset = period ? random() % period : 0;
+        uint32 repeats = random() % 5;
+
+        EventProcessor& events = *creatures[creature];
+        events.AddEvent(new RecordingEvent(events, logs[creature], id, period, repeats), events.CalculateTime(offset));
+        references[creature].AddEvent({ id, period, repeats }, references[creature].CalculateTime(offset));
+    };
+
+    uint32 nextId = 0;
+    for (uint32 tick = 0; tick < 300; ++tick)
+    {
+        uint32 diff = 1 + random() % 400;
+        for (uint32 i = 0; i < creatureCount; ++i)
+        {
+            if (random() % 8 == 0)
+                addEvent(i, ++nextId);
+
+            creatures[i]->Update(diff);
+            references[i].Update(diff, referenceLogs[i]);
+        }
+    }
+
+    for (uint32 i = 0; i < creatureCount; ++i)
+        ASSERT_EQ(logs[i], referenceLogs[i]) << "creature " << i;
+}
@@ -0,0 +1,317 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FlatMultiMap.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <type_traits>
+
+namespace
+{
+    typedef FlatMultiMap<uint32, uint32> TestMap;
+
+    std::vector<uint32> GetValues(TestMap const& map, uint32 key)
+    {
+        std::vector<uint32> values;
+        for (TestMap::const_iterator itr = map.lower_bound(key); itr != map.upper_bound(key); ++itr)
+        {
+            EXPECT_EQ(itr->first, key);
+            values.push_back(itr->second);
+        }
+
+        return values;
+    }
+
+    std::vector<uint32> GetValues(TestMap const& map)
+    {
+        std::vector<uint32> values;
+        for (TestMap::value_type const& element : map)
+            values.push_back(element.second);
+
+        return values;
+    }
+
+    TEST(FlatMultiMapTest, KeysKeepInsertionOrder)
+    {
+        TestMap map;
+        map.insert(TestMap::value_type(5, 1));
+        map.insert(TestMap::value_type(3, 2));
+        map.insert(TestMap::value_type(5, 3));
+        map.insert(TestMap::value_type(8, 4));
+
+        EXPECT_EQ(map.size(), 4u);
+        EXPECT_EQ(map.count(5), 2u);
+        EXPECT_EQ(map.count(4), 0u);
+        EXPECT_EQ(map.find(4), map.end());
+        EXPECT_EQ(GetValues(map, 5), std::vector<uint32>({ 1, 3 }));
+        EXPECT_EQ(GetValues(map), std::vector<uint32>({ 1, 2, 3, 4 }));
+
+        auto range = map.equal_range(3);
+        ASSERT_NE(range.first, range.second);
+        EXPECT_EQ(range.first->second, 2u);
+        EXPECT_EQ(++range.first, range.second);
+    }
+
+    TEST(FlatMultiMapTest, IteratorsSurviveChanges)
+    {
+        TestMap map;
+        for (uint32 i = 0; i < 4; ++i)
+            map.insert(TestMap::value_type(i % 2, i));
+
+        TestMap::iterator itr = map.find(1);
+        TestMap::iterator first = map.begin();
+
+        // growing the slots and the index does not move the iterators
+        for (uint32 i = 4; i < 100; ++i)
+            map.insert(TestMap::value_type(i, i));
+
+        EXPECT_EQ(itr->second, 1u);
+        EXPECT_EQ(first->second, 0u);
+
+        // an erased element can still be stepped over
+        TestMap::iterator erased = first;
+        map.erase(first);
+        EXPECT_EQ((++erased)->second, 1u);
+        EXPECT_EQ((++itr)->second, 3u);
+        EXPECT_EQ(++itr, map.end());
+
+        EXPECT_EQ(map.size(), 99u);
+        EXPECT_EQ(GetValues(map, 0), std::vector<uint32>({ 2 }));
+
+        map.compact();
+        EXPECT_EQ(map.size(), 99u);
+        EXPECT_EQ(GetValues(map, 1), std::vector<uint32>({ 1, 3 }));
+        EXPECT_EQ(map.begin()->second, 1u);
+    }
+
+    TEST(FlatMultiMapTest, EraseWhileIterating)
+    {
+        TestMap map;
+        for (uint32 i = 0; i < 20; ++i)
+            map.insert(TestMap::value_type(i % 4, i));
+
+        // the way Unit removes auras of a spell, restarting after every removal
+        for (TestMap::iterator itr = map.lower_bound(2); itr != map.upper_bound(2);)
+        {
+            if (itr->second % 3)
+            {
+                map.erase(itr);
+                itr = map.lower_bound(2);
+            }
+            else
+                ++itr;
+        }
+
+        EXPECT_EQ(GetValues(map, 2), std::vector<uint32>({ 6, 18 }));
+
+        for (TestMap::iterator itr = map.begin(); itr != map.end();)
+            itr = map.erase(itr);
+
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.begin(), map.end());
+
+        map.insert(TestMap::value_type(2, 7));
+        EXPECT_EQ(GetValues(map, 2), std::vector<uint32>({ 7 }));
+    }
+
+    TEST(FlatMultiMapTest, EraseThenReinsert)
+    {
+        TestMap map;
+        map.insert(TestMap::value_type(1, 1));
+        map.insert(TestMap::value_type(1, 2));
+        map.insert(TestMap::value_type(2, 3));
+
+        // the last element of a key goes, the next one of the key is appended behind the first
+        TestMap::iterator last = map.find(1);
+        ++last;
+        map.erase(last);
+        map.insert(TestMap::value_type(1, 4));
+        EXPECT_EQ(GetValues(map, 1), std::vector<uint32>({ 1, 4 }));
+        EXPECT_EQ(GetValues(map), std::vector<uint32>({ 1, 3, 4 }));
+
+        // emptying the map keeps the erased slots, iterators left on them never reach the new elements
+        TestMap::iterator erased = map.find(1);
+        for (TestMap::iterator itr = map.begin(); itr != map.end();)
+            itr = map.erase(itr);
+
+        EXPECT_TRUE(map.empty());
+        map.insert(TestMap::value_type(2, 5));
+        map.insert(TestMap::value_type(2, 6));
+        map.insert(TestMap::value_type(1, 7));
+
+        EXPECT_EQ(++erased, map.end());
+        EXPECT_EQ(GetValues(map, 1), std::vector<uint32>({ 7 }));
+        EXPECT_EQ(GetValues(map, 2), std::vector<uint32>({ 5, 6 }));
+        EXPECT_EQ(GetValues(map), std::vector<uint32>({ 5, 6, 7 }));
+
+        map.compact();
+        EXPECT_EQ(GetValues(map, 1), std::vector<uint32>({ 7 }));
+        EXPECT_EQ(GetValues(map, 2), std::vector<uint32>({ 5, 6 }));
+        EXPECT_EQ(GetValues(map), std::vector<uint32>({ 5, 6, 7 }));
+
+        map.clear();
+        map.insert(TestMap::value_type(2, 8));
+        EXPECT_EQ(GetValues(map, 1), std::vector<uint32>());
+        EXPECT_EQ(GetValues(map), std::vector<uint32>({ 8 }));
+    }
+
+    TEST(FlatMultiMapTest, MatchesMultimap)
+    {
+        std::mt19937 random(42);
+        TestMap map;
+        std::multimap<uint32, uint32> reference;
+
+        for (uint32 step = 0; step < 20000; ++step)
+        {
+            uint32 key = random() % 64;
+            switch (random() % 4)
+            {
+                case 0:
+                case 1:
+                    map.insert(TestMap::value_type(key, step));
+                    reference.insert(std::make_pair(key, step));
+                    break;
+                case 2:
+                {
+                    auto range = reference.equal_range(key);
+                    if (range.first == range.second)
+                        break;
+
+                    // erase the last element of the key
+                    uint32 value = std::prev(range.second)->second;
+                    reference.erase(std::prev(range.second));
+
+                    TestMap::iterator itr = map.find(key);
+                    while (itr->second != value)
+                        ++itr;
+
+                    map.erase(itr);
+                    break;
+                }
+                default:
+                    if (step % 16 == 0)
+                        map.compact();
+                    break;
+            }
+
+            std::vector<uint32> expected;
+            for (auto range = reference.equal_range(key); range.first != range.second; ++range.first)
+                expected.push_back(range.first->second);
+
+            ASSERT_EQ(GetValues(map, key), expected);
+            ASSERT_EQ(map.size(), reference.size());
+        }
+    }
+
+    struct BenchmarkAura
+    {
+        uint32 CasterId;
+        uint32 Duration;
+    };
+
+    template <typename Map>
+    uint32 RunRaidFight(std::vector<BenchmarkAura>& auras, std::vector<std::pair<uint32, uint32>> const& casts, uint32 ticks)
+    {
+        constexpr uint32 DEBUFFS_PER_TICK = 64;
+
+        Map map;
+        uint32 found = 0;
+        std::size_t cast = 0;
+
+        for (uint32 tick = 0; tick < ticks; ++tick)
+        {
+            // update every aura, drop the expired ones
+            for (typename Map::iterator itr = map.begin(); itr != map.end();)
+            {
+                if (!--auras[itr->second].Duration)
+                    itr = map.erase(itr);
+                else
+                    ++itr;
+            }
+
+            if constexpr (std::is_same_v<Map, TestMap>)
+                map.compact();
+
+            // players refresh their debuffs: look for their own one first, like Unit::GetOwnedAura does
+            for (uint32 i = 0; i < DEBUFFS_PER_TICK; ++i, cast = (cast + 1) % casts.size())
+            {
+                uint32 const spellId = casts[cast].first;
+                uint32 const auraIndex = casts[cast].second;
+
+                bool refreshed = false;
+                for (auto range = map.equal_range(spellId); range.first != range.second; ++range.first)
+                {
+                    BenchmarkAura& aura = auras[range.first->second];
+                    if (aura.CasterId == auras[auraIndex].CasterId)
+                    {
+                        aura.Duration = 30;
+                        refreshed = true;
+                        ++found;
+                        break;
+                    }
+                }
+
+                if (!refreshed)
+                {
+                    auras[auraIndex].Duration = 30;
+                    map.insert(typename Map::value_type(spellId, auraIndex));
+                }
+            }
+        }
+
+        return found;
+    }
+
+    TEST(FlatMultiMapTest, DISABLED_BenchmarkRaidBossAuras)
+    {
+        // 40 players with 12 debuffs each from a pool of 80 spells on a boss
+        constexpr uint32 PLAYERS = 40;
+        constexpr uint32 DEBUFFS = 12;
+        constexpr uint32 TICKS = 20000;
+
+        std::mt19937 random(7);
+        std::vector<BenchmarkAura> auras;
+        std::vector<std::pair<uint32, uint32>> casts;
+        for (uint32 player = 0; player < PLAYERS; ++player)
+        {
+            for (uint32 debuff = 0; debuff < DEBUFFS; ++debuff)
+            {
+                casts.emplace_back(10000 + random() % 80 * 37, uint32(auras.size()));
+                auras.push_back({ player, 0 });
+            }
+        }
+
+        std::shuffle(casts.begin(), casts.end(), random);
+
+        std::vector<BenchmarkAura> treeAuras = auras;
+        auto start = std::chrono::steady_clock::now();
+        uint32 treeFound = RunRaidFight<std::multimap<uint32, uint32>>(treeAuras, casts, TICKS);
+        double tree = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<BenchmarkAura> flatAuras = auras;
+        start = std::chrono::steady_clock::now();
+        uint32 flatFound = RunRaidFight<TestMap>(flatAuras, casts, TICKS);
+        double flat = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("%u ticks, %u refreshes: multimap %.1f ms, flat %.1f ms (%.1fx)\n", TICKS, flatFound, tree, flat, tree / flat);
+        EXPECT_EQ(flatFound, treeFound);
+    }
+}
@@ -0,0 +1,160 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TrigramIndex.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    std::vector<uint32> Find(TrigramIndex const& index, std::wstring_view pattern)
+    {
+        std::vector<uint32> candidates;
+        EXPECT_TRUE(index.FindCandidates(pattern, candidates));
+        return candidates;
+    }
+
+    TEST(TrigramIndexTest, FindsTextsContainingAllTrigrams)
+    {
+        TrigramIndex index;
+        index.Add(1, L"linen cloth");
+        index.Add(2, L"bolt of linen cloth");
+        index.Add(3, L"wool cloth");
+        index.Add(4, L"copper bar");
+
+        EXPECT_EQ(Find(index, L"linen"), std::vector<uint32>({ 1, 2 }));
+        EXPECT_EQ(Find(index, L"cloth"), std::vector<uint32>({ 1, 2, 3 }));
+        EXPECT_EQ(Find(index, L"bar"), std::vector<uint32>({ 4 }));
+        EXPECT_TRUE(Find(index, L"silk").empty());
+
+        // candidates are a superset, 5 has all trigrams of "cloth" without containing it
+        index.Add(5, L"clot oth");
+        EXPECT_EQ(Find(index, L"cloth"), std::vector<uint32>({ 1, 2, 3, 5 }));
+    }
+
+    TEST(TrigramIndexTest, ShortPatternsMatchEverything)
+    {
+        TrigramIndex index;
+        index.Add(1, L"ab");
+        index.Add(2, L"abc");
+
+        std::vector<uint32> candidates = { 7 };
+        EXPECT_FALSE(index.FindCandidates(L"ab", candidates));
+        EXPECT_TRUE(candidates.empty());
+        EXPECT_FALSE(index.FindCandidates(L"", candidates));
+
+        EXPECT_EQ(Find(index, L"abc"), std::vector<uint32>({ 2 }));
+    }
+
+    TEST(TrigramIndexTest, AddOutOfOrderAndRemove)
+    {
+        TrigramIndex index;
+        index.Add(9, L"arcanite bar");
+        index.Add(3, L"arcanite rod");
+        index.Add(6, L"arcanite reaper");
+        index.Add(6, L"arcanite reaper");
+
+        EXPECT_EQ(Find(index, L"arcanite"), std::vector<uint32>({ 3, 6, 9 }));
+
+        index.Remove(6, L"arcanite reaper");
+        EXPECT_EQ(Find(index, L"arcanite"), std::vector<uint32>({ 3, 9 }));
+        EXPECT_TRUE(Find(index, L"reaper").empty());
+
+        index.Remove(3, L"arcanite rod");
+        index.Remove(9, L"arcanite bar");
+        EXPECT_EQ(index.GetTrigramCount(), 0u);
+    }
+
+    TEST(TrigramIndexTest, NonLatinCharacters)
+    {
+        TrigramIndex index;
+        index.Add(1, L"льняная ткань");
+        index.Add(2, L"шерстяная ткань");
+
+        EXPECT_EQ(Find(index, L"ткань"), std::vector<uint32>({ 1, 2 }));
+        EXPECT_EQ(Find(index, L"льня"), std::vector<uint32>({ 1 }));
+    }
+
+    // Item names as found on a busy auction house: a base name, often with a prefix and a random suffix
+    std::vector<std::wstring> BuildItemNames(uint32 count)
+    {
+        std::wstring const prefixes[] = { L"", L"", L"", L"runed ", L"heavy ", L"ornate ", L"knight's ", L"savage ", L"frostsaber ", L"glorious ", L"infused ", L"titansteel " };
+        std::wstring const bases[] = { L"linen cloth", L"frostweave cloth", L"saronite bar", L"cobalt ore", L"goldclover", L"lichbloom", L"eternal fire",
+            L"infinite dust", L"greater cosmic essence", L"dream shard", L"borean leather", L"arctic fur", L"runic healing potion", L"flask of endless rage",
+            L"broadsword", L"longbow", L"chain leggings", L"leather belt", L"cloth gloves", L"plate helm", L"signet ring", L"pendant", L"battle axe",
+            L"war maul", L"dagger", L"staff", L"shoulderpads", L"bracers", L"boots", L"cloak", L"scarlet ruby", L"autumn's glow", L"monarch topaz" };
+        std::wstring const suffixes[] = { L"", L"", L"", L"", L" of the bear", L" of the eagle", L" of the monkey", L" of the tiger", L" of the whale",
+            L" of the owl", L" of the boar", L" of the falcon", L" of the wolf", L" of agility", L" of stamina", L" of intellect", L" of spirit",
+            L" of strength", L" of healing", L" of power", L" of the sorcerer", L" of the champion", L" of the elder", L" of the soldier" };
+
+        // fixed linear congruential sequence so every run searches the same names
+        uint32 seed = 12345;
+        auto next = [&seed](uint32 bound) { seed = seed * 1103515245 + 12345; return (seed >> 16) % bound; };
+
+        std::vector<std::wstring> names;
+        names.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+            names.push_back(prefixes[next(std::size(prefixes))] + bases[next(std::size(bases))] + suffixes[next(std::size(suffixes))]);
+
+        return names;
+    }
+
+    TEST(TrigramIndexTest, DISABLED_BenchmarkItemNameSearch)
+    {
+        std::vector<std::wstring> const names = BuildItemNames(60000);
+        std::wstring const patterns[] = { L"cloth", L"saronite", L"of the bear", L"titansteel", L"flask of endless", L"glow", L"missing item" };
+        constexpr uint32 iterations = 50;
+
+        TrigramIndex index;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < names.size(); ++i)
+            index.Add(i, names[i]);
+
+        double build = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%zu names, %zu trigrams, built in %.1f ms\n", names.size(), index.GetTrigramCount(), build);
+
+        for (std::wstring const& pattern : patterns)
+        {
+            uint32 scanned = 0;
+            start = std::chrono::steady_clock::now();
+            for (uint32 i = 0; i < iterations; ++i)
+                for (std::wstring const& name : names)
+                    if (name.find(pattern) != std::wstring::npos)
+                        ++scanned;
+
+            double before = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+            uint32 indexed = 0;
+            std::vector<uint32> candidates;
+            start = std::chrono::steady_clock::now();
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                index.FindCandidates(pattern, candidates);
+                for (uint32 id : candidates)
+                    if (names[id].find(pattern) != std::wstring::npos)
+                        ++indexed;
+            }
+
+            double after = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+            std::printf("%-18ls %6u matches: scan %9.1f us, index %9.1f us (%.1fx)\n", pattern.c_str(), scanned / iterations, before, after, before / after);
+            EXPECT_EQ(indexed, scanned);
+        }
+    }
+}
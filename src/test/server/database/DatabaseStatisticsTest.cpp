@@ -0,0 +1,108 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseStatistics.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    TEST(DatabaseStatisticsTest, CountsPerSlot)
+    {
+        DatabaseStatistics statistics("test", 10);
+        statistics.SetStatementQuery(3, "SELECT 1");
+
+        statistics.OnEnqueue();
+        statistics.OnEnqueue();
+        EXPECT_EQ(statistics.GetQueueSize(), 2);
+
+        statistics.OnDequeue(DATABASE_STATISTICS_STATEMENT + 3, 100us);
+        statistics.OnExecute(DATABASE_STATISTICS_STATEMENT + 3, 40us);
+        statistics.OnDequeue(DATABASE_STATISTICS_STATEMENT + 3, 300us);
+        statistics.OnExecute(DATABASE_STATISTICS_STATEMENT + 3, 20us);
+        statistics.OnExecute(DATABASE_STATISTICS_ADHOC, 5us);
+
+        EXPECT_EQ(statistics.GetQueueSize(), 0);
+        EXPECT_EQ(statistics.GetPeakQueueSize(), 2);
+
+        std::vector<DatabaseSlotStatistics> slots = statistics.GetSlots();
+        ASSERT_EQ(slots.size(), 2u);
+
+        EXPECT_EQ(slots[0].Slot, uint32(DATABASE_STATISTICS_ADHOC));
+        EXPECT_EQ(slots[0].Executions, 1u);
+        EXPECT_EQ(slots[0].Waits, 0u);
+
+        DatabaseSlotStatistics const& statement = slots[1];
+        EXPECT_EQ(statement.Slot, uint32(DATABASE_STATISTICS_STATEMENT + 3));
+        EXPECT_EQ(statement.Query, "SELECT 1");
+        EXPECT_EQ(statement.Waits, 2u);
+        EXPECT_EQ(statement.WaitTotal, 400us);
+        EXPECT_EQ(statement.WaitMax, 300us);
+        EXPECT_EQ(statement.Executions, 2u);
+        EXPECT_EQ(statement.ExecutionTotal, 60us);
+        EXPECT_EQ(statement.ExecutionMax, 40us);
+        EXPECT_EQ(DatabaseStatistics::GetSlotName(statement.Slot), "3");
+    }
+
+    TEST(DatabaseStatisticsTest, IgnoresUnknownSlots)
+    {
+        DatabaseStatistics statistics("test", 1);
+
+        EXPECT_FALSE(statistics.OnExecute(DATABASE_STATISTICS_STATEMENT + 1, 1s));
+        EXPECT_TRUE(statistics.GetSlots().empty());
+    }
+
+    TEST(DatabaseStatisticsTest, SlowExecutionsAreSampled)
+    {
+        DatabaseStatistics statistics("test", 1);
+
+        // disabled by default
+        EXPECT_FALSE(statistics.OnExecute(DATABASE_STATISTICS_STATEMENT, 10s));
+
+        statistics.SetSlowQueryLogging(100ms, 3);
+        EXPECT_FALSE(statistics.OnExecute(DATABASE_STATISTICS_STATEMENT, 99ms));
+
+        std::vector<bool> logged;
+        for (uint32 i = 0; i < 7; ++i)
+            logged.push_back(statistics.OnExecute(DATABASE_STATISTICS_STATEMENT, 100ms));
+
+        EXPECT_EQ(logged, std::vector<bool>({ true, false, false, true, false, false, true }));
+
+        // slots are sampled on their own
+        EXPECT_TRUE(statistics.OnExecute(DATABASE_STATISTICS_ADHOC, 200ms));
+        EXPECT_EQ(statistics.GetSlots().back().SlowExecutions, 7u);
+    }
+
+    TEST(DatabaseStatisticsTest, ResetKeepsQueries)
+    {
+        DatabaseStatistics statistics("test", 1);
+        statistics.SetStatementQuery(0, "SELECT 1");
+
+        statistics.OnEnqueue();
+        statistics.OnEnqueue();
+        statistics.OnDequeue(DATABASE_STATISTICS_STATEMENT, 1ms);
+        statistics.OnExecute(DATABASE_STATISTICS_STATEMENT, 1ms);
+
+        statistics.Reset();
+        EXPECT_TRUE(statistics.GetSlots().empty());
+        EXPECT_EQ(statistics.GetQueueSize(), 1);
+        EXPECT_EQ(statistics.GetPeakQueueSize(), 1);
+
+        statistics.OnExecute(DATABASE_STATISTICS_STATEMENT, 1ms);
+        ASSERT_EQ(statistics.GetSlots().size(), 1u);
+        EXPECT_EQ(statistics.GetSlots()[0].Query, "SELECT 1");
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MultiRowStatement.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    enum TestStatements : uint32
+    {
+        TEST_REP_ROW,
+        TEST_REP_ROW_BATCH
+    };
+
+    constexpr uint8 BatchRows = 3;
+    constexpr uint8 Columns = 2;
+
+    struct TestConnection { };
+
+    // Hands out statements sized like the prepared ones of a real pool
+    struct TestDatabase
+    {
+        typedef TestStatements PreparedStatementIndex;
+
+        PreparedStatement<TestConnection>* GetPreparedStatement(PreparedStatementIndex index)
+        {
+            return new PreparedStatement<TestConnection>(index, index == TEST_REP_ROW_BATCH ? BatchRows * Columns : Columns);
+        }
+    };
+
+    struct TestTransaction
+    {
+        void Append(PreparedStatement<TestConnection>* stmt) { Statements.emplace_back(stmt); }
+
+        std::vector<std::unique_ptr<PreparedStatement<TestConnection>>> Statements;
+    };
+
+    uint32 GetUInt32(PreparedStatementBase const& stmt, std::size_t index)
+    {
+        return std::get<uint32>(stmt.GetParameters().at(index).data);
+    }
+
+    TEST(MultiRowStatementTest, EmptyStatementAppendsNothing)
+    {
+        TestDatabase database;
+        auto trans = std::make_shared<TestTransaction>();
+
+        MultiRowStatement statement(TEST_REP_ROW, TEST_REP_ROW_BATCH, BatchRows);
+        EXPECT_TRUE(statement.IsEmpty());
+        EXPECT_EQ(statement.GetRowCount(), 0u);
+
+        statement.AppendTo(database, trans);
+        EXPECT_TRUE(trans->Statements.empty());
+    }
+
+    TEST(MultiRowStatementTest, RowsFillBatchesBeforeSingleRows)
+    {
+        TestDatabase database;
+        auto trans = std::make_shared<TestTransaction>();
+
+        MultiRowStatement statement(TEST_REP_ROW, TEST_REP_ROW_BATCH, BatchRows);
+        for (uint32 row = 0; row < 8; ++row)
+            statement.AddRow(uint32(1), row);
+
+        EXPECT_EQ(statement.GetRowCount(), 8u);
+        statement.AppendTo(database, trans);
+
+        // 8 rows are two batches of 3 and two single rows, in the order they were added
+        ASSERT_EQ(trans->Statements.size(), 4u);
+        EXPECT_EQ(trans->Statements[0]->GetIndex(), uint32(TEST_REP_ROW_BATCH));
+        EXPECT_EQ(trans->Statements[1]->GetIndex(), uint32(TEST_REP_ROW_BATCH));
+        EXPECT_EQ(trans->Statements[2]->GetIndex(), uint32(TEST_REP_ROW));
+        EXPECT_EQ(trans->Statements[3]->GetIndex(), uint32(TEST_REP_ROW));
+
+        uint32 row = 0;
+        for (std::unique_ptr<PreparedStatement<TestConnection>> const& stmt : trans->Statements)
+        {
+            for (std::size_t i = 0; i < stmt->GetParameters().size(); i += Columns, ++row)
+            {
+                EXPECT_EQ(GetUInt32(*stmt, i), 1u);
+                EXPECT_EQ(GetUInt32(*stmt, i + 1), row);
+            }
+        }
+
+        EXPECT_EQ(row, 8u);
+
+        // the rows were handed over, appending again writes nothing
+        EXPECT_TRUE(statement.IsEmpty());
+        statement.AppendTo(database, trans);
+        EXPECT_EQ(trans->Statements.size(), 4u);
+    }
+
+    TEST(MultiRowStatementTest, ExactBatchHasNoSingleRows)
+    {
+        TestDatabase database;
+        auto trans = std::make_shared<TestTransaction>();
+
+        MultiRowStatement statement(TEST_REP_ROW, TEST_REP_ROW_BATCH, BatchRows);
+        for (uint32 row = 0; row < BatchRows; ++row)
+            statement.AddRow(uint32(1), row);
+
+        statement.AppendTo(database, trans);
+
+        ASSERT_EQ(trans->Statements.size(), 1u);
+        EXPECT_EQ(trans->Statements[0]->GetIndex(), uint32(TEST_REP_ROW_BATCH));
+    }
+
+    TEST(MultiRowStatementTest, ValuesAreBoundWithoutEscaping)
+    {
+        TestDatabase database;
+        auto trans = std::make_shared<TestTransaction>();
+
+        // quotes and backslashes go to the server as parameters, never into the SQL text
+        MultiRowStatement statement(TEST_REP_ROW, TEST_REP_ROW_BATCH, BatchRows);
+        statement.AddRow(uint32(7), "it's a \\'test\\'");
+        statement.AppendTo(database, trans);
+
+        ASSERT_EQ(trans->Statements.size(), 1u);
+        std::vector<PreparedStatementData> const& parameters = trans->Statements[0]->GetParameters();
+        ASSERT_EQ(parameters.size(), 2u);
+        EXPECT_EQ(std::get<uint32>(parameters[0].data), 7u);
+        EXPECT_EQ(std::get<std::string>(parameters[1].data), "it's a \\'test\\'");
+    }
+
+    TEST(MultiRowStatementTest, JoinRows)
+    {
+        EXPECT_EQ(MultiRowStatement::JoinRows("(?, ?)", 3), "(?, ?), (?, ?), (?, ?)");
+        EXPECT_EQ(MultiRowStatement::JoinRows("?", 1), "?");
+    }
+}
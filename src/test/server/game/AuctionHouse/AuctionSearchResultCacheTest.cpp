@@ -0,0 +1,201 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionHouseSearcher.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    class AuctionSearchResultCacheTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _cache.SetDuration(30s);
+            _snapshot = std::make_shared<AuctionSearchSnapshot const>(SearchableAuctionEntriesMap(), std::make_shared<AuctionItemNameIndex>(), 0);
+            _cache.SetCurrentSnapshot(AuctionHouseFaction::Neutral, _snapshot.get());
+        }
+
+        std::unique_ptr<AuctionSearchListRequest> MakeRequest(ObjectGuid player, std::wstring const& name, uint32 listfrom = 0) const
+        {
+            AuctionHouseSearchInfo searchInfo;
+            searchInfo.wsearchedname = name;
+            searchInfo.listfrom = listfrom;
+            searchInfo.levelmin = 0;
+            searchInfo.levelmax = 0;
+            searchInfo.usable = false;
+            searchInfo.inventoryType = 0xffffffff;
+            searchInfo.itemClass = 0xffffffff;
+            searchInfo.itemSubClass = 0xffffffff;
+            searchInfo.quality = 0xffffffff;
+            searchInfo.getAll = false;
+
+            AuctionSortInfo sortInfo;
+            sortInfo.sortOrder = AUCTION_SORT_BUYOUT;
+            sortInfo.isDesc = false;
+            searchInfo.sorting.push_back(sortInfo);
+
+            AuctionHousePlayerInfo playerInfo;
+            playerInfo.playerGuid = player;
+            playerInfo.faction = 0;
+            playerInfo.loc_idx = 0;
+            playerInfo.locdbc_idx = 0;
+
+            std::unique_ptr<AuctionSearchListRequest> request = std::make_unique<AuctionSearchListRequest>(AuctionHouseFaction::Neutral, std::move(searchInfo), std::move(playerInfo));
+            request->snapshot = _snapshot;
+            return request;
+        }
+
+        std::shared_ptr<AuctionSearchResult> Store(AuctionSearchListRequest const& request, TimePoint now)
+        {
+            std::shared_ptr<AuctionSearchResult> result = std::make_shared<AuctionSearchResult>();
+            result->snapshot = request.snapshot;
+            result->listFaction = request.listFaction;
+            result->loc_idx = request.playerInfo.loc_idx;
+            result->searchInfo = request.searchInfo;
+            _cache.Store(request.playerInfo.playerGuid, result, now);
+            return result;
+        }
+
+        AuctionSearchResultCache _cache;
+        std::shared_ptr<AuctionSearchSnapshot const> _snapshot;
+        ObjectGuid const _player = ObjectGuid::Create<HighGuid::Player>(1);
+        TimePoint const _now = TimePoint() + 1h;
+    };
+
+    TEST_F(AuctionSearchResultCacheTest, NextPageOfSameSearchHits)
+    {
+        std::shared_ptr<AuctionSearchResult> result = Store(*MakeRequest(_player, L"cloth"), _now);
+
+        EXPECT_EQ(_cache.Find(*MakeRequest(_player, L"cloth", MAX_AUCTIONS_PER_PAGE), _now + 1s), result);
+
+        // other searches and other players do not get the result
+        EXPECT_EQ(_cache.Find(*MakeRequest(_player, L"bar"), _now), nullptr);
+        EXPECT_EQ(_cache.Find(*MakeRequest(ObjectGuid::Create<HighGuid::Player>(2), L"cloth"), _now), nullptr);
+
+        std::unique_ptr<AuctionSearchListRequest> sortedByLevel = MakeRequest(_player, L"cloth");
+        sortedByLevel->searchInfo.sorting[0].sortOrder = AUCTION_SORT_MINLEVEL;
+        EXPECT_EQ(_cache.Find(*sortedByLevel, _now), nullptr);
+
+        EXPECT_EQ(_cache.Find(*MakeRequest(_player, L"cloth"), _now), result);
+    }
+
+    TEST_F(AuctionSearchResultCacheTest, OutdatedSnapshotMisses)
+    {
+        Store(*MakeRequest(_player, L"cloth"), _now);
+
+        std::shared_ptr<AuctionSearchSnapshot const> oldSnapshot = _snapshot;
+        _snapshot = std::make_shared<AuctionSearchSnapshot const>(SearchableAuctionEntriesMap(), std::make_shared<AuctionItemNameIndex>(), 0);
+        EXPECT_EQ(_cache.Find(*MakeRequest(_player, L"cloth"), _now), nullptr);
+
+        // the result of the outdated snapshot is dropped with it
+        EXPECT_EQ(oldSnapshot.use_count(), 1);
+    }
+
+    TEST_F(AuctionSearchResultCacheTest, ReplacedSnapshotDropsItsResults)
+    {
+        std::shared_ptr<AuctionSearchResult> result = Store(*MakeRequest(_player, L"cloth"), _now);
+
+        std::unique_ptr<AuctionSearchListRequest> hordeRequest = MakeRequest(ObjectGuid::Create<HighGuid::Player>(2), L"cloth");
+        hordeRequest->listFaction = AuctionHouseFaction::Horde;
+        _cache.SetCurrentSnapshot(AuctionHouseFaction::Horde, _snapshot.get());
+        std::shared_ptr<AuctionSearchResult> hordeResult = Store(*hordeRequest, _now);
+
+        // an auction changed, nobody searched since
+        _cache.SetCurrentSnapshot(AuctionHouseFaction::Neutral, nullptr);
+        EXPECT_EQ(result.use_count(), 1);
+        EXPECT_EQ(hordeResult.use_count(), 2);
+
+        // a worker finishing a search of the old snapshot afterwards does not keep it either
+        result = Store(*MakeRequest(_player, L"cloth"), _now);
+        EXPECT_EQ(result.use_count(), 1);
+    }
+
+    TEST_F(AuctionSearchResultCacheTest, ResultsExpireUnlessUsed)
+    {
+        Store(*MakeRequest(_player, L"cloth"), _now);
+
+        // using a result keeps it for another duration
+        EXPECT_NE(_cache.Find(*MakeRequest(_player, L"cloth"), _now + 20s), nullptr);
+        EXPECT_NE(_cache.Find(*MakeRequest(_player, L"cloth"), _now + 40s), nullptr);
+        EXPECT_EQ(_cache.Find(*MakeRequest(_player, L"cloth"), _now + 71s), nullptr);
+
+        std::shared_ptr<AuctionSearchResult> result = Store(*MakeRequest(_player, L"cloth"), _now);
+        _cache.RemoveExpired(_now + 29s);
+        EXPECT_EQ(result.use_count(), 2);
+
+        _cache.RemoveExpired(_now + 30s);
+        EXPECT_EQ(result.use_count(), 1);
+    }
+
+    TEST(AuctionSearchResultTest, PagesMatchFullSort)
+    {
+        // a few equal buyouts, the bids still tell every entry apart
+        std::vector<SearchableAuctionEntry> auctions(4 * MAX_AUCTIONS_PER_PAGE + 17);
+        for (uint32 i = 0; i < auctions.size(); ++i)
+        {
+            auctions[i].Id = i + 1;
+            auctions[i].buyout = (i * 7919) % 150;
+            auctions[i].bid = i;
+        }
+
+        AuctionSortOrderVector sorting(1);
+        sorting[0].sortOrder = AUCTION_SORT_BUYOUT;
+        sorting[0].isDesc = false;
+        AuctionSorter sorter(&sorting, 0);
+
+        AuctionSearchResult result;
+        for (SearchableAuctionEntry const& auction : auctions)
+            result.entries.push_back(&auction);
+
+        std::shuffle(result.entries.begin(), result.entries.end(), std::mt19937(42));
+
+        SortableAuctionEntriesList expected = result.entries;
+        std::sort(expected.begin(), expected.end(), sorter);
+
+        auto checkPage = [&](std::size_t page)
+        {
+            std::size_t const listfrom = page * MAX_AUCTIONS_PER_PAGE;
+            std::size_t const listto = std::min<std::size_t>(listfrom + MAX_AUCTIONS_PER_PAGE, result.entries.size());
+            result.SortEntries(listto, sorter);
+
+            ASSERT_GE(result.sortedCount, listto);
+            for (std::size_t i = listfrom; i < listto; ++i)
+                EXPECT_EQ(result.entries[i]->Id, expected[i]->Id) << "page " << page << " position " << i;
+        };
+
+        checkPage(0);
+        checkPage(1);
+        EXPECT_EQ(result.sortedCount, 2u * MAX_AUCTIONS_PER_PAGE);
+
+        // jumping past the sorted entries sorts the skipped page as well
+        checkPage(3);
+        EXPECT_EQ(result.sortedCount, 4u * MAX_AUCTIONS_PER_PAGE);
+
+        // pages already sent are not sorted again
+        checkPage(2);
+        checkPage(0);
+        EXPECT_EQ(result.sortedCount, 4u * MAX_AUCTIONS_PER_PAGE);
+
+        // the last page is only partly filled
+        checkPage(4);
+        EXPECT_EQ(result.sortedCount, result.entries.size());
+        EXPECT_EQ(result.entries, expected);
+    }
+}
@@ -0,0 +1,258 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionHouseSearcher.h"
+#include "ItemTemplate.h"
+#include "gtest/gtest.h"
+#include <deque>
+
+namespace
+{
+    class AuctionSearchSnapshotTest : public ::testing::Test
+    {
+    protected:
+        void AddAuction(uint32 id, uint32 itemClass, uint32 itemSubClass, uint32 inventoryType, uint32 quality, uint32 requiredLevel,
+            ObjectGuid owner = ObjectGuid::Empty, ObjectGuid bidder = ObjectGuid::Empty, std::wstring const& name = L"")
+        {
+            ItemTemplate& proto = _templates.emplace_back();
+            proto.Class = itemClass;
+            proto.SubClass = itemSubClass;
+            proto.InventoryType = inventoryType;
+            proto.Quality = quality;
+            proto.RequiredLevel = requiredLevel;
+
+            std::shared_ptr<SearchableAuctionEntry> entry = std::make_shared<SearchableAuctionEntry>();
+            entry->Id = id;
+            entry->ownerGuid = owner;
+            entry->bidderGuid = bidder;
+            entry->item.itemTemplate = &proto;
+
+            for (uint32 locale = 0; locale < TOTAL_LOCALES; ++locale)
+            {
+                entry->item.itemName[locale] = name;
+                entry->item.itemNameIds[locale] = _nameIndex->GetNameId(name);
+            }
+
+            _auctions[id] = entry;
+        }
+
+        static AuctionHouseSearchInfo NoFilters()
+        {
+            AuctionHouseSearchInfo searchInfo;
+            searchInfo.listfrom = 0;
+            searchInfo.levelmin = 0;
+            searchInfo.levelmax = 0;
+            searchInfo.usable = false;
+            searchInfo.inventoryType = 0xffffffff;
+            searchInfo.itemClass = 0xffffffff;
+            searchInfo.itemSubClass = 0xffffffff;
+            searchInfo.quality = 0xffffffff;
+            searchInfo.getAll = false;
+            return searchInfo;
+        }
+
+        std::vector<uint32> Search(AuctionHouseSearchInfo const& searchInfo, uint32 nameLocaleMask = 1 << LOCALE_enUS) const
+        {
+            AuctionSearchSnapshot snapshot(_auctions, _nameIndex, nameLocaleMask);
+            AuctionSearchSnapshot::PostingList positions;
+            snapshot.FindEntries(searchInfo, LOCALE_enUS, positions);
+
+            std::vector<uint32> ids;
+            for (uint32 position : positions)
+                ids.push_back(snapshot.GetEntry(position).Id);
+
+            return ids;
+        }
+
+        std::deque<ItemTemplate> _templates;
+        SearchableAuctionEntriesMap _auctions;
+        std::shared_ptr<AuctionItemNameIndex> _nameIndex = std::make_shared<AuctionItemNameIndex>();
+    };
+
+    TEST_F(AuctionSearchSnapshotTest, FiltersByItemClass)
+    {
+        AddAuction(1, ITEM_CLASS_WEAPON, ITEM_SUBCLASS_WEAPON_SWORD, INVTYPE_WEAPON, ITEM_QUALITY_RARE, 10);
+        AddAuction(2, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_CHEST, ITEM_QUALITY_NORMAL, 20);
+        AddAuction(3, ITEM_CLASS_WEAPON, ITEM_SUBCLASS_WEAPON_AXE, INVTYPE_WEAPON, ITEM_QUALITY_EPIC, 30);
+
+        AuctionHouseSearchInfo searchInfo = NoFilters();
+        searchInfo.itemClass = ITEM_CLASS_WEAPON;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 1, 3 }));
+
+        searchInfo.itemSubClass = ITEM_SUBCLASS_WEAPON_AXE;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 3 }));
+
+        searchInfo.itemClass = ITEM_CLASS_CONSUMABLE;
+        EXPECT_TRUE(Search(searchInfo).empty());
+    }
+
+    TEST_F(AuctionSearchSnapshotTest, RobesAreChests)
+    {
+        AddAuction(1, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_ROBE, ITEM_QUALITY_NORMAL, 0);
+        AddAuction(2, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_HEAD, ITEM_QUALITY_NORMAL, 0);
+        AddAuction(3, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_PLATE, INVTYPE_CHEST, ITEM_QUALITY_NORMAL, 0);
+
+        AuctionHouseSearchInfo searchInfo = NoFilters();
+        searchInfo.inventoryType = INVTYPE_CHEST;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 1, 3 }));
+
+        searchInfo.inventoryType = INVTYPE_ROBE;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 1 }));
+    }
+
+    TEST_F(AuctionSearchSnapshotTest, FiltersByQualityAndLevel)
+    {
+        AddAuction(1, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_HEAD, ITEM_QUALITY_POOR, 5);
+        AddAuction(2, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_HEAD, ITEM_QUALITY_RARE, 25);
+        AddAuction(3, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_HEAD, ITEM_QUALITY_EPIC, 60);
+        AddAuction(4, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_HEAD, ITEM_QUALITY_UNCOMMON, 70);
+
+        AuctionHouseSearchInfo searchInfo = NoFilters();
+        searchInfo.quality = ITEM_QUALITY_RARE;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 2, 3 }));
+
+        searchInfo = NoFilters();
+        searchInfo.levelmin = 20;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 2, 3, 4 }));
+
+        searchInfo.levelmax = 60;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 2, 3 }));
+
+        searchInfo.quality = ITEM_QUALITY_EPIC;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 3 }));
+
+        // a maximum level alone is not a filter
+        searchInfo = NoFilters();
+        searchInfo.levelmax = 10;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 1, 2, 3, 4 }));
+    }
+
+    TEST_F(AuctionSearchSnapshotTest, FindsAuctionsByIdOwnerAndBidder)
+    {
+        ObjectGuid const owner = ObjectGuid::Create<HighGuid::Player>(1);
+        ObjectGuid const bidder = ObjectGuid::Create<HighGuid::Player>(2);
+
+        AddAuction(7, ITEM_CLASS_MISC, 0, INVTYPE_NON_EQUIP, ITEM_QUALITY_NORMAL, 0, owner);
+        AddAuction(3, ITEM_CLASS_MISC, 0, INVTYPE_NON_EQUIP, ITEM_QUALITY_NORMAL, 0, owner, bidder);
+        AddAuction(5, ITEM_CLASS_MISC, 0, INVTYPE_NON_EQUIP, ITEM_QUALITY_NORMAL, 0, bidder);
+
+        AuctionSearchSnapshot snapshot(_auctions, _nameIndex, 0);
+        ASSERT_EQ(snapshot.GetSize(), 3u);
+
+        ASSERT_NE(snapshot.FindEntry(5), nullptr);
+        EXPECT_EQ(snapshot.FindEntry(5)->Id, 5u);
+        EXPECT_EQ(snapshot.FindEntry(4), nullptr);
+        EXPECT_EQ(snapshot.FindEntry(8), nullptr);
+
+        std::vector<uint32> owned;
+        for (uint32 position : snapshot.GetOwnerEntries(owner))
+            owned.push_back(snapshot.GetEntry(position).Id);
+
+        EXPECT_EQ(owned, std::vector<uint32>({ 3, 7 }));
+
+        ASSERT_EQ(snapshot.GetBidderEntries(bidder).size(), 1u);
+        EXPECT_EQ(snapshot.GetEntry(snapshot.GetBidderEntries(bidder)[0]).Id, 3u);
+        EXPECT_TRUE(snapshot.GetBidderEntries(owner).empty());
+    }
+
+    TEST_F(AuctionSearchSnapshotTest, FiltersByName)
+    {
+        ObjectGuid const nobody = ObjectGuid::Empty;
+
+        AddAuction(1, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_HEAD, ITEM_QUALITY_UNCOMMON, 0, nobody, nobody, L"frostwoven cowl of the bear");
+        AddAuction(2, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_HEAD, ITEM_QUALITY_UNCOMMON, 0, nobody, nobody, L"frostwoven cowl of the eagle");
+        AddAuction(3, ITEM_CLASS_TRADE_GOODS, 0, INVTYPE_NON_EQUIP, ITEM_QUALITY_NORMAL, 0, nobody, nobody, L"frostweave cloth");
+        AddAuction(4, ITEM_CLASS_ARMOR, ITEM_SUBCLASS_ARMOR_CLOTH, INVTYPE_HEAD, ITEM_QUALITY_UNCOMMON, 0, nobody, nobody, L"frostwoven cowl of the bear");
+
+        AuctionHouseSearchInfo searchInfo = NoFilters();
+        searchInfo.wsearchedname = L"frostwoven";
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 1, 2, 4 }));
+
+        searchInfo.wsearchedname = L"of the bear";
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 1, 4 }));
+
+        // parts of different names do not match together
+        searchInfo.wsearchedname = L"frostweave cowl";
+        EXPECT_TRUE(Search(searchInfo).empty());
+
+        searchInfo.wsearchedname = L"frost";
+        searchInfo.itemClass = ITEM_CLASS_TRADE_GOODS;
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 3 }));
+
+        // too short to be looked up, the caller compares the names
+        searchInfo = NoFilters();
+        searchInfo.wsearchedname = L"of";
+        EXPECT_EQ(Search(searchInfo), std::vector<uint32>({ 1, 2, 3, 4 }));
+
+        // names of locales nobody searched in are not indexed, the caller compares them as well
+        searchInfo.wsearchedname = L"frostwoven";
+        EXPECT_EQ(Search(searchInfo, 1 << LOCALE_deDE), std::vector<uint32>({ 1, 2, 3, 4 }));
+    }
+
+    TEST(AuctionSearchSnapshotBuilderTest, RequestsSeeEarlierUpdates)
+    {
+        ItemTemplate proto;
+        proto.Class = ITEM_CLASS_MISC;
+        proto.SubClass = 0;
+        proto.InventoryType = INVTYPE_NON_EQUIP;
+        proto.Quality = ITEM_QUALITY_NORMAL;
+        proto.RequiredLevel = 0;
+
+        ObjectGuid const owner = ObjectGuid::Create<HighGuid::Player>(1);
+        ObjectGuid const bidder = ObjectGuid::Create<HighGuid::Player>(2);
+
+        ProducerConsumerQueue<AuctionSearcherRequest*> requestQueue;
+        AuctionSearchResultCache resultCache;
+        AuctionSearchSnapshotBuilder builder(&requestQueue, &resultCache);
+
+        for (uint32 id = 1; id <= 3; ++id)
+        {
+            std::shared_ptr<SearchableAuctionEntry> entry = std::make_shared<SearchableAuctionEntry>();
+            entry->Id = id;
+            entry->ownerGuid = owner;
+            entry->bid = 0;
+            entry->listFaction = AuctionHouseFaction::Neutral;
+            entry->item.itemTemplate = &proto;
+            builder.AddAuctionSearchUpdateToQueue(std::make_shared<AuctionSearchAdd>(entry));
+        }
+
+        builder.AddAuctionSearchUpdateToQueue(std::make_shared<AuctionSearchRemove>(2, AuctionHouseFaction::Neutral));
+        builder.AddAuctionSearchUpdateToQueue(std::make_shared<AuctionSearchUpdateBid>(3, AuctionHouseFaction::Neutral, 50, bidder));
+        builder.AddSearchRequestToQueue(new AuctionSearchOwnerListRequest(AuctionHouseFaction::Neutral, owner));
+
+        AuctionSearcherRequest* request = nullptr;
+        requestQueue.WaitAndPop(request);
+        ASSERT_NE(request, nullptr);
+        std::unique_ptr<AuctionSearcherRequest> first(request);
+
+        AuctionSearchSnapshot const& snapshot = *first->snapshot;
+        EXPECT_EQ(snapshot.GetSize(), 2u);
+        EXPECT_EQ(snapshot.FindEntry(2), nullptr);
+        ASSERT_NE(snapshot.FindEntry(3), nullptr);
+        EXPECT_EQ(snapshot.FindEntry(3)->bid, 50u);
+        EXPECT_EQ(snapshot.GetBidderEntries(bidder).size(), 1u);
+
+        // without changes in between the snapshot is shared
+        builder.AddSearchRequestToQueue(new AuctionSearchOwnerListRequest(AuctionHouseFaction::Neutral, owner));
+        requestQueue.WaitAndPop(request);
+        ASSERT_NE(request, nullptr);
+        std::unique_ptr<AuctionSearcherRequest> second(request);
+        EXPECT_EQ(second->snapshot, first->snapshot);
+
+        builder.Stop();
+    }
+}
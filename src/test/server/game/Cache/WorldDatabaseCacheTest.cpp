@@ -0,0 +1,154 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "QueryResult.h"
+#include "WorldDatabaseCache.h"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <fstream>
+#include <optional>
+
+namespace
+{
+    void AppendValue(std::string& data, std::optional<std::string_view> value)
+    {
+        uint32 length = value ? uint32(value->size()) : ResultSetRows::NULL_LENGTH;
+        data.append(reinterpret_cast<char const*>(&length), sizeof(length));
+        if (value)
+            data.append(*value).push_back('\0');
+    }
+
+    std::shared_ptr<ResultSetRows> MakeRows()
+    {
+        std::shared_ptr<ResultSetRows> rows = std::make_shared<ResultSetRows>();
+        rows->Fields.resize(2);
+        rows->Fields[0].TableName = "creature_template";
+        rows->Fields[0].Name = "entry";
+        rows->Fields[0].Alias = "entry";
+        rows->Fields[0].Type = DatabaseFieldTypes::Int32;
+        rows->Fields[1].TableName = "creature_template";
+        rows->Fields[1].Name = "name";
+        rows->Fields[1].Alias = "name";
+        rows->Fields[1].Index = 1;
+        rows->Fields[1].Type = DatabaseFieldTypes::Binary;
+
+        std::shared_ptr<std::string> data = std::make_shared<std::string>();
+        AppendValue(*data, "1");
+        AppendValue(*data, "Wolf");
+        AppendValue(*data, "42");
+        AppendValue(*data, std::nullopt);
+        AppendValue(*data, "7");
+        AppendValue(*data, "");
+
+        rows->RowCount = 3;
+        rows->Data = *data;
+        rows->Storage = std::move(data);
+        return rows;
+    }
+
+    std::string TempPath(std::string_view name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+TEST(WorldDatabaseCacheTest, StoredRowsReadLikeQueryResults)
+{
+    std::shared_ptr<ResultSetRows> rows = MakeRows();
+    ASSERT_TRUE(rows->IsValid());
+
+    ResultSet result(rows);
+    EXPECT_EQ(result.GetRowCount(), 3u);
+    EXPECT_EQ(result.GetFieldCount(), 2u);
+    EXPECT_EQ(result.GetFieldName(1), "name");
+
+    ASSERT_TRUE(result.NextRow());
+    EXPECT_EQ(result[0].Get<uint32>(), 1u);
+    EXPECT_EQ(result[1].Get<std::string>(), "Wolf");
+
+    ASSERT_TRUE(result.NextRow());
+    EXPECT_EQ(result[0].Get<uint32>(), 42u);
+    EXPECT_TRUE(result[1].IsNull());
+
+    ASSERT_TRUE(result.NextRow());
+    EXPECT_EQ(result[0].Get<uint32>(), 7u);
+    EXPECT_FALSE(result[1].IsNull());
+    EXPECT_EQ(result[1].Get<std::string>(), "");
+
+    EXPECT_FALSE(result.NextRow());
+}
+
+TEST(WorldDatabaseCacheTest, RowsSurviveReadingThemAgain)
+{
+    std::shared_ptr<ResultSetRows> rows = MakeRows();
+    ResultSet result(rows);
+    ASSERT_TRUE(result.NextRow());
+
+    std::shared_ptr<ResultSetRows> copy = ResultSetRows::Read(result);
+    EXPECT_EQ(copy->RowCount, rows->RowCount);
+    EXPECT_EQ(copy->Data, rows->Data);
+    EXPECT_EQ(copy->Fields[1].Name, "name");
+}
+
+TEST(WorldDatabaseCacheTest, DetectsDamagedRows)
+{
+    std::shared_ptr<ResultSetRows> rows = MakeRows();
+    rows->RowCount = 4;
+    EXPECT_FALSE(rows->IsValid());
+
+    rows->RowCount = 3;
+    rows->Data.remove_suffix(1);
+    EXPECT_FALSE(rows->IsValid());
+}
+
+TEST(WorldDatabaseCacheTest, FileRoundTrip)
+{
+    std::string path = TempPath("acore_world_database_cache_test.cache");
+    WorldDatabaseCache::Key key = {};
+    key[0] = 1;
+
+    std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>> entries;
+    entries["SELECT entry, name FROM creature_template"] = MakeRows();
+    entries["SELECT entry FROM item_template"] = std::make_shared<ResultSetRows>();
+    ASSERT_TRUE(WorldDatabaseCache::WriteFile(path, key, entries));
+
+    std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>> loaded;
+    ASSERT_TRUE(WorldDatabaseCache::ReadFile(path, key, loaded));
+    ASSERT_EQ(loaded.size(), 2u);
+
+    std::shared_ptr<ResultSetRows const> rows = loaded["SELECT entry, name FROM creature_template"];
+    ASSERT_TRUE(rows);
+    EXPECT_EQ(rows->RowCount, 3u);
+    EXPECT_EQ(rows->Data, entries["SELECT entry, name FROM creature_template"]->Data);
+    EXPECT_EQ(rows->Fields[1].TableName, "creature_template");
+    EXPECT_EQ(rows->Fields[1].Type, DatabaseFieldTypes::Binary);
+    EXPECT_EQ(loaded["SELECT entry FROM item_template"]->RowCount, 0u);
+
+    // Outdated key
+    WorldDatabaseCache::Key otherKey = key;
+    otherKey[0] = 2;
+    loaded.clear();
+    EXPECT_FALSE(WorldDatabaseCache::ReadFile(path, otherKey, loaded));
+    EXPECT_TRUE(loaded.empty());
+
+    // Truncated file
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    EXPECT_FALSE(WorldDatabaseCache::ReadFile(path, key, loaded));
+
+    std::filesystem::remove(path);
+    EXPECT_FALSE(WorldDatabaseCache::ReadFile(path, key, loaded));
+}
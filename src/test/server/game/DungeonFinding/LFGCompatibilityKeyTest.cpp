@@ -0,0 +1,234 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Group.h"
+#include "LFGCompatibilityKey.h"
+#include "LFGMgr.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace lfg;
+
+namespace
+{
+    struct QueueEntry
+    {
+        LfgDungeonSet dungeons;
+        LfgRolesMap roles;
+    };
+
+    LfgRolesMap MakeRoles(std::vector<uint8> const& roles, uint32 firstGuid = 1)
+    {
+        LfgRolesMap rolesMap;
+        for (uint8 role : roles)
+            rolesMap[ObjectGuid::Create<HighGuid::Player>(firstGuid++)] = role;
+
+        return rolesMap;
+    }
+
+    // What LFGQueue::CheckCompatibility finds out about two queue entries from their sets and maps
+    bool CanMatchReference(QueueEntry const& left, QueueEntry const& right)
+    {
+        if (left.roles.size() + right.roles.size() > MAXGROUPSIZE)
+            return false;
+
+        LfgRolesMap roles = left.roles;
+        roles.insert(right.roles.begin(), right.roles.end());
+        if (!LFGMgr::CheckGroupRoles(roles))
+            return false;
+
+        LfgDungeonSet dungeons;
+        std::set_intersection(left.dungeons.begin(), left.dungeons.end(), right.dungeons.begin(), right.dungeons.end(), std::inserter(dungeons, dungeons.begin()));
+        return !dungeons.empty();
+    }
+
+    TEST(LFGCompatibilityKeyTest, RolesMatchCheckGroupRoles)
+    {
+        // every combination of two to five players with any roles, split between two queue entries
+        LfgDungeonSet const dungeons = { 261 };
+        uint8 const roleMasks[] = { PLAYER_ROLE_NONE, PLAYER_ROLE_TANK, PLAYER_ROLE_HEALER, PLAYER_ROLE_DAMAGE, PLAYER_ROLE_TANK | PLAYER_ROLE_HEALER,
+            PLAYER_ROLE_TANK | PLAYER_ROLE_DAMAGE, PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE, PLAYER_ROLE_TANK | PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE | PLAYER_ROLE_LEADER };
+
+        uint32 checked = 0;
+        for (uint32 players = 2; players <= MAXGROUPSIZE; ++players)
+        {
+            uint32 combinations = 1;
+            for (uint32 i = 0; i < players; ++i)
+                combinations *= std::size(roleMasks);
+
+            for (uint32 combination = 0; combination < combinations; ++combination)
+            {
+                std::vector<uint32> masks;
+                for (uint32 i = 0, rest = combination; i < players; ++i, rest /= std::size(roleMasks))
+                    masks.push_back(rest % std::size(roleMasks));
+
+                // the order of the players in the second entry does not matter
+                if (!std::is_sorted(masks.begin() + 1, masks.end()))
+                    continue;
+
+                std::vector<uint8> roles;
+                for (uint32 mask : masks)
+                    roles.push_back(roleMasks[mask]);
+
+                QueueEntry left{ dungeons, MakeRoles(std::vector<uint8>(roles.begin(), roles.begin() + 1)) };
+                QueueEntry right{ dungeons, MakeRoles(std::vector<uint8>(roles.begin() + 1, roles.end()), 10) };
+
+                LfgCompatibilityKey leftKey(left.dungeons, left.roles);
+                LfgCompatibilityKey rightKey(right.dungeons, right.roles);
+
+                ASSERT_EQ(leftKey.CanMatch(rightKey), CanMatchReference(left, right)) << "combination " << combination << " of " << players << " players";
+                ++checked;
+            }
+        }
+
+        EXPECT_GT(checked, 0u);
+    }
+
+    TEST(LFGCompatibilityKeyTest, DungeonsMustIntersect)
+    {
+        LfgRolesMap const tank = MakeRoles({ PLAYER_ROLE_TANK });
+        LfgRolesMap const healer = MakeRoles({ PLAYER_ROLE_HEALER }, 2);
+
+        LfgCompatibilityKey const key({ 206, 209, 210 }, tank);
+        EXPECT_TRUE(key.CanMatch(LfgCompatibilityKey({ 210, 211 }, healer)));
+        EXPECT_FALSE(key.CanMatch(LfgCompatibilityKey({ 211, 212 }, healer)));
+        EXPECT_FALSE(key.CanMatch(LfgCompatibilityKey({ }, healer)));
+
+        // a combination keeps only the dungeons of all its entries
+        LfgCompatibilityKey combination = key;
+        combination.Merge(LfgCompatibilityKey({ 209, 210 }, healer));
+        EXPECT_EQ(combination.players, 2);
+        EXPECT_TRUE(combination.CanMatch(LfgCompatibilityKey({ 210 }, MakeRoles({ PLAYER_ROLE_DAMAGE }, 3))));
+        EXPECT_FALSE(combination.CanMatch(LfgCompatibilityKey({ 206 }, MakeRoles({ PLAYER_ROLE_DAMAGE }, 3))));
+
+        // the second tank does not fit anymore
+        EXPECT_FALSE(combination.CanMatch(LfgCompatibilityKey({ 210 }, MakeRoles({ PLAYER_ROLE_TANK }, 3))));
+    }
+
+    // Queue at peak time: mostly damage dealers queued for random dungeons, few tanks and healers
+    std::vector<QueueEntry> BuildQueue(uint32 count)
+    {
+        std::mt19937 generator(4242);
+        std::uniform_int_distribution<uint32> percent(0, 99);
+
+        LfgDungeonSet heroic, normal, classic;
+        for (uint32 id = 205; id <= 226; ++id)
+            (id < 215 ? heroic : normal).insert(id);
+
+        for (uint32 id = 1; id <= 40; ++id)
+            classic.insert(id * 4);
+
+        std::vector<QueueEntry> queue;
+        queue.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            QueueEntry entry;
+
+            uint32 const dungeonRoll = percent(generator);
+            if (dungeonRoll < 60)
+                entry.dungeons = heroic;
+            else if (dungeonRoll < 80)
+                entry.dungeons = normal;
+            else if (dungeonRoll < 90)
+                entry.dungeons = classic;
+            else
+                entry.dungeons = { 205 + percent(generator) % 22 };
+
+            uint32 const players = percent(generator) < 85 ? 1 : 2 + percent(generator) % 2;
+            std::vector<uint8> roles;
+            for (uint32 player = 0; player < players; ++player)
+            {
+                uint32 const roleRoll = percent(generator);
+                if (roleRoll < 70)
+                    roles.push_back(PLAYER_ROLE_DAMAGE);
+                else if (roleRoll < 80)
+                    roles.push_back(PLAYER_ROLE_HEALER);
+                else if (roleRoll < 88)
+                    roles.push_back(PLAYER_ROLE_TANK);
+                else
+                    roles.push_back(PLAYER_ROLE_TANK | PLAYER_ROLE_DAMAGE);
+            }
+
+            entry.roles = MakeRoles(roles, i * 5 + 1);
+            queue.push_back(std::move(entry));
+        }
+
+        return queue;
+    }
+
+    TEST(LFGCompatibilityKeyTest, DISABLED_BenchmarkQueueScan)
+    {
+        constexpr uint32 queued = 2000;
+        constexpr uint32 newEntries = 100;
+        std::vector<QueueEntry> const queue = BuildQueue(queued + newEntries);
+
+        // like the compatible list of the queue: every queued entry alone and grown by other entries fitting with it
+        std::vector<QueueEntry> compatibles;
+        std::vector<LfgCompatibilityKey> keys;
+        std::mt19937 generator(2424);
+        for (uint32 i = 0; i < queued; ++i)
+        {
+            QueueEntry combination = queue[i];
+            compatibles.push_back(combination);
+
+            for (uint32 attempt = 0; attempt < 8 && combination.roles.size() < MAXGROUPSIZE - 1; ++attempt)
+            {
+                QueueEntry const& other = queue[generator() % queued];
+                if (combination.roles.count(other.roles.begin()->first) || !CanMatchReference(combination, other))
+                    continue;
+
+                LfgDungeonSet dungeons;
+                std::set_intersection(combination.dungeons.begin(), combination.dungeons.end(), other.dungeons.begin(), other.dungeons.end(), std::inserter(dungeons, dungeons.begin()));
+                combination.dungeons = dungeons;
+                combination.roles.insert(other.roles.begin(), other.roles.end());
+                compatibles.push_back(combination);
+            }
+        }
+
+        for (QueueEntry const& compatible : compatibles)
+            keys.emplace_back(compatible.dungeons, compatible.roles);
+
+        uint32 referenceMatches = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 newEntry = queued; newEntry < queue.size(); ++newEntry)
+            for (QueueEntry const& compatible : compatibles)
+                if (CanMatchReference(queue[newEntry], compatible))
+                    ++referenceMatches;
+
+        double before = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / newEntries;
+
+        uint32 keyMatches = 0;
+        start = std::chrono::steady_clock::now();
+        for (uint32 newEntry = queued; newEntry < queue.size(); ++newEntry)
+        {
+            LfgCompatibilityKey const newKey(queue[newEntry].dungeons, queue[newEntry].roles);
+            for (uint32 candidate = 0; candidate < keys.size(); ++candidate)
+                if (newKey.CanMatch(keys[candidate]) && CanMatchReference(queue[newEntry], compatibles[candidate]))
+                    ++keyMatches;
+        }
+
+        double after = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / newEntries;
+
+        std::printf("%zu compatibles, %.1f%% matching: sets and maps %9.1f us, keys first %9.1f us per join (%.1fx)\n",
+            compatibles.size(), 100.0 * referenceMatches / (newEntries * compatibles.size()), before, after, before / after);
+
+        EXPECT_EQ(keyMatches, referenceMatches);
+        EXPECT_LT(after, before);
+    }
+}
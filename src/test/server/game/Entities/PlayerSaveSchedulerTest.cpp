@@ -0,0 +1,115 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveScheduler.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    constexpr Milliseconds Interval = 900s;
+
+    TEST(PlayerSaveSchedulerTest, DelayIsDisabledWithoutInterval)
+    {
+        PlayerSaveScheduler scheduler;
+        scheduler.Configure(0ms, 0, 0);
+
+        EXPECT_EQ(scheduler.GetSaveDelay(1, 12345ms), 0u);
+    }
+
+    TEST(PlayerSaveSchedulerTest, DelayKeepsPlayerOnItsSlot)
+    {
+        PlayerSaveScheduler scheduler;
+        scheduler.Configure(Interval, 0, 0);
+
+        for (ObjectGuid::LowType guid = 1; guid < 200; ++guid)
+        {
+            Milliseconds now = Milliseconds(guid * 7919);
+            uint32 delay = scheduler.GetSaveDelay(guid, now);
+
+            EXPECT_GE(delay, uint32(Interval.count() / 10));
+            EXPECT_LT(delay, uint32(Interval.count() + Interval.count() / 10));
+
+            // saving at the slot leads to the same slot one interval later
+            Milliseconds slot = now + Milliseconds(delay);
+            EXPECT_EQ(scheduler.GetSaveDelay(guid, slot), uint32(Interval.count()));
+        }
+    }
+
+    TEST(PlayerSaveSchedulerTest, LoginWaveIsSpreadOverInterval)
+    {
+        PlayerSaveScheduler scheduler;
+        scheduler.Configure(Interval, 0, 0);
+
+        // 3000 players logging in at the same moment, count the saves due in every minute of the interval
+        constexpr uint32 Players = 3000;
+        constexpr uint32 Buckets = 15;
+        std::vector<uint32> saves(Buckets, 0);
+
+        Milliseconds login = 60s;
+        for (ObjectGuid::LowType guid = 1; guid <= Players; ++guid)
+        {
+            Milliseconds slot = login + Milliseconds(scheduler.GetSaveDelay(guid, login));
+            ++saves[(slot.count() % Interval.count()) * Buckets / Interval.count()];
+        }
+
+        uint32 const expected = Players / Buckets;
+        for (uint32 count : saves)
+        {
+            EXPECT_GT(count, expected * 3 / 4);
+            EXPECT_LT(count, expected * 5 / 4);
+        }
+    }
+
+    TEST(PlayerSaveSchedulerTest, AutoSavesAreRateLimited)
+    {
+        PlayerSaveScheduler scheduler;
+        scheduler.Configure(Interval, 10, 0);
+
+        uint32 acquired = 0;
+        while (scheduler.TryAcquireAutoSave())
+            ++acquired;
+
+        EXPECT_EQ(acquired, 10u);
+
+        // half a second refills half of the tokens
+        scheduler.Update(500);
+        acquired = 0;
+        while (scheduler.TryAcquireAutoSave())
+            ++acquired;
+
+        EXPECT_EQ(acquired, 5u);
+
+        // an idle period does not allow more than one second worth of saves
+        scheduler.Update(60000);
+        acquired = 0;
+        while (scheduler.TryAcquireAutoSave())
+            ++acquired;
+
+        EXPECT_EQ(acquired, 10u);
+    }
+
+    TEST(PlayerSaveSchedulerTest, NoLimitWithoutRate)
+    {
+        PlayerSaveScheduler scheduler;
+        scheduler.Configure(Interval, 0, 0);
+
+        for (uint32 i = 0; i < 1000; ++i)
+            EXPECT_TRUE(scheduler.TryAcquireAutoSave());
+    }
+}
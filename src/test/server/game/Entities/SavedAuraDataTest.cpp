@@ -0,0 +1,98 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SavedAuraData.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+    SavedAuraData MakeAura(uint32 spellId, int32 duration = -1, uint64 casterGuid = 1)
+    {
+        return { casterGuid, 0, spellId, 1, 0, 1, 0, { 10, 0, 0 }, { 10, 0, 0 }, -1, duration };
+    }
+
+    struct Diff
+    {
+        std::vector<uint32> Removed;
+        std::vector<uint32> Changed;
+    };
+
+    Diff Compare(SavedAuraList const& saved, SavedAuraList const& current)
+    {
+        Diff diff;
+        DiffSavedAuras(saved, current,
+            [&](SavedAuraData const& aura) { diff.Removed.push_back(aura.SpellId); },
+            [&](SavedAuraData const& aura) { diff.Changed.push_back(aura.SpellId); });
+        return diff;
+    }
+
+    TEST(SavedAuraDataTest, UnchangedAurasAreNotWritten)
+    {
+        SavedAuraList saved = { MakeAura(100), MakeAura(200), MakeAura(300) };
+        SortSavedAuras(saved);
+
+        Diff diff = Compare(saved, saved);
+        EXPECT_TRUE(diff.Removed.empty());
+        EXPECT_TRUE(diff.Changed.empty());
+    }
+
+    TEST(SavedAuraDataTest, GoneAurasAreDeleted)
+    {
+        SavedAuraList saved = { MakeAura(100), MakeAura(200), MakeAura(300), MakeAura(400) };
+        SavedAuraList current = { MakeAura(200), MakeAura(500) };
+        SortSavedAuras(saved);
+        SortSavedAuras(current);
+
+        Diff diff = Compare(saved, current);
+        EXPECT_EQ(diff.Removed, std::vector<uint32>({ 100, 300, 400 }));
+        EXPECT_EQ(diff.Changed, std::vector<uint32>({ 500 }));
+    }
+
+    TEST(SavedAuraDataTest, ChangedAurasAreWrittenAgain)
+    {
+        SavedAuraList saved = { MakeAura(100, 60000), MakeAura(200) };
+        SavedAuraList current = { MakeAura(100, 30000), MakeAura(200) };
+        current[1].StackAmount = 2;
+
+        Diff diff = Compare(saved, current);
+        EXPECT_TRUE(diff.Removed.empty());
+        EXPECT_EQ(diff.Changed, std::vector<uint32>({ 100, 200 }));
+    }
+
+    TEST(SavedAuraDataTest, KeyIncludesCaster)
+    {
+        // the same spell from another caster is another row
+        SavedAuraList saved = { MakeAura(100, -1, 1) };
+        SavedAuraList current = { MakeAura(100, -1, 2) };
+
+        Diff diff = Compare(saved, current);
+        EXPECT_EQ(diff.Removed, std::vector<uint32>({ 100 }));
+        EXPECT_EQ(diff.Changed, std::vector<uint32>({ 100 }));
+    }
+
+    TEST(SavedAuraDataTest, SortKeepsOneRowPerKey)
+    {
+        SavedAuraList auras = { MakeAura(300), MakeAura(100), MakeAura(300, 5000), MakeAura(200) };
+        SortSavedAuras(auras);
+
+        ASSERT_EQ(auras.size(), 3u);
+        EXPECT_EQ(auras[0].SpellId, 100u);
+        EXPECT_EQ(auras[1].SpellId, 200u);
+        EXPECT_EQ(auras[2].SpellId, 300u);
+    }
+}
@@ -0,0 +1,175 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UpdateFieldFlags.h"
+#include "UpdateMask.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace
+{
+    // The per field loop Object::BuildValuesUpdate used before, with one byte per field and the client blocks built bit by bit
+    void BuildReferenceMask(std::vector<uint8>& bits, ByteBuffer& data, uint32 count, uint32 const* flags, uint32 const* values,
+        std::vector<uint8> const* changes, uint32 notifyFlags, uint32 visibleFlag)
+    {
+        uint32 blockCount = (count + 31) / 32;
+        bits.assign(blockCount * 32, 0);
+
+        for (uint32 index = 0; index < count; ++index)
+            if (notifyFlags & flags[index] || ((changes ? (*changes)[index] : values[index]) && (flags[index] & visibleFlag)))
+                bits[index] = 1;
+
+        for (uint32 i = 0; i < blockCount; ++i)
+        {
+            uint32 maskPart = 0;
+            for (uint32 j = 0; j < 32; ++j)
+                if (bits[32 * i + j])
+                    maskPart |= 1 << j;
+
+            data << maskPart;
+        }
+    }
+
+    struct TestObject
+    {
+        TestObject(uint32 count, uint32 changed, uint32 seed) : Values(count), ChangeBytes(count)
+        {
+            std::mt19937 rng(seed);
+            for (uint32& value : Values)
+                value = rng() % 3 ? rng() : 0;
+
+            Changes.SetCount(count);
+            for (uint32 i = 0; i < changed; ++i)
+            {
+                uint32 index = rng() % count;
+                Changes.SetBit(index);
+                ChangeBytes[index] = 1;
+            }
+        }
+
+        std::vector<uint32> Values;
+        std::vector<uint8> ChangeBytes;
+        UpdateMask Changes;
+    };
+}
+
+TEST(UpdateMaskTest, BitsAndBlocks)
+{
+    UpdateMask mask;
+    mask.SetCount(70);
+    EXPECT_EQ(mask.GetBlockCount(), 3u);
+    EXPECT_TRUE(mask.IsEmpty());
+
+    mask.SetBit(0);
+    mask.SetBit(31);
+    mask.SetBit(69);
+    EXPECT_TRUE(mask.GetBit(31));
+    EXPECT_FALSE(mask.GetBit(32));
+    EXPECT_EQ(mask.GetBlock(0), 0x80000001u);
+    EXPECT_EQ(mask.GetBlock(2), 0x20u);
+
+    std::vector<uint32> visited;
+    mask.ForEachSetBit([&](uint32 index) { visited.push_back(index); });
+    EXPECT_EQ(visited, (std::vector<uint32>{ 0, 31, 69 }));
+
+    mask.UnsetBit(31);
+    ByteBuffer data;
+    mask.AppendToPacket(&data);
+    ASSERT_EQ(data.size(), 12u);
+    EXPECT_EQ(data.read<uint32>(), 1u);
+    EXPECT_EQ(data.read<uint32>(), 0u);
+    EXPECT_EQ(data.read<uint32>(), 0x20u);
+}
+
+TEST(UpdateMaskTest, MatchesPerFieldLoop)
+{
+    struct Case { uint32* Flags; uint32 Count; };
+    Case const cases[] = { { UnitUpdateFieldFlags, PLAYER_END }, { UnitUpdateFieldFlags, UNIT_END }, { ItemUpdateFieldFlags, ITEM_END },
+        { ItemUpdateFieldFlags, CONTAINER_END }, { GameObjectUpdateFieldFlags, GAMEOBJECT_END }, { CorpseUpdateFieldFlags, CORPSE_END } };
+
+    uint32 seed = 1;
+    for (Case const& test : cases)
+    {
+        for (uint32 visibleFlag : { uint32(UF_FLAG_PUBLIC), uint32(UF_FLAG_PUBLIC | UF_FLAG_PRIVATE), uint32(UF_FLAG_PUBLIC | UF_FLAG_OWNER | UF_FLAG_PARTY_MEMBER) })
+        {
+            for (uint32 notifyFlags : { uint32(UF_FLAG_NONE), uint32(UF_FLAG_DYNAMIC) })
+            {
+                TestObject object(test.Count, test.Count / 10, ++seed);
+                for (bool valuesUpdate : { false, true })
+                {
+                    std::vector<uint8> referenceBits;
+                    ByteBuffer reference;
+                    BuildReferenceMask(referenceBits, reference, test.Count, test.Flags, object.Values.data(),
+                        valuesUpdate ? &object.ChangeBytes : nullptr, notifyFlags, visibleFlag);
+
+                    UpdateMask mask;
+                    UpdateFieldFlagMasks::Get(test.Flags).BuildUpdateMask(mask, test.Count, object.Values.data(),
+                        valuesUpdate ? &object.Changes : nullptr, notifyFlags, visibleFlag);
+
+                    ByteBuffer built;
+                    mask.AppendToPacket(&built);
+                    ASSERT_EQ(built.size(), reference.size());
+                    EXPECT_EQ(std::memcmp(built.contents(), reference.contents(), built.size()), 0)
+                        << "count " << test.Count << " visible " << visibleFlag << " notify " << notifyFlags << " values update " << valuesUpdate;
+                }
+            }
+        }
+    }
+}
+
+// Cost of selecting the fields of a values update, run with --gtest_also_run_disabled_tests
+TEST(UpdateMaskTest, DISABLED_BenchmarkBuildValuesUpdateMask)
+{
+    struct Case { char const* Name; uint32* Flags; uint32 Count; };
+    Case const cases[] = { { "player", UnitUpdateFieldFlags, PLAYER_END }, { "creature", UnitUpdateFieldFlags, UNIT_END }, { "item", ItemUpdateFieldFlags, ITEM_END } };
+    constexpr uint32 iterations = 100000;
+
+    for (Case const& test : cases)
+    {
+        // A handful of changed fields per tick, as for health/power regeneration
+        TestObject object(test.Count, 4, 7);
+        uint32 sink = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint8> bits;
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            ByteBuffer data(256);
+            BuildReferenceMask(bits, data, test.Count, test.Flags, object.Values.data(), &object.ChangeBytes, UF_FLAG_NONE, UF_FLAG_PUBLIC);
+            sink += data.size();
+        }
+        double before = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+        start = std::chrono::steady_clock::now();
+        UpdateFieldFlagMasks const& masks = UpdateFieldFlagMasks::Get(test.Flags);
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            ByteBuffer data(256);
+            UpdateMask mask;
+            masks.BuildUpdateMask(mask, test.Count, object.Values.data(), &object.Changes, UF_FLAG_NONE, UF_FLAG_PUBLIC);
+            mask.AppendToPacket(&data);
+            sink += data.size();
+        }
+        double after = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+        std::printf("%-8s %4u fields: per field loop %8.1f ns, bit packed %8.1f ns (%.1fx) [%u]\n", test.Name, test.Count, before, after, before / after, sink);
+        EXPECT_LT(after, before);
+    }
+}
@@ -0,0 +1,283 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterRequestParser.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdio>
+#include <regex>
+
+namespace
+{
+    char const* const SLOTS[] = { "HEAD", "NECK", "SHOULDERS", "BACK", "CHEST", "WRISTS", "HANDS", "WAIST", "LEGS", "FEET",
+        "FINGER_1", "FINGER_2", "TRINKET_1", "TRINKET_2", "MAIN_HAND", "OFF_HAND", "RANGED", "BODY", "TABARD" };
+
+    // Full 19 slot gear set with enchants, 40 talents and 6 glyphs, like the tooling posts
+    std::string BuildRealisticPayload()
+    {
+        std::string json = "{\n  \"name\": \"Feral PvP\",\n  \"phase\": 3,\n  \"character\": {\n    \"name\": \"Bench\",\n"
+            "    \"level\": 80,\n    \"gameClass\": \"DRUID\",\n    \"race\": \"NIGHTELF\",\n    \"faction\": \"ALLIANCE\"\n  },\n  \"items\": [\n";
+
+        for (uint32 i = 0; i < 19; ++i)
+        {
+            char buffer[384];
+            std::snprintf(buffer, sizeof(buffer), "    {\"name\": \"Item number %u\", \"id\": %u, \"slot\": \"%s\", "
+                "\"enchant\": {\"name\": \"Enchant %u\", \"id\": %u, \"itemId\": %u, \"spellId\": %u}}%s\n",
+                i, 40000 + i, SLOTS[i], i, 3000 + i, 38000 + i, 60000 + i, i + 1 < 19 ? "," : "");
+            json += buffer;
+        }
+
+        json += "  ],\n  \"talents\": [\n";
+        for (uint32 i = 0; i < 40; ++i)
+        {
+            char buffer[192];
+            std::snprintf(buffer, sizeof(buffer), "    {\"name\": \"Talent %u\", \"id\": %u, \"rank\": %u, \"spellId\": %u}%s\n",
+                i, 100 + i, 1 + i % 5, 16000 + i, i + 1 < 40 ? "," : "");
+            json += buffer;
+        }
+
+        json += "  ],\n  \"glyphs\": [\n";
+        for (uint32 i = 0; i < 6; ++i)
+        {
+            char buffer[160];
+            std::snprintf(buffer, sizeof(buffer), "    {\"name\": \"Glyph %u\", \"id\": %u, \"type\": \"%s\"}%s\n",
+                i, 40900 + i, i < 3 ? "MAJOR" : "MINOR", i + 1 < 6 ? "," : "");
+            json += buffer;
+        }
+
+        json += "  ]\n}\n";
+        return json;
+    }
+
+    // The regex based extraction CharacterWebService used before, kept as benchmark baseline
+    std::string RegexString(std::string const& json, std::string const& key)
+    {
+        std::regex pattern("\"" + key + "\"\\s*:\\s*\"([^\"]+)\"");
+        std::smatch matches;
+        return std::regex_search(json, matches, pattern) ? matches[1].str() : "";
+    }
+
+    uint32 RegexNumber(std::string const& json, std::string const& key)
+    {
+        std::regex pattern("\"" + key + "\"\\s*:\\s*(\\d+)");
+        std::smatch matches;
+        return std::regex_search(json, matches, pattern) ? std::stoul(matches[1].str()) : 0;
+    }
+
+    std::vector<std::string> RegexArray(std::string const& json, std::string const& arrayName)
+    {
+        std::vector<std::string> items;
+        std::regex arrayPattern("\"" + arrayName + "\"\\s*:\\s*\\[([^\\]]+)\\]");
+        std::smatch arrayMatch;
+        if (!std::regex_search(json, arrayMatch, arrayPattern))
+            return items;
+
+        std::string content = arrayMatch[1].str();
+        std::size_t pos = 0;
+        while ((pos = content.find('{', pos)) != std::string::npos)
+        {
+            int braces = 1;
+            std::size_t end = pos + 1;
+            for (; end < content.length() && braces > 0; ++end)
+                braces += content[end] == '{' ? 1 : content[end] == '}' ? -1 : 0;
+
+            if (braces)
+                break;
+
+            items.push_back(content.substr(pos, end - pos));
+            pos = end;
+        }
+
+        return items;
+    }
+
+    void RegexParse(std::string const& body, CharacterRequest& request)
+    {
+        std::smatch match;
+        if (std::regex_search(body, match, std::regex("\"character\"\\s*:\\s*\\{([^}]+)\\}")))
+        {
+            std::string charData = match[1].str();
+            request.character.name = RegexString(charData, "name");
+            request.character.level = RegexNumber(charData, "level");
+            request.character.gameClass = RegexString(charData, "gameClass");
+            request.character.race = RegexString(charData, "race");
+        }
+
+        for (std::string const& itemStr : RegexArray(body, "items"))
+        {
+            ItemData& item = request.items.emplace_back();
+            item.name = RegexString(itemStr, "name");
+            item.id = RegexNumber(itemStr, "id");
+            item.slot = RegexString(itemStr, "slot");
+            if (std::regex_search(itemStr, match, std::regex("\"enchant\"\\s*:\\s*\\{([^}]+)\\}")))
+            {
+                std::string enchantData = match[1].str();
+                item.enchant.id = RegexNumber(enchantData, "id");
+                item.enchant.spellId = RegexNumber(enchantData, "spellId");
+            }
+        }
+
+        for (std::string const& talentStr : RegexArray(body, "talents"))
+        {
+            TalentData& talent = request.talents.emplace_back();
+            talent.id = RegexNumber(talentStr, "id");
+            talent.rank = RegexNumber(talentStr, "rank");
+        }
+
+        for (std::string const& glyphStr : RegexArray(body, "glyphs"))
+        {
+            GlyphData& glyph = request.glyphs.emplace_back();
+            glyph.id = RegexNumber(glyphStr, "id");
+            glyph.type = RegexString(glyphStr, "type");
+        }
+    }
+}
+
+TEST(CharacterRequestParserTest, ParsesFullRequest)
+{
+    CharacterRequest request;
+    CharacterRequestParseError error;
+    ASSERT_TRUE(ParseCharacterRequest(BuildRealisticPayload(), request, error)) << error.ToString();
+
+    EXPECT_EQ(request.name, "Feral PvP");
+    EXPECT_EQ(request.phase, 3u);
+    EXPECT_EQ(request.character.name, "Bench");
+    EXPECT_EQ(request.character.level, 80u);
+    EXPECT_EQ(request.character.gameClass, "DRUID");
+    EXPECT_EQ(request.character.race, "NIGHTELF");
+    EXPECT_EQ(request.character.faction, "ALLIANCE");
+
+    ASSERT_EQ(request.items.size(), 19u);
+    EXPECT_EQ(request.items[18].id, 40018u);
+    EXPECT_EQ(request.items[18].slot, "TABARD");
+    EXPECT_EQ(request.items[5].enchant.name, "Enchant 5");
+    EXPECT_EQ(request.items[5].enchant.id, 3005u);
+    EXPECT_EQ(request.items[5].enchant.itemId, 38005u);
+    EXPECT_EQ(request.items[5].enchant.spellId, 60005u);
+
+    ASSERT_EQ(request.talents.size(), 40u);
+    EXPECT_EQ(request.talents[7].rank, 3u);
+    EXPECT_EQ(request.talents[7].spellId, 16007u);
+
+    ASSERT_EQ(request.glyphs.size(), 6u);
+    EXPECT_EQ(request.glyphs[4].type, "MINOR");
+}
+
+TEST(CharacterRequestParserTest, SkipsUnknownKeysAndNulls)
+{
+    CharacterRequest request;
+    CharacterRequestParseError error;
+    ASSERT_TRUE(ParseCharacterRequest(R"({"meta": {"tags": [1, -2.5e3, true, false, null, "x"]}, "phase": null,
+        "items": [{"id": 5, "slot": "HEAD", "enchant": null, "extra": [[]]}], "talents": null, "name": "Solo"})", request, error)) << error.ToString();
+
+    EXPECT_EQ(request.phase, 0u);
+    ASSERT_EQ(request.items.size(), 1u);
+    EXPECT_EQ(request.items[0].id, 5u);
+    EXPECT_EQ(request.items[0].enchant.id, 0u);
+    EXPECT_TRUE(request.talents.empty());
+    // Without a character object the top level name is the character name
+    EXPECT_EQ(request.character.name, "Solo");
+}
+
+TEST(CharacterRequestParserTest, DecodesEscapes)
+{
+    CharacterRequest request;
+    CharacterRequestParseError error;
+    ASSERT_TRUE(ParseCharacterRequest(R"({"character": {"name": "A\"b\\cé😀"}})", request, error)) << error.ToString();
+    EXPECT_EQ(request.character.name, "A\"b\\c\xC3\xA9\xF0\x9F\x98\x80");
+}
+
+TEST(CharacterRequestParserTest, ReportsErrorPosition)
+{
+    CharacterRequest request;
+    CharacterRequestParseError error;
+
+    EXPECT_FALSE(ParseCharacterRequest("{\n  \"phase\": 1,\n  \"items\": [{\"id\": 1,}]\n}", request, error));
+    EXPECT_EQ(error.Line, 3u);
+    EXPECT_EQ(error.Column, 22u);
+    EXPECT_EQ(error.Message, "expected a string as object key");
+
+    EXPECT_FALSE(ParseCharacterRequest(R"({"phase": -1})", request, error));
+    EXPECT_EQ(error.Offset, 10u);
+
+    EXPECT_FALSE(ParseCharacterRequest(R"({"phase": 4294967296})", request, error));
+    EXPECT_EQ(error.Message, "number out of range");
+
+    EXPECT_FALSE(ParseCharacterRequest(R"({"character": {"level": "80"}})", request, error));
+    EXPECT_EQ(error.Message, "expected a number");
+
+    EXPECT_FALSE(ParseCharacterRequest(R"({"name": "unterminated)", request, error));
+    EXPECT_EQ(error.Message, "unterminated string");
+
+    EXPECT_FALSE(ParseCharacterRequest(R"({"phase": 1} trailing)", request, error));
+    EXPECT_EQ(error.Offset, 13u);
+
+    EXPECT_FALSE(ParseCharacterRequest(std::string(100, '[') + std::string(100, ']'), request, error));
+    EXPECT_FALSE(ParseCharacterRequest("{\"x\": " + std::string(100, '[') + std::string(100, ']') + "}", request, error));
+    EXPECT_EQ(error.Message, "nesting too deep");
+}
+
+TEST(CharacterRequestParserTest, ParsesBatch)
+{
+    std::vector<CharacterRequest> requests;
+    CharacterRequestParseError error;
+    ASSERT_TRUE(ParseCharacterBatchRequest(R"({"characters": [{"character": {"name": "One", "level": 10}},
+        {"name": "Two", "items": [{"id": 7, "slot": "NECK"}]}], "comment": "rig 3"})", requests, error)) << error.ToString();
+
+    ASSERT_EQ(requests.size(), 2u);
+    EXPECT_EQ(requests[0].character.name, "One");
+    EXPECT_EQ(requests[0].character.level, 10u);
+    EXPECT_EQ(requests[1].character.name, "Two");
+    ASSERT_EQ(requests[1].items.size(), 1u);
+    EXPECT_EQ(requests[1].items[0].slot, "NECK");
+
+    requests.clear();
+    EXPECT_FALSE(ParseCharacterBatchRequest(R"({"characters": [{"name": "One"}, 5]})", requests, error));
+    EXPECT_EQ(error.Message, "expected a character object");
+    EXPECT_EQ(error.Offset, 33u);
+}
+
+// Microbenchmark against the former regex extraction, run with --gtest_also_run_disabled_tests
+TEST(CharacterRequestParserTest, DISABLED_BenchmarkAgainstRegex)
+{
+    std::string const payload = BuildRealisticPayload();
+    constexpr uint32 iterations = 200;
+
+    auto measure = [&](auto&& parse)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            CharacterRequest request;
+            parse(request);
+            EXPECT_EQ(request.items.size(), 19u);
+        }
+
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+    };
+
+    double parser = measure([&](CharacterRequest& request)
+    {
+        CharacterRequestParseError error;
+        ParseCharacterRequest(payload, request, error);
+    });
+
+    double regex = measure([&](CharacterRequest& request) { RegexParse(payload, request); });
+
+    std::printf("Payload %zu bytes: parser %.2f us/request, regex %.2f us/request (%.1fx)\n", payload.size(), parser, regex, regex / parser);
+    EXPECT_LT(parser, regex);
+}
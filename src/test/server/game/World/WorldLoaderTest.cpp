@@ -0,0 +1,157 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldLoader.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    struct LoadRecorder
+    {
+        /// The step fails the test if any of the given steps has not finished when it starts
+        std::function<void()> Step(uint32 id, std::vector<uint32> const& finishedBefore = {})
+        {
+            return [this, id, finishedBefore]()
+            {
+                std::lock_guard<std::mutex> guard(Lock);
+                for (uint32 dependency : finishedBefore)
+                    EXPECT_LT(PositionOf(dependency), Order.size()) << "step " << id << " started before step " << dependency << " finished";
+
+                Order.push_back(id);
+            };
+        }
+
+        std::size_t PositionOf(uint32 id) const
+        {
+            return std::find(Order.begin(), Order.end(), id) - Order.begin();
+        }
+
+        std::mutex Lock;
+        std::vector<uint32> Order;
+    };
+
+    /// Lets a step block until another one opens it, instead of sleeping for a guessed time
+    struct Gate
+    {
+        void Open()
+        {
+            std::lock_guard<std::mutex> guard(Lock);
+            IsOpen = true;
+            Opened.notify_all();
+        }
+
+        bool Wait()
+        {
+            std::unique_lock<std::mutex> guard(Lock);
+            return Opened.wait_for(guard, std::chrono::seconds(10), [this]() { return IsOpen; });
+        }
+
+        std::mutex Lock;
+        std::condition_variable Opened;
+        bool IsOpen = false;
+    };
+}
+
+TEST(WorldLoaderTest, SingleThreadKeepsInsertionOrder)
+{
+    LoadRecorder recorder;
+    WorldLoader loader;
+    WorldLoader::StepId first = loader.Then("first", recorder.Step(0));
+    loader.After({}, "branch", recorder.Step(1));
+    loader.Then("second", recorder.Step(2));
+    loader.After({ first }, "late branch", recorder.Step(3));
+    loader.Then("third", recorder.Step(4));
+
+    loader.Run(1);
+
+    EXPECT_EQ(recorder.Order, (std::vector<uint32>{ 0, 1, 2, 3, 4 }));
+}
+
+TEST(WorldLoaderTest, ParallelRunRespectsDependencies)
+{
+    LoadRecorder recorder;
+    Gate chainDone;
+    std::function<void()> const recordBranch = recorder.Step(0);
+    bool branchOpened = false;
+
+    WorldLoader loader;
+    // The branch only finishes once the chain ran past it, so the chain must not wait for it until it needs it
+    WorldLoader::StepId branch = loader.After({}, "blocked branch", [&]() { branchOpened = chainDone.Wait(); recordBranch(); });
+    WorldLoader::StepId chainStart = loader.Then("chain 1", recorder.Step(1));
+    std::function<void()> const recordChain = recorder.Step(2, { 1 });
+    loader.Then("chain 2", [&]() { recordChain(); chainDone.Open(); });
+    WorldLoader::StepId sub = loader.After({ chainStart }, "sub branch", recorder.Step(3, { 1 }));
+    loader.Then("needs branch", recorder.Step(4, { 0, 2 }), { branch });
+    loader.Join({ sub });
+    loader.Then("needs sub branch", recorder.Step(5, { 3, 4 }));
+
+    loader.Run(4);
+
+    EXPECT_TRUE(branchOpened);
+    ASSERT_EQ(recorder.Order.size(), 6u);
+    EXPECT_LT(recorder.PositionOf(2), recorder.PositionOf(0));
+}
+
+TEST(WorldLoaderTest, RunsIndependentStepsConcurrently)
+{
+    // Every step waits until all of them started, which only happens when they run at the same time
+    std::mutex lock;
+    std::condition_variable allStarted;
+    uint32 started = 0;
+    std::atomic<uint32> overlapped = 0;
+    auto step = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        if (++started == 4)
+            allStarted.notify_all();
+
+        if (allStarted.wait_for(guard, std::chrono::seconds(10), [&]() { return started == 4; }))
+            ++overlapped;
+    };
+
+    WorldLoader loader;
+    for (uint32 i = 0; i < 4; ++i)
+        loader.After({}, "independent", step);
+
+    loader.Run(4);
+
+    EXPECT_EQ(overlapped.load(), 4u);
+}
+
+TEST(WorldLoaderTest, CriticalPathFollowsSlowestChain)
+{
+    WorldLoader loader;
+    WorldLoader::StepId start = loader.Then("start", []() { });
+    WorldLoader::StepId slow = loader.After({ start }, "slow", []() { std::this_thread::sleep_for(std::chrono::milliseconds(40)); });
+    loader.After({ start }, "fast", []() { });
+    loader.Then("middle", []() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+    WorldLoader::StepId end = loader.Then("end", []() { }, { slow });
+
+    loader.Run(2);
+
+    std::vector<WorldLoader::StepId> path = loader.GetCriticalPath();
+    EXPECT_EQ(path, (std::vector<WorldLoader::StepId>{ start, slow, end }));
+    EXPECT_GE(loader.GetStep(slow).DurationMs, 40u);
+    EXPECT_GE(loader.GetElapsedMs(), loader.GetStep(slow).DurationMs);
+}